@@ -34,6 +34,28 @@ namespace Plugin {
     static Core::ProxyPoolType<Web::JSONBodyType<PluginHost::MetaData::Service>> jsonBodyServiceFactory(1);
     static Core::ProxyPoolType<Web::TextBody> jsonBodyTextFactory(2);
 
+    // Prometheus label values are quoted, a backslash, quote or newline in them must be escaped.
+    static string LabelValue(const string& value)
+    {
+        string result;
+
+        result.reserve(value.length());
+
+        for (const TCHAR character : value) {
+            if (character == '\\') {
+                result += _T("\\\\");
+            } else if (character == '\"') {
+                result += _T("\\\"");
+            } else if (character == '\n') {
+                result += _T("\\n");
+            } else {
+                result += character;
+            }
+        }
+
+        return (result);
+    }
+
     void Controller::SubSystems(Core::JSON::ArrayType<Core::JSON::EnumType<PluginHost::ISubSystem::subsystem>>::ConstIterator& index)
     {
         PluginHost::ISubSystem* subSystem = _service->SubSystems();
@@ -185,6 +207,101 @@ namespace Plugin {
         return (result);
     }
 
+    void Controller::LatencyMetrics(string& text) const
+    {
+        static const TCHAR metric[] = _T("wpeframework_rpc_latency_microseconds");
+
+        text = string(_T("# HELP ")) + metric + _T(" Latency of the COM-RPC and JSON-RPC calls per phase.\n")
+            + _T("# TYPE ") + metric + _T(" summary\n");
+
+        Core::LatencyStatistics::Instance().Visit([&text](const Core::LatencyStatistics::Metric& entry) {
+            const std::pair<const TCHAR*, const Core::LatencyHistogram*> phases[] = {
+                { _T("queue"), &entry.Queue },
+                { _T("execution"), &entry.Execution },
+                { _T("serialization"), &entry.Serialization }
+            };
+
+            for (const auto& phase : phases) {
+                const Core::LatencyHistogram& histogram(*phase.second);
+
+                if (histogram.Count() > 0) {
+                    const string labels(_T("protocol=\"") + LabelValue(entry.Category) + _T("\",method=\"") + LabelValue(entry.Name) + _T("\",phase=\"") + phase.first + _T("\""));
+
+                    text += string(metric) + _T("{") + labels + _T(",quantile=\"0.5\"} ") + Core::NumberType<uint64_t>(histogram.Percentile(50)).Text() + _T("\n");
+                    text += string(metric) + _T("{") + labels + _T(",quantile=\"0.9\"} ") + Core::NumberType<uint64_t>(histogram.Percentile(90)).Text() + _T("\n");
+                    text += string(metric) + _T("{") + labels + _T(",quantile=\"0.99\"} ") + Core::NumberType<uint64_t>(histogram.Percentile(99)).Text() + _T("\n");
+                    text += string(metric) + _T("_sum{") + labels + _T("} ") + Core::NumberType<uint64_t>(histogram.Sum()).Text() + _T("\n");
+                    text += string(metric) + _T("_count{") + labels + _T("} ") + Core::NumberType<uint32_t>(histogram.Count()).Text() + _T("\n");
+                }
+            }
+        });
+    }
+
+    void Controller::LockMetrics(string& text) const
+    {
+        const std::pair<const TCHAR*, Core::ReadWriteLock::Contention> locks[] = {
+            { _T("services"), _pluginServer->Services().LockStatistics() },
+            { _T("subsystems"), _pluginServer->Services().SubSystemLockStatistics() }
+        };
+
+        const std::pair<const TCHAR*, const TCHAR*> counters[] = {
+            { _T("wpeframework_lock_acquisitions_total"), _T("Read/write lock acquisitions.") },
+            { _T("wpeframework_lock_contended_total"), _T("Read/write lock acquisitions that had to wait.") }
+        };
+
+        for (const auto& counter : counters) {
+            const bool contended = (counter.first == counters[1].first);
+
+            text += string(_T("# HELP ")) + counter.first + _T(" ") + counter.second + _T("\n")
+                + _T("# TYPE ") + counter.first + _T(" counter\n");
+
+            for (const auto& lock : locks) {
+                const string labels(_T("{lock=\"") + string(lock.first) + _T("\",mode=\""));
+
+                text += counter.first + labels + _T("read\"} ") + Core::NumberType<uint64_t>(contended ? lock.second.ReadContended : lock.second.ReadAcquired).Text() + _T("\n");
+                text += counter.first + labels + _T("write\"} ") + Core::NumberType<uint64_t>(contended ? lock.second.WriteContended : lock.second.WriteAcquired).Text() + _T("\n");
+            }
+        }
+
+        text += _T("# HELP wpeframework_lock_wait_microseconds_total Time spent waiting for read/write locks.\n")
+                _T("# TYPE wpeframework_lock_wait_microseconds_total counter\n");
+
+        for (const auto& lock : locks) {
+            text += _T("wpeframework_lock_wait_microseconds_total{lock=\"") + string(lock.first) + _T("\"} ") + Core::NumberType<uint64_t>(lock.second.WaitTime).Text() + _T("\n");
+        }
+
+        text += _T("# HELP wpeframework_lock_bias_revocations_total Times a writer had to revoke the reader bias.\n")
+                _T("# TYPE wpeframework_lock_bias_revocations_total counter\n");
+
+        for (const auto& lock : locks) {
+            text += _T("wpeframework_lock_bias_revocations_total{lock=\"") + string(lock.first) + _T("\"} ") + Core::NumberType<uint64_t>(lock.second.Revocations).Text() + _T("\n");
+        }
+
+        // Only available if the core is built with LOCK_PROFILING.
+        if (Core::LockProfile::IsEnabled() == true) {
+            std::vector<Core::LockProfile::Site> sites;
+            Core::LockProfile::Snapshot(sites);
+
+            const std::pair<const TCHAR*, const TCHAR*> profile[] = {
+                { _T("wpeframework_critical_section_acquisitions_total"), _T("Critical section acquisitions, per construction site.") },
+                { _T("wpeframework_critical_section_contended_total"), _T("Critical section acquisitions that had to wait, per construction site.") },
+                { _T("wpeframework_critical_section_wait_microseconds_total"), _T("Time spent waiting for critical sections, per construction site.") },
+                { _T("wpeframework_critical_section_max_hold_microseconds"), _T("Longest a critical section was held, per construction site.") }
+            };
+
+            for (uint8_t index = 0; index < (sizeof(profile) / sizeof(profile[0])); index++) {
+                text += string(_T("# HELP ")) + profile[index].first + _T(" ") + profile[index].second + _T("\n")
+                    + _T("# TYPE ") + profile[index].first + (index == 3 ? _T(" gauge\n") : _T(" counter\n"));
+
+                for (const Core::LockProfile::Site& site : sites) {
+                    const uint64_t value = (index == 0 ? site.Acquired : index == 1 ? site.Contended : index == 2 ? (site.WaitTime / 1000) : (site.MaxHoldTime / 1000));
+
+                    text += profile[index].first + string(_T("{site=\"")) + LabelValue(Core::LockProfile::Name(site.Address)) + _T("\"} ") + Core::NumberType<uint64_t>(value).Text() + _T("\n");
+                }
+            }
+        }
+    }
+
     Core::ProxyType<Web::Response> Controller::GetMethod(Core::TextSegmentIterator& index) const
     {
         Core::ProxyType<Web::Response> result(PluginHost::IFactories::Instance().Response());
@@ -266,6 +383,15 @@ namespace Plugin {
                 response->Bridges.Add(newElement);
             }
 
+            result->Body(Core::proxy_cast<Web::IBody>(response));
+        } else if (index.Current() == _T("Metrics")) {
+            // Prometheus text exposition format, so it can be scraped as is.
+            Core::ProxyType<Web::TextBody> response(jsonBodyTextFactory.Element());
+
+            LatencyMetrics(*response);
+            LockMetrics(*response);
+
+            result->ContentType = Web::MIME_TEXT;
             result->Body(Core::proxy_cast<Web::IBody>(response));
         } else if (index.Current() == _T("SubSystems")) {
             PluginHost::ISubSystem* subSystem = _service->SubSystems();
@@ -520,7 +646,9 @@ namespace Plugin {
     {
         uint32_t result = Core::ERROR_BAD_REQUEST;
         bool asyncCall = false;
-        string callsign(inbound.Callsign());
+        const string designator(inbound.Designator.Value());
+        const Core::JSONRPC::Message::Designation designation(designator);
+        const string callsign(designation.Callsign().Text());
         Core::ProxyType<Core::JSONRPC::Message> response;
 
         if (callsign.empty() || (callsign == PluginHost::JSONRPC::Callsign())) {
@@ -544,7 +672,7 @@ namespace Plugin {
                     forwarder.Id = inbound.Id;
                     forwarder.Parameters = inbound.Parameters;
                     
-                    forwarder.Designator = inbound.VersionedFullMethod();
+                    forwarder.Designator = designation.VersionedFullMethod().Text();
                     response = plugin->Invoke(channelId, forwarder);
                     asyncCall = (response.IsValid() == false);
                 }
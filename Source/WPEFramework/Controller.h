@@ -60,7 +60,7 @@ namespace Plugin {
                 {
                     if (_schedule == false) {
                         _schedule = true;
-                        Core::WorkerPool::Instance().Submit(Core::ProxyType<Core::IDispatchType<void>>(*this));
+                        Core::WorkerPool::Instance().Submit(Core::ProxyType<Core::IDispatchType<void>>(*this), Core::ThreadPool::LOW);
                     }
                 }
                 virtual void Dispatch()
@@ -260,7 +260,14 @@ namespace Plugin {
                 newElement = snapshot.Slot[teller];
                 data.ThreadPoolRuns.Add(newElement);
             }
+
+            for (uint8_t lane = 0; lane < Core::ThreadPool::Priorities; lane++) {
+                data.Lanes.Add(PluginHost::MetaData::Server::Lane(static_cast<Core::ThreadPool::priority>(lane), snapshot.Lane[lane], snapshot.Peak[lane]));
+            }
+            data.Promoted = snapshot.Promoted;
 		}
+        void LatencyMetrics(string& text) const;
+        void LockMetrics(string& text) const;
         void SubSystems();
         void SubSystems(Core::JSON::ArrayType<Core::JSON::EnumType<PluginHost::ISubSystem::subsystem>>::ConstIterator& index);
         Core::ProxyType<Web::Response> GetMethod(Core::TextSegmentIterator& index) const;
@@ -283,6 +290,7 @@ namespace Plugin {
         uint32_t get_processinfo(PluginHost::MetaData::Server& response) const;
         uint32_t get_subsystems(Core::JSON::ArrayType<JsonData::Controller::SubsystemsParamsData>& response) const;
         uint32_t get_discoveryresults(Core::JSON::ArrayType<PluginHost::MetaData::Bridge>& response) const;
+        uint32_t get_latencies(Core::JSON::ArrayType<PluginHost::MetaData::Latency>& response) const;
         uint32_t get_environment(const string& index, Core::JSON::String& response) const;
         uint32_t get_configuration(const string& index, Core::JSON::String& response) const;
         uint32_t set_configuration(const string& index, const Core::JSON::String& params);
@@ -44,6 +44,7 @@ namespace Plugin {
         Property<PluginHost::MetaData::Server>(_T("processinfo"), &Controller::get_processinfo, nullptr, this);
         Property<Core::JSON::ArrayType<SubsystemsParamsData>>(_T("subsystems"), &Controller::get_subsystems, nullptr, this);
         Property<Core::JSON::ArrayType<PluginHost::MetaData::Bridge>>(_T("discoveryresults"), &Controller::get_discoveryresults, nullptr, this);
+        Property<Core::JSON::ArrayType<PluginHost::MetaData::Latency>>(_T("latencies"), &Controller::get_latencies, nullptr, this);
         Property<Core::JSON::String>(_T("environment"), &Controller::get_environment, nullptr, this);
         Property<Core::JSON::String>(_T("configuration"), &Controller::get_configuration, &Controller::set_configuration, this);
     }
@@ -58,6 +59,7 @@ namespace Plugin {
         Unregister(_T("activate"));
         Unregister(_T("configuration"));
         Unregister(_T("environment"));
+        Unregister(_T("latencies"));
         Unregister(_T("discoveryresults"));
         Unregister(_T("subsystems"));
         Unregister(_T("processinfo"));
@@ -311,6 +313,19 @@ namespace Plugin {
         return Core::ERROR_NONE;
     }
 
+    // Property: latencies - Queue, execution and serialization latencies of the COM-RPC and JSON-RPC calls
+    // Return codes:
+    //  - ERROR_NONE: Success
+    uint32_t Controller::get_latencies(Core::JSON::ArrayType<PluginHost::MetaData::Latency>& response) const
+    {
+        Core::LatencyStatistics::Instance().Visit([&response](const Core::LatencyStatistics::Metric& metric) {
+            PluginHost::MetaData::Latency element(metric);
+            response.Add(element);
+        });
+
+        return Core::ERROR_NONE;
+    }
+
     // Property: environment - Value of an environment variable
     // Return codes:
     //  - ERROR_NONE: Success
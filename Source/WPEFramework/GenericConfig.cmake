@@ -21,6 +21,7 @@ string(TOLOWER ${NAMESPACE} NAMESPACE_LIB)
 set(PORT 80 CACHE STRING "The port for the webinterface")
 set(BINDING "0.0.0.0" CACHE STRING "The binding interface")
 set(IDLE_TIME 180 CACHE STRING "Idle time")
+set(OFFICER_CACHE 0 CACHE STRING "Seconds a validated token is trusted without revalidation, 0 is off")
 set(PERSISTENT_PATH "/root" CACHE STRING "Persistent path")
 set(DATA_PATH "${CMAKE_INSTALL_PREFIX}/share/${NAMESPACE}" CACHE STRING "Data path")
 set(SYSTEM_PATH "${CMAKE_INSTALL_PREFIX}/lib/${NAMESPACE_LIB}/plugins" CACHE STRING "System path")
@@ -46,6 +47,7 @@ map_set(${CONFIG} port ${PORT})
 map_set(${CONFIG} binding ${BINDING})
 map_set(${CONFIG} ipv6 ${IPV6_SUPPORT})
 map_set(${CONFIG} idletime ${IDLE_TIME})
+map_set(${CONFIG} officercache ${OFFICER_CACHE})
 map_set(${CONFIG} persistentpath ${PERSISTENT_PATH})
 map_set(${CONFIG} volatilepath ${VOLATILE_PATH})
 map_set(${CONFIG} datapath ${DATA_PATH})
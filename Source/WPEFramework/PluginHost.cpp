@@ -627,6 +627,10 @@ namespace PluginHost {
                         printf("------------------------------------------------------------\n");
                     }
                     printf("Pending:     %d\n", metaData.Pending);
+                    printf("  High:      %d (peak %d)\n", metaData.Lane[Core::ThreadPool::HIGH], metaData.Peak[Core::ThreadPool::HIGH]);
+                    printf("  Normal:    %d (peak %d)\n", metaData.Lane[Core::ThreadPool::NORMAL], metaData.Peak[Core::ThreadPool::NORMAL]);
+                    printf("  Low:       %d (peak %d)\n", metaData.Lane[Core::ThreadPool::LOW], metaData.Peak[Core::ThreadPool::LOW]);
+                    printf("Promoted:    %d\n", metaData.Promoted);
                     printf("Occupation:  %d\n", metaData.Occupation);
                     printf("Poolruns:\n");
                     for (uint8_t index = 0; index < metaData.Slots; index++) {
@@ -685,6 +689,12 @@ namespace PluginHost {
                     }
                     break;
                 }
+                case 'L': {
+                    printf("\nLock profile:\n");
+                    printf("============================================================\n");
+                    Core::LockProfile::Dump(stdout);
+                    break;
+                }
                 case 'Q':
                     break;
 
@@ -724,6 +734,7 @@ namespace PluginHost {
                     printf("  [S]erver stats\n");
                     printf("  [T]rigger resource monitor\n");
                     printf("  [M]etadata resource monitor\n");
+                    printf("  [L]ock profile\n");
                     printf("  [R]esource monitor stack\n");
                     printf("  [0..%d] Workerpool stacks\n", THREADPOOL_COUNT);
                     printf("  [Q]uit\n\n");
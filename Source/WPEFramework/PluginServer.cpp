@@ -40,6 +40,24 @@ ENUM_CONVERSION_BEGIN(Core::ProcessInfo::scheduler)
 
 ENUM_CONVERSION_END(Core::ProcessInfo::scheduler)
 
+ENUM_CONVERSION_BEGIN(Core::Thread::policy)
+
+    { Core::Thread::BATCH, _TXT("Batch") },
+    { Core::Thread::IDLE, _TXT("Idle") },
+    { Core::Thread::FIFO, _TXT("FIFO") },
+    { Core::Thread::ROUNDROBIN, _TXT("RoundRobin") },
+    { Core::Thread::OTHER, _TXT("Other") },
+
+ENUM_CONVERSION_END(Core::Thread::policy)
+
+ENUM_CONVERSION_BEGIN(Core::Thread::cluster)
+
+    { Core::Thread::ALL, _TXT("all") },
+    { Core::Thread::PERFORMANCE, _TXT("performance") },
+    { Core::Thread::EFFICIENCY, _TXT("efficiency") },
+
+ENUM_CONVERSION_END(Core::Thread::cluster)
+
 ENUM_CONVERSION_BEGIN(PluginHost::InputHandler::type)
 
     { PluginHost::InputHandler::DEVICE, _TXT("device") },
@@ -49,6 +67,38 @@ ENUM_CONVERSION_END(PluginHost::InputHandler::type)
 
 namespace PluginHost
 {
+#ifdef ALLOCATION_ACCOUNTING
+    static thread_local uint64_t _allocations = 0;
+    static thread_local uint64_t _allocated = 0;
+#endif
+
+    /* static */ Server::Usage Server::Usage::Now()
+    {
+        Usage result;
+
+#ifdef __WINDOWS__
+        FILETIME creation, exit, kernel, user;
+        ::GetThreadTimes(::GetCurrentThread(), &creation, &exit, &kernel, &user);
+        // Both in units of 100ns.
+        result.CpuTime = ((static_cast<uint64_t>(kernel.dwHighDateTime) << 32) | kernel.dwLowDateTime) / 10;
+        result.CpuTime += ((static_cast<uint64_t>(user.dwHighDateTime) << 32) | user.dwLowDateTime) / 10;
+#else
+        struct timespec now;
+        ::clock_gettime(CLOCK_THREAD_CPUTIME_ID, &now);
+        result.CpuTime = (static_cast<uint64_t>(now.tv_sec) * 1000000) + (now.tv_nsec / 1000);
+#endif
+
+#ifdef ALLOCATION_ACCOUNTING
+        result.Allocations = _allocations;
+        result.Allocated = _allocated;
+#else
+        result.Allocations = 0;
+        result.Allocated = 0;
+#endif
+
+        return (result);
+    }
+
     /* static */ Core::ProxyType<Web::Response> Server::Channel::_missingCallsign(Core::ProxyType<Web::Response>::Create());
     /* static */ Core::ProxyType<Web::Response> Server::Channel::_incorrectVersion(Core::ProxyType<Web::Response>::Create());
     /* static */ Core::ProxyType<Web::Response> Server::Channel::WebRequestJob::_missingResponse(Core::ProxyType<Web::Response>::Create());
@@ -140,9 +190,11 @@ namespace PluginHost
         bool CheckMessage(const Core::JSONRPC::Message& message) const
         {
             bool result = false;
+            const string designator(message.Designator.Value());
+            const Core::JSONRPC::Message::Designation designation(designator);
 
-            if (message.Callsign() == _controllerName) {
-                result = (message.Method() == _T("exists"));
+            if (designation.Callsign() == _controllerName.c_str()) {
+                result = (designation.Method() == _T("exists"));
             }
 
             return (result);
@@ -236,37 +288,61 @@ namespace PluginHost
     {
         _adminLock.Lock();
 
-        std::map<const string, Core::ProxyType<Service>>::iterator index(_services.end());
+        // The cached officers might live in the plugins that are about to be deactivated.
+        ReleaseOfficers();
+
+        // Deactivating a plugin might make it look up others, so do not hold the services lock
+        // while doing so.
+        _servicesLock.ReadLock();
+
+        std::vector<Core::ProxyType<Service>> services;
+        services.reserve(_services.size());
 
-        TRACE_L1("Deactivating %d plugins.", static_cast<uint32_t>(_services.size()));
+        for (const std::pair<const string, Core::ProxyType<Service>>& entry : _services) {
+            ASSERT(entry.second.IsValid());
+
+            services.push_back(entry.second);
+        }
+
+        _servicesLock.ReadUnlock();
+
+        TRACE_L1("Deactivating %d plugins.", static_cast<uint32_t>(services.size()));
 
         // First, move them all to deactivated except Controller
         Core::ProxyType<Service> controller;
-        do {
-            index--;
+        std::vector<Core::ProxyType<Service>>::reverse_iterator index(services.rbegin());
 
-            ASSERT(index->second.IsValid());
-
-            if (index->first.c_str() == _server._controller->Callsign()) {
-                controller = index->second;
+        while (index != services.rend()) {
+            if ((*index)->Callsign() == _server._controller->Callsign()) {
+                controller = *index;
             } else {
-                index->second->Deactivate(PluginHost::IShell::SHUTDOWN);
+                (*index)->Deactivate(PluginHost::IShell::SHUTDOWN);
             }
-        } while (index != _services.begin());
+            index++;
+        }
 
-        TRACE_L1("Destructing %d plugins.", static_cast<uint32_t>(_services.size()));
+        TRACE_L1("Destructing %d plugins.", static_cast<uint32_t>(services.size()));
         // Now deactivate controller plugin, once other plugins are deactivated
         controller->Deactivate(PluginHost::IShell::SHUTDOWN);
 
         // Now release them all
-        index = _services.begin();
+        std::map<const string, Core::ProxyType<Service>> released;
+
+        _servicesLock.WriteLock();
+        released.swap(_services);
+        _servicesLock.WriteUnlock();
 
-        while (index != _services.end()) {
-            Core::ProxyType<Service> service(index->second);
+        services.clear();
+        controller.Release();
+
+        std::map<const string, Core::ProxyType<Service>>::iterator entry(released.begin());
+
+        while (entry != released.end()) {
+            Core::ProxyType<Service> service(entry->second);
 
             ASSERT(service.IsValid());
 
-            index = _services.erase(index);
+            entry = released.erase(entry);
 
             service.Release();
         }
@@ -625,6 +701,7 @@ namespace PluginHost
     Server::Server(Server::Config & configuration, const bool background)
         : _accessor()
         , _dispatcher(configuration.Process.IsSet() ? configuration.Process.StackSize.Value() : 0)
+        , _scheduler(_dispatcher, THREADPOOL_COUNT)
         , _connections(*this, DetermineAccessor(configuration, _accessor), configuration.IdleTime)
         , _config(configuration.Version.Value(),
               DetermineProperModel(configuration.Model),
@@ -640,7 +717,7 @@ namespace PluginHost
               _accessor,
               Core::NodeId(configuration.Communicator.Value().c_str()),
               configuration.Redirect.Value())
-        , _services(*this, _config, configuration.Process.IsSet() ? configuration.Process.StackSize.Value() : 0)
+        , _services(*this, _config, configuration.Process.IsSet() ? configuration.Process.StackSize.Value() : 0, configuration.OfficerCache.Value())
         , _controller()
         , _factoriesImplementation()
     {
@@ -660,6 +737,34 @@ namespace PluginHost
         // Lets assign a workerpool, we created it...
         Core::WorkerPool::Assign(&_dispatcher);
 
+        const Config::ThreadSet& pool(configuration.Threads.WorkerPool);
+        const Config::ThreadSet& monitor(configuration.Threads.ResourceMonitor);
+
+        if ((pool.Policy.IsSet() == true) || (pool.Priority.IsSet() == true)) {
+            _dispatcher.Policy(pool.Policy.Value(), pool.Priority.Value());
+        }
+        if (pool.IsRestricted() == true) {
+            const uint64_t cores(pool.Cores());
+
+            if (cores == 0) {
+                SYSLOG(Logging::Startup, (_T("No cores left for the workerpool threads, affinity not changed.")));
+            } else {
+                _dispatcher.Affinity(cores);
+            }
+        }
+        if ((monitor.Policy.IsSet() == true) || (monitor.Priority.IsSet() == true)) {
+            Core::ResourceMonitor::Instance().Policy(monitor.Policy.Value(), monitor.Priority.Value());
+        }
+        if (monitor.IsRestricted() == true) {
+            const uint64_t cores(monitor.Cores());
+
+            if (cores == 0) {
+                SYSLOG(Logging::Startup, (_T("No cores left for the resource monitor thread, affinity not changed.")));
+            } else {
+                Core::ResourceMonitor::Instance().Affinity(cores);
+            }
+        }
+
         Core::JSON::ArrayType<Plugin::Config>::Iterator index = configuration.Plugins.Elements();
 
         // First register all services, than if we got them, start "activating what is required.
@@ -797,6 +902,7 @@ namespace PluginHost
     {
         Plugin::Controller* destructor(_controller->ClassType<Plugin::Controller>());
         _connections.Close(Core::infinite);
+        _scheduler.Flush();
         destructor->Stopped();
         _services.Destroy();
         _dispatcher.Stop();
@@ -805,3 +911,33 @@ namespace PluginHost
     }
 }
 }
+
+#ifdef ALLOCATION_ACCOUNTING
+// Count what the thread allocates, so the Scheduler can attribute it to the plugin whose request
+// it is running. Only the counting is added, the memory still comes from malloc.
+void* operator new(std::size_t size)
+{
+    void* result = ::malloc(size == 0 ? 1 : size);
+
+    if (result == nullptr) {
+        throw std::bad_alloc();
+    }
+
+    WPEFramework::PluginHost::_allocations++;
+    WPEFramework::PluginHost::_allocated += size;
+
+    return (result);
+}
+void* operator new[](std::size_t size)
+{
+    return (::operator new(size));
+}
+void operator delete(void* ptr) noexcept
+{
+    ::free(ptr);
+}
+void operator delete[](void* ptr) noexcept
+{
+    ::free(ptr);
+}
+#endif
@@ -23,6 +23,7 @@
 #include "Environment.h"
 #include "IRemoteInstantiation.h"
 #include "Module.h"
+#include "Scheduler.h"
 #include "SystemInfo.h"
 
 #ifdef PROCESSCONTAINERS_ENABLED
@@ -169,6 +170,117 @@ namespace PluginHost {
                 Core::JSON::DecUInt16 Umask;
             };
 
+            // Scheduling and placement of a group of framework threads.
+            class ThreadSet : public Core::JSON::Container {
+            public:
+                ThreadSet()
+                    : Core::JSON::Container()
+                    , Policy(Core::Thread::OTHER)
+                    , Priority(0)
+                    , Affinity()
+                    , Cluster(Core::Thread::ALL)
+                    , Node(0)
+                {
+                    Add(_T("policy"), &Policy);
+                    Add(_T("priority"), &Priority);
+                    Add(_T("affinity"), &Affinity);
+                    Add(_T("cluster"), &Cluster);
+                    Add(_T("node"), &Node);
+                }
+                ThreadSet(const ThreadSet& copy)
+                    : Core::JSON::Container()
+                    , Policy(copy.Policy)
+                    , Priority(copy.Priority)
+                    , Affinity(copy.Affinity)
+                    , Cluster(copy.Cluster)
+                    , Node(copy.Node)
+                {
+                    Add(_T("policy"), &Policy);
+                    Add(_T("priority"), &Priority);
+                    Add(_T("affinity"), &Affinity);
+                    Add(_T("cluster"), &Cluster);
+                    Add(_T("node"), &Node);
+                }
+                ~ThreadSet()
+                {
+                }
+
+                ThreadSet& operator=(const ThreadSet& RHS)
+                {
+                    Policy = RHS.Policy;
+                    Priority = RHS.Priority;
+                    Affinity = RHS.Affinity;
+                    Cluster = RHS.Cluster;
+                    Node = RHS.Node;
+
+                    return (*this);
+                }
+
+            public:
+                // The cores allowed by the affinity list, the cluster and the NUMA node together, 0 if
+                // nothing restricts them.
+                uint64_t Cores() const
+                {
+                    uint64_t result = ~0ULL;
+
+                    if (Affinity.IsSet() == true) {
+                        result &= Core::Thread::Cores(Affinity.Value());
+                    }
+                    if (Cluster.IsSet() == true) {
+                        result &= Core::Thread::Cores(Cluster.Value());
+                    }
+                    if (Node.IsSet() == true) {
+                        result &= Core::Thread::Node(Node.Value());
+                    }
+
+                    return (result == ~0ULL ? 0 : result);
+                }
+                bool IsRestricted() const
+                {
+                    return ((Affinity.IsSet() == true) || (Cluster.IsSet() == true) || (Node.IsSet() == true));
+                }
+
+                Core::JSON::EnumType<Core::Thread::policy> Policy;
+                Core::JSON::DecSInt8 Priority;
+                Core::JSON::String Affinity;
+                Core::JSON::EnumType<Core::Thread::cluster> Cluster;
+                Core::JSON::DecUInt8 Node;
+            };
+
+            class ThreadsConfig : public Core::JSON::Container {
+            public:
+                ThreadsConfig()
+                    : Core::JSON::Container()
+                    , WorkerPool()
+                    , ResourceMonitor()
+                {
+                    Add(_T("workerpool"), &WorkerPool);
+                    Add(_T("resourcemonitor"), &ResourceMonitor);
+                }
+                ThreadsConfig(const ThreadsConfig& copy)
+                    : Core::JSON::Container()
+                    , WorkerPool(copy.WorkerPool)
+                    , ResourceMonitor(copy.ResourceMonitor)
+                {
+                    Add(_T("workerpool"), &WorkerPool);
+                    Add(_T("resourcemonitor"), &ResourceMonitor);
+                }
+                ~ThreadsConfig()
+                {
+                }
+
+                ThreadsConfig& operator=(const ThreadsConfig& RHS)
+                {
+                    WorkerPool = RHS.WorkerPool;
+                    ResourceMonitor = RHS.ResourceMonitor;
+
+                    return (*this);
+                }
+
+                ThreadSet WorkerPool;
+                ThreadSet ResourceMonitor;
+            };
+
             class InputConfig : public Core::JSON::Container {
             public:
                 InputConfig()
@@ -260,9 +372,11 @@ namespace PluginHost {
                 , Redirect(_T("http://127.0.0.1/Service/Controller/UI"))
                 , Signature(_T("TestSecretKey"))
                 , IdleTime(0)
+                , OfficerCache(0)
                 , IPV6(false)
                 , DefaultTraceCategories(false)
                 , Process()
+                , Threads()
                 , Input()
                 , Configs()
                 , Environments()
@@ -285,10 +399,12 @@ namespace PluginHost {
                 Add(_T("communicator"), &Communicator);
                 Add(_T("signature"), &Signature);
                 Add(_T("idletime"), &IdleTime);
+                Add(_T("officercache"), &OfficerCache);
                 Add(_T("ipv6"), &IPV6);
                 Add(_T("tracing"), &DefaultTraceCategories);
                 Add(_T("redirect"), &Redirect);
                 Add(_T("process"), &Process);
+                Add(_T("threads"), &Threads);
                 Add(_T("input"), &Input);
                 Add(_T("plugins"), &Plugins);
                 Add(_T("configs"), &Configs);
@@ -318,9 +434,12 @@ namespace PluginHost {
             Core::JSON::String Redirect;
             Core::JSON::String Signature;
             Core::JSON::DecUInt16 IdleTime;
+            // Seconds a validated token is accepted without asking the security officer again, 0 disables it.
+            Core::JSON::DecUInt16 OfficerCache;
             Core::JSON::Boolean IPV6;
             Core::JSON::String DefaultTraceCategories;
             ProcessSet Process;
+            ThreadsConfig Threads;
             InputConfig Input;
             Core::JSON::String Configs;
             Core::JSON::ArrayType<Plugin::Config> Plugins;
@@ -557,6 +676,37 @@ namespace PluginHost {
             std::string _text;
         };
 
+        // What the requests of a plugin cost us, and how many of them are in flight.
+        struct Resources {
+            Resources()
+                : CpuTime(0)
+                , Jobs(0)
+                , Allocations(0)
+                , Allocated(0)
+                , Running(0)
+                , Pending(0)
+            {
+            }
+
+            uint64_t CpuTime; // microseconds
+            uint32_t Jobs;
+            uint64_t Allocations;
+            uint64_t Allocated; // bytes
+            uint32_t Running;
+            uint32_t Pending;
+        };
+
+        // Cpu time and heap allocations of the calling thread so far, the difference between two
+        // snapshots taken around a job is what that job cost. Allocations are only counted if the
+        // framework is built with ALLOCATION_ACCOUNTING (it then replaces the global operator new).
+        struct Usage {
+            uint64_t CpuTime; // microseconds
+            uint64_t Allocations;
+            uint64_t Allocated; // bytes
+
+            static Usage Now();
+        };
+
         class EXTERNAL Service : public PluginHost::Service {
         private:
             Service() = delete;
@@ -647,6 +797,7 @@ namespace PluginHost {
                 , _precondition(plugin->Precondition, true)
                 , _termination(plugin->Termination, false)
                 , _activity(0)
+                , _resources()
                 , _administrator(*administrator)
             {
                 ASSERT(server != nullptr);
@@ -953,8 +1104,20 @@ namespace PluginHost {
                 if (_versionHash.empty() == false)
                     metaData.Hash = _versionHash;
 
+                metaData.Resources.CpuTime = _resources.CpuTime;
+                metaData.Resources.Jobs = _resources.Jobs;
+                metaData.Resources.Allocations = _resources.Allocations;
+                metaData.Resources.Allocated = _resources.Allocated;
+                metaData.Resources.Running = _resources.Running;
+                metaData.Resources.Pending = _resources.Pending;
+
                 PluginHost::Service::GetMetaData(metaData);
             }
+            // Owned by the Scheduler, only to be changed with the scheduler lock taken.
+            inline Resources& Budget()
+            {
+                return (_resources);
+            }
             inline void Evaluate()
             {
                 Lock();
@@ -1156,6 +1319,7 @@ namespace PluginHost {
             Condition _precondition;
             Condition _termination;
             uint32_t _activity;
+            Resources _resources;
 
             ServiceMap& _administrator;
             static Core::ProxyType<Web::Response> _unavailableHandler;
@@ -1630,7 +1794,7 @@ namespace PluginHost {
                         {
                             if (_schedule == false) {
                                 _schedule = true;
-                                _parent.WorkerPool().Submit(Core::ProxyType<Core::IDispatchType<void>>(*this));
+                                _parent.WorkerPool().Submit(Core::ProxyType<Core::IDispatchType<void>>(*this), Core::ThreadPool::LOW);
                             }
                         }
                         virtual void Dispatch()
@@ -1686,10 +1850,11 @@ namespace PluginHost {
 #ifdef __WINDOWS__
 #pragma warning(disable : 4355)
 #endif
-                ServiceMap(Server& server, PluginHost::Config& config, const uint32_t stackSize)
+                ServiceMap(Server& server, PluginHost::Config& config, const uint32_t stackSize, const uint16_t officerLifetime)
                     : _webbridgeConfig(config)
                     , _adminLock()
                     , _notificationLock()
+                    , _servicesLock(Core::ReadWriteLock::WRITER, true)
                     , _services()
                     , _notifiers()
                     , _engine(Core::ProxyType<RPC::InvokeServer>::Create(&(server._dispatcher)))
@@ -1697,6 +1862,8 @@ namespace PluginHost {
                     , _server(server)
                     , _subSystems(this)
                     , _authenticationHandler(nullptr)
+                    , _officerLifetime(static_cast<uint64_t>(officerLifetime) * 1000 * Core::Time::TicksPerMillisecond)
+                    , _officers()
                 {
                 }
 #ifdef __WINDOWS__
@@ -1714,6 +1881,9 @@ namespace PluginHost {
                     _adminLock.Lock();
 
                     if ((_authenticationHandler == nullptr) ^ (enabled == false)) {
+                        // Officers handed out under the previous regime are no longer valid.
+                        ReleaseOfficers();
+
                         if (_authenticationHandler == nullptr) {
                             // Let get the AuthentcationHandler.
                             _authenticationHandler = reinterpret_cast<IAuthenticate*>(QueryInterfaceByCallsign(IAuthenticate::ID, _subSystems.SecurityCallsign()));
@@ -1731,8 +1901,39 @@ namespace PluginHost {
 
                     _adminLock.Lock();
 
-                    if (_authenticationHandler != nullptr) {
+                    if ((_authenticationHandler != nullptr) && (_officerLifetime == 0)) {
                         result = _authenticationHandler->Officer(token);
+                    } else if (_authenticationHandler != nullptr) {
+                        const uint64_t now = Core::Time::Now().Ticks();
+                        std::list<CachedOfficer>::iterator index(_officers.begin());
+
+                        while ((index != _officers.end()) && (index->Token != token)) {
+                            index++;
+                        }
+
+                        if ((index != _officers.end()) && (index->Expiry > now)) {
+                            // Seen this token recently, no need to have it validated again.
+                            result = index->Officer;
+                            result->AddRef();
+                            _officers.splice(_officers.begin(), _officers, index);
+                        } else {
+                            if (index != _officers.end()) {
+                                index->Officer->Release();
+                                _officers.erase(index);
+                            }
+
+                            result = _authenticationHandler->Officer(token);
+
+                            if (result != nullptr) {
+                                if (_officers.size() >= MaxCachedOfficers) {
+                                    _officers.back().Officer->Release();
+                                    _officers.pop_back();
+                                }
+
+                                result->AddRef();
+                                _officers.push_front({ token, result, now + _officerLifetime });
+                            }
+                        }
                     } else {
                         result = _webbridgeConfig.Security();
                     }
@@ -1748,6 +1949,14 @@ namespace PluginHost {
                 {
                     return (_subSystems.Value());
                 }
+                inline Core::ReadWriteLock::Contention LockStatistics() const
+                {
+                    return (_servicesLock.Statistics());
+                }
+                inline Core::ReadWriteLock::Contention SubSystemLockStatistics() const
+                {
+                    return (_subSystems.LockStatistics());
+                }
                 inline ISubSystem* SubSystemsInterface()
                 {
                     return (reinterpret_cast<ISubSystem*>(_subSystems.QueryInterface(ISubSystem::ID)));
@@ -1856,29 +2065,35 @@ namespace PluginHost {
                     Core::ProxyType<Service> newService(Core::ProxyType<Service>::Create(&_webbridgeConfig, &configuration, this));
 
                     if (newService.IsValid() == true) {
-                        _adminLock.Lock();
+                        _servicesLock.WriteLock();
 
                         // Fire up the interface. Let it handle the messages.
                         _services.insert(std::pair<const string, Core::ProxyType<Service>>(configuration.Callsign.Value(), newService));
 
-                        _adminLock.Unlock();
+                        _servicesLock.WriteUnlock();
                     }
 
                     return (newService);
                 }
                 inline void Destroy(const string& callSign)
                 {
-                    _adminLock.Lock();
+                    Core::ProxyType<Service> service;
+
+                    _servicesLock.WriteLock();
 
-                    // First stop all services running ...
                     std::map<const string, Core::ProxyType<Service>>::iterator index(_services.find(callSign));
 
                     if (index != _services.end()) {
-                        index->second->Destroy();
+                        service = index->second;
                         _services.erase(index);
                     }
 
-                    _adminLock.Unlock();
+                    _servicesLock.WriteUnlock();
+
+                    // Destroying runs the notifiers, that might look up services, so not under the lock.
+                    if (service.IsValid() == true) {
+                        service->Destroy();
+                    }
                 }
                 inline Iterator Services()
                 {
@@ -1900,7 +2115,7 @@ namespace PluginHost {
 #endif
                 void GetMetaData(Core::JSON::ArrayType<MetaData::Service>& metaData) const
                 {
-                    _adminLock.Lock();
+                    _servicesLock.ReadLock();
 
                     std::list<Core::ProxyType<Service>> duplicates;
                     std::map<const string, Core::ProxyType<Service>>::const_iterator index(_services.begin());
@@ -1910,7 +2125,7 @@ namespace PluginHost {
                         index++;
                     }
 
-                    _adminLock.Unlock();
+                    _servicesLock.ReadUnlock();
 
                     while (duplicates.size() > 0) {
                         MetaData::Service newInfo;
@@ -1923,7 +2138,7 @@ namespace PluginHost {
                 {
                     uint32_t result = Core::ERROR_UNAVAILABLE;
 
-                    _adminLock.Lock();
+                    _servicesLock.ReadLock();
 
                     for (auto index : _services) {
                         const string& source(index.first);
@@ -1950,7 +2165,7 @@ namespace PluginHost {
                         }
                     }
 
-                    _adminLock.Unlock();
+                    _servicesLock.ReadUnlock();
 
                     return (result);
                 }
@@ -2016,12 +2231,12 @@ namespace PluginHost {
                         RecursiveNotification(index);
                         element->Evaluate();
                     } else {
-                        _adminLock.Unlock();
+                        _servicesLock.ReadUnlock();
                     }
                 }
                 void Evaluate()
                 {
-                    _adminLock.Lock();
+                    _servicesLock.ReadLock();
 
                     // First stop all services running ...
                     std::map<const string, Core::ProxyType<Service>>::iterator index(_services.begin());
@@ -2033,11 +2248,34 @@ namespace PluginHost {
                     return (_server.WorkerPool());
                 }
 
+                // Should be called with the _adminLock taken.
+                void ReleaseOfficers()
+                {
+                    for (CachedOfficer& entry : _officers) {
+                        entry.Officer->Release();
+                    }
+                    _officers.clear();
+                }
+
             private:
+                // If configured (officercache), the officer the authentication handler returns for
+                // a token is kept for a while, clients issuing many calls with the same token only
+                // pay the validation cost once per lifetime. A token revoked in the meantime is
+                // still accepted until its entry expires.
+                struct CachedOfficer {
+                    string Token;
+                    ISecurity* Officer;
+                    uint64_t Expiry;
+                };
+
+                static constexpr uint8_t MaxCachedOfficers = 32;
+
                 PluginHost::Config& _webbridgeConfig;
 
                 mutable Core::CriticalSection _adminLock;
                 Core::CriticalSection _notificationLock;
+                // Looked up for every request, changed only when plugins are added or removed.
+                mutable Core::ReadWriteLock _servicesLock;
                 std::map<const string, Core::ProxyType<Service>> _services;
                 mutable RemoteInstantiators _instantiators;
                 std::list<IPlugin::INotification*> _notifiers;
@@ -2046,8 +2284,12 @@ namespace PluginHost {
                 Server& _server;
                 Core::Sink<SubSystems> _subSystems;
                 IAuthenticate* _authenticationHandler;
+                const uint64_t _officerLifetime;
+                std::list<CachedOfficer> _officers;
             };
 
+            typedef SchedulerType<Service, Resources, Usage, Plugin::Config::BACKGROUND + 1> Scheduler;
+
             // Connection handler is the listening socket and keeps track of all open
             // Links. A Channel is identified by an ID, this way, whenever a link dies
             // (is closed) during the service process, the ChannelMap will
@@ -2186,6 +2428,7 @@ namespace PluginHost {
                         , _service()
                         , _element()
                         , _jsonrpc(false)
+                        , _submitted(0)
                     {
                     }
                     virtual ~JSONElementJob()
@@ -2211,6 +2454,7 @@ namespace PluginHost {
                         _element = element;
                         _ID = id;
                         _jsonrpc = JSONRPC;
+                        _submitted = Core::Time::Now().Ticks();
                     }
                     virtual void Dispatch()
                     {
@@ -2230,7 +2474,22 @@ namespace PluginHost {
                                     ASSERT(message.IsValid() == true);
 
                                     if ((dispatcher != nullptr) && (message.IsValid() == true)) {
-                                        _element = Core::ProxyType<Core::JSON::IElement>(dispatcher->Invoke(_ID, *message));
+                                        const uint64_t started(Core::Time::Now().Ticks());
+                                        Core::ProxyType<Core::JSONRPC::Message> response(dispatcher->Invoke(_ID, *message));
+                                        const uint64_t finished(Core::Time::Now().Ticks());
+
+                                        // The statistics table is fixed in size and never shrinks, so only the methods the
+                                        // plugin knows are tracked, by callsign and method (no version, no index).
+                                        if (Rejected(response) == false) {
+                                            Core::LatencyStatistics::Metric* metric(Core::LatencyStatistics::Instance().Find(_T("JSON-RPC"), _service->Callsign() + '.' + message->Method()));
+
+                                            if (metric != nullptr) {
+                                                metric->Queue.Record(_submitted, started);
+                                                metric->Execution.Record(started, finished);
+                                            }
+                                        }
+
+                                        _element = Core::ProxyType<Core::JSON::IElement>(response);
                                     }
                                 } else {
                                     _element = _service->Inbound(_ID, *_element);
@@ -2247,12 +2506,20 @@ namespace PluginHost {
                         }
                     }
 
+                private:
+                    // Invalid designators, unknown methods and unsupported versions never reached a method.
+                    static bool Rejected(const Core::ProxyType<Core::JSONRPC::Message>& response)
+                    {
+                        return ((response.IsValid() == true) && (response->Error.IsSet() == true) && ((response->Error.Code.Value() == -32600) || (response->Error.Code.Value() == -32601) || (response->Error.Code.Value() == -32602)));
+                    }
+
                 private:
                     uint32_t _ID;
                     Server* _server;
                     Core::ProxyType<Service> _service;
                     Core::ProxyType<Core::JSON::IElement> _element;
                     bool _jsonrpc;
+                    uint64_t _submitted;
                 };
 
                 class EXTERNAL TextJob : public Core::IDispatchType<void> {
@@ -2512,7 +2779,7 @@ namespace PluginHost {
                             if (job.IsValid() == true) {
                                 Core::ProxyType<Web::Request> baseRequest(Core::proxy_cast<Web::Request>(request));
                                 job->Set(Id(), service, baseRequest, !request->ServiceCall());
-                                _parent.Submit(Core::proxy_cast<Core::IDispatchType<void>>(job));
+                                _parent.Submit(service, Core::proxy_cast<Core::IDispatch>(job));
                             }
                         }
                         break;
@@ -2580,7 +2847,7 @@ namespace PluginHost {
 
                         if ((_service.IsValid() == true) && (job.IsValid() == true)) {
                             job->Set(Id(), _service, element, ((State() & Channel::JSONRPC) == Channel::JSONRPC));
-                            _parent.Submit(Core::proxy_cast<Core::IDispatch>(job));
+                            _parent.Submit(_service, Core::proxy_cast<Core::IDispatch>(job));
                         }
                     }
                 }
@@ -2598,7 +2865,7 @@ namespace PluginHost {
 
                     if ((_service.IsValid() == true) && (job.IsValid() == true)) {
                         job->Set(Id(), _service, value);
-                        _parent.Submit(Core::proxy_cast<Core::IDispatch>(job));
+                        _parent.Submit(_service, Core::proxy_cast<Core::IDispatch>(job));
                     }
                 }
 
@@ -2665,6 +2932,8 @@ namespace PluginHost {
                                 State(TEXT, false);
                             } else if (Protocol() == _T("jsonrpc")) {
                                 State(JSONRPC, false);
+                            } else if (Protocol() == _T("jsonrpc-msgpack")) {
+                                State(JSONRPC, false, true);
                             } else {
                                 // Channel is a raw communication channel.
                                 // This channel allows for passing binary data back and forth
@@ -2685,7 +2954,8 @@ namespace PluginHost {
                             if (Name().length() > (JSONRPCHeader.length() + 1)) {
                                 Properties(static_cast<uint32_t>(JSONRPCHeader.length()) + 1);
                             }
-                            State(JSONRPC, false);
+                            // The JSONRPC messages travel as text, unless the client asked for MessagePack.
+                            State(JSONRPC, false, (Protocol() == _T("jsonrpc-msgpack")));
 
                             // The state needs to be correct before we c
                             if (_service->Subscribe(*this) == false) {
@@ -2883,6 +3153,11 @@ namespace PluginHost {
             {
                 _dispatcher.Submit(job);
             }
+            // Requests on behalf of a plugin, these are accounted to it and subject to its budget.
+            inline void Submit(const Core::ProxyType<Service>& service, const Core::ProxyType<Core::IDispatch>& job)
+            {
+                _scheduler.Submit(service, job);
+            }
             inline void Schedule(const uint64_t time, const Core::ProxyType<Core::IDispatchType<void>>& job)
             {
                 _dispatcher.Schedule(time, job);
@@ -2930,6 +3205,9 @@ namespace PluginHost {
             // that can handle the request.
             WorkerPoolImplementation _dispatcher;
 
+            // Decides in which order the requests for the plugins are handed to the dispatcher.
+            Scheduler _scheduler;
+
             // Create the server. This is a socket listening for incoming connections. Any connection comming in, will be
             // linked to this server and will forward the received requests to this server. This server will than handl it using a thread pool.
             ChannelMap _connections;
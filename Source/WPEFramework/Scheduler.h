@@ -0,0 +1,258 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2020 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef __WEBBRIDGESCHEDULER_H
+#define __WEBBRIDGESCHEDULER_H
+
+#include "Module.h"
+
+namespace WPEFramework {
+namespace PluginHost {
+
+    // All requests for plugins (web requests, JSON and text messages) pass through here, before
+    // they are handed to the worker pool. Only as many requests as there are worker threads are
+    // handed out at a time, so the order in which they are picked up is decided here: interactive
+    // plugins go before normal ones, normal ones before background ones, and a plugin never has
+    // more requests running than its configured concurrency. To keep the lower classes from
+    // starving, every so many picks from a higher class, the oldest lower class request goes first.
+    //
+    // A SERVICE tells its Priority() (class 0 is the most urgent one), its Concurrency() (0 is no
+    // limit) and hands out the RESOURCES it is accounted on with Budget(). USAGE::Now() is what the
+    // calling thread used so far, the difference around a job is added to the budget.
+    template <typename SERVICE, typename RESOURCES, typename USAGE, const uint8_t CLASSES>
+    class SchedulerType {
+    private:
+        SchedulerType() = delete;
+        SchedulerType(const SchedulerType<SERVICE, RESOURCES, USAGE, CLASSES>&) = delete;
+        SchedulerType<SERVICE, RESOURCES, USAGE, CLASSES>& operator=(const SchedulerType<SERVICE, RESOURCES, USAGE, CLASSES>&) = delete;
+
+        static constexpr uint8_t MaxStreak = 8;
+
+        struct Entry {
+            Entry(const Core::ProxyType<SERVICE>& service, const Core::ProxyType<Core::IDispatch>& job, const uint8_t lane)
+                : Service(service)
+                , Job(job)
+                , Lane(lane)
+            {
+            }
+
+            Core::ProxyType<SERVICE> Service;
+            Core::ProxyType<Core::IDispatch> Job;
+            uint8_t Lane;
+        };
+
+        class Job : public Core::IDispatch {
+        public:
+            Job() = delete;
+            Job(const Job&) = delete;
+            Job& operator=(const Job&) = delete;
+
+            Job(SchedulerType<SERVICE, RESOURCES, USAGE, CLASSES>* parent)
+                : _parent(*parent)
+                , _service()
+                , _job()
+            {
+                ASSERT(parent != nullptr);
+            }
+            ~Job() override
+            {
+                ASSERT(_service.IsValid() == false);
+                ASSERT(_job.IsValid() == false);
+            }
+
+        public:
+            void Set(const Core::ProxyType<SERVICE>& service, const Core::ProxyType<Core::IDispatch>& job)
+            {
+                _service = service;
+                _job = job;
+            }
+            void Dispatch() override
+            {
+                const USAGE start(USAGE::Now());
+
+                _job->Dispatch();
+                _job.Release();
+
+                Core::ProxyType<SERVICE> service(_service);
+                _service.Release();
+
+                _parent.Completed(*service, start, USAGE::Now());
+            }
+
+        private:
+            SchedulerType<SERVICE, RESOURCES, USAGE, CLASSES>& _parent;
+            Core::ProxyType<SERVICE> _service;
+            Core::ProxyType<Core::IDispatch> _job;
+        };
+
+    public:
+        SchedulerType(Core::IWorkerPool& pool, const uint8_t slots)
+            : _adminLock()
+            , _pool(pool)
+            , _slots(slots)
+            , _inFlight(0)
+            , _streak(0)
+            , _factory(slots)
+        {
+        }
+        ~SchedulerType()
+        {
+            ASSERT(_inFlight == 0);
+        }
+
+    public:
+        void Submit(const Core::ProxyType<SERVICE>& service, const Core::ProxyType<Core::IDispatch>& job)
+        {
+            std::list<Entry> ready;
+            const uint8_t lane(std::min(static_cast<uint8_t>(service->Priority()), static_cast<uint8_t>(CLASSES - 1)));
+
+            _adminLock.Lock();
+
+            _queues[lane].emplace_back(service, job, lane);
+            service->Budget().Pending++;
+
+            Schedule(ready);
+
+            _adminLock.Unlock();
+
+            Dispatch(ready);
+        }
+        // Hand out whatever is still waiting, limits or not, used when shutting down.
+        void Flush()
+        {
+            std::list<Entry> ready;
+
+            _adminLock.Lock();
+
+            for (uint8_t lane = 0; lane < CLASSES; lane++) {
+                for (Entry& entry : _queues[lane]) {
+                    entry.Service->Budget().Pending--;
+                    entry.Service->Budget().Running++;
+                    _inFlight++;
+                }
+                ready.splice(ready.end(), _queues[lane]);
+            }
+
+            _adminLock.Unlock();
+
+            Dispatch(ready);
+        }
+
+    private:
+        void Completed(SERVICE& service, const USAGE& start, const USAGE& end)
+        {
+            std::list<Entry> ready;
+
+            _adminLock.Lock();
+
+            RESOURCES& budget(service.Budget());
+
+            ASSERT(budget.Running > 0);
+            ASSERT(_inFlight > 0);
+
+            budget.Running--;
+            budget.Jobs++;
+            budget.CpuTime += (end.CpuTime - start.CpuTime);
+            budget.Allocations += (end.Allocations - start.Allocations);
+            budget.Allocated += (end.Allocated - start.Allocated);
+            _inFlight--;
+
+            Schedule(ready);
+
+            _adminLock.Unlock();
+
+            Dispatch(ready);
+        }
+        // Must be called with the lock taken, moves the requests that may run now to ready.
+        void Schedule(std::list<Entry>& ready)
+        {
+            bool found = true;
+
+            while ((_inFlight < _slots) && (found == true)) {
+                found = false;
+
+                // Normally the highest class goes first, after MaxStreak picks that skipped over a
+                // waiting lower class, the lowest waiting class gets its turn.
+                const bool aged(_streak >= MaxStreak);
+                uint8_t lowest = CLASSES;
+
+                for (uint8_t index = 0; (index < CLASSES) && (found == false); index++) {
+                    const uint8_t lane(aged == true ? (CLASSES - 1 - index) : index);
+                    std::list<Entry>& queue(_queues[lane]);
+                    typename std::list<Entry>::iterator entry(queue.begin());
+
+                    while ((entry != queue.end()) && (Admissible(*(entry->Service)) == false)) {
+                        entry++;
+                    }
+
+                    if (entry != queue.end()) {
+                        RESOURCES& budget(entry->Service->Budget());
+
+                        budget.Pending--;
+                        budget.Running++;
+                        _inFlight++;
+
+                        ready.splice(ready.end(), queue, entry);
+                        found = true;
+
+                        for (uint8_t below = lane + 1; below < CLASSES; below++) {
+                            if (_queues[below].empty() == false) {
+                                lowest = below;
+                            }
+                        }
+                        _streak = ((aged == false) && (lowest != CLASSES) ? _streak + 1 : 0);
+                    }
+                }
+            }
+        }
+        void Dispatch(std::list<Entry>& ready)
+        {
+            // Outside the lock, submitting might have to wait for room in the worker pool queue.
+            for (Entry& entry : ready) {
+                Core::ProxyType<Job> job(_factory.Element(this));
+
+                job->Set(entry.Service, entry.Job);
+                _pool.Submit(Core::ProxyType<Core::IDispatch>(job), Lane(entry.Lane));
+            }
+        }
+        static Core::IWorkerPool::priority Lane(const uint8_t lane)
+        {
+            return (lane == 0 ? Core::ThreadPool::HIGH : (lane == (CLASSES - 1) ? Core::ThreadPool::LOW : Core::ThreadPool::NORMAL));
+        }
+        inline bool Admissible(SERVICE& service)
+        {
+            const uint8_t limit(service.Concurrency());
+
+            return ((limit == 0) || (service.Budget().Running < limit));
+        }
+
+    private:
+        Core::CriticalSection _adminLock;
+        Core::IWorkerPool& _pool;
+        const uint8_t _slots;
+        uint32_t _inFlight;
+        uint8_t _streak;
+        std::list<Entry> _queues[CLASSES];
+        Core::ProxyPoolType<Job> _factory;
+    };
+
+} // namespace PluginHost
+} // namespace WPEFramework
+
+#endif // __WEBBRIDGESCHEDULER_H
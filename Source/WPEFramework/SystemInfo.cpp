@@ -26,6 +26,7 @@ namespace PluginHost {
 #endif
     SystemInfo::SystemInfo(Core::IDispatch* callback)
         : _adminLock()
+        , _infoLock(Core::ReadWriteLock::WRITER, true)
         , _notificationClients()
         , _callback(callback)
         , _identifier(nullptr)
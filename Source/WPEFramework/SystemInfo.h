@@ -256,13 +256,13 @@ namespace PluginHost {
         {
             string result;
 
-            _adminLock.Lock();
+            _infoLock.ReadLock();
 
             if (_security != nullptr) {
                 result = _security->Callsign();
             }
 
-            _adminLock.Unlock();
+            _infoLock.ReadUnlock();
 
             return (result);
         }
@@ -299,7 +299,7 @@ namespace PluginHost {
 
                 if (info == nullptr) {
 
-                    _adminLock.Lock();
+                    _infoLock.WriteLock();
 
                     if (_identifier != nullptr) {
                         _identifier->Release();
@@ -309,21 +309,21 @@ namespace PluginHost {
                     const uint8_t* id(Core::SystemInfo::Instance().RawDeviceId());
                     _identifier->Set(id[0], &id[1]);
 
-                    _adminLock.Unlock();
+                    _infoLock.WriteUnlock();
                 } else {
                     Id* id = Core::Service<Id>::Create<Id>();
                     sendUpdate = id->Set(info) || sendUpdate;
 
                     info->Release();
 
-                    _adminLock.Lock();
+                    _infoLock.WriteLock();
 
                     if (_identifier != nullptr) {
                         _identifier->Release();
                     }
 
                     _identifier = id;
-                    _adminLock.Unlock();
+                    _infoLock.WriteUnlock();
                 }
 
                 SYSLOG(Logging::Startup, (_T("EVENT: Identifier: %s"), _identifier->Identifier().c_str()));
@@ -339,7 +339,7 @@ namespace PluginHost {
 
                 if (info == nullptr) {
 
-                    _adminLock.Lock();
+                    _infoLock.WriteLock();
 
                     if (_internet != nullptr) {
                         _internet->Release();
@@ -347,7 +347,7 @@ namespace PluginHost {
 
                     _internet = Core::Service<Internet>::Create<Internet>();
                     _internet->Set(_T("127.0.0.1"));
-                    _adminLock.Unlock();
+                    _infoLock.WriteUnlock();
 
                 } else {
                     Internet* internet = Core::Service<Internet>::Create<Internet>();
@@ -355,14 +355,14 @@ namespace PluginHost {
 
                     info->Release();
 
-                    _adminLock.Lock();
+                    _infoLock.WriteLock();
 
                     if (_internet != nullptr) {
                         _internet->Release();
                     }
 
                     _internet = internet;
-                    _adminLock.Unlock();
+                    _infoLock.WriteUnlock();
                 }
 
                 SYSLOG(Logging::Startup, (_T("EVENT: Internet [%s]"), _internet->PublicIPAddress().c_str()));
@@ -377,7 +377,7 @@ namespace PluginHost {
                 PluginHost::ISubSystem::ILocation* info = (information != nullptr ? information->QueryInterface<PluginHost::ISubSystem::ILocation>() : nullptr);
 
                 if (info == nullptr) {
-                    _adminLock.Lock();
+                    _infoLock.WriteLock();
 
                     if (_location != nullptr) {
                         _location->Release();
@@ -385,21 +385,21 @@ namespace PluginHost {
 
                     _location = Core::Service<Location>::Create<Location>();
 
-                    _adminLock.Unlock();
+                    _infoLock.WriteUnlock();
                 } else {
                     Location* location = Core::Service<Location>::Create<Location>();
                     sendUpdate = location->Set(info) || sendUpdate;
 
                     info->Release();
 
-                    _adminLock.Lock();
+                    _infoLock.WriteLock();
 
                     if (_location != nullptr) {
                         _location->Release();
                     }
 
                     _location = location;
-                    _adminLock.Unlock();
+                    _infoLock.WriteUnlock();
                 }
 
                 SYSLOG(Logging::Startup, (_T("EVENT: TimeZone: %s, Country: %s, Region: %s, City: %s"), _location->TimeZone().c_str(), _location->Country().c_str(), _location->Region().c_str(), _location->City().c_str()));
@@ -416,7 +416,7 @@ namespace PluginHost {
 
                 if (info == nullptr) {
 
-                    _adminLock.Lock();
+                    _infoLock.WriteLock();
 
                     if (_time != nullptr) {
                         _time->Release();
@@ -425,21 +425,21 @@ namespace PluginHost {
                     _time = Core::Service<Time>::Create<Time>();
                     _time->Set(Core::Time::Now().Ticks());
 
-                    _adminLock.Unlock();
+                    _infoLock.WriteUnlock();
                 } else {
                     Time* time = Core::Service<Time>::Create<Time>();
                     sendUpdate = time->Set(info) || sendUpdate;
 
                     info->Release();
 
-                    _adminLock.Lock();
+                    _infoLock.WriteLock();
 
                     if (_time != nullptr) {
                         _time->Release();
                     }
 
                     _time = time;
-                    _adminLock.Unlock();
+                    _infoLock.WriteUnlock();
                 }
 
                 SYSLOG(Logging::Startup, (_T("EVENT: Time: %s"), Core::Time(_time->TimeSync()).ToRFC1123(false).c_str()));
@@ -453,7 +453,7 @@ namespace PluginHost {
             case PROVISIONING: {
                 PluginHost::ISubSystem::IProvisioning* info = (information != nullptr ? information->QueryInterface<PluginHost::ISubSystem::IProvisioning>() : nullptr);
 
-                _adminLock.Lock();
+                _infoLock.WriteLock();
 
                 if (_provisioning != nullptr) {
                     _provisioning->Release();
@@ -461,7 +461,7 @@ namespace PluginHost {
 
                 _provisioning = Core::Service<Provisioning>::Create<PluginHost::ISubSystem::IProvisioning>(info);
 
-                _adminLock.Unlock();
+                _infoLock.WriteUnlock();
 
                 if (info != nullptr) {
                     info->Release();
@@ -530,7 +530,7 @@ namespace PluginHost {
 
                 if (info == nullptr) {
 
-                    _adminLock.Lock();
+                    _infoLock.WriteLock();
 
                     if (_security != nullptr) {
                         _security->Release();
@@ -539,21 +539,21 @@ namespace PluginHost {
                     _security = Core::Service<Security>::Create<Security>();
                     _security->Set(_T(""));
 
-                    _adminLock.Unlock();
+                    _infoLock.WriteUnlock();
                 } else {
                     Security* security = Core::Service<Security>::Create<Security>();
                     sendUpdate = security->Set(info) || sendUpdate;
 
                     info->Release();
 
-                    _adminLock.Lock();
+                    _infoLock.WriteLock();
 
                     if (_security != nullptr) {
                         _security->Release();
                     }
 
                     _security = security;
-                    _adminLock.Unlock();
+                    _infoLock.WriteUnlock();
                 }
 
                 SYSLOG(Logging::Startup, (_T("EVENT: Security")));
@@ -572,7 +572,7 @@ namespace PluginHost {
 
             if (sendUpdate == true) {
 
-                _adminLock.Lock();
+                _infoLock.WriteLock();
 
                 if (type > END_LIST) {
                     _flags &= ~(1 << (type & 0xFF));
@@ -580,7 +580,7 @@ namespace PluginHost {
                     _flags |= (1 << type);
                 }
 
-                _adminLock.Unlock();
+                _infoLock.WriteUnlock();
 
                 Update();
             }
@@ -589,7 +589,7 @@ namespace PluginHost {
         {
             const Core::IUnknown* result(nullptr);
 
-            _adminLock.Lock();
+            _infoLock.ReadLock();
 
             if ((type < END_LIST) && (IsActive(type) == true)) {
 
@@ -640,7 +640,7 @@ namespace PluginHost {
                 }
             }
 
-            _adminLock.Unlock();
+            _infoLock.ReadUnlock();
 
             return result;
         }
@@ -652,6 +652,10 @@ namespace PluginHost {
         {
             return (_flags);
         }
+        inline Core::ReadWriteLock::Contention LockStatistics() const
+        {
+            return (_infoLock.Statistics());
+        }
 
         BEGIN_INTERFACE_MAP(SystemInfo)
         INTERFACE_ENTRY(PluginHost::ISubSystem)
@@ -666,6 +670,8 @@ namespace PluginHost {
 
     private:
         mutable Core::CriticalSection _adminLock;
+        // Guards the subsystem information, _adminLock the notifications.
+        mutable Core::ReadWriteLock _infoLock;
         std::list<PluginHost::ISubSystem::INotification*> _notificationClients;
         Core::IDispatch* _callback;
         Id* _identifier;
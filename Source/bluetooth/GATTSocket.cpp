@@ -93,8 +93,10 @@ uint16_t Attribute::Deserialize(const uint16_t size, const uint8_t stream[])
 {
     uint16_t result = 0;
 
-    // See if we need to retrigger..
-    if ((stream[0] != _id) && ((stream[0] != ATT_OP_ERROR) && (stream[1] == _id))) {
+    // Notifications and indications can arrive while a request is pending, they are not ours..
+    if ((stream[0] == ATT_OP_HANDLE_NOTIFY) || (stream[0] == ATT_OP_HANDLE_IND)) {
+        result = 0;
+    } else if ((stream[0] != _id) && ((stream[0] != ATT_OP_ERROR) && (stream[1] == _id))) {
         TRACE_L1(_T("Unexpected L2CapSocket message. Expected: %d, got %d [%d]"), _id, stream[0], stream[1]);
     } else {
         result = length;
@@ -295,6 +297,35 @@ uint16_t Attribute::Deserialize(const uint16_t size, const uint8_t stream[])
             _response.Type(ATT_OP_READ_RESP);
             break;
         }
+        case ATT_OP_READ_MULTI_RESP: {
+            _response.Add(0, length - 1, &(stream[1]));
+            _error = Core::ERROR_NONE;
+            _response.Type(stream[0]);
+            break;
+        }
+        case ATT_OP_PREPARE_WRITE_RESP: {
+            if (_frame.IsEcho(stream, length) == false) {
+                // The server did not queue what we sent, drop all that was prepared.
+                TRACE_L1(_T("Prepare Write response does not match the request, cancelling"));
+                _id = _frame.ExecuteWrite(false);
+            }
+            else {
+                const uint16_t offset = _frame.Offset() + (length - 5);
+
+                if (offset < _response.Length()) {
+                    _id = _frame.PrepareWrite(_frame.Handle(), offset, std::min(static_cast<uint16_t>(_response.Length() - offset), static_cast<uint16_t>(_mtu - 5)), &(_response.Data()[offset]));
+                }
+                else {
+                    _id = _frame.ExecuteWrite(true);
+                }
+            }
+            break;
+        }
+        case ATT_OP_EXECUTE_WRITE_RESP: {
+            _error = (_frame.IsCommitted() == true ? Core::ERROR_NONE : Core::ERROR_ASYNC_FAILED);
+            _response.Type(ATT_OP_WRITE_RESP);
+            break;
+        }
         default:
             break;
         }
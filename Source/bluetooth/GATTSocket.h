@@ -20,177 +20,12 @@
 #pragma once
 
 #include "Module.h"
+#include "UUID.h"
 
 namespace WPEFramework {
 
 namespace Bluetooth {
 
-    class UUID {
-    private:
-        static const uint8_t BASE[];
-
-    public:
-        UUID() {
-            _uuid[0] = 0;
-        }
-        UUID(const uint16_t uuid)
-        {
-            _uuid[0] = 2;
-            ::memcpy(&(_uuid[1]), BASE, sizeof(_uuid) - 3);
-            _uuid[15] = (uuid & 0xFF);
-            _uuid[16] = (uuid >> 8) & 0xFF;
-        }
-        UUID(const uint8_t uuid[16])
-        {
-            ::memcpy(&(_uuid[1]), uuid, 16);
-
-            // See if this contains the Base, cause than it can be a short...
-            if (::memcmp(BASE, uuid, 14) == 0) {
-                _uuid[0] = 2;
-            }
-            else {
-                _uuid[0] = 16;
-            }
-        }
-        explicit UUID(const string& uuidStr)
-        {
-            FromString(uuidStr);
-        }
-        UUID(const UUID& copy)
-        {
-            ::memcpy(_uuid, copy._uuid, sizeof(_uuid));
-        }
-        ~UUID()
-        {
-        }
-
-        UUID& operator=(const UUID& rhs)
-        {
-            ::memcpy(_uuid, rhs._uuid, sizeof(_uuid));
-            return (*this);
-        }
-
-    public:
-        bool IsValid() const {
-            return (_uuid[0] != 0);
-        }
-        uint16_t Short() const
-        {
-            ASSERT(_uuid[0] == 2);
-            return ((_uuid[16] << 8) | _uuid[15]);
-        }
-        bool operator==(const UUID& rhs) const
-        {
-            return ((rhs._uuid[0] == _uuid[0]) && 
-                    ((_uuid[0] == 2) ? ((rhs._uuid[15] == _uuid[15]) && (rhs._uuid[16] == _uuid[16])) : 
-                                       (::memcmp(_uuid, rhs._uuid, _uuid[0] + 1) == 0)));
-        }
-        bool operator!=(const UUID& rhs) const
-        {
-            return !(operator==(rhs));
-        }
-        bool operator==(const uint16_t shortUuid) const
-        {
-            return ((HasShort() == true) && (Short() == shortUuid));
-        }
-        bool operator!=(const uint16_t shortUuid) const
-        {
-            return !(operator==(shortUuid));
-        }
-        bool HasShort() const
-        {
-            return (_uuid[0] == 2);
-        }
-        uint8_t Length() const
-        {
-            return (_uuid[0]);
-        }
-        const uint8_t* Data() const
-        {
-             return (_uuid[0] == 2 ? &(_uuid[15]) :  &(_uuid[1]));
-        }
-        string ToString(const bool full = false) const
-        {
-            // 00002a23-0000-1000-8000-00805f9b34fb
-            static const TCHAR hexArray[] = "0123456789abcdef";
-
-            uint8_t index = 0;
-            string result;
-
-            if ((HasShort() == false) || (full == true)) {
-                result.resize(36);
-                for (uint8_t byte = 12 + 4; byte > 12; byte--) {
-                    result[index++] = hexArray[_uuid[byte] >> 4];
-                    result[index++] = hexArray[_uuid[byte] & 0xF];
-                }
-                result[index++] = '-';
-                for (uint8_t byte = 10 + 2; byte > 10; byte--) {
-                    result[index++] = hexArray[_uuid[byte] >> 4];
-                    result[index++] = hexArray[_uuid[byte] & 0xF];
-                }
-                result[index++] = '-';
-                for (uint8_t byte = 8 + 2; byte > 8; byte--) {
-                    result[index++] = hexArray[_uuid[byte] >> 4];
-                    result[index++] = hexArray[_uuid[byte] & 0xF];
-                }
-                result[index++] = '-';
-                for (uint8_t byte = 6 + 2; byte > 6; byte--) {
-                    result[index++] = hexArray[_uuid[byte] >> 4];
-                    result[index++] = hexArray[_uuid[byte] & 0xF];
-                }
-                result[index++] = '-';
-                for (uint8_t byte = 0 + 6; byte > 0; byte--) {
-                    result[index++] = hexArray[_uuid[byte] >> 4];
-                    result[index++] = hexArray[_uuid[byte] & 0xF];
-                }
-            }
-            else {
-                result.resize(4);
-
-                for (uint8_t byte = 14 + 2; byte > 14; byte--) {
-                    result[index++] = hexArray[_uuid[byte] >> 4];
-                    result[index++] = hexArray[_uuid[byte] & 0xF];
-                }
-            }
-            return (result);
-        }
-        bool FromString(const string& uuidStr)
-        {
-            if ((uuidStr.length() == 4) || (uuidStr.length() == ((16 * 2) + 4))) {
-                uint8_t buf[16];
-                if (uuidStr.length() == 4) {
-                    memcpy(buf, BASE, sizeof(buf));
-                }
-                uint8_t* p = (buf + sizeof(buf));
-                int16_t idx = 0;
-                uint16_t size = uuidStr.length();
-
-                while (idx < size) {
-                    if ((idx == 8) || (idx == 13) || (idx == 18) || (idx == 23)) {
-                        if (uuidStr[idx] != '-') {
-                            break;
-                        } else {
-                            idx++;
-                        }
-                    } else {
-                        (*--p) = ((Core::FromHexDigits(uuidStr[idx]) << 4) | Core::FromHexDigits(uuidStr[idx + 1]));
-                        idx += 2;
-                    }
-                }
-
-                if (idx == size) {
-                    (*this) = UUID(buf);
-                    return true;
-                }
-            }
-
-            return false;
-        }
-
-    private:
-        uint8_t _uuid[17];
-    };
-
     class Attribute {
     public:
         enum type {
@@ -282,6 +117,8 @@ namespace Bluetooth {
         GATTSocket(const GATTSocket&) = delete;
         GATTSocket& operator=(const GATTSocket&) = delete;
 
+        static constexpr uint16_t ATT_DEFAULT_MTU = 23;
+
         static constexpr uint8_t ATT_OP_ERROR = 0x01;
         static constexpr uint8_t ATT_OP_MTU_REQ = 0x02;
         static constexpr uint8_t ATT_OP_MTU_RESP = 0x03;
@@ -301,7 +138,15 @@ namespace Bluetooth {
         static constexpr uint8_t ATT_OP_READ_BY_GROUP_RESP = 0x11;
         static constexpr uint8_t ATT_OP_WRITE_REQ = 0x12;
         static constexpr uint8_t ATT_OP_WRITE_RESP = 0x13;
+        static constexpr uint8_t ATT_OP_PREPARE_WRITE_REQ = 0x16;
+        static constexpr uint8_t ATT_OP_PREPARE_WRITE_RESP = 0x17;
+        static constexpr uint8_t ATT_OP_EXECUTE_WRITE_REQ = 0x18;
+        static constexpr uint8_t ATT_OP_EXECUTE_WRITE_RESP = 0x19;
         static constexpr uint8_t ATT_OP_HANDLE_NOTIFY = 0x1B;
+        static constexpr uint8_t ATT_OP_HANDLE_IND = 0x1D;
+        static constexpr uint8_t ATT_OP_HANDLE_CONF = 0x1E;
+        static constexpr uint8_t ATT_OP_WRITE_CMD = 0x52;
+        static constexpr uint8_t ATT_OP_SIGNED_WRITE_CMD = 0xD2;
 
 
         static constexpr uint8_t ATT_ECODE_INVALID_HANDLE = 0x01;
@@ -378,7 +223,8 @@ namespace Bluetooth {
 
                 // See if we need to retrigger..
                 if (stream[0] == ATT_OP_MTU_RESP) {
-                    _mtu = ((stream[2] << 8) | stream[1]);
+                    // Both sides must be able to receive it, so the smallest of the two is used.
+                    _mtu = std::max(static_cast<uint32_t>(ATT_DEFAULT_MTU), std::min(static_cast<uint32_t>((stream[2] << 8) | stream[1]), (_mtu & 0xFFFF)));
                     result = length;
                 } else if ((stream[0] == ATT_OP_ERROR) && (stream[1] == ATT_OP_MTU_RESP)) {
                     TRACE_L1("Error on receiving MTU: [%d]", stream[2]);
@@ -395,8 +241,41 @@ namespace Bluetooth {
             mutable uint32_t _mtu;
         };
 
+        // An indication must be confirmed before the remote can send the next one. There is only one
+        // of these, a confirmation owed while it is queued is send after it completes.
+        class Confirmation : public Core::IOutbound {
+        public:
+            Confirmation(const Confirmation&) = delete;
+            Confirmation& operator= (const Confirmation&) = delete;
+
+            Confirmation() : _send(false) {
+            }
+            virtual ~Confirmation() {
+            }
+
+        public:
+            virtual void Reload() const override
+            {
+                _send = false;
+            }
+            virtual uint16_t Serialize(uint8_t stream[], const uint16_t length) const override
+            {
+                uint16_t result = 0;
+                if ((_send == false) && (length >= 1)) {
+                    stream[0] = ATT_OP_HANDLE_CONF;
+                    _send = true;
+                    result = 1;
+                }
+                return (result);
+            }
+
+        private:
+            mutable bool _send;
+        };
+
     public:
         static constexpr uint32_t CommunicationTimeOut = 2000; /* 2 seconds. */
+        static constexpr uint8_t SIGNATURE_SIZE = 12;
 
         class Command : public Core::IOutbound, public Core::IInbound {
         private:
@@ -413,11 +292,17 @@ namespace Bluetooth {
             public:
                 Exchange()
                     : _offset(~0)
+                    , _end(0)
                     , _size(0)
+                    , _maxSize(BLOCKSIZE)
+                    , _buffer(reinterpret_cast<uint8_t*>(::malloc(_maxSize)))
                 {
                 }
                 ~Exchange()
                 {
+                    if (_buffer != nullptr) {
+                        ::free(_buffer);
+                    }
                 }
 
             public:
@@ -429,6 +314,10 @@ namespace Bluetooth {
                 {
                     _offset = 0;
                 }
+                uint8_t Opcode() const
+                {
+                    return (_buffer[0]);
+                }
                 void ReadByGroupType(const uint16_t start)
                 {
                     _buffer[1] = (start & 0xFF);
@@ -445,6 +334,7 @@ namespace Bluetooth {
                     ::memcpy(&(_buffer[5]), id.Data(), id.Length());
                     _size = id.Length() + 5;
                     _end = end;
+                    Reload();
                     return (ATT_OP_READ_BY_GROUP_RESP);
                 }
                 void FindByType(const uint16_t start)
@@ -455,6 +345,7 @@ namespace Bluetooth {
                 }
                 uint8_t FindByType(const uint16_t start, const uint16_t end, const UUID& id, const uint8_t length, const uint8_t data[])
                 {
+                    Reserve(7 + length);
                     _buffer[0] = ATT_OP_FIND_BY_TYPE_REQ;
                     _buffer[1] = (start & 0xFF);
                     _buffer[2] = (start >> 8) & 0xFF;
@@ -465,6 +356,7 @@ namespace Bluetooth {
                     ::memcpy(&(_buffer[7]), data, length);
                     _size = 7 + length;
                     _end = end;
+                    Reload();
                     return (ATT_OP_FIND_BY_TYPE_RESP);
                 }
                 uint8_t FindByType(const uint16_t start, const uint16_t end, const UUID& id, const uint16_t handle)
@@ -480,6 +372,7 @@ namespace Bluetooth {
                     _buffer[8] = (handle >> 8) & 0xFF;
                     _size = 9;
                     _end = end;
+                    Reload();
                     return (ATT_OP_FIND_BY_TYPE_RESP);
                 }
                 void ReadByType(const uint16_t start)
@@ -498,6 +391,7 @@ namespace Bluetooth {
                     ::memcpy(&(_buffer[5]), id.Data(), id.Length());
                     _size = id.Length() + 5;
                     _end = end;
+                    Reload();
                     return (ATT_OP_READ_BY_TYPE_RESP);
                 }
                 void FindInformation(const uint16_t start)
@@ -515,6 +409,7 @@ namespace Bluetooth {
                     _buffer[4] = (end >> 8) & 0xFF;
                     _size = 5;
                     _end = end;
+                    Reload();
                     return (ATT_OP_FIND_INFO_RESP);
                 }
                 uint8_t Read(const uint16_t handle)
@@ -524,6 +419,7 @@ namespace Bluetooth {
                     _buffer[2] = (handle >> 8) & 0xFF;
                     _size = 3;
                     _end = 0;
+                    Reload();
                     return (ATT_OP_READ_RESP);
                 }
                 uint8_t ReadBlob(const uint16_t handle, const uint16_t offset)
@@ -535,17 +431,62 @@ namespace Bluetooth {
                     _buffer[4] = (offset >> 8) & 0xFF;
                     _size = 5;
                     _end = 0;
+                    Reload();
                     return (ATT_OP_READ_BLOB_RESP);
                 }
-                uint8_t Write(const uint16_t handle, const uint8_t length, const uint8_t data[])
+                uint8_t ReadMultiple(const uint8_t count, const uint16_t handles[])
+                {
+                    Reserve(1 + (2 * count));
+                    _buffer[0] = ATT_OP_READ_MULTI_REQ;
+                    for (uint8_t index = 0; index < count; index++) {
+                        _buffer[1 + (2 * index)] = (handles[index] & 0xFF);
+                        _buffer[2 + (2 * index)] = (handles[index] >> 8) & 0xFF;
+                    }
+                    _size = 1 + (2 * count);
+                    _end = 0;
+                    Reload();
+                    return (ATT_OP_READ_MULTI_RESP);
+                }
+                uint8_t Write(const uint16_t handle, const uint16_t length, const uint8_t data[])
                 {
-                    _buffer[0] = ATT_OP_WRITE_REQ;
+                    return (Write(ATT_OP_WRITE_REQ, handle, length, data) == 0 ? 0 : ATT_OP_WRITE_RESP);
+                }
+                // Commands get no response, so there is no opcode to wait for.
+                uint8_t WriteCommand(const uint16_t handle, const uint16_t length, const uint8_t data[])
+                {
+                    Write(ATT_OP_WRITE_CMD, handle, length, data);
+                    return (0);
+                }
+                uint8_t SignedWrite(const uint16_t handle, const uint16_t length, const uint8_t data[], const uint8_t signature[])
+                {
+                    Write(ATT_OP_SIGNED_WRITE_CMD, handle, length, data);
+                    Reserve(_size + SIGNATURE_SIZE);
+                    ::memcpy(&(_buffer[_size]), signature, SIGNATURE_SIZE);
+                    _size += SIGNATURE_SIZE;
+                    return (0);
+                }
+                uint8_t PrepareWrite(const uint16_t handle, const uint16_t offset, const uint16_t length, const uint8_t data[])
+                {
+                    Reserve(5 + length);
+                    _buffer[0] = ATT_OP_PREPARE_WRITE_REQ;
                     _buffer[1] = (handle & 0xFF);
                     _buffer[2] = (handle >> 8) & 0xFF;
-                    ::memcpy(&(_buffer[3]), data, length);
-                    _size = 3 + length;
+                    _buffer[3] = (offset & 0xFF);
+                    _buffer[4] = (offset >> 8) & 0xFF;
+                    ::memcpy(&(_buffer[5]), data, length);
+                    _size = 5 + length;
+                    _end = 0;
+                    Reload();
+                    return (ATT_OP_PREPARE_WRITE_RESP);
+                }
+                uint8_t ExecuteWrite(const bool commit)
+                {
+                    _buffer[0] = ATT_OP_EXECUTE_WRITE_REQ;
+                    _buffer[1] = (commit ? 0x01 : 0x00);
+                    _size = 2;
                     _end = 0;
-                    return (ATT_OP_WRITE_RESP);
+                    Reload();
+                    return (ATT_OP_EXECUTE_WRITE_RESP);
                 }
                 uint16_t Serialize(uint8_t stream[], const uint16_t length) const
                 {
@@ -562,43 +503,84 @@ namespace Bluetooth {
                 }
                 uint16_t Handle() const
                 {
-                    return (((_buffer[0] == ATT_OP_READ_BLOB_REQ) || (_buffer[0] == ATT_OP_READ_REQ)) ? ((_buffer[2] << 8) | _buffer[1]) : 0);
+                    return (((_buffer[0] == ATT_OP_READ_BLOB_REQ) || (_buffer[0] == ATT_OP_READ_REQ) || (_buffer[0] == ATT_OP_WRITE_REQ) || 
+                             (_buffer[0] == ATT_OP_WRITE_CMD) || (_buffer[0] == ATT_OP_PREPARE_WRITE_REQ)) ? ((_buffer[2] << 8) | _buffer[1]) : 0);
                 }
                 uint16_t Offset() const
                 {
-                    return ((_buffer[0] == ATT_OP_READ_BLOB_REQ) ? ((_buffer[4] << 8) | _buffer[3]) : 0);
+                    return (((_buffer[0] == ATT_OP_READ_BLOB_REQ) || (_buffer[0] == ATT_OP_PREPARE_WRITE_REQ)) ? ((_buffer[4] << 8) | _buffer[3]) : 0);
                 }
                 uint16_t End() const {
                     return (_end);
                 }
+                bool IsCommitted() const {
+                    return ((_buffer[0] == ATT_OP_EXECUTE_WRITE_REQ) && (_buffer[1] == 0x01));
+                }
+                // A Prepare Write response echoes the request, which is how the client can tell the
+                // server queued exactly what was sent.
+                bool IsEcho(const uint8_t stream[], const uint16_t length) const
+                {
+                    return ((_buffer[0] == ATT_OP_PREPARE_WRITE_REQ) && (length == _size) && (::memcmp(&(stream[1]), &(_buffer[1]), _size - 1) == 0));
+                }
+
+            private:
+                uint16_t Write(const uint8_t opcode, const uint16_t handle, const uint16_t length, const uint8_t data[])
+                {
+                    Reserve(3 + length);
+                    _buffer[0] = opcode;
+                    _buffer[1] = (handle & 0xFF);
+                    _buffer[2] = (handle >> 8) & 0xFF;
+                    if (length > 0) {
+                        ::memcpy(&(_buffer[3]), data, length);
+                    }
+                    _size = 3 + length;
+                    _end = 0;
+                    Reload();
+                    return (length);
+                }
+                void Reserve(const uint16_t size)
+                {
+                    if (size > _maxSize) {
+                        _maxSize = (((size / BLOCKSIZE) + 1) * BLOCKSIZE);
+                        _buffer = reinterpret_cast<uint8_t*>(::realloc(_buffer, _maxSize));
+                    }
+                }
 
             private:
                 mutable uint16_t _offset;
                 uint16_t _end;
-                uint8_t _size;
-                uint8_t _buffer[BLOCKSIZE];
+                uint16_t _size;
+                uint16_t _maxSize;
+                uint8_t* _buffer;
             };
 
         public:
+            // The entries are kept in one flat array that is reused by the next command, the values
+            // they point to are all in the same storage buffer.
             class Response {
             private:
                 Response(const Response&) = delete;
                 Response& operator=(const Response&) = delete;
 
-                typedef std::pair<uint16_t, std::pair<uint16_t, uint16_t> > Entry;
+                struct Entry {
+                    uint16_t Handle;
+                    uint16_t Group;
+                    uint16_t Offset;
+                };
 
             public:
                 Response()
                     : _maxSize(BLOCKSIZE)
                     , _loaded(0)
                     , _result()
-                    , _iterator()
+                    , _index(0)
                     , _storage(reinterpret_cast<uint8_t*>(::malloc(_maxSize)))
                     , _preHead(true)
                     , _min(0x0001)
                     , _max(0xFFFF)
                     , _type(ATT_OP_ERROR)
                 {
+                    _result.reserve(BLOCKSIZE / sizeof(Entry));
                 }
                 ~Response()
                 {
@@ -629,21 +611,21 @@ namespace Bluetooth {
                 }
                 bool IsValid() const
                 {
-                    return ((_preHead == false) && (_iterator != _result.end()));
+                    return ((_preHead == false) && (_index < _result.size()));
                 }
                 bool Next()
                 {
                     if (_preHead == true) {
                         _preHead = false;
-                        _iterator = _result.begin();
-                    } else {
-                        _iterator++;
+                        _index = 0;
+                    } else if (_index < _result.size()) {
+                        _index++;
                     }
-                    return (_iterator != _result.end());
+                    return (_index < _result.size());
                 }
                 uint16_t Handle() const
                 {
-                    return (_iterator->first);
+                    return (_result[_index].Handle);
                 }
                 uint16_t MTU() const
                 {
@@ -651,12 +633,12 @@ namespace Bluetooth {
                 }
                 uint16_t Group() const
                 {
-                    return (_type == ATT_OP_READ_BY_TYPE_RESP ? ((_storage[_iterator->second.second + 2] << 8) | (_storage[_iterator->second.second + 1])) : _iterator->second.first);
+                    return (_type == ATT_OP_READ_BY_TYPE_RESP ? ((_storage[_result[_index].Offset + 2] << 8) | (_storage[_result[_index].Offset + 1])) : _result[_index].Group);
                 }
                 UUID Attribute() const {
                     uint8_t        offset = (_type == ATT_OP_READ_BY_TYPE_RESP ? 3 : 0);
                     uint16_t       length = Delta() - offset;
-                    const uint8_t* data   = &(_storage[_iterator->second.second + offset]);
+                    const uint8_t* data   = &(_storage[_result[_index].Offset + offset]);
  
                     if ((length != 2) && (length != 16)) {
                         TRACE_L1("**** Unexpected Attribute length [%d] !!!!", length);
@@ -667,11 +649,11 @@ namespace Bluetooth {
                                            UUID());
                 }
                 uint8_t Rights() const {
-                    return (_storage[_iterator->second.second]);
+                    return (_storage[_result[_index].Offset]);
                 }
                 uint16_t Count() const
                 {
-                    return (_result.size());
+                    return (static_cast<uint16_t>(_result.size()));
                 }
                 bool Empty() const
                 {
@@ -687,7 +669,7 @@ namespace Bluetooth {
                 }
                 const uint8_t* Data() const
                 {
-                    return (IsValid() == true ? &(_storage[_iterator->second.second]) : (((_result.size() <= 1) && (_loaded > 0)) ? _storage : nullptr));
+                    return (IsValid() == true ? &(_storage[_result[_index].Offset]) : (((_result.size() <= 1) && (_loaded > 0)) ? _storage : nullptr));
                 }
                 uint16_t Min() const {
                     return(_min);
@@ -699,8 +681,7 @@ namespace Bluetooth {
             private:
                 friend class Command;
                 uint16_t Delta() const {
-                    std::list<Entry>::iterator next(_iterator);
-                    return (++next == _result.end() ? (_loaded - _iterator->second.second) : (next->second.second - _iterator->second.second));
+                    return ((_index + 1u) == _result.size() ? (_loaded - _result[_index].Offset) : (_result[_index + 1].Offset - _result[_index].Offset));
                 }
                 void SetMTU(const uint16_t MTU)
                 {
@@ -713,28 +694,28 @@ namespace Bluetooth {
                         _min = handle;
                     if (_max < group)
                         _max = group;
-                    _result.emplace_back(Entry(handle, std::pair<uint16_t,uint16_t>(group,_loaded)));
+                    _result.push_back({ handle, group, _loaded });
                 }
-                void Add(const uint16_t handle, const uint8_t length, const uint8_t buffer[])
+                void Add(const uint16_t handle, const uint16_t length, const uint8_t buffer[])
                 {
                     if (_min > handle)
                         _min = handle;
                     if (_max < handle)
                         _max = handle;
 
-                    _result.emplace_back(Entry(handle, std::pair<uint16_t,uint16_t>(0,_loaded)));
+                    _result.push_back({ handle, 0, _loaded });
                     Extend(length, buffer);
                 }
-                void Add(const uint16_t handle, const uint16_t group, const uint8_t length, const uint8_t buffer[])
+                void Add(const uint16_t handle, const uint16_t group, const uint16_t length, const uint8_t buffer[])
                 {
                     if (_min > handle)
                         _min = handle;
                     if (_max < group)
                         _max = group;
-                    _result.emplace_back(Entry(handle, std::pair<uint16_t,uint16_t>(group,_loaded)));
+                    _result.push_back({ handle, group, _loaded });
                     Extend(length, buffer);
                 }
-                void Extend(const uint8_t length, const uint8_t buffer[])
+                void Extend(const uint16_t length, const uint8_t buffer[])
                 {
                     if (length > 0) {
                         if ((_loaded + length) > _maxSize) {
@@ -746,16 +727,17 @@ namespace Bluetooth {
                         _loaded += length;
                     }
                 }
+                // Bytes loaded for the last value, where a Read Blob continues.
                 uint16_t Offset() const
                 {
-                    return (_result.size() != 0 ? _loaded : _loaded - _result.back().second.second);
+                    return (_result.empty() == true ? 0 : _loaded - _result.back().Offset);
                 }
 
             private:
                 uint16_t _maxSize;
                 uint16_t _loaded;
-                std::list<Entry> _result;
-                std::list<Entry>::iterator _iterator;
+                std::vector<Entry> _result;
+                uint16_t _index;
                 uint8_t* _storage;
                 bool _preHead;
                 uint16_t _min;
@@ -768,6 +750,7 @@ namespace Bluetooth {
                 : _error(~0)
                 , _mtu(0)
                 , _id(0)
+                , _written(0)
                 , _frame()
                 , _response()
             {
@@ -789,6 +772,10 @@ namespace Bluetooth {
             uint16_t Error() const {
                 return(_error);
             }
+            // Commands (Write Without Response, Signed Write) are done as soon as they are sent.
+            bool HasResponse() const {
+                return (_id != 0);
+            }
             void FindInformation(const uint16_t min, const uint16_t max)
             {
                 _response.Clear();
@@ -819,12 +806,44 @@ namespace Bluetooth {
                 _error = ~0;
                 _id = _frame.Read(handle);
             }
-            void Write(const uint16_t handle, const uint8_t length, const uint8_t data[])
+            // The values are concatenated in the Result, only the last one may be of variable length
+            // and it is cut off at the MTU.
+            void ReadMultiple(const uint8_t count, const uint16_t handles[])
+            {
+                ASSERT(count >= 2);
+                _response.Clear();
+                _error = ~0;
+                _id = _frame.ReadMultiple(count, handles);
+            }
+            // A value that does not fit in the MTU is written with Prepare Write requests and committed
+            // with an Execute Write request.
+            void Write(const uint16_t handle, const uint16_t length, const uint8_t data[])
+            {
+                _response.Clear();
+                _response.Extend(length, data);
+                _error = ~0;
+                _written = 0;
+                _id = _frame.Write(handle, 0, nullptr);
+            }
+            // Write Without Response. A value that does not fit in the MTU is streamed to the handle as
+            // consecutive commands of the largest size possible.
+            void WriteCommand(const uint16_t handle, const uint16_t length, const uint8_t data[])
+            {
+                _response.Clear();
+                _response.Extend(length, data);
+                _error = ~0;
+                _written = 0;
+                _id = _frame.WriteCommand(handle, 0, nullptr);
+            }
+            // Signed Write Without Response, the signature (sign counter and CMAC over the PDU with the
+            // CSRK) is calculated by the owner of the key. Only allowed on an unencrypted link.
+            void SignedWrite(const uint16_t handle, const uint16_t length, const uint8_t data[], const uint8_t signature[SIGNATURE_SIZE])
             {
                 _response.Clear();
                 _response.Extend(length, data);
                 _error = ~0;
-                _id = _frame.Write(handle, length, data);
+                _written = length;
+                _id = _frame.SignedWrite(handle, length, data, signature);
             }
             void FindByType(const uint16_t min, const uint16_t max, const UUID& uuid, const uint8_t length, const uint8_t data[])
             {
@@ -844,8 +863,39 @@ namespace Bluetooth {
             void Error(const uint32_t error_code) {
                 _error = error_code;
             }
+            // The writes get their (first) PDU once the MTU they have to fit in is known.
             void MTU(const uint16_t mtu) {
                 _mtu = mtu;
+
+                if (_frame.Opcode() == ATT_OP_WRITE_REQ) {
+                    const uint16_t handle = _frame.Handle();
+
+                    if (_response.Length() <= (_mtu - 3)) {
+                        _id = _frame.Write(handle, _response.Length(), _response.Data());
+                    }
+                    else {
+                        _id = _frame.PrepareWrite(handle, 0, (_mtu - 5), _response.Data());
+                    }
+                }
+                else if ((_frame.Opcode() == ATT_OP_WRITE_CMD) && (_written == 0)) {
+                    Continue();
+                }
+                else if (_frame.Opcode() == ATT_OP_SIGNED_WRITE_CMD) {
+                    ASSERT((_response.Length() + 3 + SIGNATURE_SIZE) <= _mtu);
+                }
+            }
+            // Loads the next part of a streamed Write Without Response, false if all is sent.
+            bool Continue() {
+                bool result = false;
+
+                if ((_frame.Opcode() == ATT_OP_WRITE_CMD) && ((_written < _response.Length()) || ((_written == 0) && (_frame.IsSend() == false)))) {
+                    const uint16_t length = std::min(static_cast<uint16_t>(_response.Length() - _written), static_cast<uint16_t>(_mtu - 3));
+                    _frame.WriteCommand(_frame.Handle(), length, (length > 0 ? &(_response.Data()[_written]) : nullptr));
+                    _written += length;
+                    result = true;
+                }
+
+                return (result);
             }
  
         private:
@@ -867,6 +917,7 @@ namespace Bluetooth {
             uint16_t _error;
             uint16_t _mtu;
             uint8_t  _id;
+            uint16_t _written;
             Exchange _frame;
             Response _response;
         };
@@ -916,6 +967,8 @@ namespace Bluetooth {
             : Core::SynchronousChannelType<Core::SocketPort>(SocketPort::SEQUENCED, localNode, remoteNode, maxMTU, maxMTU)
             , _adminLock()
             , _sink(*this, maxMTU)
+            , _confirmation()
+            , _confirmations(0)
             , _queue()
         {
         }
@@ -929,19 +982,25 @@ namespace Bluetooth {
         inline uint16_t MTU() const {
             return (_sink.MTU());
         }
+        // ATT allows one outstanding request, the next one is send as soon as its predecessor completes.
+        // Commands (Write Without Response) complete once they are send, so they stream back to back.
         void Execute(const uint32_t waitTime, Command& cmd, const Handler& handler)
         {
             cmd.MTU(_sink.MTU());
             _adminLock.Lock();
             _queue.emplace_back(waitTime, cmd, handler);
-            if (_queue.size() ==  1) {
-                Send(waitTime, cmd, &_sink, &cmd);
-            }
+            bool trigger = (_queue.size() == 1);
             _adminLock.Unlock();
+
+            // Only the completion of the first one sends the next, so nobody else can send this one,
+            // and the channel lock is never taken while holding ours.
+            if (trigger == true) {
+                Send(waitTime, cmd, &_sink, (cmd.HasResponse() ? &cmd : nullptr));
+            }
         }
         void Revoke(const Command& cmd)
         {
-            Revoke(cmd);
+            Core::SynchronousChannelType<Core::SocketPort>::Revoke(cmd);
         }
 
     private:
@@ -961,6 +1020,19 @@ namespace Bluetooth {
                     Notification(handle, &dataFrame[3], (availableData - 3));
                     result = availableData;
                 }
+                else if ((opcode == ATT_OP_HANDLE_IND) && (availableData >= 3)) {
+                    uint16_t handle = ((dataFrame[2] << 8) | dataFrame[1]);
+                    Notification(handle, &dataFrame[3], (availableData - 3));
+
+                    _adminLock.Lock();
+                    bool send = (_confirmations++ == 0);
+                    _adminLock.Unlock();
+
+                    if (send == true) {
+                        Send(CommunicationTimeOut, _confirmation, &_sink, nullptr);
+                    }
+                    result = availableData;
+                }
                 else {
                     printf ("**** Unexpected data, TYPE [%02X] !!!!\n", dataFrame[0]);
                 }
@@ -973,7 +1045,17 @@ namespace Bluetooth {
         }
         void Completed(const Core::IOutbound& data, const uint32_t error_code) 
         {
-            if ( (&data == &_sink) && (_sink.HasMTU() == true) ) {
+            if (&data == &_confirmation) {
+                _adminLock.Lock();
+                ASSERT(_confirmations > 0);
+                bool send = (--_confirmations > 0);
+                _adminLock.Unlock();
+
+                if (send == true) {
+                    Send(CommunicationTimeOut, _confirmation, &_sink, nullptr);
+                }
+            }
+            else if ( (&data == &_sink) && (_sink.HasMTU() == true) ) {
                 Operational();
             }
             else {
@@ -982,6 +1064,10 @@ namespace Bluetooth {
                 if ((_queue.size() == 0) || (*(_queue.begin()) != &data)) {
                     ASSERT (false && _T("Always the first one should be the one to be handled!!"));
                 }
+                else if ((error_code == Core::ERROR_NONE) && (_queue.begin()->Cmd().Continue() == true)) {
+                    // Next part of a streamed write..
+                    Send(_queue.begin()->WaitTime(), _queue.begin()->Cmd(), &_sink, nullptr);
+                }
                 else {
                     // Command completion...
                     _queue.begin()->Completed(error_code);
@@ -991,7 +1077,7 @@ namespace Bluetooth {
                         Entry& entry(*(_queue.begin()));
                         Command& cmd (entry.Cmd());
 
-                        Send(entry.WaitTime(), cmd, &_sink, &cmd);
+                        Send(entry.WaitTime(), cmd, &_sink, (cmd.HasResponse() ? &cmd : nullptr));
                     }
                 }
 
@@ -1002,6 +1088,8 @@ namespace Bluetooth {
     private:
         Core::CriticalSection _adminLock;
         CommandSink _sink;
+        Confirmation _confirmation;
+        uint32_t _confirmations;
         std::list<Entry> _queue;
         uint32_t _mtuSize;
         struct l2cap_conninfo _connectionInfo;
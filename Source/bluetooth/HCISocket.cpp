@@ -29,6 +29,355 @@ ENUM_CONVERSION_END(Bluetooth::Address::type)
 
 namespace Bluetooth {
 
+namespace {
+
+    constexpr uint8_t EIR_UUID16_SOME = 0x02;
+    constexpr uint8_t EIR_UUID16_ALL = 0x03;
+    constexpr uint8_t EIR_UUID128_SOME = 0x06;
+    constexpr uint8_t EIR_UUID128_ALL = 0x07;
+    constexpr uint8_t EIR_MANUFACTURER_DATA = 0xFF;
+
+    // Calls the action with every AD structure (type, length, data) in the payload, till it returns true.
+    template <typename ACTION>
+    bool Structures(const uint8_t length, const uint8_t data[], ACTION&& action)
+    {
+        bool result = false;
+        uint16_t offset = 0;
+
+        while ((result == false) && ((offset + 1) < length) && (data[offset] != 0) && ((offset + 1 + data[offset]) <= length)) {
+            result = action(data[offset + 1], static_cast<uint8_t>(data[offset] - 1), &(data[offset + 2]));
+            offset += (1 + data[offset]);
+        }
+
+        return (result);
+    }
+
+    uint64_t Key(const le_advertising_info& info)
+    {
+        uint64_t result = info.bdaddr_type;
+
+        for (uint8_t index = 0; index < sizeof(info.bdaddr.b); index++) {
+            result = (result << 8) | info.bdaddr.b[index];
+        }
+
+        return (result);
+    }
+}
+
+HCISocket::Advertisement::Advertisement()
+    : _source()
+    , _addressType(0)
+    , _type(~0)
+    , _rssi(NO_RSSI)
+    , _reported(127)
+    , _accepted(false)
+    , _pending(false)
+    , _length(0)
+    , _responseLength(0)
+    , _seen(0)
+{
+}
+
+HCISocket::Advertisement::Advertisement(const le_advertising_info& info)
+    : _source(info.bdaddr)
+    , _addressType(info.bdaddr_type)
+    , _type(~0)
+    , _rssi(NO_RSSI)
+    , _reported(127)
+    , _accepted(false)
+    , _pending(false)
+    , _length(0)
+    , _responseLength(0)
+    , _seen(0)
+{
+}
+
+HCISocket::Advertisement::Advertisement(const Advertisement& copy)
+    : _source(copy._source)
+    , _addressType(copy._addressType)
+    , _type(copy._type)
+    , _rssi(copy._rssi)
+    , _reported(copy._reported)
+    , _accepted(copy._accepted)
+    , _pending(copy._pending)
+    , _length(copy._length)
+    , _responseLength(copy._responseLength)
+    , _seen(copy._seen)
+{
+    ::memcpy(_data, copy._data, _length);
+    ::memcpy(_response, copy._response, _responseLength);
+}
+
+HCISocket::Advertisement::~Advertisement()
+{
+}
+
+HCISocket::Advertisement& HCISocket::Advertisement::operator=(const Advertisement& rhs)
+{
+    _source = rhs._source;
+    _addressType = rhs._addressType;
+    _type = rhs._type;
+    _rssi = rhs._rssi;
+    _reported = rhs._reported;
+    _accepted = rhs._accepted;
+    _pending = rhs._pending;
+    _length = rhs._length;
+    _responseLength = rhs._responseLength;
+    _seen = rhs._seen;
+    ::memcpy(_data, rhs._data, _length);
+    ::memcpy(_response, rhs._response, _responseLength);
+
+    return (*this);
+}
+
+uint8_t HCISocket::Advertisement::Name(string& name) const
+{
+    std::string store;
+    uint8_t type = 0;
+
+    auto finder = [&](const uint8_t kind, const uint8_t length, const uint8_t data[]) -> bool {
+        if ((kind == EIR_NAME_COMPLETE) || ((kind == EIR_NAME_SHORT) && (type == 0))) {
+            store = std::string(reinterpret_cast<const char*>(data), length);
+            type = kind;
+        }
+        return (type == EIR_NAME_COMPLETE);
+    };
+
+    if (Structures(_length, _data, finder) == false) {
+        Structures(_responseLength, _response, finder);
+    }
+    if (type != 0) {
+        name = Core::ToString(store.c_str());
+    }
+
+    return (type);
+}
+
+bool HCISocket::Advertisement::HasService(const UUID& service) const
+{
+    auto finder = [&](const uint8_t kind, const uint8_t length, const uint8_t data[]) -> bool {
+        bool result = false;
+        if ((service.HasShort() == true) && ((kind == EIR_UUID16_SOME) || (kind == EIR_UUID16_ALL))) {
+            for (uint8_t index = 0; (result == false) && ((index + 2) <= length); index += 2) {
+                result = (service == static_cast<uint16_t>((data[index + 1] << 8) | data[index]));
+            }
+        } else if ((service.HasShort() == false) && ((kind == EIR_UUID128_SOME) || (kind == EIR_UUID128_ALL))) {
+            for (uint8_t index = 0; (result == false) && ((index + 16) <= length); index += 16) {
+                result = (::memcmp(&(data[index]), service.Data(), 16) == 0);
+            }
+        }
+        return (result);
+    };
+
+    return ((Structures(_length, _data, finder) == true) || (Structures(_responseLength, _response, finder) == true));
+}
+
+bool HCISocket::Advertisement::HasManufacturer(const uint16_t company, const uint8_t length, const uint8_t data[]) const
+{
+    auto finder = [&](const uint8_t kind, const uint8_t size, const uint8_t value[]) -> bool {
+        return ((kind == EIR_MANUFACTURER_DATA) && (size >= (2 + length)) && (((value[1] << 8) | value[0]) == company) && ((length == 0) || (::memcmp(&(value[2]), data, length) == 0)));
+    };
+
+    return ((Structures(_length, _data, finder) == true) || (Structures(_responseLength, _response, finder) == true));
+}
+
+bool HCISocket::Advertisement::Update(const le_advertising_info& info)
+{
+    const uint8_t length = (info.length < MAX_DATA ? info.length : MAX_DATA);
+    const int8_t sample = Sample(info);
+    bool changed;
+
+    if (info.evt_type == SCAN_RESPONSE) {
+        changed = ((length != _responseLength) || (::memcmp(_response, info.data, length) != 0));
+        _responseLength = length;
+        ::memcpy(_response, info.data, length);
+    } else {
+        changed = ((info.evt_type != _type) || (length != _length) || (::memcmp(_data, info.data, length) != 0));
+        _type = info.evt_type;
+        _length = length;
+        ::memcpy(_data, info.data, length);
+    }
+
+    if (sample != 127) {
+        // Exponential moving average, a quarter of every new sample.
+        _rssi = (_rssi == NO_RSSI ? (sample * 16) : static_cast<int16_t>(_rssi + (((sample * 16) - _rssi) / 4)));
+    }
+
+    return (changed);
+}
+
+HCISocket::Advertisements::Advertisements()
+    : _adminLock()
+    , _entries()
+    , _services()
+    , _manufacturers()
+    , _timeToLive(TIME_TO_LIVE)
+    , _interval(INTERVAL)
+    , _threshold(THRESHOLD)
+{
+}
+
+HCISocket::Advertisements::~Advertisements()
+{
+}
+
+void HCISocket::Advertisements::Configure(const uint32_t timeToLive, const uint16_t interval, const uint8_t threshold)
+{
+    ASSERT(interval > 0);
+
+    _adminLock.Lock();
+    _timeToLive = timeToLive;
+    _interval = interval;
+    _threshold = threshold;
+    _adminLock.Unlock();
+}
+
+void HCISocket::Advertisements::Filter(const UUID& service)
+{
+    _adminLock.Lock();
+    _services.push_back(service);
+    for (auto& entry : _entries) {
+        entry.second._accepted = Accepted(entry.second);
+    }
+    _adminLock.Unlock();
+}
+
+void HCISocket::Advertisements::Filter(const uint16_t company, const uint8_t length, const uint8_t data[])
+{
+    ASSERT(length <= Advertisement::MAX_DATA);
+
+    Manufacturer entry;
+    entry.Company = company;
+    entry.Length = (length < Advertisement::MAX_DATA ? length : Advertisement::MAX_DATA);
+    if (entry.Length > 0) {
+        ::memcpy(entry.Data, data, entry.Length);
+    }
+
+    _adminLock.Lock();
+    _manufacturers.push_back(entry);
+    for (auto& element : _entries) {
+        element.second._accepted = Accepted(element.second);
+    }
+    _adminLock.Unlock();
+}
+
+void HCISocket::Advertisements::ResetFilters()
+{
+    _adminLock.Lock();
+    _services.clear();
+    _manufacturers.clear();
+    for (auto& entry : _entries) {
+        entry.second._accepted = true;
+    }
+    _adminLock.Unlock();
+}
+
+uint16_t HCISocket::Advertisements::Count() const
+{
+    _adminLock.Lock();
+    uint16_t result = static_cast<uint16_t>(_entries.size());
+    _adminLock.Unlock();
+
+    return (result);
+}
+
+void HCISocket::Advertisements::Clear()
+{
+    _adminLock.Lock();
+    _entries.clear();
+    _adminLock.Unlock();
+}
+
+bool HCISocket::Advertisements::Update(const le_advertising_info& info, const uint64_t now)
+{
+    const uint64_t key = Key(info);
+    bool result = false;
+
+    _adminLock.Lock();
+
+    std::unordered_map<uint64_t, Advertisement>::iterator index(_entries.find(key));
+    bool changed = (index == _entries.end());
+
+    if (changed == true) {
+        if (_entries.size() >= CAPACITY) {
+            // Make room by dropping the one not heard of the longest.
+            std::unordered_map<uint64_t, Advertisement>::iterator oldest(_entries.begin());
+            for (std::unordered_map<uint64_t, Advertisement>::iterator loop(_entries.begin()); loop != _entries.end(); ++loop) {
+                if (loop->second._seen < oldest->second._seen) {
+                    oldest = loop;
+                }
+            }
+            _entries.erase(oldest);
+        }
+        index = _entries.emplace(key, Advertisement(info)).first;
+    }
+
+    Advertisement& entry(index->second);
+
+    changed = (entry.Update(info) || changed);
+    entry._seen = now;
+
+    if (changed == true) {
+        entry._accepted = Accepted(entry);
+    }
+
+    if ((entry._accepted == true) && (entry._pending == false)) {
+        const int8_t rssi = entry.RSSI();
+        const uint8_t delta = static_cast<uint8_t>(rssi > entry._reported ? (rssi - entry._reported) : (entry._reported - rssi));
+
+        if ((changed == true) || ((rssi != 127) && (delta >= _threshold))) {
+            entry._pending = true;
+            result = true;
+        }
+    }
+
+    _adminLock.Unlock();
+
+    return (result);
+}
+
+void HCISocket::Advertisements::Collect(const uint64_t now, std::vector<Advertisement>& batch)
+{
+    _adminLock.Lock();
+
+    const uint64_t expired = static_cast<uint64_t>(_timeToLive) * Core::Time::TicksPerMillisecond;
+    std::unordered_map<uint64_t, Advertisement>::iterator index(_entries.begin());
+
+    while (index != _entries.end()) {
+        if ((now > index->second._seen) && ((now - index->second._seen) > expired)) {
+            index = _entries.erase(index);
+        } else {
+            if (index->second._pending == true) {
+                index->second._pending = false;
+                index->second._reported = index->second.RSSI();
+                batch.push_back(index->second);
+            }
+            ++index;
+        }
+    }
+
+    _adminLock.Unlock();
+}
+
+bool HCISocket::Advertisements::Accepted(const Advertisement& entry) const
+{
+    bool result = ((_services.empty() == true) && (_manufacturers.empty() == true));
+
+    std::list<UUID>::const_iterator service(_services.begin());
+    while ((result == false) && (service != _services.end())) {
+        result = entry.HasService(*service);
+        service++;
+    }
+
+    std::list<Manufacturer>::const_iterator manufacturer(_manufacturers.begin());
+    while ((result == false) && (manufacturer != _manufacturers.end())) {
+        result = entry.HasManufacturer(manufacturer->Company, manufacturer->Length, manufacturer->Data);
+        manufacturer++;
+    }
+
+    return (result);
+}
+
 uint32_t HCISocket::Advertising(const bool enable, const uint8_t mode)
 {
     uint32_t result = Core::ERROR_ILLEGAL_STATE;
@@ -151,16 +500,27 @@ void HCISocket::Scan(const uint16_t scanTime, const bool limited, const bool pas
             Command::ScanEnableLE scanner;
             scanner.Clear();
             scanner->enable = 1;
+
+            // Every scan starts from scratch, so whatever is around gets reported again.
+            _advertisements.Clear();
             scanner->filter_dup = SCAN_FILTER_DUPLICATES;
 
             if ((Exchange(MAX_ACTION_TIMEOUT, scanner, scanner) == Core::ERROR_NONE) && (scanner.Response() == 0)) {
 
                 _state.SetState(static_cast<state>(_state.GetState() | SCANNING));
 
-                // Now lets wait for the scanning period..
+                // Now lets wait for the scanning period, handing out what is seen every interval.
                 _state.Unlock();
 
-                _state.WaitState(ABORT, scanTime * 1000);
+                const Core::Time end(Core::Time::Now().Add(scanTime * 1000));
+                uint32_t remaining = scanTime * 1000;
+
+                while ((remaining > 0) && (_state.WaitState(ABORT, std::min(remaining, static_cast<uint32_t>(_advertisements.Interval()))) == false)) {
+                    Report();
+
+                    const Core::Time now(Core::Time::Now());
+                    remaining = (now < end ? static_cast<uint32_t>((end.Ticks() - now.Ticks()) / Core::Time::TicksPerMillisecond) : 0);
+                }
 
                 _state.Lock();
 
@@ -168,6 +528,8 @@ void HCISocket::Scan(const uint16_t scanTime, const bool limited, const bool pas
                 Exchange(MAX_ACTION_TIMEOUT, scanner, scanner);
 
                 _state.SetState(static_cast<state>(_state.GetState() & (~(ABORT | SCANNING))));
+
+                Report();
             }
         }
     }
@@ -202,7 +564,7 @@ void HCISocket::Abort()
 /* virtual */ void HCISocket::StateChange() 
 {
     Core::SynchronousChannelType<Core::SocketPort>::StateChange();
-    if (IsOpen() == true) {
+    if ((IsOpen() == true) && (LocalNode().Type() == Core::NodeId::TYPE_BLUETOOTH)) {
         hci_filter_clear(&_filter);
 	hci_filter_set_ptype(HCI_EVENT_PKT, &_filter);
         hci_filter_set_event(EVT_LE_META_EVENT, &_filter);
@@ -277,13 +639,26 @@ uint8_t HCISocket::Name(const le_advertising_info& info, string& name) const {
         }
         else {
             const uint8_t* segment = reinterpret_cast<const evt_le_meta_event*>(ptr)->data;
+            const uint8_t* last = &(dataFrame[result]);
+            const uint64_t now = Core::Time::Now().Ticks();
             uint8_t  entries = segment[0];
             segment++;
 
-            for (uint8_t loop = 0; loop < entries; loop++) {
+            // Each report is followed by its RSSI, do not trust the controller to stay within the event.
+            for (uint8_t loop = 0; (loop < entries) && ((segment + sizeof(le_advertising_info)) < last); loop++) {
                 const le_advertising_info* info = reinterpret_cast<const le_advertising_info*>(segment);
-                Update (*info);
-                segment = &(segment[info->length + sizeof(le_advertising_info)]);
+
+                if ((segment + sizeof(le_advertising_info) + info->length + 1) > last) {
+                    TRACE_L1(_T("EVT_HCI: Advertising report exceeds the event"));
+                    break;
+                }
+
+                if (_batched == true) {
+                    _advertisements.Update(*info, now);
+                } else {
+                    Update (*info);
+                }
+                segment = &(segment[info->length + sizeof(le_advertising_info) + 1]);
             }
         }
     }
@@ -306,6 +681,21 @@ uint8_t HCISocket::Name(const le_advertising_info& info, string& name) const {
 {
 }
 
+/* virtual */ void HCISocket::Discovered(const std::vector<Advertisement>&)
+{
+}
+
+void HCISocket::Report()
+{
+    std::vector<Advertisement> batch;
+
+    _advertisements.Collect(Core::Time::Now().Ticks(), batch);
+
+    if (batch.empty() == false) {
+        Discovered(batch);
+    }
+}
+
 // --------------------------------------------------------------------------------------------------
 // ManagementSocket !!!
 // --------------------------------------------------------------------------------------------------
@@ -20,6 +20,7 @@
 #pragma once
 
 #include "Module.h"
+#include "UUID.h"
 
 namespace WPEFramework {
 
@@ -802,6 +803,145 @@ namespace Bluetooth {
             ABORT       = 0x8000
         };
 
+        class Advertisements;
+
+        // The last state seen of an LE device while scanning. Advertising data and scan response data
+        // are kept apart, an active scan gets both from the same address and neither is a change.
+        class EXTERNAL Advertisement {
+        public:
+            static constexpr uint8_t MAX_DATA = 31;
+            static constexpr uint8_t SCAN_RESPONSE = 0x04;
+
+        public:
+            Advertisement();
+            Advertisement(const le_advertising_info& info);
+            Advertisement(const Advertisement& copy);
+            ~Advertisement();
+
+            Advertisement& operator=(const Advertisement& rhs);
+
+        public:
+            const Address& Source() const
+            {
+                return (_source);
+            }
+            uint8_t AddressType() const
+            {
+                return (_addressType);
+            }
+            // Event type of the last advertising report (not the scan response).
+            uint8_t Type() const
+            {
+                return (_type);
+            }
+            // Smoothed over the reports, 127 if the controller did not tell.
+            int8_t RSSI() const
+            {
+                return (_rssi == NO_RSSI ? 127 : static_cast<int8_t>(_rssi / 16));
+            }
+            uint8_t Length() const
+            {
+                return (_length);
+            }
+            const uint8_t* Data() const
+            {
+                return (_data);
+            }
+            uint8_t ResponseLength() const
+            {
+                return (_responseLength);
+            }
+            const uint8_t* ResponseData() const
+            {
+                return (_response);
+            }
+            uint8_t Name(string& name) const;
+            bool HasService(const UUID& service) const;
+            bool HasManufacturer(const uint16_t company, const uint8_t length, const uint8_t data[]) const;
+
+        private:
+            friend class Advertisements;
+
+            static constexpr int16_t NO_RSSI = 0x7FFF;
+
+            // True if the payload differs from what was kept.
+            bool Update(const le_advertising_info& info);
+            int8_t Sample(const le_advertising_info& info) const
+            {
+                return (static_cast<int8_t>(info.data[info.length]));
+            }
+
+        private:
+            Address _source;
+            uint8_t _addressType;
+            uint8_t _type;
+            int16_t _rssi; // in 1/16 dBm
+            int8_t _reported;
+            bool _accepted;
+            bool _pending;
+            uint8_t _length;
+            uint8_t _responseLength;
+            uint8_t _data[MAX_DATA];
+            uint8_t _response[MAX_DATA];
+            uint64_t _seen;
+        };
+
+        // Collapses the advertising reports of a scan per address. A device advertising every 20ms is
+        // reported when it is new, when its payload changes or its signal strength moves more than the
+        // threshold, and only if it passes the filters. Reports are handed out in batches and addresses
+        // not heard of for the time to live are forgotten.
+        class EXTERNAL Advertisements {
+        public:
+            static constexpr uint32_t TIME_TO_LIVE = 30000; // ms
+            static constexpr uint16_t INTERVAL = 500; // ms
+            static constexpr uint8_t THRESHOLD = 6; // dB
+            static constexpr uint16_t CAPACITY = 256;
+
+        private:
+            struct Manufacturer {
+                uint16_t Company;
+                uint8_t Length;
+                uint8_t Data[Advertisement::MAX_DATA];
+            };
+
+        public:
+            Advertisements(const Advertisements&) = delete;
+            Advertisements& operator=(const Advertisements&) = delete;
+
+            Advertisements();
+            ~Advertisements();
+
+        public:
+            void Configure(const uint32_t timeToLive, const uint16_t interval, const uint8_t threshold);
+            uint16_t Interval() const
+            {
+                return (_interval);
+            }
+            // Without filters everything is reported, otherwise a device has to match any of them.
+            void Filter(const UUID& service);
+            void Filter(const uint16_t company, const uint8_t length = 0, const uint8_t data[] = nullptr);
+            void ResetFilters();
+            uint16_t Count() const;
+            void Clear();
+
+            // Returns true if the report makes the address due for the next batch.
+            bool Update(const le_advertising_info& info, const uint64_t now);
+            // Moves what is due into the batch, and forgets what has expired.
+            void Collect(const uint64_t now, std::vector<Advertisement>& batch);
+
+        private:
+            bool Accepted(const Advertisement& entry) const;
+
+        private:
+            mutable Core::CriticalSection _adminLock;
+            std::unordered_map<uint64_t, Advertisement> _entries;
+            std::list<UUID> _services;
+            std::list<Manufacturer> _manufacturers;
+            uint32_t _timeToLive;
+            uint16_t _interval;
+            uint8_t _threshold;
+        };
+
     public:
         HCISocket(const HCISocket&) = delete;
         HCISocket& operator=(const HCISocket&) = delete;
@@ -809,11 +949,23 @@ namespace Bluetooth {
         HCISocket()
             : Core::SynchronousChannelType<Core::SocketPort>(SocketPort::RAW, Core::NodeId(), Core::NodeId(), 1024, 1024)
             , _state(IDLE)
+            , _advertisements()
+            , _batched(false)
         {
         }
         HCISocket(const Core::NodeId& sourceNode)
             : Core::SynchronousChannelType<Core::SocketPort>(SocketPort::RAW, sourceNode, Core::NodeId(), 1024, 1024)
             , _state(IDLE)
+            , _advertisements()
+            , _batched(false)
+        {
+        }
+        // Runs on a descriptor that is already open, e.g. a user channel or a replayed event stream.
+        HCISocket(const SOCKET& connector)
+            : Core::SynchronousChannelType<Core::SocketPort>(SocketPort::RAW, connector, Core::NodeId(), 1024, 1024)
+            , _state(IDLE)
+            , _advertisements()
+            , _batched(false)
         {
         }
         virtual ~HCISocket()
@@ -830,6 +982,20 @@ namespace Bluetooth {
         {
             return ((_state & ADVERTISING) != 0);
         }
+        Advertisements& Scanned()
+        {
+            return (_advertisements);
+        }
+        // Off by default: every advertising report goes to Update(le_advertising_info). Once on, the
+        // reports are collapsed in Scanned() and only handed out through Discovered(batch).
+        void Batched(const bool enabled)
+        {
+            _batched = enabled;
+        }
+        bool IsBatched() const
+        {
+            return (_batched);
+        }
         uint32_t Advertising(const bool enable, const uint8_t mode = 0);
         void Scan(const uint16_t scanTime, const uint32_t type, const uint8_t flags);
         void Scan(const uint16_t scanTime, const bool limited, const bool passive);
@@ -874,15 +1040,20 @@ namespace Bluetooth {
         virtual void Update(const le_advertising_info& eventData);
         virtual void Update(const hci_event_hdr& eventData);
         virtual void Discovered(const bool lowEnergy, const Bluetooth::Address& address, const string& name);
+        // A batch of LE devices that are new or changed, only called if Batched() is enabled.
+        virtual void Discovered(const std::vector<Advertisement>& batch);
 
     private:
         virtual void StateChange() override;
         virtual uint16_t Deserialize(const uint8_t* dataFrame, const uint16_t availableData) override;
         void SetOpcode(const uint16_t opcode);
+        void Report();
 
     private:
         Core::StateTrigger<state> _state;
         struct hci_filter _filter;
+        Advertisements _advertisements;
+        bool _batched;
     };
 
     class ManagementSocket : public Core::SynchronousChannelType<Core::SocketPort> {
@@ -93,6 +93,7 @@ ENUM_CONVERSION_BEGIN(Bluetooth::Profile::Service::Characteristic::type)
     { Bluetooth::Profile::Service::Characteristic::CyclingPowerMeasurement,                   _TXT("CyclingPowerMeasurement") },
     { Bluetooth::Profile::Service::Characteristic::CyclingPowerVector,                        _TXT("CyclingPowerVector") },
     { Bluetooth::Profile::Service::Characteristic::DatabaseChangeIncrement,                   _TXT("DatabaseChangeIncrement") },
+    { Bluetooth::Profile::Service::Characteristic::DatabaseHash,                              _TXT("DatabaseHash") },
     { Bluetooth::Profile::Service::Characteristic::DateofBirth,                               _TXT("DateofBirth") },
     { Bluetooth::Profile::Service::Characteristic::DateofThresholdAssessment,                 _TXT("DateofThresholdAssessment") },
     { Bluetooth::Profile::Service::Characteristic::DateTime,                                  _TXT("DateTime") },
@@ -322,5 +323,271 @@ ENUM_CONVERSION_BEGIN(Bluetooth::Profile::Service::type)
 
 ENUM_CONVERSION_END(Bluetooth::Profile::Service::type)
 
+namespace Bluetooth {
+
+namespace {
+
+    // Cache file layout (all little endian):
+    //   magic[4] version[1] custom[1] hash[16] services[2]
+    //   per service:        handle[2] group[2] uuid characteristics[2]
+    //   per characteristic: handle[2] end[2] rights[1] uuid descriptors[2]
+    //   per descriptor:     handle[2] uuid
+    // where a uuid is stored as length[1] data[length], the length being 2 or 16. Values are not
+    // part of it, the Database Hash does not cover them so they are always read from the remote.
+    const uint8_t CacheMagic[] = { 'G', 'A', 'T', 'T' };
+    constexpr uint8_t CacheVersion = 2;
+
+    class Writer {
+    public:
+        Writer(const Writer&) = delete;
+        Writer& operator=(const Writer&) = delete;
+
+        Writer(string& buffer)
+            : _buffer(buffer)
+        {
+        }
+        ~Writer()
+        {
+        }
+
+    public:
+        void Byte(const uint8_t value)
+        {
+            _buffer.push_back(static_cast<char>(value));
+        }
+        void Word(const uint16_t value)
+        {
+            Byte(value & 0xFF);
+            Byte((value >> 8) & 0xFF);
+        }
+        void Bytes(const uint16_t length, const uint8_t data[])
+        {
+            _buffer.append(reinterpret_cast<const char*>(data), length);
+        }
+        void Id(const UUID& id)
+        {
+            Byte(id.Length());
+            Bytes(id.Length(), id.Data());
+        }
+
+    private:
+        string& _buffer;
+    };
+
+    class Reader {
+    public:
+        Reader(const Reader&) = delete;
+        Reader& operator=(const Reader&) = delete;
+
+        Reader(const uint8_t data[], const uint32_t length)
+            : _data(data)
+            , _length(length)
+            , _offset(0)
+        {
+        }
+        ~Reader()
+        {
+        }
+
+    public:
+        // Once something did not fit, all that follows reads as zero and IsValid turns false.
+        bool IsValid() const
+        {
+            return (_offset <= _length);
+        }
+        bool IsComplete() const
+        {
+            return (_offset == _length);
+        }
+        uint8_t Byte()
+        {
+            uint8_t result = 0;
+            if (_offset < _length) {
+                result = _data[_offset];
+                _offset++;
+            } else {
+                _offset = _length + 1;
+            }
+            return (result);
+        }
+        uint16_t Word()
+        {
+            uint16_t result = Byte();
+            return (result | (Byte() << 8));
+        }
+        const uint8_t* Bytes(const uint16_t length)
+        {
+            const uint8_t* result = nullptr;
+            if ((_offset + length) <= _length) {
+                result = &(_data[_offset]);
+                _offset += length;
+            } else {
+                _offset = _length + 1;
+            }
+            return (result);
+        }
+        UUID Id()
+        {
+            UUID result;
+            const uint8_t length = Byte();
+            const uint8_t* data = Bytes(length);
+
+            if (data != nullptr) {
+                if (length == 2) {
+                    result = UUID(static_cast<uint16_t>(data[0] | (data[1] << 8)));
+                } else if (length == 16) {
+                    result = UUID(data);
+                }
+            }
+            if (result.IsValid() == false) {
+                _offset = _length + 1;
+            }
+            return (result);
+        }
+
+    private:
+        const uint8_t* _data;
+        uint32_t _length;
+        uint32_t _offset;
+    };
+}
+
+/* static */ string Profile::CacheName(const string& remote)
+{
+    string result(remote);
+
+    for (char& c : result) {
+        if (::isalnum(c) == 0) {
+            c = '_';
+        }
+    }
+
+    return (result + _T(".gatt"));
+}
+
+uint32_t Profile::Load(const string& fileName, const string& hash)
+{
+    uint32_t result = Core::ERROR_UNAVAILABLE;
+    Core::File file(fileName);
+
+    if (file.Open(true) == true) {
+        string buffer(static_cast<size_t>(file.Size()), '\0');
+
+        result = Core::ERROR_INVALID_SIGNATURE;
+
+        if (file.Read(reinterpret_cast<uint8_t*>(&buffer[0]), static_cast<uint32_t>(buffer.length())) == buffer.length()) {
+            Reader reader(reinterpret_cast<const uint8_t*>(buffer.c_str()), static_cast<uint32_t>(buffer.length()));
+            const uint8_t* magic = reader.Bytes(sizeof(CacheMagic));
+            const uint8_t version = reader.Byte();
+            const uint8_t custom = reader.Byte();
+            const uint8_t* stored = reader.Bytes(DATABASE_HASH_SIZE);
+
+            // A cache taken with a different vendor filter does not hold the same characteristics.
+            if ((magic != nullptr) && (::memcmp(magic, CacheMagic, sizeof(CacheMagic)) == 0) && (version == CacheVersion) && 
+                (custom == (_custom ? 1 : 0)) && (stored != nullptr) && (hash.length() == DATABASE_HASH_SIZE) && 
+                (::memcmp(stored, hash.c_str(), DATABASE_HASH_SIZE) == 0)) {
+
+                uint16_t services = reader.Word();
+
+                while ((services-- > 0) && (reader.IsValid() == true)) {
+                    const uint16_t handle = reader.Word();
+                    const uint16_t group = reader.Word();
+                    const UUID serviceId(reader.Id());
+
+                    _services.emplace_back(serviceId, handle, group);
+
+                    Service& service(_services.back());
+                    uint16_t characteristics = reader.Word();
+
+                    while ((characteristics-- > 0) && (reader.IsValid() == true)) {
+                        const uint16_t value = reader.Word();
+                        const uint16_t end = reader.Word();
+                        const uint8_t rights = reader.Byte();
+                        const UUID attribute(reader.Id());
+
+                        service._characteristics.emplace_back(end, rights, value, attribute);
+
+                        Service::Characteristic& characteristic(service._characteristics.back());
+                        uint16_t descriptors = reader.Word();
+
+                        while ((descriptors-- > 0) && (reader.IsValid() == true)) {
+                            const uint16_t descriptor = reader.Word();
+                            const UUID type(reader.Id());
+
+                            characteristic._descriptors.emplace_back(descriptor, type);
+                        }
+                    }
+                }
+
+                if (reader.IsComplete() == true) {
+                    result = Core::ERROR_NONE;
+                } else {
+                    TRACE_L1("GATT cache [%s] is corrupt, discovering again", fileName.c_str());
+                    _services.clear();
+                }
+            }
+        }
+    }
+
+    return (result);
+}
+
+uint32_t Profile::Save(const string& fileName, const string& hash) const
+{
+    uint32_t result = Core::ERROR_WRITE_ERROR;
+    string buffer;
+    Writer writer(buffer);
+
+    ASSERT(hash.length() == DATABASE_HASH_SIZE);
+
+    writer.Bytes(sizeof(CacheMagic), CacheMagic);
+    writer.Byte(CacheVersion);
+    writer.Byte(_custom ? 1 : 0);
+    writer.Bytes(DATABASE_HASH_SIZE, reinterpret_cast<const uint8_t*>(hash.c_str()));
+    writer.Word(static_cast<uint16_t>(_services.size()));
+
+    for (const Service& service : _services) {
+        writer.Word(service._handle);
+        writer.Word(service._group);
+        writer.Id(service._serviceId);
+        writer.Word(static_cast<uint16_t>(service._characteristics.size()));
+
+        for (const Service::Characteristic& characteristic : service._characteristics) {
+            writer.Word(characteristic._handle);
+            writer.Word(characteristic._end);
+            writer.Byte(characteristic._rights);
+            writer.Id(characteristic._type);
+            writer.Word(static_cast<uint16_t>(characteristic._descriptors.size()));
+
+            for (const Service::Characteristic::Descriptor& descriptor : characteristic._descriptors) {
+                writer.Word(descriptor.Handle());
+                writer.Id(descriptor.Type());
+            }
+        }
+    }
+
+    // Write it aside and move it in place, so a crash never leaves a half written cache behind.
+    Core::File file(fileName + _T(".new"));
+
+    if (file.Create(Core::File::USER_READ | Core::File::USER_WRITE) == true) {
+        if (file.Write(reinterpret_cast<const uint8_t*>(buffer.c_str()), static_cast<uint32_t>(buffer.length())) == buffer.length()) {
+            if (file.Move(fileName) == true) {
+                result = Core::ERROR_NONE;
+            }
+        }
+        if (result != Core::ERROR_NONE) {
+            file.Destroy();
+        }
+    }
+
+    if (result != Core::ERROR_NONE) {
+        TRACE_L1("Could not store the GATT cache [%s]", fileName.c_str());
+    }
+
+    return (result);
+}
+
+} // namespace Bluetooth
+
 } // namespace WPEFramework
 
@@ -30,6 +30,8 @@ namespace Bluetooth {
     private:
         static constexpr uint16_t PRIMARY_SERVICE_UUID = 0x2800;
         static constexpr uint16_t CHARACTERISTICS_UUID = 0x2803;
+        static constexpr uint16_t DATABASE_HASH_UUID = 0x2B2A;
+        static constexpr uint8_t DATABASE_HASH_SIZE = 16;
 
     public:
         class Service {
@@ -133,6 +135,7 @@ namespace Bluetooth {
                     CyclingPowerMeasurement                   = 0x2A63,
                     CyclingPowerVector                        = 0x2A64,
                     DatabaseChangeIncrement                   = 0x2A99,
+                    DatabaseHash                              = 0x2B2A,
                     DateofBirth                               = 0x2A85,
                     DateofThresholdAssessment                 = 0x2A86,
                     DateTime                                  = 0x2A08,
@@ -580,6 +583,13 @@ namespace Bluetooth {
         Profile& operator= (const Profile&) = delete;
 
         Profile(const bool includeVendorCharacteristics)
+            : Profile(includeVendorCharacteristics, string()) {
+        }
+        // If a storage directory is given, the discovered database is kept there per remote device. On
+        // the next Discover the Database Hash of the remote is read first and if it still matches, the
+        // services, characteristics and descriptors are loaded from the cache instead of walking the
+        // remote again. The values of the characteristics are read again, they may have changed since.
+        Profile(const bool includeVendorCharacteristics, const string& storage)
             : _adminLock()
             , _services()
             , _index()
@@ -587,7 +597,11 @@ namespace Bluetooth {
             , _socket(nullptr)
             , _command()
             , _handler()
-            , _expired(0) {
+            , _expired(0)
+            , _storage(storage.empty() || (storage[storage.length() - 1] == '/') ? storage : storage + '/')
+            , _cache()
+            , _hash()
+            , _cached(false) {
         }
         ~Profile() {
         }
@@ -603,8 +617,18 @@ namespace Bluetooth {
                 _expired = Core::Time::Now().Add(waitTime).Ticks();
                 _handler = handler;
                 _services.clear();
-                _command.ReadByGroupType(0x0001, 0xFFFF, UUID(PRIMARY_SERVICE_UUID));
-                _socket->Execute(waitTime, _command, [&](const GATTSocket::Command& cmd) { OnServices(cmd); });
+                _hash.clear();
+                _cached = false;
+
+                if (_storage.empty() == true) {
+                    _command.ReadByGroupType(0x0001, 0xFFFF, UUID(PRIMARY_SERVICE_UUID));
+                    _socket->Execute(waitTime, _command, [&](const GATTSocket::Command& cmd) { OnServices(cmd); });
+                }
+                else {
+                    _cache = _storage + CacheName(socket.RemoteId());
+                    _command.ReadByType(0x0001, 0xFFFF, UUID(DATABASE_HASH_UUID));
+                    _socket->Execute(waitTime, _command, [&](const GATTSocket::Command& cmd) { OnHash(cmd); });
+                }
             }
             _adminLock.Unlock();
 
@@ -616,6 +640,35 @@ namespace Bluetooth {
         bool IsValid() const {
             return ((_services.size() > 0) && (_expired == Core::ERROR_NONE));
         }
+        // True if the layout of the last Discover was served from the cache.
+        bool IsCached() const {
+            return (_cached);
+        }
+        // Pass the handles of the notifications/indications received on the GATTSocket. Returns true
+        // for a Service Changed indication: the remote database was modified, the cached copy is
+        // dropped and the services should be discovered again.
+        bool Changed(const uint16_t handle) {
+            bool result = false;
+
+            _adminLock.Lock();
+
+            const Service* service = operator[](UUID(Service::GenericAttribute));
+
+            if (service != nullptr) {
+                const Service::Characteristic* characteristic = (*service)[UUID(Service::Characteristic::ServiceChanged)];
+
+                if ((characteristic != nullptr) && (characteristic->Handle() == handle)) {
+                    result = true;
+                    if (_cache.empty() == false) {
+                        Core::File(_cache).Destroy();
+                    }
+                }
+            }
+
+            _adminLock.Unlock();
+
+            return (result);
+        }
         Iterator Services() const {
             return (Iterator(_services));
         }
@@ -658,7 +711,8 @@ namespace Bluetooth {
             _adminLock.Lock();
 
             if (_socket != nullptr) {
-                if ((begin + 1) < end){
+                // The descriptors of a cached characteristic are known already, only its value is read.
+                if ((_cached == false) && ((begin + 1) < end)) {
                     _command.FindInformation(begin+1, end);
                     _socket->Execute(waitTime, _command, [&](const GATTSocket::Command& cmd) { OnDescriptors(cmd); });
                 }
@@ -669,6 +723,43 @@ namespace Bluetooth {
             }
             _adminLock.Unlock();
         }
+        void OnHash(const GATTSocket::Command& cmd) {
+            ASSERT (&cmd == &_command);
+
+            uint32_t waitTime = AvailableTime();
+
+            if (waitTime > 0) {
+                GATTSocket::Command::Response& response(_command.Result());
+
+                // A remote without a Database Hash can not be validated, so it is never cached.
+                if ((cmd.Error() == Core::ERROR_NONE) && (response.Next() == true) && (response.Length() == DATABASE_HASH_SIZE)) {
+                    _hash = string(reinterpret_cast<const char*>(response.Data()), DATABASE_HASH_SIZE);
+                }
+
+                if ((_hash.empty() == false) && (Load(_cache, _hash) == Core::ERROR_NONE) && (_services.empty() == false)) {
+                    _cached = true;
+                    _index = _services.begin();
+                    _characteristics = _index->Filler();
+
+                    if (NextCharacteristic() == false) {
+                        Report(Core::ERROR_NONE);
+                    }
+                    else {
+                        LoadCharacteristics(waitTime);
+                    }
+                }
+                else {
+                    _services.clear();
+
+                    _adminLock.Lock();
+                    if (_socket != nullptr) {
+                        _command.ReadByGroupType(0x0001, 0xFFFF, UUID(PRIMARY_SERVICE_UUID));
+                        _socket->Execute(waitTime, _command, [&](const GATTSocket::Command& cmd) { OnServices(cmd); });
+                    }
+                    _adminLock.Unlock();
+                }
+            }
+        }
         void OnServices(const GATTSocket::Command& cmd) {
             ASSERT (&cmd == &_command);
 
@@ -812,6 +903,10 @@ namespace Bluetooth {
                 _handler = nullptr;
                 _expired = result;
 
+                if ((result == Core::ERROR_NONE) && (_cached == false) && (_hash.empty() == false)) {
+                    Save(_cache, _hash);
+                }
+
                 caller(result);
             }
             _adminLock.Unlock();
@@ -826,6 +921,10 @@ namespace Bluetooth {
             return (result);
         }
 
+        static string CacheName(const string& remote);
+        uint32_t Load(const string& fileName, const string& hash);
+        uint32_t Save(const string& fileName, const string& hash) const;
+
     private:
         Core::CriticalSection _adminLock;
         std::list<Service> _services;
@@ -836,6 +935,10 @@ namespace Bluetooth {
         GATTSocket::Command _command;
         Handler _handler;
         uint64_t _expired;
+        const string _storage;
+        string _cache;
+        string _hash;
+        bool _cached;
     };
 
 } // namespace Bluetooth
@@ -203,18 +203,21 @@ namespace RPC {
             : _message()
             , _channel()
             , _handler(nullptr)
+            , _submitted(0)
         {
         }
         Job(Core::IPCChannel& channel, const Core::ProxyType<Core::IIPC>& message, Core::IIPCServer* handler)
             : _message(message)
             , _channel(channel)
             , _handler(handler)
+            , _submitted(Core::Time::Now().Ticks())
         {
         }
         Job(const Job& copy)
             : _message(copy._message)
             , _channel(copy._channel)
             , _handler(copy._handler)
+            , _submitted(copy._submitted)
         {
         }
         virtual ~Job()
@@ -225,6 +228,7 @@ namespace RPC {
             _message = rhs._message;
             _channel = rhs._channel;
             _handler = rhs._handler;
+            _submitted = rhs._submitted;
 
             return (*this);
         }
@@ -245,11 +249,12 @@ namespace RPC {
             _message = message;
             _channel = Core::ProxyType<Core::IPCChannel>(channel);
             _handler = handler;
+            _submitted = Core::Time::Now().Ticks();
         }
         virtual void Dispatch() override
         {
             if (_message->Label() == InvokeMessage::Id()) {
-                Invoke(_channel, _message);
+                Invoke(_channel, _message, _submitted);
             } else {
                 ASSERT(_message->Label() == AnnounceMessage::Id());
                 ASSERT(_handler != nullptr);
@@ -258,19 +263,38 @@ namespace RPC {
             }
         }
 
-		static void Invoke(Core::ProxyType<Core::IPCChannel>& channel, Core::ProxyType<Core::IIPC>& data)
+        // If the invoke was queued, submitted holds the time (Core::Time ticks) it was handed to the pool.
+		static void Invoke(Core::ProxyType<Core::IPCChannel>& channel, Core::ProxyType<Core::IIPC>& data, const uint64_t submitted = 0)
 		{
             Core::ProxyType<InvokeMessage> message(data);
             ASSERT(message.IsValid() == true);
+
+            const uint32_t interfaceId(message->Parameters().InterfaceId());
+            const uint32_t methodId(message->Parameters().MethodId());
+            const uint64_t started(Core::Time::Now().Ticks());
+
             _administrator.Invoke(channel, message);
+
+            const uint64_t executed(Core::Time::Now().Ticks());
+
             channel->ReportResponse(data);
 
+            Core::LatencyStatistics::Metric* metric(Core::LatencyStatistics::Instance().Find(_T("COM-RPC"), interfaceId, methodId));
+
+            if (metric != nullptr) {
+                if (submitted != 0) {
+                    metric->Queue.Record(submitted, started);
+                }
+                metric->Execution.Record(started, executed);
+                metric->Serialization.Record(executed, Core::Time::Now().Ticks());
+            }
 		}
 
     private:
         Core::ProxyType<Core::IIPC> _message;
         Core::ProxyType<Core::IPCChannel> _channel;
         Core::IIPCServer* _handler;
+        uint64_t _submitted;
 
         static Core::ProxyPoolType<Job> _factory;
         static Administrator& _administrator;
@@ -496,6 +496,11 @@ namespace RPC {
                 // Also load the ProxyStubs before we do anything else
                 RPC::LoadProxyStubs(proxyStubPath);
             }
+
+            string shortcut(announceMessage->Response().Shortcut());
+            if ((shortcut.empty() == false) && (BaseClass::OpenShortcut(shortcut) != Core::ERROR_NONE)) {
+                TRACE_L1("Could not open the shortcut %s, staying on the socket", shortcut.c_str());
+            }
         }
 
         // Set event so WaitForCompletion() can continue.
@@ -677,12 +677,154 @@ namespace RPC {
             RemoteConnectionMap(const RemoteConnectionMap&) = delete;
             RemoteConnectionMap& operator=(const RemoteConnectionMap&) = delete;
 
+#ifndef __WINDOWS__
+            // Watches the hosts launched by us through the kernel process connector, so their exit
+            // is handled right away, even if a descendant inherited (and keeps open) the channel.
+            class EXTERNAL ProcessMonitor : public Core::ProcessObserver::INotification {
+            private:
+                ProcessMonitor() = delete;
+                ProcessMonitor(const ProcessMonitor&) = delete;
+                ProcessMonitor& operator=(const ProcessMonitor&) = delete;
+
+                enum state {
+                    IDLE,
+                    OPENING,
+                    OPENED,
+                    UNAVAILABLE
+                };
+
+            public:
+                ProcessMonitor(RemoteConnectionMap& parent)
+                    : _adminLock()
+                    , _parent(parent)
+                    , _processes()
+                    , _observer(this)
+                    , _state(IDLE)
+                {
+                }
+                ~ProcessMonitor() override
+                {
+                    _observer.Close(Core::infinite);
+                }
+
+            public:
+                void Watch(const uint32_t pid, const uint32_t id)
+                {
+                    _adminLock.Lock();
+
+                    bool open = (_state == IDLE);
+
+                    if (open == true) {
+                        _state = OPENING;
+                    }
+
+                    _adminLock.Unlock();
+
+                    // The connector is only opened if we really launch something, a plain RPC server
+                    // has no interest in the process events of the system.
+                    if (open == true) {
+                        uint32_t result = _observer.Open(MaxOpenTime);
+
+                        if (result != Core::ERROR_NONE) {
+                            TRACE_L1("Process connector not available [%d], relying on the channel state only.", result);
+                        }
+
+                        _adminLock.Lock();
+                        _state = (result == Core::ERROR_NONE ? OPENED : UNAVAILABLE);
+                        _adminLock.Unlock();
+                    }
+
+                    _adminLock.Lock();
+
+                    if (_state == OPENED) {
+                        _processes[pid] = id;
+                        _observer.Watch(pid);
+                    }
+
+                    _adminLock.Unlock();
+
+                    // A host that died before it was watched is never reported, do not wait for it.
+                    if (IsAlive(pid) == false) {
+                        _adminLock.Lock();
+
+                        std::map<uint32_t, uint32_t>::iterator index(_processes.find(pid));
+                        bool report = ((index != _processes.end()) || (_state != OPENED));
+
+                        if (index != _processes.end()) {
+                            _observer.Unwatch(pid);
+                            _processes.erase(index);
+                        }
+
+                        _adminLock.Unlock();
+
+                        if (report == true) {
+                            TRACE_L1("Process %d of connection %d exited before it was watched.", pid, id);
+                            _parent.Exited(id);
+                        }
+                    }
+                }
+
+            private:
+                static bool IsAlive(const uint32_t pid)
+                {
+                    siginfo_t info;
+                    ::memset(&info, 0, sizeof(info));
+
+                    // Our own children stay around as zombies until reaped, so ask if they exited
+                    // (without reaping them). Anything else, e.g. a container host, just has to exist.
+                    if (::waitid(P_PID, pid, &info, WEXITED | WNOHANG | WNOWAIT) == 0) {
+                        return (info.si_pid == 0);
+                    }
+
+                    return (::kill(pid, 0) == 0);
+                }
+                void Forked(const uint32_t, const uint32_t) override
+                {
+                }
+                void Executed(const uint32_t) override
+                {
+                }
+                void Exited(const uint32_t pid, const uint32_t exitCode) override
+                {
+                    _adminLock.Lock();
+
+                    std::map<uint32_t, uint32_t>::iterator index(_processes.find(pid));
+                    bool found = (index != _processes.end());
+                    uint32_t id = (found == true ? index->second : 0);
+
+                    if (found == true) {
+                        _observer.Unwatch(pid);
+                        _processes.erase(index);
+                    }
+
+                    _adminLock.Unlock();
+
+                    if (found == true) {
+                        TRACE_L1("Process %d of connection %d exited with code %d.", pid, id, exitCode);
+                        _parent.Exited(id);
+                    }
+                }
+
+            private:
+                static constexpr uint32_t MaxOpenTime = 1000;
+
+                Core::CriticalSection _adminLock;
+                RemoteConnectionMap& _parent;
+                std::map<uint32_t, uint32_t> _processes;
+                Core::ProcessObserver _observer;
+                state _state;
+            };
+#endif
+
         public:
             RemoteConnectionMap(Communicator& parent)
                 : _adminLock()
                 , _announcements()
                 , _connections()
                 , _parent(parent)
+#ifndef __WINDOWS__
+                , _processMonitor(*this)
+#endif
             {
             }
             virtual ~RemoteConnectionMap()
@@ -776,10 +918,14 @@ namespace RPC {
                     _adminLock.Unlock();
 
                     // Start the process, and....
-                    result->Launch();
+                    if ((result->Launch() == Core::ERROR_NONE) && (result->RemoteId() != 0)) {
+#ifndef __WINDOWS__
+                        _processMonitor.Watch(result->RemoteId(), result->Id());
+#endif
+                    }
 
-                    // wait for the announce message to be exchanged
-                    if (trigger.Lock(waitTime) == Core::ERROR_NONE) {
+                    // wait for the announce message to be exchanged, or the process to die before it did.
+                    if ((trigger.Lock(waitTime) == Core::ERROR_NONE) && (result->IsOperational() == true)) {
 
                         uint32_t interfaceId = instance.Interface();
 
@@ -920,6 +1066,26 @@ namespace RPC {
             }
 
         private:
+            void Exited(const uint32_t id)
+            {
+                _adminLock.Lock();
+
+                std::map<uint32_t, std::pair<Core::Event&, void*>>::iterator pending(_announcements.find(id));
+
+                if (pending != _announcements.end()) {
+                    // Never going to announce itself anymore, no need to wait for the timeout.
+                    pending->second.first.SetEvent();
+                }
+
+                std::map<uint32_t, RemoteConnection*>::iterator index(_connections.find(id));
+
+                if ((index != _connections.end()) && (index->second->IsOperational() == true)) {
+                    // Closing the channel triggers the regular Closed() handling.
+                    index->second->Close();
+                }
+
+                _adminLock.Unlock();
+            }
             void Activated(RPC::IRemoteConnection* connection)
             {
                 std::list<RPC::IRemoteConnection::INotification*>::iterator index(_observers.begin());
@@ -1006,6 +1172,9 @@ namespace RPC {
             std::map<uint32_t, RemoteConnection*> _connections;
             std::list<RPC::IRemoteConnection::INotification*> _observers;
             Communicator& _parent;
+#ifndef __WINDOWS__
+            ProcessMonitor _processMonitor;
+#endif
         };
 
     protected:
@@ -1097,8 +1266,9 @@ namespace RPC {
                     // Anounce the interface as completed
                     string jsonDefaultCategories(Trace::TraceUnit::Instance().Defaults());
                     void* result = _parent.Announce(proxyChannel, message->Parameters());
+                    string shortcut(_parent.Shortcut(proxyChannel));
 
-                    message->Response().Set(result, proxyChannel->Extension().Id(), _parent.ProxyStubPath(), jsonDefaultCategories);
+                    message->Response().Set(result, proxyChannel->Extension().Id(), _parent.ProxyStubPath(), jsonDefaultCategories, shortcut);
 
                     // We are done, report completion
                     channel.ReportResponse(data);
@@ -1140,6 +1310,8 @@ namespace RPC {
                 , _proxyStubPath(proxyStubPath)
                 , _connections(processes)
                 , _announceHandler(this)
+                , _shortcutSize(0)
+                , _shortcutSequence(0)
             {
                 BaseClass::Register(InvokeMessage::Id(), Core::ProxyType<Core::IIPCServer>(Core::ProxyType<InvokeHandlerImplementation>::Create()));
                 BaseClass::Register(AnnounceMessage::Id(), Core::ProxyType<Core::IIPCServer>(Core::ProxyType<AnnounceHandlerImplementation>::Create(this)));
@@ -1153,6 +1325,8 @@ namespace RPC {
                 , _proxyStubPath(proxyStubPath)
                 , _connections(processes)
                 , _announceHandler(this)
+                , _shortcutSize(0)
+                , _shortcutSequence(0)
             {
                 BaseClass::Register(InvokeMessage::Id(), handler);
                 BaseClass::Register(AnnounceMessage::Id(), handler);
@@ -1176,6 +1350,10 @@ namespace RPC {
             {
                 return (&_announceHandler);
             }
+            inline void Shortcut(const uint32_t size)
+            {
+                _shortcutSize = size;
+            }
 
         private:
             inline void* Announce(Core::ProxyType<Client>& channel, const Data::Init& info)
@@ -1183,11 +1361,29 @@ namespace RPC {
                 // We are in business, register the process with this channel.
                 return (_connections.Announce(channel, info));
             }
+            // Offer the rings on the first announce of a local (domain socket) client. If the client
+            // does not know about them, or can not open them, the channel just stays on the socket.
+            string Shortcut(Core::ProxyType<Client>& channel)
+            {
+                string result;
+
+                if ((_shortcutSize != 0) && (channel->Source().LocalNode().Type() == Core::NodeId::TYPE_DOMAIN)) {
+                    const string name(BaseClass::Connector() + '.' + Core::NumberType<uint32_t>(_shortcutSequence++).Text());
+
+                    if (channel->CreateShortcut(name, _shortcutSize) == Core::ERROR_NONE) {
+                        result = name;
+                    }
+                }
+
+                return (result);
+            }
 
         private:
             const string _proxyStubPath;
             RemoteConnectionMap& _connections;
             AnnounceHandlerImplementation _announceHandler;
+            uint32_t _shortcutSize;
+            std::atomic<uint32_t> _shortcutSequence;
         };
 
     private:
@@ -1210,6 +1406,12 @@ namespace RPC {
         {
             return (_ipcServer.Announcement());
         }
+        // Let local clients exchange frames over a pair of shared memory rings of the given size,
+        // instead of over the socket. 0 (the default) turns it off for new connections.
+        inline void Shortcut(const uint32_t ringSize)
+        {
+            _ipcServer.Shortcut(ringSize);
+        }
         inline bool IsListening() const
         {
             return (_ipcServer.IsListening());
@@ -339,12 +339,13 @@ namespace RPC {
             {
                 _data.Clear();
             }
-            void Set(void* implementation, const uint32_t sequenceNumber, const string& proxyStubPath, const string& traceCategories)
+            void Set(void* implementation, const uint32_t sequenceNumber, const string& proxyStubPath, const string& traceCategories, const string& shortcut)
             {
                 _data.SetNumber<void*>(0, implementation);
                 _data.SetNumber<uint32_t>(sizeof(void*), sequenceNumber);
                 uint16_t length = _data.SetText(sizeof(void*) + sizeof(uint32_t), proxyStubPath);
-                _data.SetText(sizeof(void*)+ sizeof(uint32_t) + length, traceCategories);
+                length += _data.SetText(sizeof(void*)+ sizeof(uint32_t) + length, traceCategories);
+                _data.SetText(sizeof(void*) + sizeof(uint32_t) + length, shortcut);
             }
             inline bool IsSet() const {
                 return (_data.Size() > 0);
@@ -376,6 +377,24 @@ namespace RPC {
 
                 return (value);
             }
+            // Base name of the shared memory rings the server created for this channel, if any.
+            string Shortcut() const
+            {
+                string value;
+
+                uint16_t length = sizeof(void*) + sizeof(uint32_t);
+                length += _data.GetText(length, value); // skip proxyStub path
+                length += _data.GetText(length, value); // skip trace categories
+
+                // Older servers do not send it.
+                if ((length + sizeof(uint16_t)) <= _data.Size()) {
+                    _data.GetText(length, value);
+                } else {
+                    value.clear();
+                }
+
+                return (value);
+            }
             void* Implementation() const
             {
                 void* result = nullptr;
@@ -0,0 +1,139 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2020 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "Histogram.h"
+
+#include <thread>
+
+namespace WPEFramework {
+namespace Core {
+
+    namespace {
+
+        // FNV-1a, a key of 0 marks an empty slot so it is never handed out.
+        constexpr uint64_t OffsetBasis = 0xCBF29CE484222325ULL;
+        constexpr uint64_t Prime = 0x100000001B3ULL;
+
+        inline uint64_t Hash(uint64_t hash, const uint8_t data[], const uint32_t length)
+        {
+            for (uint32_t index = 0; index < length; index++) {
+                hash = (hash ^ data[index]) * Prime;
+            }
+            return (hash);
+        }
+        inline uint64_t Hash(uint64_t hash, const string& text)
+        {
+            // Include the terminator, so "ab" + "c" and "a" + "bc" differ.
+            return (Hash(hash, reinterpret_cast<const uint8_t*>(text.c_str()), static_cast<uint32_t>((text.length() + 1) * sizeof(TCHAR))));
+        }
+        inline uint64_t Hash(uint64_t hash, const uint32_t value)
+        {
+            return (Hash(hash, reinterpret_cast<const uint8_t*>(&value), sizeof(value)));
+        }
+        inline uint64_t Key(const uint64_t hash)
+        {
+            return (hash == 0 ? 1 : hash);
+        }
+    }
+
+    LatencyStatistics::LatencyStatistics()
+    {
+        for (uint16_t index = 0; index < Slots; index++) {
+            _keys[index].store(0, std::memory_order_relaxed);
+            _entries[index].store(nullptr, std::memory_order_relaxed);
+        }
+    }
+
+    LatencyStatistics::~LatencyStatistics()
+    {
+        for (uint16_t index = 0; index < Slots; index++) {
+            delete _entries[index].load(std::memory_order_relaxed);
+        }
+    }
+
+    /* static */ LatencyStatistics& LatencyStatistics::Instance()
+    {
+        static LatencyStatistics singleton;
+
+        return (singleton);
+    }
+
+    LatencyStatistics::Metric* LatencyStatistics::Find(const string& category, const string& name)
+    {
+        return (Find(Key(Hash(Hash(OffsetBasis, category), name)), category, name, 0, 0));
+    }
+
+    LatencyStatistics::Metric* LatencyStatistics::Find(const string& category, const uint32_t id, const uint32_t method)
+    {
+        // The name is only formatted when the metric gets created, not on every call.
+        return (Find(Key(Hash(Hash(Hash(OffsetBasis, category), id), method)), category, EMPTY_STRING, id, method));
+    }
+
+    void LatencyStatistics::Reset()
+    {
+        for (uint16_t index = 0; index < Slots; index++) {
+            Metric* entry = _entries[index].load(std::memory_order_acquire);
+
+            if (entry != nullptr) {
+                entry->Queue.Reset();
+                entry->Execution.Reset();
+                entry->Serialization.Reset();
+            }
+        }
+    }
+
+    LatencyStatistics::Metric* LatencyStatistics::Find(const uint64_t key, const string& category, const string& name, const uint32_t id, const uint32_t method)
+    {
+        Metric* result = nullptr;
+        uint16_t index = static_cast<uint16_t>(key % Slots);
+        uint16_t probes = 0;
+
+        while ((result == nullptr) && (probes < Slots)) {
+            uint64_t current = _keys[index].load(std::memory_order_acquire);
+
+            if (current == 0) {
+                if (_keys[index].compare_exchange_strong(current, key, std::memory_order_acq_rel) == true) {
+                    if (name.empty() == false) {
+                        result = new Metric(category, name);
+                    } else {
+                        TCHAR text[32];
+                        ::snprintf(text, sizeof(text), _T("0x%08X.%u"), id, method);
+                        result = new Metric(category, text);
+                    }
+                    _entries[index].store(result, std::memory_order_release);
+                    current = key;
+                }
+            }
+
+            if (current == key) {
+                // Someone else might just have claimed the slot, the metric follows shortly.
+                while ((result = _entries[index].load(std::memory_order_acquire)) == nullptr) {
+                    std::this_thread::yield();
+                }
+            } else {
+                index = (index + 1) % Slots;
+                probes++;
+            }
+        }
+
+        return (result);
+    }
+
+} // namespace Core
+} // namespace WPEFramework
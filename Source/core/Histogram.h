@@ -0,0 +1,247 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2020 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "Module.h"
+#include "Portability.h"
+#include "Trace.h"
+
+#include <atomic>
+
+namespace WPEFramework {
+namespace Core {
+
+    // Lock free latency histogram with log-linear (HDR style) buckets. Every power of two is split
+    // in 8 linear sub buckets, so a reported value is at most 12.5% off, from 1us up to 2^37us (~38 hours).
+    // Recording is a handful of relaxed atomic operations, so it can be left on in production.
+    class EXTERNAL LatencyHistogram {
+    private:
+        static constexpr uint8_t SubBits = 3;
+        static constexpr uint8_t SubBuckets = (1 << SubBits);
+        static constexpr uint8_t Magnitudes = 36;
+
+    public:
+        static constexpr uint16_t Buckets = (Magnitudes - SubBits + 1) * SubBuckets;
+
+    public:
+        LatencyHistogram(const LatencyHistogram&) = delete;
+        LatencyHistogram& operator=(const LatencyHistogram&) = delete;
+
+        LatencyHistogram()
+            : _count(0)
+            , _sum(0)
+            , _max(0)
+        {
+            for (uint16_t index = 0; index < Buckets; index++) {
+                _buckets[index].store(0, std::memory_order_relaxed);
+            }
+        }
+        ~LatencyHistogram()
+        {
+        }
+
+    public:
+        // Value in microseconds.
+        void Record(const uint64_t value)
+        {
+            _buckets[Bucket(value)].fetch_add(1, std::memory_order_relaxed);
+            _count.fetch_add(1, std::memory_order_relaxed);
+            _sum.fetch_add(value, std::memory_order_relaxed);
+
+            uint64_t current = _max.load(std::memory_order_relaxed);
+            while ((value > current) && (_max.compare_exchange_weak(current, value, std::memory_order_relaxed) == false)) {
+            }
+        }
+        // Interval between two Core::Time ticks, the wall clock might have been set back in between.
+        inline void Record(const uint64_t start, const uint64_t end)
+        {
+            Record(end > start ? end - start : 0);
+        }
+        void Reset()
+        {
+            for (uint16_t index = 0; index < Buckets; index++) {
+                _buckets[index].store(0, std::memory_order_relaxed);
+            }
+            _count.store(0, std::memory_order_relaxed);
+            _sum.store(0, std::memory_order_relaxed);
+            _max.store(0, std::memory_order_relaxed);
+        }
+        inline uint32_t Count() const
+        {
+            return (_count.load(std::memory_order_relaxed));
+        }
+        inline uint64_t Sum() const
+        {
+            return (_sum.load(std::memory_order_relaxed));
+        }
+        inline uint64_t Max() const
+        {
+            return (_max.load(std::memory_order_relaxed));
+        }
+        inline uint64_t Average() const
+        {
+            const uint32_t count = Count();
+            return (count == 0 ? 0 : (Sum() / count));
+        }
+        inline uint32_t Occurrences(const uint16_t bucket) const
+        {
+            ASSERT(bucket < Buckets);
+            return (_buckets[bucket].load(std::memory_order_relaxed));
+        }
+        // Upper bound of the bucket holding the given percentile (0-100), never more than the maximum seen.
+        uint64_t Percentile(const uint8_t percentage) const
+        {
+            const uint32_t count = Count();
+            uint64_t result = 0;
+
+            if (count > 0) {
+                const uint32_t threshold = static_cast<uint32_t>(((static_cast<uint64_t>(count) * percentage) + 99) / 100);
+                uint32_t seen = 0;
+                uint16_t index = 0;
+
+                while ((index < (Buckets - 1)) && ((seen += Occurrences(index)) < threshold)) {
+                    index++;
+                }
+
+                result = std::min(UpperBound(index), Max());
+            }
+
+            return (result);
+        }
+
+        static uint16_t Bucket(const uint64_t value)
+        {
+            uint16_t result;
+
+            if (value < SubBuckets) {
+                result = static_cast<uint16_t>(value);
+            } else {
+#ifdef __GNUC__
+                const uint8_t magnitude = static_cast<uint8_t>(63 - __builtin_clzll(value));
+#else
+                uint8_t magnitude = SubBits;
+                while ((value >> (magnitude + 1)) != 0) {
+                    magnitude++;
+                }
+#endif
+                const uint8_t shift = magnitude - SubBits;
+
+                result = static_cast<uint16_t>(((shift + 1) * SubBuckets) + ((value >> shift) & (SubBuckets - 1)));
+
+                if (result >= Buckets) {
+                    result = Buckets - 1;
+                }
+            }
+
+            return (result);
+        }
+        static uint64_t UpperBound(const uint16_t bucket)
+        {
+            uint64_t result;
+
+            if (bucket < SubBuckets) {
+                result = bucket;
+            } else {
+                const uint8_t shift = (bucket / SubBuckets) - 1;
+
+                result = ((static_cast<uint64_t>(SubBuckets + (bucket % SubBuckets)) + 1) << shift) - 1;
+            }
+
+            return (result);
+        }
+
+    private:
+        std::atomic<uint32_t> _buckets[Buckets];
+        std::atomic<uint32_t> _count;
+        std::atomic<uint64_t> _sum;
+        std::atomic<uint64_t> _max;
+    };
+
+    // Process wide collection of call latencies, e.g. per COM-RPC interface/method or per JSON-RPC
+    // designator. Lookups and recording never take a lock: the metrics live in a fixed size open
+    // addressed table, a slot is claimed with a compare-and-swap on first use and never released.
+    class EXTERNAL LatencyStatistics {
+    public:
+        class EXTERNAL Metric {
+        public:
+            Metric() = delete;
+            Metric(const Metric&) = delete;
+            Metric& operator=(const Metric&) = delete;
+
+            Metric(const string& category, const string& name)
+                : Category(category)
+                , Name(name)
+                , Queue()
+                , Execution()
+                , Serialization()
+            {
+            }
+            ~Metric()
+            {
+            }
+
+        public:
+            const string Category;
+            const string Name;
+            LatencyHistogram Queue;
+            LatencyHistogram Execution;
+            LatencyHistogram Serialization;
+        };
+
+    private:
+        static constexpr uint16_t Slots = 1024;
+
+    public:
+        LatencyStatistics(const LatencyStatistics&) = delete;
+        LatencyStatistics& operator=(const LatencyStatistics&) = delete;
+
+        LatencyStatistics();
+        ~LatencyStatistics();
+
+        static LatencyStatistics& Instance();
+
+    public:
+        // Returns nullptr if the table is full, the call then simply goes unmeasured.
+        Metric* Find(const string& category, const string& name);
+        Metric* Find(const string& category, const uint32_t id, const uint32_t method);
+
+        template <typename ACTION>
+        void Visit(ACTION&& action) const
+        {
+            for (uint16_t index = 0; index < Slots; index++) {
+                const Metric* entry = _entries[index].load(std::memory_order_acquire);
+
+                if (entry != nullptr) {
+                    action(*entry);
+                }
+            }
+        }
+        void Reset();
+
+    private:
+        Metric* Find(const uint64_t key, const string& category, const string& name, const uint32_t id, const uint32_t method);
+
+    private:
+        std::atomic<uint64_t> _keys[Slots];
+        std::atomic<Metric*> _entries[Slots];
+    };
+
+} // namespace Core
+} // namespace WPEFramework
@@ -22,6 +22,7 @@
 
 #include "Factory.h"
 #include "IAction.h"
+#include "IPCRing.h"
 #include "Link.h"
 #include "Module.h"
 #include "Portability.h"
@@ -197,6 +198,9 @@ namespace Core {
                         if (_offset == 8) {
                             _current = Element(_label);
                             _label = 0;
+                        } else {
+                            // The header continues in the next frame.
+                            break;
                         }
                     }
 
@@ -786,6 +790,10 @@ namespace Core {
         IPCChannelType(const IPCChannelType<ACTUALSOURCE, EXTENSION>&) = delete;
         IPCChannelType<ACTUALSOURCE, EXTENSION>& operator=(const IPCChannelType<ACTUALSOURCE, EXTENSION>&) = delete;
 
+        // How long a frame without a caller deadline (responses, asynchronous invokes) may wait for
+        // room in the shortcut ring, in ms.
+        static constexpr uint32_t ResponseWaitTime = 2000;
+
         class IPCLink : public LinkType<ACTUALSOURCE, IMessage, IMessage, IPCFactory&> {
         private:
             typedef LinkType<ACTUALSOURCE, IMessage, IMessage, IPCFactory&> BaseClass;
@@ -846,19 +854,13 @@ namespace Core {
                 ASSERT(inbound.IsValid() == true);
 
                 // This is an inbound call, Report what we have processed !!!
-                return (BaseClass::Submit(inbound->IResponse()));
+                return (_parent.Submit(inbound->IResponse(), ResponseWaitTime) == Core::ERROR_NONE);
             }
 
             // Notification of a INBOUND element received.
             virtual void Received(Core::ProxyType<IMessage>& message)
             {
-
-                Core::ProxyType<IIPC> inbound;
-                ProxyType<IIPCServer> handler(_factory.ReceivedMessage(message, inbound));
-
-                if (handler.IsValid() == true) {
-                    _parent.CallProcedure(handler, inbound);
-                } 
+                _parent.Received(message);
             }
 
             // Notification of a Response send.
@@ -872,6 +874,7 @@ namespace Core {
             {
                 if (_parent.Source().IsOpen() == false) {
                     // Whatever s hapening, Flush what we were doing..
+                    _parent.CloseShortcut();
                     _parent.Abort();
                     _factory.Flush();
                 }
@@ -893,7 +896,7 @@ namespace Core {
         public:
             IPCTrigger(IPCFactory& administration)
                 : _administration(administration)
-                , _signal(false, true)
+                , _signal(false)
             {
             }
             virtual ~IPCTrigger()
@@ -923,7 +926,185 @@ namespace Core {
 
         private:
             IPCFactory& _administration;
-            Event _signal;
+            AdaptiveEvent _signal;
+        };
+
+
+        // Same host shortcut: the frames travel over a pair of shared memory rings, instead of over
+        // the socket. The socket stays, it tracks the lifetime of the peer and carries all frames
+        // until the peer attached to the rings. The side that creates the rings writes to "<name>.0"
+        // and reads from "<name>.1", the side that opens them the other way around.
+        class IPCShortcut : public Thread {
+        private:
+            IPCShortcut() = delete;
+            IPCShortcut(const IPCShortcut&) = delete;
+            IPCShortcut& operator=(const IPCShortcut&) = delete;
+
+            class SerializerImpl : public IMessage::Serializer {
+            public:
+                SerializerImpl(const SerializerImpl&) = delete;
+                SerializerImpl& operator=(const SerializerImpl&) = delete;
+
+                SerializerImpl()
+                    : IMessage::Serializer()
+                {
+                }
+                ~SerializerImpl() override
+                {
+                }
+
+            private:
+                void Serialized(const IMessage& /* element */) override
+                {
+                }
+            };
+
+            class DeserializerImpl : public IMessage::Deserializer {
+            public:
+                DeserializerImpl() = delete;
+                DeserializerImpl(const DeserializerImpl&) = delete;
+                DeserializerImpl& operator=(const DeserializerImpl&) = delete;
+
+                DeserializerImpl(IPCChannelType<ACTUALSOURCE, EXTENSION>& parent)
+                    : IMessage::Deserializer()
+                    , _parent(parent)
+                    , _current()
+                {
+                }
+                ~DeserializerImpl() override
+                {
+                }
+
+            private:
+                void Deserialized(IMessage& /* element */) override
+                {
+                    _parent.Received(_current);
+                    _current.Release();
+                }
+                IMessage* Element(const uint32_t& label) override
+                {
+                    _current = _parent._administration.Element(label);
+
+                    return (_current.IsValid() ? &(*_current) : nullptr);
+                }
+
+            private:
+                IPCChannelType<ACTUALSOURCE, EXTENSION>& _parent;
+                ProxyType<IMessage> _current;
+            };
+
+        public:
+            IPCShortcut(IPCChannelType<ACTUALSOURCE, EXTENSION>* parent, const string& name, const uint32_t size)
+                : Thread(Thread::DefaultStackSize(), _T("IPCShortcut"))
+                , _lock()
+                , _outbound(name + _T(".0"), size)
+                , _inbound(name + _T(".1"), size)
+                , _serializer()
+                , _deserializer(*parent)
+            {
+            }
+            IPCShortcut(IPCChannelType<ACTUALSOURCE, EXTENSION>* parent, const string& name)
+                : Thread(Thread::DefaultStackSize(), _T("IPCShortcut"))
+                , _lock()
+                , _outbound(name + _T(".1"))
+                , _inbound(name + _T(".0"))
+                , _serializer()
+                , _deserializer(*parent)
+            {
+            }
+            ~IPCShortcut() override
+            {
+                Close();
+            }
+
+        public:
+            inline bool IsValid() const
+            {
+                return ((_outbound.IsValid() == true) && (_inbound.IsValid() == true));
+            }
+            // Frames can go over the rings once the peer attached and as long as nobody closed them.
+            inline bool IsActive() const
+            {
+                return ((_outbound.IsAttached() == true) && (_outbound.IsClosed() == false));
+            }
+            // Returns ERROR_CONNECTION_CLOSED if the ring got closed, the frame should go over the socket
+            // than, and ERROR_TIMEDOUT if the peer did not make room in time.
+            uint32_t Submit(const ProxyType<IMessage>& message, const uint32_t waitTime)
+            {
+                const uint64_t deadline = (waitTime == Core::infinite ? 0 : Core::Time::Now().Add(waitTime).Ticks());
+                uint32_t result = Core::ERROR_NONE;
+                uint16_t length;
+
+                _lock.Lock();
+
+                _serializer.Submit(*message);
+
+                // If the ring got closed or timed out halfway, run the serializer to the end anyway, so
+                // it is ready for the next one.
+                while ((length = _serializer.Serialize(_buffer, sizeof(_buffer))) > 0) {
+                    if (result == Core::ERROR_NONE) {
+                        result = _outbound.Write(_buffer, length, Remaining(deadline));
+                    }
+                }
+
+                if (result == Core::ERROR_TIMEDOUT) {
+                    // Part of the frame might be in the ring, whatever follows it can not be understood
+                    // by the peer anymore. From here on the frames go over the socket.
+                    _outbound.Close();
+                }
+
+                _lock.Unlock();
+
+                return (result);
+            }
+            void Close()
+            {
+                _outbound.Close();
+                _inbound.Close();
+
+                Thread::Stop();
+
+                // The channel might be closed from a procedure that runs on our own thread.
+                if (Thread::Id() != Thread::ThreadId()) {
+                    Thread::Wait(Thread::STOPPED | Thread::BLOCKED, Core::infinite);
+                }
+            }
+
+        private:
+            static uint32_t Remaining(const uint64_t deadline)
+            {
+                uint32_t result = Core::infinite;
+
+                if (deadline != 0) {
+                    const uint64_t now = Core::Time::Now().Ticks();
+                    result = (now < deadline ? static_cast<uint32_t>((deadline - now) / Core::Time::TicksPerMillisecond) : 0);
+                }
+
+                return (result);
+            }
+            uint32_t Worker() override
+            {
+                uint32_t delay = 0;
+                const uint32_t length = _inbound.Read(_frame, sizeof(_frame), Core::infinite);
+
+                if (length > 0) {
+                    _deserializer.Deserialize(_frame, static_cast<uint16_t>(length));
+                } else if (_inbound.IsClosed() == true) {
+                    Thread::Block();
+                    delay = Core::infinite;
+                }
+
+                return (delay);
+            }
+
+        private:
+            CriticalSection _lock;
+            IPCRing _outbound;
+            IPCRing _inbound;
+            SerializerImpl _serializer;
+            DeserializerImpl _deserializer;
+            uint8_t _buffer[1024];
+            uint8_t _frame[1024];
         };
 
     public:
@@ -935,6 +1116,8 @@ namespace Core {
             : IPCChannel()
             , _link(this, &_administration, arg1)
             , _extension(this)
+            , _shortcutLock()
+            , _shortcut()
         {
         }
         template <typename ARG1, typename ARG2>
@@ -942,6 +1125,8 @@ namespace Core {
             : IPCChannel()
             , _link(this, &_administration, arg1, arg2)
             , _extension(this)
+            , _shortcutLock()
+            , _shortcut()
         {
         }
         template <typename ARG1, typename ARG2, typename ARG3>
@@ -949,6 +1134,8 @@ namespace Core {
             : IPCChannel()
             , _link(this, &_administration, arg1, arg2, arg3)
             , _extension(this)
+            , _shortcutLock()
+            , _shortcut()
         {
         }
         template <typename ARG1, typename ARG2, typename ARG3, typename ARG4>
@@ -956,6 +1143,8 @@ namespace Core {
             : IPCChannel()
             , _link(this, &_administration, arg1, arg2, arg3, arg4)
             , _extension(this)
+            , _shortcutLock()
+            , _shortcut()
         {
         }
         template <typename ARG1, typename ARG2, typename ARG3, typename ARG4, typename ARG5>
@@ -963,6 +1152,8 @@ namespace Core {
             : IPCChannel()
             , _link(this, &_administration, arg1, arg2, arg3, arg4, arg5)
             , _extension(this)
+            , _shortcutLock()
+            , _shortcut()
         {
         }
         template <typename ARG1>
@@ -970,6 +1161,8 @@ namespace Core {
             : IPCChannel(factory)
             , _link(this, &_administration, arg1)
             , _extension(this)
+            , _shortcutLock()
+            , _shortcut()
         {
         }
         template <typename ARG1, typename ARG2>
@@ -977,6 +1170,8 @@ namespace Core {
             : IPCChannel(factory)
             , _link(this, &_administration, arg1, arg2)
             , _extension(this)
+            , _shortcutLock()
+            , _shortcut()
         {
         }
         template <typename ARG1, typename ARG2, typename ARG3>
@@ -984,6 +1179,8 @@ namespace Core {
             : IPCChannel(factory)
             , _link(this, &_administration, arg1, arg2, arg3)
             , _extension(this)
+            , _shortcutLock()
+            , _shortcut()
         {
         }
         template <typename ARG1, typename ARG2, typename ARG3, typename ARG4>
@@ -991,6 +1188,8 @@ namespace Core {
             : IPCChannel(factory)
             , _link(this, &_administration, arg1, arg2, arg3, arg4)
             , _extension(this)
+            , _shortcutLock()
+            , _shortcut()
         {
         }
         template <typename ARG1, typename ARG2, typename ARG3, typename ARG4, typename ARG5>
@@ -998,6 +1197,8 @@ namespace Core {
             : IPCChannel(factory)
             , _link(this, &_administration, arg1, arg2, arg3, arg4, arg5)
             , _extension(this)
+            , _shortcutLock()
+            , _shortcut()
         {
         }
 #ifdef __WINDOWS__
@@ -1006,6 +1207,7 @@ namespace Core {
 
         virtual ~IPCChannelType()
         {
+            CloseShortcut();
         }
 
     public:
@@ -1029,6 +1231,44 @@ namespace Core {
         {
             return (_administration.InProgress());
         }
+        // Creates the rings of the shortcut (see IPCShortcut), they are used once the peer opened them.
+        uint32_t CreateShortcut(const string& name, const uint32_t size)
+        {
+            uint32_t result = Core::ERROR_ALREADY_CONNECTED;
+
+            _shortcutLock.Lock();
+
+            if (_shortcut.IsValid() == false) {
+                result = Shortcut(ProxyType<IPCShortcut>::Create(this, name, size));
+            }
+
+            _shortcutLock.Unlock();
+
+            return (result);
+        }
+        // Opens the rings created by the peer, from here on frames go over the rings.
+        uint32_t OpenShortcut(const string& name)
+        {
+            uint32_t result = Core::ERROR_ALREADY_CONNECTED;
+
+            _shortcutLock.Lock();
+
+            if (_shortcut.IsValid() == false) {
+                result = Shortcut(ProxyType<IPCShortcut>::Create(this, name));
+            }
+
+            _shortcutLock.Unlock();
+
+            return (result);
+        }
+        inline bool IsShortcut() const
+        {
+            _shortcutLock.Lock();
+            bool result = ((_shortcut.IsValid() == true) && (_shortcut->IsActive() == true));
+            _shortcutLock.Unlock();
+
+            return (result);
+        }
         virtual uint32_t ReportResponse(Core::ProxyType<IIPC>& inbound)
         {
 
@@ -1074,9 +1314,11 @@ namespace Core {
                 _administration.SetOutbound(command, completed);
 
                 // Send out the
-                _link.Submit(command->IParameters());
+                success = Submit(command->IParameters(), ResponseWaitTime);
 
-                success = Core::ERROR_NONE;
+                if (success != Core::ERROR_NONE) {
+                    _administration.AbortOutbound();
+                }
             }
 
             _serialize.Unlock();
@@ -1096,10 +1338,20 @@ namespace Core {
                 // proxy casted objects.
                 _administration.SetOutbound(command, &sink);
 
-                // Send out the
-                _link.Submit(command->IParameters());
+                const uint64_t start = Core::Time::Now().Ticks();
+
+                // Send out the request, if the shortcut ring is full this takes part of the wait time.
+                success = Submit(command->IParameters(), waitTime);
 
-                success = sink.Wait(waitTime);
+                if (success != Core::ERROR_NONE) {
+                    _administration.AbortOutbound();
+                } else if (waitTime == Core::infinite) {
+                    success = sink.Wait(waitTime);
+                } else {
+                    const uint32_t elapsed = static_cast<uint32_t>((Core::Time::Now().Ticks() - start) / Core::Time::TicksPerMillisecond);
+
+                    success = sink.Wait(elapsed < waitTime ? (waitTime - elapsed) : 0);
+                }
             }
 
             _serialize.Unlock();
@@ -1110,11 +1362,70 @@ namespace Core {
         {
             procedure->Procedure(*this, message);
         }
+        uint32_t Submit(const ProxyType<IMessage>& message, const uint32_t waitTime)
+        {
+            uint32_t result = Core::ERROR_CONNECTION_CLOSED;
+
+            _shortcutLock.Lock();
+            ProxyType<IPCShortcut> shortcut(_shortcut);
+            _shortcutLock.Unlock();
+
+            if ((shortcut.IsValid() == true) && (shortcut->IsActive() == true)) {
+                result = shortcut->Submit(message, waitTime);
+            }
+
+            if (result == Core::ERROR_CONNECTION_CLOSED) {
+                result = (_link.Submit(message) == true ? Core::ERROR_NONE : Core::ERROR_CONNECTION_CLOSED);
+            }
+
+            return (result);
+        }
+        void Received(ProxyType<IMessage>& message)
+        {
+            Core::ProxyType<IIPC> inbound;
+            ProxyType<IIPCServer> handler(_administration.ReceivedMessage(message, inbound));
+
+            if (handler.IsValid() == true) {
+                CallProcedure(handler, inbound);
+            }
+        }
+        // Called with the _shortcutLock taken.
+        uint32_t Shortcut(const ProxyType<IPCShortcut>& shortcut)
+        {
+            uint32_t result = Core::ERROR_UNAVAILABLE;
+
+            if (shortcut->IsValid() == true) {
+                _shortcut = shortcut;
+                _shortcut->Run();
+                result = Core::ERROR_NONE;
+            }
+
+            return (result);
+        }
+        void CloseShortcut()
+        {
+            ProxyType<IPCShortcut> shortcut;
+
+            _shortcutLock.Lock();
+
+            if (_shortcut.IsValid() == true) {
+                shortcut = _shortcut;
+                _shortcut.Release();
+            }
+
+            _shortcutLock.Unlock();
+
+            if (shortcut.IsValid() == true) {
+                shortcut->Close();
+            }
+        }
 
     private:
         CriticalSection _serialize;
         IPCLink _link;
         EXTENSION _extension;
+        mutable CriticalSection _shortcutLock;
+        ProxyType<IPCShortcut> _shortcut;
     };
 }
 } // namespace Core
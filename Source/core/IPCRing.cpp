@@ -0,0 +1,262 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2020 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "IPCRing.h"
+#include "Time.h"
+
+#ifdef __LINUX__
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <time.h>
+#include <unistd.h>
+#endif
+
+namespace WPEFramework {
+namespace Core {
+
+    namespace {
+
+        constexpr uint32_t MinimumSize = 4096;
+
+        constexpr uint32_t Mode = File::USER_READ | File::USER_WRITE | File::GROUP_READ | File::GROUP_WRITE | File::SHAREABLE;
+
+        inline uint32_t RoundUp(const uint32_t size)
+        {
+            uint32_t result = MinimumSize;
+
+            while (result < size) {
+                result <<= 1;
+            }
+
+            return (result);
+        }
+
+#ifdef __LINUX__
+        // The ring lives in a MAP_SHARED mapping, so these have to be the process shared (non private)
+        // futex operations.
+        inline void FutexWait(std::atomic<uint32_t>& word, const uint32_t expected, const uint32_t waitTime)
+        {
+            if (waitTime == Core::infinite) {
+                ::syscall(SYS_futex, reinterpret_cast<uint32_t*>(&word), FUTEX_WAIT, expected, nullptr, nullptr, 0);
+            } else {
+                struct timespec timeout;
+                timeout.tv_sec = waitTime / 1000;
+                timeout.tv_nsec = (waitTime % 1000) * 1000000;
+                ::syscall(SYS_futex, reinterpret_cast<uint32_t*>(&word), FUTEX_WAIT, expected, &timeout, nullptr, 0);
+            }
+        }
+        inline void FutexWake(std::atomic<uint32_t>& word)
+        {
+            ::syscall(SYS_futex, reinterpret_cast<uint32_t*>(&word), FUTEX_WAKE, 1, nullptr, nullptr, 0);
+        }
+#else
+        // No cross process address based wait available, fall back to polling.
+        inline void FutexWait(std::atomic<uint32_t>& word, const uint32_t expected, const uint32_t waitTime)
+        {
+            if (word.load(std::memory_order_acquire) == expected) {
+                ::SleepMs(waitTime < 1 ? waitTime : 1);
+            }
+        }
+        inline void FutexWake(std::atomic<uint32_t>&)
+        {
+        }
+#endif
+    }
+
+    IPCRing::IPCRing(const string& name, const uint32_t size)
+        : _storage(name, Mode | File::CREATE, sizeof(Control) + RoundUp(size))
+        , _control(nullptr)
+        , _data(nullptr)
+        , _size(RoundUp(size))
+        , _owner(true)
+    {
+        if ((_storage.IsValid() == true) && (_storage.Size() >= (sizeof(Control) + _size))) {
+            _control = reinterpret_cast<Control*>(_storage.Buffer());
+            _data = &(_storage.Buffer()[sizeof(Control)]);
+
+            _control->Size = _size;
+            _control->Sleepers.store(0, std::memory_order_relaxed);
+            _control->State.store(0, std::memory_order_relaxed);
+            _control->Head.store(0, std::memory_order_relaxed);
+            _control->Filled.store(0, std::memory_order_relaxed);
+            _control->Tail.store(0, std::memory_order_relaxed);
+            _control->Drained.store(0, std::memory_order_relaxed);
+
+            // Last, so a peer that finds the magic finds a usable ring.
+            std::atomic_thread_fence(std::memory_order_release);
+            _control->Magic = MAGIC;
+        } else {
+            TRACE_L1("Could not create IPC ring %s", name.c_str());
+        }
+    }
+
+    IPCRing::IPCRing(const string& name)
+        : _storage(name, Mode)
+        , _control(nullptr)
+        , _data(nullptr)
+        , _size(0)
+        , _owner(false)
+    {
+        if ((_storage.IsValid() == true) && (_storage.Size() > sizeof(Control))) {
+            Control* control = reinterpret_cast<Control*>(_storage.Buffer());
+
+            std::atomic_thread_fence(std::memory_order_acquire);
+
+            if ((control->Magic == MAGIC) && ((control->Size & (control->Size - 1)) == 0) && (_storage.Size() >= (sizeof(Control) + control->Size))) {
+                _control = control;
+                _data = &(_storage.Buffer()[sizeof(Control)]);
+                _size = control->Size;
+
+                _control->State.fetch_or(ATTACHED, std::memory_order_acq_rel);
+            }
+        }
+
+        if (_control == nullptr) {
+            TRACE_L1("Could not open IPC ring %s", name.c_str());
+        }
+    }
+
+    IPCRing::~IPCRing()
+    {
+        Close();
+
+        if ((_owner == true) && (_storage.IsValid() == true)) {
+            // Unlinking the file is fine, the peer keeps its mapping until it lets go.
+            Core::File{ _storage.Name() }.Destroy();
+        }
+    }
+
+    uint32_t IPCRing::Write(const uint8_t data[], const uint32_t length, const uint32_t waitTime)
+    {
+        uint32_t result = Core::ERROR_NONE;
+        uint32_t written = 0;
+        const uint64_t deadline = (waitTime == Core::infinite ? 0 : Core::Time::Now().Add(waitTime).Ticks());
+
+        while ((written < length) && (result == Core::ERROR_NONE)) {
+
+            if (IsClosed() == true) {
+                result = Core::ERROR_CONNECTION_CLOSED;
+            } else {
+                const uint32_t head = _control->Head.load(std::memory_order_relaxed);
+                const uint32_t space = _size - (head - _control->Tail.load(std::memory_order_acquire));
+
+                if (space > 0) {
+                    const uint32_t offset = head & (_size - 1);
+                    const uint32_t chunk = std::min(std::min(space, length - written), _size - offset);
+
+                    ::memcpy(&_data[offset], &data[written], chunk);
+                    written += chunk;
+
+                    _control->Head.store(head + chunk, std::memory_order_seq_cst);
+
+                    Wake(_control->Filled, CONSUMER_SLEEPING);
+                } else {
+                    uint32_t remaining = Core::infinite;
+
+                    if (waitTime != Core::infinite) {
+                        const uint64_t now = Core::Time::Now().Ticks();
+                        remaining = (now >= deadline ? 0 : static_cast<uint32_t>((deadline - now + 999) / 1000));
+                    }
+
+                    if (remaining == 0) {
+                        result = Core::ERROR_TIMEDOUT;
+                    } else {
+                        Sleep(_control->Drained, PRODUCER_SLEEPING, true, remaining);
+                    }
+                }
+            }
+        }
+
+        return (result);
+    }
+
+    uint32_t IPCRing::Read(uint8_t data[], const uint32_t length, const uint32_t waitTime)
+    {
+        uint32_t result = 0;
+
+        if (IsClosed() == false) {
+            uint32_t tail = _control->Tail.load(std::memory_order_relaxed);
+            uint32_t available = _control->Head.load(std::memory_order_acquire) - tail;
+
+            if ((available == 0) && (waitTime > 0) && (Sleep(_control->Filled, CONSUMER_SLEEPING, false, waitTime) == true)) {
+                available = _control->Head.load(std::memory_order_acquire) - tail;
+            }
+
+            if ((available > 0) && (IsClosed() == false)) {
+                const uint32_t offset = tail & (_size - 1);
+
+                result = std::min(std::min(available, length), _size - offset);
+
+                ::memcpy(data, &_data[offset], result);
+
+                _control->Tail.store(tail + result, std::memory_order_seq_cst);
+
+                Wake(_control->Drained, PRODUCER_SLEEPING);
+            }
+        }
+
+        return (result);
+    }
+
+    void IPCRing::Close()
+    {
+        if (_control != nullptr) {
+            _control->State.fetch_or(CLOSED, std::memory_order_seq_cst);
+
+            _control->Filled.fetch_add(1, std::memory_order_seq_cst);
+            _control->Drained.fetch_add(1, std::memory_order_seq_cst);
+            FutexWake(_control->Filled);
+            FutexWake(_control->Drained);
+        }
+    }
+
+    // Returns false if the condition the caller is waiting for did not come true in time.
+    bool IPCRing::Sleep(std::atomic<uint32_t>& doorbell, const uint32_t sleeper, const bool producer, const uint32_t waitTime)
+    {
+        const uint32_t ring = doorbell.load(std::memory_order_seq_cst);
+
+        // Announce that we go to sleep before the final check, the other side either sees the flag
+        // or we see its update.
+        _control->Sleepers.fetch_or(sleeper, std::memory_order_seq_cst);
+
+        const uint32_t used = _control->Head.load(std::memory_order_seq_cst) - _control->Tail.load(std::memory_order_seq_cst);
+        bool result = (producer ? (used < _size) : (used > 0));
+
+        if ((result == false) && (IsClosed() == false)) {
+            FutexWait(doorbell, ring, waitTime);
+
+            const uint32_t now = _control->Head.load(std::memory_order_acquire) - _control->Tail.load(std::memory_order_acquire);
+            result = (producer ? (now < _size) : (now > 0));
+        }
+
+        _control->Sleepers.fetch_and(~sleeper, std::memory_order_seq_cst);
+
+        return (result);
+    }
+
+    void IPCRing::Wake(std::atomic<uint32_t>& doorbell, const uint32_t sleeper)
+    {
+        if ((_control->Sleepers.load(std::memory_order_seq_cst) & sleeper) != 0) {
+            doorbell.fetch_add(1, std::memory_order_seq_cst);
+            FutexWake(doorbell);
+        }
+    }
+
+} // namespace Core
+} // namespace WPEFramework
@@ -0,0 +1,124 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2020 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "DataElementFile.h"
+#include "Module.h"
+#include "Portability.h"
+
+#include <atomic>
+
+namespace WPEFramework {
+namespace Core {
+
+    // Single producer, single consumer byte ring in a shared memory file, meant to carry the frames
+    // of an IPC channel between two processes on the same host. The producer and consumer only touch
+    // their own index, so the data path is lock free. A side only goes to sleep (futex) if the ring
+    // is empty (consumer) or full (producer), and the other side only makes the wake up system call
+    // if it sees a sleeper.
+    // The creator owns the file and removes it when it goes away, the peer Open()s it and marks the
+    // ring as attached, so the creator knows it is safe to start using it.
+    class EXTERNAL IPCRing {
+    private:
+        // Head (and its doorbell) is only written by the producer, Tail by the consumer, keep them
+        // on separate cache lines.
+        struct Control {
+            uint32_t Magic;
+            uint32_t Size;
+            std::atomic<uint32_t> Sleepers;
+            std::atomic<uint32_t> State;
+            uint8_t Reserved1[48];
+            std::atomic<uint32_t> Head;
+            std::atomic<uint32_t> Filled;
+            uint8_t Reserved2[56];
+            std::atomic<uint32_t> Tail;
+            std::atomic<uint32_t> Drained;
+            uint8_t Reserved3[56];
+        };
+
+        static constexpr uint32_t MAGIC = 0x52494E47; // RING
+        static constexpr uint32_t CONSUMER_SLEEPING = 0x01;
+        static constexpr uint32_t PRODUCER_SLEEPING = 0x02;
+        static constexpr uint32_t ATTACHED = 0x01;
+        static constexpr uint32_t CLOSED = 0x02;
+
+    public:
+        IPCRing() = delete;
+        IPCRing(const IPCRing&) = delete;
+        IPCRing& operator=(const IPCRing&) = delete;
+
+        // Create the ring, the size is rounded up to a power of 2.
+        IPCRing(const string& name, const uint32_t size);
+        // Open a ring created by the other side.
+        IPCRing(const string& name);
+        ~IPCRing();
+
+    public:
+        inline const string& Name() const
+        {
+            return (_storage.Name());
+        }
+        inline bool IsValid() const
+        {
+            return (_control != nullptr);
+        }
+        inline uint32_t Size() const
+        {
+            return (_size);
+        }
+        inline bool IsAttached() const
+        {
+            return ((_control != nullptr) && ((_control->State.load(std::memory_order_acquire) & ATTACHED) != 0));
+        }
+        inline bool IsClosed() const
+        {
+            return ((_control == nullptr) || ((_control->State.load(std::memory_order_acquire) & CLOSED) != 0));
+        }
+        inline uint32_t Used() const
+        {
+            return (_control == nullptr ? 0 : (_control->Head.load(std::memory_order_acquire) - _control->Tail.load(std::memory_order_acquire)));
+        }
+
+        // Blocks until all data is in the ring. Returns ERROR_TIMEDOUT if the consumer did not make
+        // room in time and ERROR_CONNECTION_CLOSED if either side closed the ring, part of the data
+        // might have been written in that case.
+        uint32_t Write(const uint8_t data[], const uint32_t length, const uint32_t waitTime);
+
+        // Returns what is available, up to length bytes. Only blocks if the ring is empty, 0 means
+        // nothing arrived in time or the ring got closed.
+        uint32_t Read(uint8_t data[], const uint32_t length, const uint32_t waitTime);
+
+        // Wakes up both sides, all subsequent reads and writes fail.
+        void Close();
+
+    private:
+        bool Sleep(std::atomic<uint32_t>& doorbell, const uint32_t sleeper, const bool producer, const uint32_t waitTime);
+        void Wake(std::atomic<uint32_t>& doorbell, const uint32_t sleeper);
+
+    private:
+        DataElementFile _storage;
+        Control* _control;
+        uint8_t* _data;
+        uint32_t _size;
+        bool _owner;
+    };
+
+} // namespace Core
+} // namespace WPEFramework
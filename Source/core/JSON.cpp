@@ -18,7 +18,9 @@
  */
 
 #include "JSON.h"
+#include <cerrno>
 #include <iomanip>
+#include <limits>
 #include <sstream>
 
 namespace WPEFramework {
@@ -37,9 +39,554 @@ namespace Core {
         }
 
         /* static */ constexpr size_t Error::kContextMaxLength;
+        /* static */ constexpr uint8_t IMessagePack::NullValue;
 
         /* static */ char IElement::NullTag[] = "null";
 
+        // Nesting is limited, the transcoders below are recursive.
+        static constexpr uint8_t MaxTranscodeDepth = 32;
+
+        static void PackHeader(std::vector<uint8_t>& stream, const uint8_t fix, const uint8_t fixLimit, const uint8_t base, const uint32_t size)
+        {
+            if (size <= fixLimit) {
+                stream.push_back(fix | static_cast<uint8_t>(size));
+            } else if ((base == 0xD9) && (size <= 0xFF)) {
+                stream.push_back(base);
+                stream.push_back(static_cast<uint8_t>(size));
+            } else if (size <= 0xFFFF) {
+                stream.push_back(base == 0xD9 ? 0xDA : base);
+                stream.push_back(static_cast<uint8_t>(size >> 8));
+                stream.push_back(static_cast<uint8_t>(size));
+            } else {
+                stream.push_back(base == 0xD9 ? 0xDB : base + 1);
+                stream.push_back(static_cast<uint8_t>(size >> 24));
+                stream.push_back(static_cast<uint8_t>(size >> 16));
+                stream.push_back(static_cast<uint8_t>(size >> 8));
+                stream.push_back(static_cast<uint8_t>(size));
+            }
+        }
+
+        static void PackBigEndian(std::vector<uint8_t>& stream, const uint8_t marker, const uint64_t value, const uint8_t bytes)
+        {
+            stream.push_back(marker);
+            for (uint8_t index = bytes; index > 0; index--) {
+                stream.push_back(static_cast<uint8_t>(value >> (8 * (index - 1))));
+            }
+        }
+
+        static void PackInteger(std::vector<uint8_t>& stream, const bool negative, const uint64_t magnitude)
+        {
+            if (negative == false) {
+                if (magnitude <= 0x7F) {
+                    stream.push_back(static_cast<uint8_t>(magnitude));
+                } else if (magnitude <= 0xFF) {
+                    PackBigEndian(stream, 0xCC, magnitude, 1);
+                } else if (magnitude <= 0xFFFF) {
+                    PackBigEndian(stream, 0xCD, magnitude, 2);
+                } else if (magnitude <= 0xFFFFFFFF) {
+                    PackBigEndian(stream, 0xCE, magnitude, 4);
+                } else {
+                    PackBigEndian(stream, 0xCF, magnitude, 8);
+                }
+            } else {
+                const uint64_t value = (~magnitude + 1);
+
+                if (magnitude <= 32) {
+                    stream.push_back(static_cast<uint8_t>(value));
+                } else if (magnitude <= 0x80) {
+                    PackBigEndian(stream, 0xD0, value, 1);
+                } else if (magnitude <= 0x8000) {
+                    PackBigEndian(stream, 0xD1, value, 2);
+                } else if (magnitude <= 0x80000000) {
+                    PackBigEndian(stream, 0xD2, value, 4);
+                } else {
+                    PackBigEndian(stream, 0xD3, value, 8);
+                }
+            }
+        }
+
+        static void SkipSpace(const char text[], const uint32_t length, uint32_t& index)
+        {
+            while ((index < length) && ((text[index] == ' ') || (text[index] == '\t') || (text[index] == '\r') || (text[index] == '\n'))) {
+                index++;
+            }
+        }
+
+        static bool HexCode(const char text[], const uint32_t length, uint32_t& index, uint32_t& code)
+        {
+            code = 0;
+
+            if ((index + 4) > length) {
+                return (false);
+            }
+            for (uint8_t digit = 0; digit < 4; digit++) {
+                const char c = static_cast<char>(toupper(text[index++]));
+                if (isdigit(c)) {
+                    code = (code << 4) | (c - '0');
+                } else if ((c >= 'A') && (c <= 'F')) {
+                    code = (code << 4) | (c - 'A' + 10);
+                } else {
+                    return (false);
+                }
+            }
+            return (true);
+        }
+
+        static bool PackString(const char text[], const uint32_t length, uint32_t& index, std::vector<uint8_t>& stream)
+        {
+            std::string value;
+
+            ASSERT(text[index] == '\"');
+            index++;
+
+            while ((index < length) && (text[index] != '\"')) {
+                if (text[index] != '\\') {
+                    value += text[index++];
+                } else if ((index + 1) >= length) {
+                    return (false);
+                } else {
+                    const char escaped = text[index + 1];
+                    index += 2;
+
+                    switch (escaped) {
+                    case 'b': value += '\b'; break;
+                    case 'f': value += '\f'; break;
+                    case 'n': value += '\n'; break;
+                    case 'r': value += '\r'; break;
+                    case 't': value += '\t'; break;
+                    case 'u': {
+                        uint32_t code;
+                        if (HexCode(text, length, index, code) == false) {
+                            return (false);
+                        }
+                        if ((code >= 0xD800) && (code <= 0xDBFF) && ((index + 1) < length) && (text[index] == '\\') && (text[index + 1] == 'u')) {
+                            uint32_t low;
+                            uint32_t next = index + 2;
+                            if ((HexCode(text, length, next, low) == true) && (low >= 0xDC00) && (low <= 0xDFFF)) {
+                                code = 0x10000 + ((code - 0xD800) << 10) + (low - 0xDC00);
+                                index = next;
+                            }
+                        }
+                        if (code < 0x80) {
+                            value += static_cast<char>(code);
+                        } else if (code < 0x800) {
+                            value += static_cast<char>(0xC0 | (code >> 6));
+                            value += static_cast<char>(0x80 | (code & 0x3F));
+                        } else if (code < 0x10000) {
+                            value += static_cast<char>(0xE0 | (code >> 12));
+                            value += static_cast<char>(0x80 | ((code >> 6) & 0x3F));
+                            value += static_cast<char>(0x80 | (code & 0x3F));
+                        } else {
+                            value += static_cast<char>(0xF0 | (code >> 18));
+                            value += static_cast<char>(0x80 | ((code >> 12) & 0x3F));
+                            value += static_cast<char>(0x80 | ((code >> 6) & 0x3F));
+                            value += static_cast<char>(0x80 | (code & 0x3F));
+                        }
+                        break;
+                    }
+                    default: value += escaped; break;
+                    }
+                }
+            }
+
+            if (index >= length) {
+                return (false);
+            }
+
+            index++;
+            PackHeader(stream, 0xA0, 31, 0xD9, static_cast<uint32_t>(value.length()));
+            stream.insert(stream.end(), value.begin(), value.end());
+
+            return (true);
+        }
+
+        static bool PackValue(const char text[], const uint32_t length, uint32_t& index, std::vector<uint8_t>& stream, const uint8_t depth)
+        {
+            bool result = false;
+
+            SkipSpace(text, length, index);
+
+            if ((index < length) && (depth < MaxTranscodeDepth)) {
+                const char marker = text[index];
+
+                if ((marker == '{') || (marker == '[')) {
+                    const bool object = (marker == '{');
+                    const char closing = (object ? '}' : ']');
+                    const size_t start = stream.size();
+                    uint32_t count = 0;
+
+                    index++;
+                    SkipSpace(text, length, index);
+
+                    result = true;
+
+                    if ((index < length) && (text[index] == closing)) {
+                        index++;
+                    } else {
+                        bool more = true;
+
+                        while ((result == true) && (more == true)) {
+                            SkipSpace(text, length, index);
+
+                            if (object == true) {
+                                result = ((index < length) && (text[index] == '\"') && (PackString(text, length, index, stream) == true));
+                                SkipSpace(text, length, index);
+                                result = result && (index < length) && (text[index++] == ':');
+                            }
+
+                            result = result && (PackValue(text, length, index, stream, depth + 1) == true);
+
+                            SkipSpace(text, length, index);
+
+                            if ((result == true) && (index < length)) {
+                                count++;
+                                more = (text[index] == ',');
+                                result = (more == true) || (text[index] == closing);
+                                index++;
+                            } else {
+                                result = false;
+                            }
+                        }
+                    }
+
+                    if (result == true) {
+                        // The size goes in front, so the header is inserted once the content is known.
+                        std::vector<uint8_t> header;
+                        if (object == true) {
+                            PackHeader(header, 0x80, 15, 0xDE, count);
+                        } else {
+                            PackHeader(header, 0x90, 15, 0xDC, count);
+                        }
+                        stream.insert(stream.begin() + start, header.begin(), header.end());
+                    }
+                } else if (marker == '\"') {
+                    result = PackString(text, length, index, stream);
+                } else if ((length - index >= 4) && (strncmp(&text[index], "true", 4) == 0)) {
+                    stream.push_back(0xC3);
+                    index += 4;
+                    result = true;
+                } else if ((length - index >= 5) && (strncmp(&text[index], "false", 5) == 0)) {
+                    stream.push_back(0xC2);
+                    index += 5;
+                    result = true;
+                } else if ((length - index >= 4) && (strncmp(&text[index], "null", 4) == 0)) {
+                    stream.push_back(IMessagePack::NullValue);
+                    index += 4;
+                    result = true;
+                } else if ((marker == '-') || (isdigit(marker))) {
+                    const uint32_t start = index;
+                    bool integer = true;
+
+                    index++;
+                    while ((index < length) && ((isdigit(text[index])) || (text[index] == '.') || (text[index] == 'e') || (text[index] == 'E') || (text[index] == '+') || (text[index] == '-'))) {
+                        integer = integer && (isdigit(text[index]) != 0);
+                        index++;
+                    }
+
+                    const std::string number(&text[start], index - start);
+                    const bool negative = (marker == '-');
+
+                    uint64_t magnitude = 0;
+
+                    if (integer == true) {
+                        // Only what fits an int64 (negative) or uint64 (positive) is packed as an
+                        // integer, anything beyond that range goes out as a float64.
+                        errno = 0;
+                        magnitude = strtoull(&(number.c_str()[negative ? 1 : 0]), nullptr, 10);
+                        integer = (errno != ERANGE) && ((negative == false) || (magnitude <= (static_cast<uint64_t>(1) << 63)));
+                    }
+
+                    if (integer == true) {
+                        PackInteger(stream, negative, magnitude);
+                    } else {
+                        const double value = strtod(number.c_str(), nullptr);
+                        uint64_t bits;
+                        ::memcpy(&bits, &value, sizeof(bits));
+                        PackBigEndian(stream, 0xCB, bits, 8);
+                    }
+                    result = true;
+                }
+            }
+
+            return (result);
+        }
+
+        static uint64_t ReadBigEndian(const uint8_t stream[], const uint8_t bytes)
+        {
+            uint64_t value = 0;
+            for (uint8_t index = 0; index < bytes; index++) {
+                value = (value << 8) | stream[index];
+            }
+            return (value);
+        }
+
+        // Determines the header of the value at the start of the stream. The returned size is
+        // the header size, the payload holds the bytes (strings, binaries, extensions) or the
+        // number of elements (arrays and maps, maps count both the keys and the values).
+        static bool Header(const uint8_t stream[], const uint32_t length, uint8_t& headerSize, uint64_t& payload, bool& nested)
+        {
+            static const uint8_t extraBytes[] = {
+                /* 0xC0 */ 0, 0, 0, 0, 1, 2, 4, 1, 2, 4, 4, 8, 1, 2, 4, 8,
+                /* 0xD0 */ 1, 2, 4, 8, 1, 1, 1, 1, 1, 1, 2, 4, 2, 4, 2, 4
+            };
+
+            const uint8_t marker = stream[0];
+
+            nested = false;
+            payload = 0;
+            headerSize = 1;
+
+            if ((marker <= 0x7F) || (marker >= 0xE0) || (marker == 0xC0) || (marker == 0xC2) || (marker == 0xC3)) {
+                // Fixed ints and constants are complete in the first byte.
+            } else if (marker <= 0x8F) {
+                payload = 2 * (marker & 0x0F);
+                nested = true;
+            } else if (marker <= 0x9F) {
+                payload = (marker & 0x0F);
+                nested = true;
+            } else if (marker <= 0xBF) {
+                payload = (marker & 0x1F);
+            } else if (marker == 0xC1) {
+                return (false);
+            } else {
+                const uint8_t extra = extraBytes[marker - 0xC0];
+
+                if (length < static_cast<uint32_t>(1 + extra)) {
+                    headerSize = 0;
+                } else if (((marker >= 0xC4) && (marker <= 0xC6)) || ((marker >= 0xD9) && (marker <= 0xDB))) {
+                    headerSize = 1 + extra;
+                    payload = ReadBigEndian(&stream[1], extra);
+                } else if ((marker >= 0xC7) && (marker <= 0xC9)) {
+                    // Extension: size, type and data.
+                    headerSize = 2 + extra;
+                    payload = ReadBigEndian(&stream[1], extra);
+                } else if ((marker >= 0xD4) && (marker <= 0xD8)) {
+                    // Fixed extension: type and 1..16 bytes of data.
+                    headerSize = 2;
+                    payload = (1 << (marker - 0xD4));
+                } else if ((marker == 0xDC) || (marker == 0xDD)) {
+                    headerSize = 1 + extra;
+                    payload = ReadBigEndian(&stream[1], extra);
+                    nested = true;
+                } else if ((marker == 0xDE) || (marker == 0xDF)) {
+                    headerSize = 1 + extra;
+                    payload = 2 * ReadBigEndian(&stream[1], extra);
+                    nested = true;
+                } else {
+                    // Numbers, the payload is part of the "header".
+                    headerSize = 1 + extra;
+                }
+            }
+
+            return (true);
+        }
+
+        static void TextEscaped(const char value[], const uint32_t length, string& text)
+        {
+            text += '\"';
+            for (uint32_t index = 0; index < length; index++) {
+                const char c = value[index];
+                switch (c) {
+                case '\"': text += _T("\\\""); break;
+                case '\\': text += _T("\\\\"); break;
+                case '\b': text += _T("\\b"); break;
+                case '\f': text += _T("\\f"); break;
+                case '\n': text += _T("\\n"); break;
+                case '\r': text += _T("\\r"); break;
+                case '\t': text += _T("\\t"); break;
+                default:
+                    if (static_cast<uint8_t>(c) < 0x20) {
+                        TCHAR escaped[8];
+                        ::snprintf(escaped, sizeof(escaped), _T("\\u%04X"), c);
+                        text += escaped;
+                    } else {
+                        text += c;
+                    }
+                    break;
+                }
+            }
+            text += '\"';
+        }
+
+        static uint32_t UnpackValue(const uint8_t stream[], const uint32_t length, string& text, const uint8_t depth)
+        {
+            uint8_t headerSize;
+            uint64_t payload;
+            bool nested;
+
+            if ((length == 0) || (depth >= MaxTranscodeDepth) || (Header(stream, length, headerSize, payload, nested) == false) || (headerSize == 0) || (headerSize > length)) {
+                return (0);
+            }
+
+            const uint8_t marker = stream[0];
+            uint32_t used = headerSize;
+
+            if (nested == true) {
+                const bool object = ((marker <= 0x8F) || (marker >= 0xDE)) && (marker >= 0x80) && (marker < 0xE0);
+
+                text += (object ? '{' : '[');
+
+                for (uint64_t index = 0; index < payload; index++) {
+                    if (index != 0) {
+                        text += (((object == true) && ((index & 1) == 1)) ? ':' : ',');
+                    }
+
+                    uint32_t size;
+
+                    if ((object == true) && ((index & 1) == 0)) {
+                        string key;
+
+                        size = UnpackValue(&stream[used], length - used, key, depth + 1);
+
+                        if ((key.empty() == false) && (key[0] != '\"')) {
+                            // JSON only allows string keys, anything else becomes the string of its text.
+                            TextEscaped(key.c_str(), static_cast<uint32_t>(key.length()), text);
+                        } else {
+                            text += key;
+                        }
+                    } else {
+                        size = UnpackValue(&stream[used], length - used, text, depth + 1);
+                    }
+
+                    if (size == 0) {
+                        return (0);
+                    }
+                    used += size;
+                }
+
+                text += (object ? '}' : ']');
+            } else if (((marker >= 0xA0) && (marker <= 0xBF)) || ((marker >= 0xD9) && (marker <= 0xDB))) {
+                if ((length - used) < payload) {
+                    return (0);
+                }
+                TextEscaped(reinterpret_cast<const char*>(&stream[used]), static_cast<uint32_t>(payload), text);
+                used += static_cast<uint32_t>(payload);
+            } else if ((marker >= 0xC4) && (marker <= 0xC6)) {
+                if (((length - used) < payload) || (payload > 0xFFFF)) {
+                    return (0);
+                }
+                string encoded;
+                Core::ToString(&stream[used], static_cast<uint16_t>(payload), true, encoded);
+                text += '\"' + encoded + '\"';
+                used += static_cast<uint32_t>(payload);
+            } else if (((marker >= 0xC7) && (marker <= 0xC9)) || ((marker >= 0xD4) && (marker <= 0xD8))) {
+                if ((length - used) < payload) {
+                    return (0);
+                }
+                // Extensions have no JSON counterpart.
+                text += IElement::NullTag;
+                used += static_cast<uint32_t>(payload);
+            } else if (marker <= 0x7F) {
+                text += Core::NumberType<uint8_t>(marker).Text();
+            } else if (marker >= 0xE0) {
+                text += Core::NumberType<int8_t>(static_cast<int8_t>(marker)).Text();
+            } else if (marker == 0xC0) {
+                text += IElement::NullTag;
+            } else if (marker == 0xC2) {
+                text += _T("false");
+            } else if (marker == 0xC3) {
+                text += _T("true");
+            } else if ((marker >= 0xCC) && (marker <= 0xCF)) {
+                text += Core::NumberType<uint64_t>(ReadBigEndian(&stream[1], headerSize - 1)).Text();
+            } else if ((marker >= 0xD0) && (marker <= 0xD3)) {
+                const uint8_t bytes = headerSize - 1;
+                uint64_t value = ReadBigEndian(&stream[1], bytes);
+                if ((bytes < 8) && ((value >> ((8 * bytes) - 1)) != 0)) {
+                    value |= (~static_cast<uint64_t>(0) << (8 * bytes));
+                }
+                text += Core::NumberType<int64_t>(static_cast<int64_t>(value)).Text();
+            } else if ((marker == 0xCA) || (marker == 0xCB)) {
+                double value;
+                TCHAR number[32];
+
+                if (marker == 0xCA) {
+                    const uint32_t bits = static_cast<uint32_t>(ReadBigEndian(&stream[1], 4));
+                    float single;
+                    ::memcpy(&single, &bits, sizeof(single));
+                    value = single;
+                } else {
+                    const uint64_t bits = ReadBigEndian(&stream[1], 8);
+                    ::memcpy(&value, &bits, sizeof(value));
+                }
+
+                if ((value != value) || (value > std::numeric_limits<double>::max()) || (value < -std::numeric_limits<double>::max())) {
+                    text += IElement::NullTag;
+                } else {
+                    ::snprintf(number, sizeof(number), (marker == 0xCA ? _T("%.9g") : _T("%.17g")), value);
+                    text += number;
+                }
+            }
+
+            return (used);
+        }
+
+        /* static */ bool IMessagePack::Transcode(const string& text, std::vector<uint8_t>& stream)
+        {
+            uint32_t index = 0;
+            const uint32_t length = static_cast<uint32_t>(text.length());
+
+            stream.clear();
+
+            bool result = PackValue(text.c_str(), length, index, stream, 0);
+
+            SkipSpace(text.c_str(), length, index);
+
+            return ((result == true) && (index == length));
+        }
+
+        /* static */ uint32_t IMessagePack::Transcode(const uint8_t stream[], const uint32_t length, string& text)
+        {
+            text.clear();
+
+            uint32_t result = UnpackValue(stream, length, text, 0);
+
+            if (result == 0) {
+                text.clear();
+            }
+
+            return (result);
+        }
+
+        /* static */ uint32_t IMessagePack::Length(const uint8_t stream[], const uint32_t length)
+        {
+            uint32_t used = 0;
+            uint64_t pending = 1;
+
+            return (Length(stream, length, used, pending));
+        }
+
+        /* static */ uint32_t IMessagePack::Length(const uint8_t stream[], const uint32_t length, uint32_t& used, uint64_t& pending)
+        {
+            // Walk the headers only, nested values just add to the number of pending values. The
+            // progress only moves past complete headers and payloads, so a next call picks up there.
+            while ((pending > 0) && (used < length)) {
+                uint8_t headerSize;
+                uint64_t payload;
+                bool nested;
+
+                if (Header(&stream[used], length - used, headerSize, payload, nested) == false) {
+                    return (~0);
+                }
+                if ((headerSize == 0) || ((length - used) < headerSize)) {
+                    return (0);
+                }
+                if ((nested == false) && ((length - used - headerSize) < payload)) {
+                    return (0);
+                }
+
+                used += headerSize;
+                pending--;
+
+                if (nested == true) {
+                    pending += payload;
+                } else {
+                    used += static_cast<uint32_t>(payload);
+                }
+            }
+
+            return (pending == 0 ? used : 0);
+        }
+
         string Variant::GetDebugString(const TCHAR name[], int indent, int arrayIndex) const
         {
             std::stringstream ss;
@@ -77,6 +624,434 @@ namespace Core {
                 ss << iterator.Current().GetDebugString(iterator.Label(), indent);
             return ss.str();
         }
+
+        Reader::Reader(const uint16_t maxDepth)
+            : _maxDepth(maxDepth)
+            , _data(nullptr)
+            , _length(0)
+            , _index(0)
+            , _consumed(0)
+            , _closed(false)
+            , _name(false)
+            , _reported(false)
+            , _expect(expect::VALUE)
+            , _lexer(lexer::STRUCTURE)
+            , _scopes()
+            , _text()
+            , _error()
+            , _capture(capture::NONE)
+            , _captureDepth(0)
+            , _captureStart(0)
+            , _element(nullptr)
+            , _elementOffset(0)
+        {
+        }
+
+        Reader::~Reader()
+        {
+        }
+
+        void Reader::Reset()
+        {
+            _data = nullptr;
+            _length = 0;
+            _index = 0;
+            _consumed = 0;
+            _closed = false;
+            _name = false;
+            _reported = false;
+            _expect = expect::VALUE;
+            _lexer = lexer::STRUCTURE;
+            _scopes.clear();
+            _text.clear();
+            _error.Clear();
+            _capture = capture::NONE;
+            _element = nullptr;
+            _elementOffset = 0;
+        }
+
+        void Reader::Feed(const char data[], const uint32_t length)
+        {
+            ASSERT((_index == _length) || (_expect == expect::FAILED));
+
+            _consumed += _index;
+            _data = data;
+            _length = length;
+            _index = 0;
+
+            if (_capture == capture::ACTIVE) {
+                _captureStart = 0;
+            }
+        }
+
+        void Reader::Close()
+        {
+            _closed = true;
+        }
+
+        void Reader::Load(IElement& element)
+        {
+            element.Clear();
+
+            _element = &element;
+            _elementOffset = 0;
+            _capture = capture::PENDING;
+        }
+
+        void Reader::Skip()
+        {
+            _element = nullptr;
+            _capture = capture::PENDING;
+        }
+
+        Reader::token Reader::Next()
+        {
+            token result = Scan();
+
+            while ((_capture == capture::ACTIVE) && (result != INVALID)) {
+                if (result == NONE) {
+                    // Out of data, hand over what we have of the value so far.
+                    if (Forward(&(_data[_captureStart]), _length - _captureStart) == false) {
+                        result = INVALID;
+                    }
+                    _captureStart = _length;
+                    break;
+                } else if ((Depth() == _captureDepth) && (result != BEGIN_OBJECT) && (result != BEGIN_ARRAY) && (result != END)) {
+                    result = ELEMENT;
+
+                    if (Forward(&(_data[_captureStart]), _index - _captureStart) == false) {
+                        result = INVALID;
+                    } else if (_element != nullptr) {
+                        // Numbers (and unquoted strings) only know they are complete once they see
+                        // what follows them.
+                        const char terminator = (_index < _length ? _data[_index] : '\0');
+
+                        if ((Forward(&terminator, 1) == false) || (_element != nullptr)) {
+                            result = (_error.IsSet() == true ? INVALID : Fail(_T("The element did not accept the value")));
+                        }
+                    }
+
+                    _element = nullptr;
+                    _capture = capture::NONE;
+                } else {
+                    result = Scan();
+                }
+            }
+
+            if (result == INVALID) {
+                _expect = expect::FAILED;
+                _capture = capture::NONE;
+                _element = nullptr;
+            } else if ((_capture == capture::PENDING) && (result != NONE)) {
+                // There was no value to load, e.g. the end of an array.
+                _capture = capture::NONE;
+                _element = nullptr;
+            }
+
+            return (result);
+        }
+
+        Reader::token Reader::Scan()
+        {
+            token result = NONE;
+
+            if (_expect == expect::FAILED) {
+                result = INVALID;
+            } else if ((_expect == expect::DONE) && (_reported == false)) {
+                _reported = true;
+                result = END;
+            }
+
+            while ((result == NONE) && (_index < _length)) {
+                const char current = _data[_index];
+
+                switch (_lexer) {
+                case lexer::STRING: {
+                    // Take everything up to the next quote or escape in one go.
+                    uint32_t end = _index;
+
+                    while ((end < _length) && (_data[end] != '\"') && (_data[end] != '\\')) {
+                        end++;
+                    }
+                    if (_capture != capture::ACTIVE) {
+                        _text.append(&(_data[_index]), end - _index);
+                    }
+
+                    _index = end;
+
+                    if (end < _length) {
+                        _index++;
+
+                        if (_data[end] == '\\') {
+                            _lexer = lexer::ESCAPE;
+                        } else {
+                            _lexer = lexer::STRUCTURE;
+
+                            if (_name == true) {
+                                _name = false;
+                                _expect = expect::COLON;
+                                result = NAME;
+                            } else {
+                                result = Completed(STRING);
+                            }
+                        }
+                    }
+                    break;
+                }
+                case lexer::ESCAPE: {
+                    char replacement = current;
+
+                    switch (current) {
+                    case '\"':
+                    case '\\':
+                    case '/':
+                        break;
+                    case 'b':
+                        replacement = '\b';
+                        break;
+                    case 'f':
+                        replacement = '\f';
+                        break;
+                    case 'n':
+                        replacement = '\n';
+                        break;
+                    case 'r':
+                        replacement = '\r';
+                        break;
+                    case 't':
+                        replacement = '\t';
+                        break;
+                    case 'u':
+                        // Kept as is, just like JSON::String does.
+                        if (_capture != capture::ACTIVE) {
+                            _text += '\\';
+                        }
+                        break;
+                    default:
+                        result = Fail(_T("Invalid escape sequence \"\\") + string(1, current) + _T("\""));
+                        break;
+                    }
+
+                    if (result == NONE) {
+                        if (_capture != capture::ACTIVE) {
+                            _text += replacement;
+                        }
+                        _index++;
+                        _lexer = lexer::STRING;
+                    }
+                    break;
+                }
+                case lexer::NUMBER:
+                    // Hexadecimal numbers are accepted as well, like JSON::NumberType does.
+                    if ((::isalnum(static_cast<unsigned char>(current)) != 0) || (current == '.') || (current == '-') || (current == '+')) {
+                        if (_capture != capture::ACTIVE) {
+                            _text += current;
+                        }
+                        _index++;
+                    } else {
+                        _lexer = lexer::STRUCTURE;
+                        result = Completed(NUMBER);
+                    }
+                    break;
+                case lexer::LITERAL:
+                    if (::isalpha(static_cast<unsigned char>(current)) != 0) {
+                        if (_capture != capture::ACTIVE) {
+                            _text += current;
+                        }
+                        _index++;
+                    } else {
+                        _lexer = lexer::STRUCTURE;
+                        result = Literal();
+                    }
+                    break;
+                default:
+                    result = Structure(current);
+                    break;
+                }
+            }
+
+            if ((result == NONE) && (_index == _length) && (_closed == true)) {
+                if (_lexer == lexer::NUMBER) {
+                    _lexer = lexer::STRUCTURE;
+                    result = Completed(NUMBER);
+                } else if (_lexer == lexer::LITERAL) {
+                    _lexer = lexer::STRUCTURE;
+                    result = Literal();
+                } else if ((_expect != expect::DONE) && (_expect != expect::FAILED)) {
+                    result = Fail(_T("Unexpected end of the document"));
+                }
+            }
+
+            return (result);
+        }
+
+        Reader::token Reader::Structure(const char current)
+        {
+            token result = NONE;
+
+            if (::isspace(static_cast<unsigned char>(current)) != 0) {
+                _index++;
+            } else {
+                switch (_expect) {
+                case expect::COLON:
+                    if (current == ':') {
+                        _expect = expect::VALUE;
+                        _index++;
+                    } else {
+                        result = Fail(_T("Expected \":\", found \"") + string(1, current) + _T("\""));
+                    }
+                    break;
+                case expect::SEPARATOR:
+                    if (current == ',') {
+                        _expect = (_scopes.back() == '{' ? expect::NAME : expect::VALUE);
+                        _index++;
+                    } else if ((current == '}') || (current == ']')) {
+                        result = Leave(current);
+                    } else {
+                        result = Fail(_T("Expected \",\" or the end of the scope, found \"") + string(1, current) + _T("\""));
+                    }
+                    break;
+                case expect::FIRST_NAME:
+                case expect::NAME:
+                    if (current == '\"') {
+                        _text.clear();
+                        _name = true;
+                        _lexer = lexer::STRING;
+                        _index++;
+                    } else if ((current == '}') && (_expect == expect::FIRST_NAME)) {
+                        result = Leave(current);
+                    } else {
+                        result = Fail(_T("Expected a name, found \"") + string(1, current) + _T("\""));
+                    }
+                    break;
+                case expect::FIRST_ELEMENT:
+                case expect::VALUE:
+                    if ((current == ']') && (_expect == expect::FIRST_ELEMENT)) {
+                        result = Leave(current);
+                    } else if ((current == '{') || (current == '[')) {
+                        if (Depth() >= _maxDepth) {
+                            result = Fail(_T("Nesting too deep"));
+                        } else {
+                            Start();
+                            _scopes += current;
+                            _expect = (current == '{' ? expect::FIRST_NAME : expect::FIRST_ELEMENT);
+                            _index++;
+                            result = (current == '{' ? BEGIN_OBJECT : BEGIN_ARRAY);
+                        }
+                    } else if (current == '\"') {
+                        Start();
+                        _lexer = lexer::STRING;
+                        _index++;
+                    } else if ((current == '-') || (::isdigit(static_cast<unsigned char>(current)) != 0)) {
+                        Start();
+                        _lexer = lexer::NUMBER;
+                    } else if (::isalpha(static_cast<unsigned char>(current)) != 0) {
+                        Start();
+                        _lexer = lexer::LITERAL;
+                    } else {
+                        result = Fail(_T("Expected a value, found \"") + string(1, current) + _T("\""));
+                    }
+                    break;
+                default:
+                    result = Fail(_T("Unexpected \"") + string(1, current) + _T("\" after the end of the document"));
+                    break;
+                }
+            }
+
+            return (result);
+        }
+
+        void Reader::Start()
+        {
+            _text.clear();
+
+            if (_capture == capture::PENDING) {
+                _capture = capture::ACTIVE;
+                _captureStart = _index;
+                _captureDepth = Depth();
+            }
+        }
+
+        Reader::token Reader::Leave(const char current)
+        {
+            token result;
+
+            if (_scopes.back() != (current == '}' ? '{' : '[')) {
+                result = Fail(_T("Unexpected \"") + string(1, current) + _T("\""));
+            } else {
+                _scopes.pop_back();
+                _index++;
+                result = Completed(current == '}' ? END_OBJECT : END_ARRAY);
+            }
+
+            return (result);
+        }
+
+        Reader::token Reader::Literal()
+        {
+            token result;
+
+            if (_capture == capture::ACTIVE) {
+                // Nothing collected, whoever loads it will judge it.
+                result = Completed(BOOLEAN);
+            } else if ((_text == _T("true")) || (_text == _T("false"))) {
+                result = Completed(BOOLEAN);
+            } else if (_text == IElement::NullTag) {
+                result = Completed(NULL_VALUE);
+            } else {
+                result = Fail(_T("Unexpected literal \"") + _text + _T("\""));
+            }
+
+            return (result);
+        }
+
+        Reader::token Reader::Completed(const token value)
+        {
+            _expect = (_scopes.empty() == true ? expect::DONE : expect::SEPARATOR);
+
+            return (value);
+        }
+
+        Reader::token Reader::Fail(string&& message)
+        {
+            _error = Error{ std::move(message) };
+
+            if (_data != nullptr) {
+                _error.Value().Context(_data, _length, _index);
+            }
+
+            _expect = expect::FAILED;
+
+            return (INVALID);
+        }
+
+        // The elements take at most 64K at a time. They report they are done by resetting the offset,
+        // from then on the element is left alone.
+        bool Reader::Forward(const char data[], const uint32_t length)
+        {
+            uint32_t handled = 0;
+
+            while ((_element != nullptr) && (handled < length)) {
+                const uint16_t size = static_cast<uint16_t>(std::min(length - handled, static_cast<uint32_t>(0x8000)));
+                Core::OptionalType<Error> error;
+
+                const uint16_t loaded = _element->Deserialize(&(data[handled]), size, _elementOffset, error);
+
+                if ((error.IsSet() == false) && (loaded == 0) && (_elementOffset != 0)) {
+                    error = Error{ _T("The element did not accept the value") };
+                }
+                if (error.IsSet() == true) {
+                    _error = error;
+                    _element = nullptr;
+                } else if (_elementOffset == 0) {
+                    _element = nullptr;
+                }
+
+                handled += loaded;
+            }
+
+            return (_error.IsSet() == false);
+        }
     }
 }
 
@@ -20,6 +20,9 @@
 #ifndef __JSON_H
 #define __JSON_H
 
+#include <deque>
+#include <iterator>
+#include <list>
 #include <map>
 #include <vector>
 
@@ -105,7 +108,7 @@ namespace Core {
                     ASSERT(loaded <= sizeof(buffer));
                     DEBUG_VARIABLE(loaded);
 
-                    text += string(buffer, loaded);
+                    text.append(buffer, loaded);
 
                 } while ((offset != 0) && (loaded == sizeof(buffer)));
 
@@ -127,11 +130,22 @@ namespace Core {
                 realObject.Clear();
 
                 if (text.empty() == false) {
+                    // The elements take at most 64K at a time, bigger documents are handed over in parts.
+                    const uint32_t length = static_cast<uint32_t>(text.length() + 1);
+                    uint32_t position = 0;
+                    uint16_t size;
+                    uint16_t loaded;
+
                     // Deserialize object
-                    uint16_t loaded = static_cast<IElement&>(realObject).Deserialize(text.c_str(), static_cast<uint16_t>(text.length() + 1), offset, error);
+                    do {
+                        size = static_cast<uint16_t>(std::min(length - position, static_cast<uint32_t>(0xFFFF)));
+                        loaded = static_cast<IElement&>(realObject).Deserialize(&(text.c_str()[position]), size, offset, error);
 
-                    ASSERT(loaded <= (text.length() + 1));
-                    DEBUG_VARIABLE(loaded);
+                        ASSERT(loaded <= size);
+
+                        position += loaded;
+
+                    } while ((offset != 0) && (loaded == size) && (position < length) && (error.IsSet() == false));
                 }
 
                 if (offset != 0 && error.IsSet() == false) {
@@ -410,6 +424,18 @@ namespace Core {
                 return (Core::JSON::IMessagePack::FromFile(fileObject, *this));
             }
 
+            // Opaque values (e.g. the params of a JSON-RPC message) are kept as JSON text, these
+            // convert them from and to their native MessagePack representation.
+            static bool Transcode(const string& text, std::vector<uint8_t>& stream);
+            static uint32_t Transcode(const uint8_t stream[], const uint32_t length, string& text);
+
+            // Size of the first complete value in the stream, 0 if more data is needed and
+            // ~0 if the stream does not hold a valid value.
+            static uint32_t Length(const uint8_t stream[], const uint32_t length);
+            // Same, but resumes where an earlier call on the same (by now longer) stream stopped.
+            // Used holds the bytes walked and pending the values still to come, start at 0 and 1.
+            static uint32_t Length(const uint8_t stream[], const uint32_t length, uint32_t& used, uint64_t& pending);
+
             // JSON Serialization interface
             // --------------------------------------------------------------------------------
             virtual void Clear() = 0;
@@ -699,8 +725,14 @@ namespace Core {
 
                 bool completed = ((_set & ERROR) != 0);
 
+                uint32_t chunk;
+
                 while ((loaded < maxLength) && (completed == false)) {
-                    if (isdigit(stream[loaded])) {
+                    if (((_set & 0x1F) == DECIMAL) && ((maxLength - loaded) >= 8) && (NumberConversion::EightDigits(&stream[loaded], chunk) == true)) {
+                        // Long runs of decimal digits are taken 8 at a time.
+                        _value = static_cast<TYPE>((static_cast<uint64_t>(_value) * 100000000) + chunk);
+                        loaded += 8;
+                    } else if (isdigit(stream[loaded])) {
                         _value *= (_set & 0x1F);
                         _value += (stream[loaded] - '0');
                         loaded++;
@@ -751,7 +783,7 @@ namespace Core {
 
             uint16_t Deserialize(const uint8_t stream[], const uint16_t maxLength, uint16_t& offset) override
             {
-                uint8_t loaded = 0;
+                uint16_t loaded = 0;
                 if (offset == 0) {
                     // First byte depicts a lot. Find out what we need to read
                     _value = 0;
@@ -759,62 +791,66 @@ namespace Core {
 
                     if (header == IMessagePack::NullValue) {
                         _set = UNDEFINED;
+                    } else if ((header & 0x80) == 0) {
+                        _value = header;
+                        _set = SET;
+                    } else if ((header & 0xE0) == 0xE0) {
+                        _value = static_cast<TYPE>(static_cast<int8_t>(header));
+                        _set = SET;
                     } else if ((header >= 0xCC) && (header <= 0xCF)) {
                         _set = (1 << (header - 0xCC)) << 12;
                         offset = 1;
                     } else if ((header >= 0xD0) && (header <= 0xD3)) {
-                        _set = (1 << (header - 0xD0)) << 12;
+                        // Signed encoding, the sign is extended once all bytes are in.
+                        _set = ((1 << (header - 0xD0)) << 12) | NEGATIVE;
                         offset = 1;
-                    } else if ((header & 0x80) == 0) {
-                        _value = (header & 0x7F);
-                    } else if ((header & 0xE0) == 0xE0) {
-                        _value = (header & 0x0F);
-                        _set = NEGATIVE;
                     } else {
                         _set = ERROR;
                     }
                 }
 
                 while ((loaded < maxLength) && (offset != 0)) {
-                    _value = _value << 8;
-                    _value += stream[loaded++];
-                    offset = (offset == ((_set >> 12) & 0xF) ? 0 : offset + 1);
-                }
+                    const uint8_t bytes = ((_set >> 12) & 0xF);
 
-                if (_value != 0) {
-                    _set |= SET;
+                    _value = static_cast<TYPE>((static_cast<uint64_t>(_value) << 8) | stream[loaded++]);
+
+                    if (offset != bytes) {
+                        offset++;
+                    } else {
+                        if (((_set & NEGATIVE) != 0) && (bytes < 8)) {
+                            const uint64_t raw = (static_cast<uint64_t>(_value) & ((1ULL << (8 * bytes)) - 1));
+                            if ((raw >> ((8 * bytes) - 1)) != 0) {
+                                _value = static_cast<TYPE>(raw | (~0ULL << (8 * bytes)));
+                            }
+                        }
+                        _set = SET;
+                        offset = 0;
+                    }
                 }
+
                 return (loaded);
             }
 
-            uint16_t Convert(char stream[], const uint16_t maxLength, uint16_t& offset, const TYPE serialize) const
+            uint16_t Convert(char stream[], const uint16_t maxLength, uint16_t& offset, const uint64_t serialize) const
             {
-                uint8_t parsed = 4;
-                uint16_t loaded = 0;
-                TYPE divider = 1;
-                TYPE value = (serialize / BASETYPE);
+                // Enough for 64 bits in octal, the least dense representation we support.
+                char digits[24];
+                char* const end = &digits[sizeof(digits)];
+                const char* start = (BASETYPE == BASE_HEXADECIMAL ? NumberConversion::PowerOfTwo(end, serialize, 4) : (BASETYPE == BASE_OCTAL ? NumberConversion::PowerOfTwo(end, serialize, 3) : NumberConversion::Decimal(end, serialize)));
 
-                while (divider <= value) {
-                    divider *= BASETYPE;
-                }
+                // The offset counts the digits already written, starting at 4 (after the prefix).
+                ASSERT(offset >= 4);
 
-                value = serialize;
+                uint16_t written = (offset - 4);
+                uint16_t loaded = static_cast<uint16_t>(end - start) - written;
 
-                while ((divider > 0) && (loaded < maxLength)) {
-                    if (parsed >= offset) {
-                        uint8_t digit = static_cast<uint8_t>(value / divider);
-                        if ((BASETYPE != BASE_HEXADECIMAL) || (digit < 10)) {
-                            stream[loaded++] = static_cast<char>('0' + digit);
-                        } else {
-                            stream[loaded++] = static_cast<char>('A' - 10 + digit);
-                        }
-                        offset++;
-                    }
-                    parsed++;
-                    value %= divider;
-                    divider /= BASETYPE;
+                if (loaded > maxLength) {
+                    loaded = maxLength;
                 }
 
+                ::memcpy(stream, &start[written], loaded);
+                offset += loaded;
+
                 if ((BASETYPE == BASE_DECIMAL) && (loaded < maxLength)) {
                     offset = 0;
                 }
@@ -824,90 +860,62 @@ namespace Core {
 
             uint16_t Convert(char stream[], const uint16_t maxLength, uint16_t& offset, const TemplateIntToType<false>& /* For compile time diffrentiation */) const
             {
-                return (Convert(stream, maxLength, offset, _value));
+                return (Convert(stream, maxLength, offset, static_cast<uint64_t>(_value)));
             }
 
             uint16_t Convert(char stream[], const uint16_t maxLength, uint16_t& offset, const TemplateIntToType<true>& /* For c ompile time diffrentiation */) const
             {
-                return (Convert(stream, maxLength, offset, ::abs(_value)));
+                return (Convert(stream, maxLength, offset, (_value < 0 ? (0 - static_cast<uint64_t>(_value)) : static_cast<uint64_t>(_value))));
             }
 
             uint16_t Convert(uint8_t stream[], const uint16_t maxLength, uint16_t& offset, const TemplateIntToType<false>& /* For compile time diffrentiation */) const
             {
-                uint8_t loaded = 0;
-                uint8_t bytes = (_value <= 0x7F ? 0 : _value < 0xFF ? 1 : _value < 0xFFFF ? 2 : _value < 0xFFFFFFFF ? 4 : 8);
+                const uint64_t value = static_cast<uint64_t>(_value);
 
-                if (offset == 0) {
-                    if (bytes == 0) {
-                        if (_value != 0) {
-                            stream[loaded++] = static_cast<uint8_t>(_value);
-                        } else {
-                            stream[loaded++] = IMessagePack::NullValue;
-                        }
-                    } else {
-                        switch (bytes) {
-                        case 1:
-                            stream[loaded++] = 0xCC;
-                            break;
-                        case 2:
-                            stream[loaded++] = 0xCD;
-                            break;
-                        case 4:
-                            stream[loaded++] = 0xCE;
-                            break;
-                        case 8:
-                            stream[loaded++] = 0xCF;
-                            break;
-                        default:
-                            ASSERT(false);
-                        }
-                        offset = 1;
-                    }
+                if (value <= 0x7F) {
+                    return (Pack(stream, maxLength, offset, 0x00, 0));
+                } else if (value <= 0xFF) {
+                    return (Pack(stream, maxLength, offset, 0xCC, 1));
+                } else if (value <= 0xFFFF) {
+                    return (Pack(stream, maxLength, offset, 0xCD, 2));
+                } else if (value <= 0xFFFFFFFF) {
+                    return (Pack(stream, maxLength, offset, 0xCE, 4));
                 }
+                return (Pack(stream, maxLength, offset, 0xCF, 8));
+            }
 
-                while ((loaded < maxLength) && (offset != 0)) {
-                    TYPE value = _value >> (8 * (bytes - offset));
+            uint16_t Convert(uint8_t stream[], const uint16_t maxLength, uint16_t& offset, const TemplateIntToType<true>& /* For c ompile time diffrentiation */) const
+            {
+                const int64_t value = static_cast<int64_t>(_value);
 
-                    stream[loaded++] = static_cast<uint8_t>(value & 0xFF);
-                    offset = (offset == bytes ? 0 : offset + 1);
+                if ((value >= -32) && (value <= 0x7F)) {
+                    return (Pack(stream, maxLength, offset, 0x00, 0));
+                } else if ((value >= NUMBER_MIN_SIGNED(int8_t)) && (value <= NUMBER_MAX_SIGNED(int8_t))) {
+                    return (Pack(stream, maxLength, offset, 0xD0, 1));
+                } else if ((value >= NUMBER_MIN_SIGNED(int16_t)) && (value <= NUMBER_MAX_SIGNED(int16_t))) {
+                    return (Pack(stream, maxLength, offset, 0xD1, 2));
+                } else if ((value >= NUMBER_MIN_SIGNED(int32_t)) && (value <= NUMBER_MAX_SIGNED(int32_t))) {
+                    return (Pack(stream, maxLength, offset, 0xD2, 4));
                 }
-
-                return (loaded);
+                return (Pack(stream, maxLength, offset, 0xD3, 8));
             }
 
-            uint16_t Convert(uint8_t stream[], const uint16_t maxLength, uint16_t& offset, const TemplateIntToType<true>& /* For c ompile time diffrentiation */) const
+            // A marker followed by the value in big endian, or the value as a fixed int if it needs no bytes.
+            uint16_t Pack(uint8_t stream[], const uint16_t maxLength, uint16_t& offset, const uint8_t marker, const uint8_t bytes) const
             {
-                uint8_t loaded = 0;
-                uint8_t bytes = (((_value < 16) && (_value > -15)) ? 0 : ((_value < 128) && (_value > -127)) ? 1 : ((_value < 32767) && (_value > -32766)) ? 2 : ((_value < 2147483647) && (_value > -2147483646)) ? 4 : 8);
+                uint16_t loaded = 0;
 
                 if (offset == 0) {
                     if (bytes == 0) {
-                        stream[loaded++] = (_value & 0x1F) | 0xE0;
+                        stream[loaded++] = static_cast<uint8_t>(_value);
                     } else {
-                        switch (bytes) {
-                        case 1:
-                            stream[loaded++] = 0xD0;
-                            break;
-                        case 2:
-                            stream[loaded++] = 0xD1;
-                            break;
-                        case 4:
-                            stream[loaded++] = 0xD2;
-                            break;
-                        case 8:
-                            stream[loaded++] = 0xD3;
-                            break;
-                        default:
-                            ASSERT(false);
-                        }
+                        stream[loaded++] = marker;
                         offset = 1;
                     }
                 }
 
                 while ((loaded < maxLength) && (offset != 0)) {
-                    TYPE value = _value >> (8 * (bytes - offset));
-
-                    stream[loaded++] = static_cast<uint8_t>(value & 0xFF);
+                    stream[loaded++] = static_cast<uint8_t>(static_cast<uint64_t>(_value) >> (8 * (bytes - offset)));
                     offset = (offset == bytes ? 0 : offset + 1);
                 }
 
@@ -1156,6 +1164,9 @@ namespace Core {
             static constexpr uint32_t SetBit = 0x40000000;
             static constexpr uint32_t QuoteFoundBit = 0x20000000;
             static constexpr uint32_t NullBit = 0x10000000;
+            static constexpr uint32_t OpaqueValue = ~0;
+            // Upper bound for the MessagePack bytes of an opaque value that are collected.
+            static constexpr uint32_t MaxOpaqueSize = 4 * 1024 * 1024;
 
             template <int N>
             uint8_t MaxOpaqueObjectDepth()
@@ -1167,6 +1178,8 @@ namespace Core {
             explicit String(const bool quoted = true)
                 : _default()
                 , _scopeCount(quoted ? QuotedSerializeBit : None)
+                , _walked(0)
+                , _pending(0)
                 , _value()
             {
             }
@@ -1174,6 +1187,8 @@ namespace Core {
             explicit String(const string& Value, const bool quoted = true)
                 : _default()
                 , _scopeCount(quoted ? QuotedSerializeBit : None)
+                , _walked(0)
+                , _pending(0)
                 , _value()
             {
                 Core::ToString(Value.c_str(), _default);
@@ -1182,6 +1197,8 @@ namespace Core {
             explicit String(const char Value[], const bool quoted = true)
                 : _default()
                 , _scopeCount(quoted ? QuotedSerializeBit : None)
+                , _walked(0)
+                , _pending(0)
                 , _value()
             {
                 Core::ToString(Value, _default);
@@ -1191,6 +1208,8 @@ namespace Core {
             explicit String(const wchar_t Value[], const bool quoted = true)
                 : _default()
                 , _scopeCount(quoted ? QuotedSerializeBit : None)
+                , _walked(0)
+                , _pending(0)
                 , _value()
             {
                 Core::ToString(Value, _default);
@@ -1200,6 +1219,8 @@ namespace Core {
             String(const String& copy)
                 : _default(copy._default)
                 , _scopeCount(copy._scopeCount & (QuotedSerializeBit | SetBit))
+                , _walked(0)
+                , _pending(0)
                 , _value(copy._value)
             {
             }
@@ -1216,6 +1237,14 @@ namespace Core {
                 return (*this);
             }
 
+            String& operator=(std::string&& RHS)
+            {
+                _value = std::move(RHS);
+                _scopeCount |= SetBit;
+
+                return (*this);
+            }
+
             String& operator=(const char RHS[])
             {
                 Core::ToString(RHS, _value);
@@ -1354,6 +1383,13 @@ namespace Core {
                 return (str.length() > 0) && (str[str.length() - 1] == ch);
             }
 
+            // For derived types that collect the text themselves.
+            inline void Append(const char text[], const uint32_t length)
+            {
+                _value.append(text, length);
+                _scopeCount |= SetBit;
+            }
+
             // IElement iface:
             uint16_t Serialize(char stream[], const uint16_t maxLength, uint16_t& offset) const override
             {
@@ -1508,7 +1544,9 @@ namespace Core {
                 }
 
                 if (finished == false) {
-                    offset = static_cast<uint16_t>(_value.length()) + _unaccountedCount;
+                    // Only tells there is more to come, the progress is in _value. Keep it small, the
+                    // enclosing containers add their own state to it.
+                    offset = ((_value.empty() == true) && (_unaccountedCount == 0) ? 0 : 1);
                 } else {
                     offset = 0;
                     _scopeCount |= ((_scopeCount & QuoteFoundBit) ? SetBit : (_value == NullTag ? NullBit : SetBit));
@@ -1518,49 +1556,72 @@ namespace Core {
             }
 
             // IMessagePack iface:
+            // While a value is in progress the offset only flags that, the position within the value
+            // is kept in _unaccountedCount so strings of any size (str32) fit.
             uint16_t Serialize(uint8_t stream[], const uint16_t maxLength, uint16_t& offset) const override
             {
                 uint16_t loaded = 0;
+
                 if (offset == 0) {
                     if ((_scopeCount & NullBit) != 0) {
                         stream[loaded++] = IMessagePack::NullValue;
-                    } else if (_value.length() <= 31) {
-                        _unaccountedCount = 1;
-                        stream[loaded++] = static_cast<uint8_t>(_value.length() | 0xA0);
-                        offset++;
-                    } else if (_value.length() <= 0xFF) {
-                        _unaccountedCount = 2;
-                        stream[loaded++] = 0xD9;
-                        offset++;
-                    } else if (_value.length() <= 0xFFFF) {
-                        _unaccountedCount = 3;
-                        stream[loaded++] = 0xDA;
-                        offset++;
-                    } else {
-                        stream[loaded++] = IMessagePack::NullValue;
+                        return (loaded);
                     }
-                }
 
-                if (offset != 0) {
-                    while ((loaded < maxLength) && (offset < _unaccountedCount)) {
-                        stream[loaded++] = static_cast<uint8_t>((_value.length() >> (8 * (_unaccountedCount - offset - 1))) & 0xFF);
-                        offset++;
-                    }
+                    _packed.clear();
+                    _unaccountedCount = 0;
 
-                    uint16_t copied = 0;
-                    while ((loaded < maxLength) && (offset != 0)) {
-                        copied = static_cast<uint16_t>(_value.copy(reinterpret_cast<char*>(&stream[loaded]), (maxLength - loaded), offset - _unaccountedCount));
-                        offset += copied;
-                        loaded += copied;
-                        if (_unaccountedCount) {
-                           offset -=_unaccountedCount;
-                           _unaccountedCount = 0;
+                    if (IsOpaque() == true) {
+                        // An opaque value, send it as the native MessagePack value its JSON text describes.
+                        // It is transcoded once, the chunks are taken from the packed buffer.
+                        if (IMessagePack::Transcode(_value, _packed) == false) {
+                            TRACE_L1(_T("Opaque value is not valid JSON, sent as nil"));
+                            _packed.assign(1, IMessagePack::NullValue);
                         }
-
-                        if (offset >= _value.length()) {
-                            offset = 0;
+                    } else {
+                        const uint32_t length = static_cast<uint32_t>(_value.length());
+                        uint8_t bytes = 0;
+
+                        if (length <= 31) {
+                            _packed.push_back(static_cast<uint8_t>(length | 0xA0));
+                        } else if (length <= 0xFF) {
+                            _packed.push_back(0xD9);
+                            bytes = 1;
+                        } else if (length <= 0xFFFF) {
+                            _packed.push_back(0xDA);
+                            bytes = 2;
+                        } else {
+                            _packed.push_back(0xDB);
+                            bytes = 4;
+                        }
+                        while (bytes > 0) {
+                            bytes--;
+                            _packed.push_back(static_cast<uint8_t>(length >> (8 * bytes)));
                         }
                     }
+
+                    offset = 1;
+                }
+
+                // The packed bytes go first, for a string the text follows.
+                const uint32_t packed = static_cast<uint32_t>(_packed.size());
+                const uint32_t total = packed + (IsOpaque() == true ? 0 : static_cast<uint32_t>(_value.length()));
+
+                if (_unaccountedCount < packed) {
+                    const uint16_t chunk = static_cast<uint16_t>(std::min(static_cast<uint32_t>(maxLength), packed - _unaccountedCount));
+                    ::memcpy(stream, &(_packed[_unaccountedCount]), chunk);
+                    _unaccountedCount += chunk;
+                    loaded = chunk;
+                }
+                if ((loaded < maxLength) && (_unaccountedCount < total)) {
+                    const uint16_t chunk = static_cast<uint16_t>(_value.copy(reinterpret_cast<char*>(&stream[loaded]), maxLength - loaded, _unaccountedCount - packed));
+                    _unaccountedCount += chunk;
+                    loaded += chunk;
+                }
+                if (_unaccountedCount == total) {
+                    _packed.clear();
+                    _unaccountedCount = 0;
+                    offset = 0;
                 }
 
                 return (loaded);
@@ -1569,22 +1630,27 @@ namespace Core {
             uint16_t Deserialize(const uint8_t stream[], const uint16_t maxLength, uint16_t& offset) override
             {
                 uint16_t loaded = 0;
+
+                if ((offset == 0) ? (((_scopeCount & QuotedSerializeBit) == 0) && (stream[0] != IMessagePack::NullValue)) : (_unaccountedCount == OpaqueValue)) {
+                    return (DeserializeOpaque(stream, maxLength, offset));
+                }
+
+                // The offset counts the length bytes still to come plus one, the text is complete
+                // once it holds the announced length.
                 if (offset == 0) {
+                    const uint8_t marker = stream[loaded];
+
                     _value.clear();
-                    if (stream[loaded] == IMessagePack::NullValue) {
+                    if (marker == IMessagePack::NullValue) {
                         _scopeCount |= NullBit;
                         loaded++;
-                    } else if ((stream[loaded] & 0xA0) == 0xA0) {
-                        _unaccountedCount = stream[loaded] & 0x1F;
-                        offset = 3;
-                        loaded++;
-                    } else if (stream[loaded] == 0xD9) {
-                        _unaccountedCount = 0;
-                        offset = 2;
+                    } else if ((marker & 0xE0) == 0xA0) {
+                        _unaccountedCount = marker & 0x1F;
+                        offset = 1;
                         loaded++;
-                    } else if (stream[loaded] == 0xDA) {
+                    } else if ((marker >= 0xD9) && (marker <= 0xDB)) {
                         _unaccountedCount = 0;
-                        offset = 1;
+                        offset = 1 + (1 << (marker - 0xD9));
                         loaded++;
                     } else {
                         loaded = maxLength;
@@ -1592,19 +1658,21 @@ namespace Core {
                 }
 
                 if (offset != 0) {
-                    while ((loaded < maxLength) && (offset < 3)) {
-                        _unaccountedCount = (_unaccountedCount << 8) + stream[loaded++];
-                        offset++;
+                    while ((loaded < maxLength) && (offset > 1)) {
+                        _unaccountedCount = (_unaccountedCount << 8) | stream[loaded++];
+                        offset--;
                     }
 
-                    while ((loaded < maxLength) && ((offset - 3) < static_cast<uint16_t>(_unaccountedCount))) {
-                        _value += static_cast<char>(stream[loaded++]);
-                        offset++;
-                    }
+                    if (offset == 1) {
+                        const uint16_t chunk = static_cast<uint16_t>(std::min(static_cast<uint32_t>(maxLength - loaded), _unaccountedCount - static_cast<uint32_t>(_value.length())));
+                        _value.append(reinterpret_cast<const char*>(&stream[loaded]), chunk);
+                        loaded += chunk;
 
-                    if ((offset >= 3) && (static_cast<uint16_t>(offset - 3) == _unaccountedCount)) {
-                        offset = 0;
-                        _scopeCount |= ((_scopeCount & QuoteFoundBit) ? SetBit : (_value == NullTag ? NullBit : SetBit));
+                        if (_value.length() == _unaccountedCount) {
+                            offset = 0;
+                            _unaccountedCount = 0;
+                            _scopeCount |= ((_scopeCount & QuoteFoundBit) ? SetBit : (_value == NullTag ? NullBit : SetBit));
+                        }
                     }
                 }
 
@@ -1612,6 +1680,55 @@ namespace Core {
             }
 
         private:
+            bool IsOpaque() const
+            {
+                return (((_scopeCount & (QuotedSerializeBit | QuoteFoundBit | NullBit | SetBit)) == SetBit) && (_value.empty() == false));
+            }
+
+            // An opaque value can be any MessagePack value. Its bytes are collected until the value is
+            // complete, after which it is stored as the JSON text it represents. The headers are walked
+            // as the bytes come in, each chunk continues the walk where the previous one stopped.
+            uint16_t DeserializeOpaque(const uint8_t stream[], const uint16_t maxLength, uint16_t& offset)
+            {
+                uint16_t loaded = maxLength;
+
+                if (offset == 0) {
+                    _value.clear();
+                    _unaccountedCount = OpaqueValue;
+                    _walked = 0;
+                    _pending = 1;
+                }
+
+                const uint32_t collected = static_cast<uint32_t>(_value.length());
+                _value.append(reinterpret_cast<const char*>(stream), std::min(static_cast<uint32_t>(maxLength), MaxOpaqueSize - collected));
+
+                uint32_t size = IMessagePack::Length(reinterpret_cast<const uint8_t*>(_value.data()), static_cast<uint32_t>(_value.length()), _walked, _pending);
+
+                if ((size == 0) && (_value.length() >= MaxOpaqueSize)) {
+                    TRACE_L1(_T("Opaque value exceeds %d bytes, dropped"), MaxOpaqueSize);
+                    size = ~0;
+                }
+
+                if (size == 0) {
+                    // Still incomplete, the collected bytes keep track of the progress.
+                    offset = 1;
+                } else {
+                    string text;
+
+                    if ((size != static_cast<uint32_t>(~0)) && (IMessagePack::Transcode(reinterpret_cast<const uint8_t*>(_value.data()), size, text) == size)) {
+                        loaded = static_cast<uint16_t>(size - collected);
+                        _value = std::move(text);
+                        _scopeCount |= SetBit;
+                    } else {
+                        _value.clear();
+                    }
+                    _unaccountedCount = 0;
+                    offset = 0;
+                }
+
+                return (loaded);
+            }
+
             bool IsValidEscapeSequence(char current) const
             {
                 ASSERT(MatchLastCharacter(_value, '\\') == true);
@@ -1681,6 +1798,9 @@ namespace Core {
             // This constrains the maximal depth of the opaque object to be 23.
             uint32_t _scopeCount;
             mutable uint32_t _unaccountedCount;
+            mutable std::vector<uint8_t> _packed;
+            uint32_t _walked;
+            uint64_t _pending;
             std::string _value;
         };
 
@@ -2170,7 +2290,12 @@ namespace Core {
             mutable NumberType<uint32_t, FALSE, BASE_HEXADECIMAL> _package;
         };
 
-        template <typename ELEMENT>
+        // By default the elements are kept in a std::list, adding one never moves the others, so
+        // references and iterators stay valid. With a std::deque as STORAGE references stay valid on
+        // Add() as well, but it allocates in chunks and indexes in constant time. A std::vector is the
+        // fastest to fill (Reserve() up front) and to walk, but Add() may move the elements, so only
+        // use it if nobody holds on to them.
+        template <typename ELEMENT, typename STORAGE = std::list<ELEMENT>>
         class ArrayType : public IElement, public IMessagePack {
         private:
             enum modus : uint8_t {
@@ -2188,7 +2313,7 @@ namespace Core {
             template <typename ARRAYELEMENT>
             class ConstIteratorType {
             private:
-                typedef std::list<ARRAYELEMENT> ArrayContainer;
+                typedef STORAGE ArrayContainer;
                 enum State {
                     AT_BEGINNING,
                     AT_ELEMENT,
@@ -2285,7 +2410,7 @@ namespace Core {
             template <typename ARRAYELEMENT>
             class IteratorType {
             private:
-                typedef std::list<ARRAYELEMENT> ArrayContainer;
+                typedef STORAGE ArrayContainer;
                 enum State {
                     AT_BEGINNING,
                     AT_ELEMENT,
@@ -2396,7 +2521,7 @@ namespace Core {
             {
             }
 
-            ArrayType(const ArrayType<ELEMENT>& copy)
+            ArrayType(const ArrayType<ELEMENT, STORAGE>& copy)
                 : _data(copy._data)
                 , _iterator(_data)
             {
@@ -2430,9 +2555,15 @@ namespace Core {
                 return static_cast<uint16_t>(_data.size());
             }
 
+            // Only has an effect if the elements are kept in a std::vector.
+            inline void Reserve(const uint32_t count)
+            {
+                Allocate(_data, count);
+            }
+
             inline ELEMENT& Add()
             {
-                _data.push_back(ELEMENT());
+                _data.emplace_back();
 
                 return (_data.back());
             }
@@ -2446,36 +2577,17 @@ namespace Core {
 
             ELEMENT& operator[](const uint32_t index)
             {
-                uint32_t skip = index;
                 ASSERT(index < Length());
 
-                typename std::list<ELEMENT>::iterator locator = _data.begin();
-
-                while (skip != 0) {
-                    locator++;
-                    skip--;
-                }
-
-                ASSERT(locator != _data.end());
-
-                return (*locator);
+                // Constant time, unless the elements are kept in a std::list.
+                return (*std::next(_data.begin(), index));
             }
 
             const ELEMENT& operator[](const uint32_t index) const
             {
-                uint32_t skip = index;
                 ASSERT(index < Length());
 
-                typename std::list<ELEMENT>::const_iterator locator = _data.begin();
-
-                while (skip != 0) {
-                    locator++;
-                    skip--;
-                }
-
-                ASSERT(locator != _data.end());
-
-                return (*locator);
+                return (*std::next(_data.begin(), index));
             }
 
             const ELEMENT& Get(const uint32_t index) const
@@ -2493,7 +2605,7 @@ namespace Core {
                 return (ConstIterator(_data));
             }
 
-            ArrayType<ELEMENT>& operator=(const ArrayType<ELEMENT>& RHS)
+            ArrayType<ELEMENT, STORAGE>& operator=(const ArrayType<ELEMENT, STORAGE>& RHS)
             {
                 _state = RHS._state;
                 _data = RHS._data;
@@ -2509,7 +2621,7 @@ namespace Core {
                 return (result);
             }
 
-            inline ArrayType<ELEMENT>& operator=(const string& RHS)
+            inline ArrayType<ELEMENT, STORAGE>& operator=(const string& RHS)
             {
                 FromString(RHS);
                 return (*this);
@@ -2607,7 +2719,7 @@ namespace Core {
                                     ++loaded;
                                 } else {
                                     offset = PARSE;
-                                    _data.push_back(ELEMENT());
+                                    _data.emplace_back();
                                 }
                                 break;
                             }
@@ -2673,13 +2785,15 @@ namespace Core {
                 if (offset == 0) {
                     if (stream[0] == IMessagePack::NullValue) {
                         _state = UNDEFINED;
-                        loaded = 1;
                     } else if ((stream[0] & 0xF0) == 0x90) {
                         _count = (stream[0] & 0x0F);
-                        offset = PARSE;
-                    } else if (stream[0] & 0xDC) {
+                        Anticipate(maxLength - 1);
+                        offset = (_count > 0 ? PARSE : 0);
+                    } else if (stream[0] == 0xDC) {
+                        _count = 0;
                         offset = 1;
                     }
+                    loaded = 1;
                 }
 
                 while ((loaded < maxLength) && (offset > 0) && (offset < PARSE)) {
@@ -2688,34 +2802,49 @@ namespace Core {
                         offset = 2;
                     } else if (offset == 2) {
                         _count = (_count << 8) | stream[loaded++];
-                        offset = PARSE;
+                        Anticipate(maxLength - loaded);
+                        offset = (_count > 0 ? PARSE : 0);
                     }
                 }
 
                 while ((loaded < maxLength) && (offset >= PARSE)) {
-
                     if (offset == PARSE) {
-                        if (_count > 0) {
-                            _count--;
-                            _data.emplace_back(ELEMENT());
-                        } else {
-                            offset = 0;
-                        }
+                        _data.emplace_back();
                     }
-                    if (offset >= PARSE) {
-                        offset -= PARSE;
-                        loaded += static_cast<IMessagePack&>(_data.back()).Deserialize(stream, maxLength, offset);
-                        offset += PARSE;
+
+                    offset -= PARSE;
+                    loaded += static_cast<IMessagePack&>(_data.back()).Deserialize(&(stream[loaded]), maxLength - loaded, offset);
+                    offset += PARSE;
+
+                    // Seems like another element is completed, reduce the count.
+                    if ((offset == PARSE) && (--_count == 0)) {
+                        offset = 0;
                     }
                 }
 
                 return (loaded);
             }
 
+        private:
+            // The count is taken from the stream as is. Every element takes at least one byte, so never
+            // reserve more than the bytes at hand can fill, the rest is allocated as the elements arrive.
+            void Anticipate(const uint16_t available)
+            {
+                Reserve(static_cast<uint32_t>(_data.size()) + std::min(_count, available));
+            }
+            template <typename CONTAINER>
+            static void Allocate(CONTAINER&, const uint32_t)
+            {
+            }
+            static void Allocate(std::vector<ELEMENT>& data, const uint32_t count)
+            {
+                data.reserve(count);
+            }
+
         private:
             uint8_t _state;
             uint16_t _count;
-            std::list<ELEMENT> _data;
+            STORAGE _data;
             mutable IteratorType<ELEMENT> _iterator;
         };
 
@@ -3288,6 +3417,7 @@ namespace Core {
             Variant()
                 : JSON::String(false)
                 , _type(type::EMPTY)
+                , _scope(0)
             {
                 String::operator=("null");
             }
@@ -3295,6 +3425,7 @@ namespace Core {
             Variant(const int32_t value)
                 : JSON::String(false)
                 , _type(type::NUMBER)
+                , _scope(0)
             {
                 String::operator=(Core::NumberType<int32_t, true, NumberBase::BASE_DECIMAL>(value).Text());
             }
@@ -3302,6 +3433,7 @@ namespace Core {
             Variant(const int64_t value)
                 : JSON::String(false)
                 , _type(type::NUMBER)
+                , _scope(0)
             {
                 String::operator=(Core::NumberType<int64_t, true, NumberBase::BASE_DECIMAL>(value).Text());
             }
@@ -3309,6 +3441,7 @@ namespace Core {
             Variant(const uint32_t value)
                 : JSON::String(false)
                 , _type(type::NUMBER)
+                , _scope(0)
             {
                 String::operator=(Core::NumberType<uint32_t, false, NumberBase::BASE_DECIMAL>(value).Text());
             }
@@ -3316,6 +3449,7 @@ namespace Core {
             Variant(const uint64_t value)
                 : JSON::String(false)
                 , _type(type::NUMBER)
+                , _scope(0)
             {
                 String::operator=(Core::NumberType<uint64_t, false, NumberBase::BASE_DECIMAL>(value).Text());
             }
@@ -3323,6 +3457,7 @@ namespace Core {
             Variant(const bool value)
                 : JSON::String(false)
                 , _type(type::BOOLEAN)
+                , _scope(0)
             {
                 String::operator=(value ? _T("true") : _T("false"));
             }
@@ -3330,6 +3465,7 @@ namespace Core {
             Variant(const string& text)
                 : JSON::String(true)
                 , _type(type::STRING)
+                , _scope(0)
             {
                 String::operator=(text);
             }
@@ -3337,6 +3473,7 @@ namespace Core {
             Variant(const TCHAR* text)
                 : JSON::String(true)
                 , _type(type::STRING)
+                , _scope(0)
             {
                 String::operator=(text);
             }
@@ -3344,6 +3481,7 @@ namespace Core {
             Variant(const Variant& copy)
                 : JSON::String(copy)
                 , _type(copy._type)
+                , _scope(0)
             {
             }
 
@@ -3484,34 +3622,44 @@ namespace Core {
             // IElement iface:
             uint16_t Deserialize(const char stream[], const uint16_t maxLength, uint16_t& offset, Core::OptionalType<Error>& error) override;
 
-            static uint16_t FindEndOfScope(const char stream[], uint16_t maxLength)
-            {
-                ASSERT(maxLength > 0 && (stream[0] == '{' || stream[0] == '['));
-                char charOpen = stream[0];
-                char charClose = charOpen == '{' ? '}' : ']';
-                uint16_t stack = 1;
-                uint16_t endIndex = 0;
-                bool insideQuotes = false;
-                for (uint16_t i = 1; i < maxLength; ++i) {
-                    if (stream[i] == '\"') {
-                        insideQuotes = !insideQuotes;
-                    }
-                    if (!insideQuotes) {
-                        if (stream[i] == charClose)
-                            stack--;
-                        else if (stream[i] == charOpen)
-                            stack++;
-                        if (stack == 0) {
-                            endIndex = i;
-                            break;
+            // Collects the text of an object or array as is, it is only parsed if it is asked for. The
+            // scope is kept in between calls, so it can span chunks.
+            uint16_t Scope(const char stream[], const uint16_t maxLength)
+            {
+                uint16_t loaded = 0;
+                bool finished = false;
+
+                while ((loaded < maxLength) && (finished == false)) {
+                    const char current = stream[loaded++];
+
+                    if ((_scope & EscapedBit) != 0) {
+                        _scope &= ~EscapedBit;
+                    } else if ((_scope & QuotedBit) != 0) {
+                        if (current == '\\') {
+                            _scope |= EscapedBit;
+                        } else if (current == '\"') {
+                            _scope &= ~QuotedBit;
                         }
+                    } else if (current == '\"') {
+                        _scope |= QuotedBit;
+                    } else if ((current == '{') || (current == '[')) {
+                        _scope++;
+                    } else if ((current == '}') || (current == ']')) {
+                        _scope--;
+                        finished = ((_scope & DepthMask) == 0);
                     }
                 }
-                return endIndex;
+
+                return (loaded);
             }
 
         private:
+            static constexpr uint32_t QuotedBit = 0x80000000;
+            static constexpr uint32_t EscapedBit = 0x40000000;
+            static constexpr uint32_t DepthMask = 0x3FFFFFFF;
+
             type _type;
+            uint32_t _scope;
         };
 
         class EXTERNAL VariantContainer : public Container {
@@ -3795,6 +3943,7 @@ namespace Core {
         inline Variant::Variant(const VariantContainer& object)
             : JSON::String(false)
             , _type(type::OBJECT)
+            , _scope(0)
         {
             string value;
             object.ToString(value);
@@ -3819,20 +3968,20 @@ namespace Core {
         inline uint16_t Variant::Deserialize(const char stream[], const uint16_t maxLength, uint16_t& offset, Core::OptionalType<Error>& error)
         {
             uint16_t result = 0;
-            if (stream[0] == '{' || stream[0] == '[') {
-                uint16_t endIndex = FindEndOfScope(stream, maxLength);
-                if (endIndex > 0 && endIndex < maxLength) {
-                    result = endIndex + 1;
+            const bool scope = (offset == 0 ? ((stream[0] == '{') || (stream[0] == '[')) : ((_type == type::OBJECT) || (_type == type::ARRAY)));
+
+            if (scope == true) {
+                if (offset == 0) {
+                    _type = (stream[0] == '{' ? type::OBJECT : type::ARRAY);
+                    _scope = 0;
                     SetQuoted(false);
-                    string str(stream, endIndex + 1);
-                    if (stream[0] == '{') {
-                        _type = type::OBJECT;
-                        String::operator=(str);
-                    } else {
-                        _type = type::ARRAY;
-                        String::operator=(str);
-                    }
+                    String::operator=(string());
                 }
+
+                result = Scope(stream, maxLength);
+                Append(stream, result);
+
+                offset = ((_scope & DepthMask) == 0 ? 0 : 1);
             } else {
                 result = String::Deserialize(stream, maxLength, offset, error);
 
@@ -3855,6 +4004,132 @@ namespace Core {
             return (result);
         }
 
+        // Pull parser for documents that are too big to keep in memory, or are not wanted in memory as
+        // a whole. The text is fed in chunks of any size and Next() reports it one token at a time, a
+        // token split over chunks is reported once it is complete. Instead of walking through its
+        // tokens, a value can also be handed to an IElement (Load) as it streams by, or be skipped.
+        // Strings are unescaped the same way JSON::String does it, \uXXXX sequences are kept as is.
+        class EXTERNAL Reader {
+        public:
+            enum token : uint8_t {
+                NONE, // All data is consumed, Feed() the next chunk.
+                BEGIN_OBJECT,
+                END_OBJECT,
+                BEGIN_ARRAY,
+                END_ARRAY,
+                NAME,
+                STRING,
+                NUMBER,
+                BOOLEAN,
+                NULL_VALUE,
+                ELEMENT, // The value that was Load()ed or Skip()ped is complete.
+                END, // The document is complete.
+                INVALID // See Failure(), Reset() to start over.
+            };
+
+        private:
+            enum class expect : uint8_t {
+                VALUE,
+                FIRST_ELEMENT,
+                FIRST_NAME,
+                NAME,
+                COLON,
+                SEPARATOR,
+                DONE,
+                FAILED
+            };
+
+            enum class lexer : uint8_t {
+                STRUCTURE,
+                STRING,
+                ESCAPE,
+                NUMBER,
+                LITERAL
+            };
+
+            enum class capture : uint8_t {
+                NONE,
+                PENDING,
+                ACTIVE
+            };
+
+        public:
+            Reader(const Reader&) = delete;
+            Reader& operator=(const Reader&) = delete;
+
+            explicit Reader(const uint16_t maxDepth = 256);
+            ~Reader();
+
+        public:
+            void Reset();
+
+            // The data is not copied, it has to stay valid until Next() returns NONE.
+            void Feed(const char data[], const uint32_t length);
+            // No more data will follow, this completes a number at the very end of the document.
+            void Close();
+
+            token Next();
+
+            // Load the next value into the element, Next() returns ELEMENT once it is complete.
+            void Load(IElement& element);
+            void Skip();
+
+            // Text of the NAME, STRING, NUMBER and BOOLEAN tokens.
+            inline const string& Text() const
+            {
+                return (_text);
+            }
+            // Number of objects and arrays the last token is in.
+            inline uint16_t Depth() const
+            {
+                return (static_cast<uint16_t>(_scopes.size()));
+            }
+            // Bytes consumed since the start of the document.
+            inline uint64_t Position() const
+            {
+                return (_consumed + _index);
+            }
+            inline bool IsComplete() const
+            {
+                return (_expect == expect::DONE);
+            }
+            inline const Core::OptionalType<Error>& Failure() const
+            {
+                return (_error);
+            }
+
+        private:
+            token Scan();
+            token Structure(const char current);
+            void Start();
+            token Leave(const char current);
+            token Literal();
+            token Completed(const token value);
+            token Fail(string&& message);
+            bool Forward(const char data[], const uint32_t length);
+
+        private:
+            const uint16_t _maxDepth;
+            const char* _data;
+            uint32_t _length;
+            uint32_t _index;
+            uint64_t _consumed;
+            bool _closed;
+            bool _name;
+            bool _reported;
+            expect _expect;
+            lexer _lexer;
+            string _scopes;
+            string _text;
+            Core::OptionalType<Error> _error;
+
+            capture _capture;
+            uint16_t _captureDepth;
+            uint32_t _captureStart;
+            IElement* _element;
+            uint16_t _elementOffset;
+        };
+
         template <uint16_t SIZE, typename INSTANCEOBJECT>
         class Tester {
         private:
@@ -132,82 +132,129 @@ namespace Core {
             }
 
         public:
-            static string Callsign(const string& designator)
-            {
-                size_t pos = designator.find_last_of('.', designator.find_last_of('@'));
-                if ((pos != string::npos) && (pos > 0)) {
-                    size_t index = pos - 1;
-                    while ((index != 0) && (isdigit(designator[index]))) {
-                        index--;
+            // Splits a designator ([callsign.][version.]method[@index]) in a single pass. All parts
+            // are returned as views on the designator, so it must outlive the Designation.
+            class Designation {
+            private:
+                Designation() = delete;
+                Designation(const Designation&) = delete;
+                Designation& operator=(const Designation&) = delete;
+
+            public:
+                explicit Designation(const string& designator)
+                    : _designator(designator)
+                    , _separator(designator.find_last_of('.', designator.find_last_of('@')))
+                    , _callsign(string::npos)
+                    , _version(0)
+                    , _index(designator.find_last_of('@'))
+                {
+                    if (_separator != string::npos) {
+                        _callsign = _separator;
+                        _version = _separator;
+
+                        if (_separator > 0) {
+                            size_t index = _separator - 1;
+                            while ((index != 0) && (isdigit(designator[index]))) {
+                                index--;
+                            }
+                            if ((index != 0) && (designator[index] == '.')) {
+                                _callsign = index;
+                                _version = index + 1;
+                            } else if ((index == 0) && (isdigit(designator[0]))) {
+                                _callsign = string::npos;
+                                _version = 0;
+                            }
+                        }
                     }
-                    if ((index != 0) && (designator[index] == '.')) {
-                        pos = index;
-                    } else if ((index == 0) && (isdigit(designator[0]))) {
-                        pos = string::npos;
+                }
+                ~Designation()
+                {
+                }
+
+            public:
+                inline TextFragment Callsign() const
+                {
+                    return (Fragment(0, (_callsign == string::npos ? 0 : _callsign)));
+                }
+                inline TextFragment FullCallsign() const
+                {
+                    return (Fragment(0, (_separator == string::npos ? 0 : _separator)));
+                }
+                inline TextFragment Method() const
+                {
+                    size_t begin = (_separator == string::npos ? 0 : _separator + 1);
+                    return (Fragment(begin, (_index == string::npos ? _designator.length() : _index) - begin));
+                }
+                inline TextFragment FullMethod() const
+                {
+                    size_t begin = (_separator == string::npos ? 0 : _separator + 1);
+                    return (Fragment(begin, _designator.length() - begin));
+                }
+                inline TextFragment VersionedFullMethod() const
+                {
+                    size_t begin = (_callsign == string::npos ? 0 : _callsign + 1);
+                    return (Fragment(begin, _designator.length() - begin));
+                }
+                inline TextFragment Index() const
+                {
+                    return (_index == string::npos ? TextFragment() : Fragment(_index + 1, _designator.length() - _index - 1));
+                }
+                uint8_t Version() const
+                {
+                    uint8_t result = ~0;
+
+                    if ((_separator != string::npos) && (_version < _separator)) {
+                        uint32_t value = 0;
+                        for (size_t index = _version; index < _separator; index++) {
+                            value = (value * 10) + (_designator[index] - '0');
+                        }
+                        result = static_cast<uint8_t>(value);
                     }
+                    return (result);
                 }
-                return (pos == string::npos ? EMPTY_STRING : designator.substr(0, pos));
+
+            private:
+                inline TextFragment Fragment(const size_t offset, const size_t length) const
+                {
+                    return (TextFragment(_designator.c_str(), static_cast<uint32_t>(offset), static_cast<uint32_t>(length)));
+                }
+
+            private:
+                const string& _designator;
+                size_t _separator; // the last '.' before the index, splits callsign and method
+                size_t _callsign; // end of the callsign, without the version
+                size_t _version; // start of the version digits, if any
+                size_t _index; // the '@' that starts the index, if any
+            };
+
+        public:
+            static string Callsign(const string& designator)
+            {
+                return (Designation(designator).Callsign().Text());
             }
             static string FullCallsign(const string& designator)
             {
-                size_t pos = designator.find_last_of('.', designator.find_last_of('@'));
-                return (pos == string::npos ? EMPTY_STRING : designator.substr(0, pos));
+                return (Designation(designator).FullCallsign().Text());
             }
             static string Method(const string& designator)
             {
-                size_t end = designator.find_last_of('@');
-                size_t begin = designator.find_last_of('.', end);
-
-                return (designator.substr((begin == string::npos) ? 0 : begin + 1, (end == string::npos ? string::npos : (begin == string::npos) ? end : end - begin - 1)));
+                return (Designation(designator).Method().Text());
             }
             static string FullMethod(const string& designator)
             {
-                size_t pos = designator.find_last_of('.', designator.find_last_of('@'));
-                return (designator.substr(pos == string::npos ? 0 : pos + 1));
+                return (Designation(designator).FullMethod().Text());
             }
             static string VersionedFullMethod(const string& designator)
             {
-                size_t pos = designator.find_last_of('.', designator.find_last_of('@'));
-                if ((pos != string::npos) && (pos > 0)) {
-                    size_t index = pos - 1;
-                    while ((index != 0) && (isdigit(designator[index]))) {
-                        index--;
-                    }
-                    if ((index != 0) && (designator[index] == '.')) {
-                        pos = index;
-                    } else if ((index == 0) && (isdigit(designator[0]))) {
-                        pos = string::npos;
-                    }
-                }
-                return (designator.substr(pos == string::npos ? 0 : pos + 1));
+                return (Designation(designator).VersionedFullMethod().Text());
             }
             static uint8_t Version(const string& designator)
             {
-                uint8_t result = ~0;
-                size_t pos = designator.find_last_of('.', designator.find_last_of('@'));
-
-                if (pos != string::npos) {
-                    size_t index = pos - 1;
-                    while ((index != 0) && (isdigit(designator[index]))) {
-                        index--;
-                    }
-                    if ((index != 0) && (designator[index] == '.')) {
-                        index++;
-                    } else if ((index == 0) && (isdigit(designator[0]) == false)) {
-                        index = pos;
-                    }
-
-                    if (index < pos) {
-                        result = static_cast<uint8_t>(atoi(designator.substr(index, pos - index).c_str()));
-                    }
-                }
-                return (result);
+                return (Designation(designator).Version());
             }
             static string Index(const string& designator)
             {
-                size_t end = designator.find_last_of('@');
-
-                return (end == string::npos ? EMPTY_STRING : designator.substr(end + 1, string::npos));
+                return (Designation(designator).Index().Text());
             }
             void Clear()
             {
@@ -651,6 +698,19 @@ namespace Core {
                 }
                 return (result);
             }
+            // Invoke on a designator the caller already split, so it does not need to be parsed again.
+            uint32_t Invoke(const Connection connection, const Message::Designation& designation, const string& parameters, string& response)
+            {
+                uint32_t result = Core::ERROR_UNKNOWN_KEY;
+
+                response.clear();
+
+                HandlerMap::iterator index = _handlers.find(designation.Method().Text());
+                if (index != _handlers.end()) {
+                    result = index->second.Invoke(connection, designation.FullMethod().Text(), parameters, response);
+                }
+                return (result);
+            }
             void Subscribe(const uint32_t id, const string& eventId, const string& callsign, Core::JSONRPC::Message& response)
             {
                 _adminLock.Lock();
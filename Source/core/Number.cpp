@@ -83,6 +83,69 @@ namespace Core {
     }
     }
 
+    /* static */ const char NumberConversion::_pairs[201] =
+        "00010203040506070809"
+        "10111213141516171819"
+        "20212223242526272829"
+        "30313233343536373839"
+        "40414243444546474849"
+        "50515253545556575859"
+        "60616263646566676869"
+        "70717273747576777879"
+        "80818283848586878889"
+        "90919293949596979899";
+
+    /* static */ char* NumberConversion::Decimal(char* end, uint64_t value)
+    {
+        char* location = end;
+
+        // Only use 64 bits arithmetic as long as it is needed, on 32 bits platforms
+        // these divisions are library calls.
+        while (value > 0xFFFFFFFF) {
+            uint64_t next = value / 100;
+            const char* pair = &_pairs[(value - (next * 100)) * 2];
+
+            *(--location) = pair[1];
+            *(--location) = pair[0];
+            value = next;
+        }
+
+        uint32_t small = static_cast<uint32_t>(value);
+
+        while (small >= 100) {
+            uint32_t next = small / 100;
+            const char* pair = &_pairs[(small - (next * 100)) * 2];
+
+            *(--location) = pair[1];
+            *(--location) = pair[0];
+            small = next;
+        }
+
+        if (small >= 10) {
+            *(--location) = _pairs[(small * 2) + 1];
+            *(--location) = _pairs[small * 2];
+        } else {
+            *(--location) = static_cast<char>('0' + small);
+        }
+
+        return (location);
+    }
+
+    /* static */ char* NumberConversion::PowerOfTwo(char* end, uint64_t value, const uint8_t bits)
+    {
+        static const char digits[] = "0123456789ABCDEF";
+
+        char* location = end;
+        const uint8_t mask = static_cast<uint8_t>((1 << bits) - 1);
+
+        do {
+            *(--location) = digits[value & mask];
+            value >>= bits;
+        } while (value != 0);
+
+        return (location);
+    }
+
     Fractional::Fractional()
         : m_Integer(0)
         , m_Remainder(0)
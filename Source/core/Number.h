@@ -38,6 +38,53 @@ namespace Core {
     EXTERNAL TCHAR ToDirect(const unsigned char element);
     }
 
+    // Digit level helpers shared by the number conversions. The formatters write the digits
+    // right aligned, ending just before "end", and return the position of the first digit.
+    class EXTERNAL NumberConversion {
+    private:
+        NumberConversion() = delete;
+        NumberConversion(const NumberConversion&) = delete;
+        NumberConversion& operator=(const NumberConversion&) = delete;
+
+    public:
+        // Decimal digits are produced two at a time from a lookup table, halving the
+        // number of divisions.
+        static char* Decimal(char* end, uint64_t value);
+        // Hexadecimal (bits = 4) and octal (bits = 3) digits are shifted out, no divisions.
+        static char* PowerOfTwo(char* end, uint64_t value, const uint8_t bits);
+
+        // Takes 8 decimal digits in one go (SWAR), returns false if they are not all digits.
+        static inline bool EightDigits(const char text[], uint32_t& value)
+        {
+            // The first digit must end up in the lowest byte.
+            uint64_t chunk;
+
+#ifdef LITTLE_ENDIAN_PLATFORM
+            ::memcpy(&chunk, text, sizeof(chunk));
+#else
+            chunk = 0;
+
+            for (uint8_t index = 0; index < 8; index++) {
+                chunk |= static_cast<uint64_t>(static_cast<uint8_t>(text[index])) << (8 * index);
+            }
+#endif
+
+            bool result = (((chunk & 0xF0F0F0F0F0F0F0F0ULL) | (((chunk + 0x0606060606060606ULL) & 0xF0F0F0F0F0F0F0F0ULL) >> 4)) == 0x3333333333333333ULL);
+
+            if (result == true) {
+                chunk -= 0x3030303030303030ULL;
+                chunk = (chunk * 10) + (chunk >> 8);
+                chunk = (((chunk & 0x000000FF000000FFULL) * (100 + (1000000ULL << 32))) + (((chunk >> 16) & 0x000000FF000000FFULL) * (1 + (10000ULL << 32)))) >> 32;
+                value = static_cast<uint32_t>(chunk);
+            }
+
+            return (result);
+        }
+
+    private:
+        static const char _pairs[201];
+    };
+
     template <class TYPE, bool SIGNED = (TypeTraits::sign<TYPE>::Signed == 1), const NumberBase BASETYPE = BASE_UNKNOWN>
     class NumberType {
     public:
@@ -376,39 +423,31 @@ namespace Core {
     private:
         uint16_t FillBuffer(char* buffer, const uint16_t maxLength, const NumberBase BaseType) const
         {
-            TCHAR* Location = &buffer[maxLength - 1];
-            TYPE Value = NumberType<TYPE, SIGNED>(m_Value).Abs();
-            uint16_t Index = maxLength - 1 /* closing character */ - (Negative() ? 1 : 0) - (BaseType == BASE_OCTAL ? 1 : (BaseType == BASE_HEXADECIMAL ? 2 : 0));
-            uint8_t Divider = (BaseType == BASE_UNKNOWN ? BASE_DECIMAL : BaseType);
+            char* Location = &buffer[maxLength - 1];
+            uint64_t Value = (Negative() ? (0 - static_cast<uint64_t>(m_Value)) : static_cast<uint64_t>(m_Value));
+
+            ASSERT(maxLength >= 24);
 
             // Close it with a terminating character!!
-            *Location-- = '\0';
+            *Location = '\0';
 
             // Convert the number to a string
-            do {
-                uint8_t newDigit = (Value % Divider);
-                if (newDigit < 10) {
-                    *Location-- = static_cast<wchar_t>(newDigit + '0');
-                } else {
-                    *Location-- = static_cast<wchar_t>(newDigit - 10 + 'A');
-                }
-                Value = Value / Divider;
-                Index--;
-
-            } while ((Value != 0) && (Index > 0));
-
-            if ((BaseType == BASE_OCTAL) || (BaseType == BASE_HEXADECIMAL)) {
-                if (BaseType == BASE_HEXADECIMAL) {
-                    *Location-- = 'x';
-                }
-                *Location-- = '0';
+            if (BaseType == BASE_HEXADECIMAL) {
+                Location = NumberConversion::PowerOfTwo(Location, Value, 4);
+                *(--Location) = 'x';
+                *(--Location) = '0';
+            } else if (BaseType == BASE_OCTAL) {
+                Location = NumberConversion::PowerOfTwo(Location, Value, 3);
+                *(--Location) = '0';
+            } else {
+                Location = NumberConversion::Decimal(Location, Value);
             }
 
             if (Negative()) {
-                *Location = '-';
+                *(--Location) = '-';
             }
 
-            return (Index);
+            return (static_cast<uint16_t>(Location - buffer));
         }
         uint16_t FillBuffer(wchar_t* buffer, const uint16_t maxLength, const NumberBase BaseType)
         {
@@ -661,11 +700,18 @@ namespace Core {
                         Max = NUMBER_MIN_SIGNED(NUMBER);
                     }
                 } else {
+                    uint32_t Chunk;
+
                     if (Base == BASE_UNKNOWN) {
                         Base = BASE_DECIMAL;
                     }
 
-                    if ((*Text >= '0') && (*Text <= '7')) {
+                    if ((Base == BASE_DECIMAL) && (ItemsLeft >= 8) && (NumberConversion::EightDigits(Text, Chunk) == true) && (Fits(Value, Max, Sign, Chunk) == true)) {
+                        // Long run of decimal digits, take 8 at once, the last one is accounted for below.
+                        Value = (Sign ? static_cast<NUMBER>((static_cast<int64_t>(Value) * 100000000) - Chunk) : static_cast<NUMBER>((static_cast<int64_t>(Value) * 100000000) + Chunk));
+                        Text += 7;
+                        ItemsLeft -= 7;
+                    } else if ((*Text >= '0') && (*Text <= '7')) {
                         if (Sign) {
                             int8_t Digit = ('0' - *Text);
 
@@ -764,11 +810,18 @@ namespace Core {
                 } else if ((Value == 0) && ((*Text == '+') || (*Text == ' ') || (*Text == '\t') || (*Text == '0'))) {
                     // Skip all shit and other white spaces
                 } else {
+                    uint32_t Chunk;
+
                     if (Base == BASE_UNKNOWN) {
                         Base = BASE_DECIMAL;
                     }
 
-                    if ((*Text >= '0') && (*Text <= '7')) {
+                    if ((Base == BASE_DECIMAL) && (ItemsLeft >= 8) && (NumberConversion::EightDigits(Text, Chunk) == true) && (Fits(Value, Max, false, Chunk) == true)) {
+                        // Long run of decimal digits, take 8 at once, the last one is accounted for below.
+                        Value = static_cast<NUMBER>((static_cast<uint64_t>(Value) * 100000000) + Chunk);
+                        Text += 7;
+                        ItemsLeft -= 7;
+                    } else if ((*Text >= '0') && (*Text <= '7')) {
                         uint8_t Digit = (*Text - '0');
 
                         if ((Value <= (Max / Base)) && (Digit <= (Max - (Value * Base)))) {
@@ -806,6 +859,16 @@ namespace Core {
 
             return (MaxLength - ItemsLeft);
         }
+        // Can Value be shifted 8 decimal digits to the left and Chunk be added (subtracted if
+        // negative) without passing Max?
+        template <typename NUMBER>
+        static inline bool Fits(const NUMBER Value, const NUMBER Max, const bool negative, const uint32_t Chunk)
+        {
+            const uint64_t magnitude = (negative ? (0 - static_cast<uint64_t>(Value)) : static_cast<uint64_t>(Value));
+            const uint64_t limit = (negative ? (0 - static_cast<uint64_t>(Max)) : static_cast<uint64_t>(Max));
+
+            return ((magnitude <= (limit / 100000000)) && (Chunk <= (limit - (magnitude * 100000000))));
+        }
         inline const TYPE TypedAbs(const TemplateIntToType<true>& /* For compile time diffrentiation */) const
         {
             return (m_Value < 0 ? -m_Value : m_Value);
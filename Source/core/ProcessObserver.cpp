@@ -0,0 +1,219 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2020 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "ProcessObserver.h"
+#include "ProcessInfo.h"
+
+namespace WPEFramework {
+
+namespace Core {
+
+    /* virtual */ uint16_t ProcessObserver::Channel::Deserialize(const uint8_t dataFrame[], const uint16_t receivedSize)
+    {
+        Netlink::Frames frames(dataFrame, receivedSize);
+
+        while (frames.Next() == true) {
+
+            if ((frames.Type() == NLMSG_DONE) && (frames.Size() >= sizeof(struct cn_msg))) {
+
+                const struct cn_msg* message(reinterpret_cast<const struct cn_msg*>(frames.Data()));
+
+                if ((message->id.idx == CN_IDX_PROC) && (message->id.val == CN_VAL_PROC) && (message->len >= sizeof(struct proc_event)) && ((sizeof(struct cn_msg) + message->len) <= frames.Size())) {
+
+                    // The payload is not guaranteed to be aligned, copy it out before interpreting it.
+                    struct proc_event event;
+                    ::memcpy(&event, message->data, sizeof(event));
+
+                    _parent.Event(event);
+                }
+            }
+        }
+
+        return (receivedSize);
+    }
+
+    ProcessObserver::ProcessObserver(INotification* callback)
+        : _adminLock()
+        , _callback(callback)
+        , _watched()
+        , _channel(*this)
+    {
+        ASSERT(callback != nullptr);
+    }
+
+    ProcessObserver::~ProcessObserver()
+    {
+        Close(Core::infinite);
+    }
+
+    uint32_t ProcessObserver::Open(const uint32_t waitTime)
+    {
+        uint32_t result = Core::ERROR_NONE;
+
+        if (_channel.IsOpen() == false) {
+
+            result = _channel.Open(waitTime);
+
+            if (result == Core::ERROR_NONE) {
+                Subscription listen(true);
+
+                result = _channel.Send(listen, waitTime);
+
+                if (result != Core::ERROR_NONE) {
+                    TRACE_L1("Could not subscribe to the process connector, error: %d", result);
+                    _channel.Close(waitTime);
+                }
+            }
+        }
+
+        return (result);
+    }
+
+    uint32_t ProcessObserver::Close(const uint32_t waitTime)
+    {
+        if (_channel.IsOpen() == true) {
+            Subscription ignore(false);
+
+            _channel.Send(ignore, waitTime);
+        }
+
+        _channel.Close(waitTime);
+
+        _adminLock.Lock();
+        _watched.clear();
+        _adminLock.Unlock();
+
+        return (Core::ERROR_NONE);
+    }
+
+    void ProcessObserver::Watch(const uint32_t pid)
+    {
+        std::list<uint32_t> pending({ pid });
+
+        _adminLock.Lock();
+
+        // Pick up the descendants that already exist, the new ones are reported by fork events.
+        while (pending.empty() == false) {
+            uint32_t current = pending.front();
+            pending.pop_front();
+
+            _watched[current] = pid;
+
+            ProcessInfo::Iterator children(current);
+
+            while (children.Next() == true) {
+                pending.push_back(children.Current().Id());
+            }
+        }
+
+        _adminLock.Unlock();
+    }
+
+    void ProcessObserver::Unwatch(const uint32_t pid)
+    {
+        _adminLock.Lock();
+
+        WatchMap::iterator index(_watched.begin());
+
+        while (index != _watched.end()) {
+            if (index->second == pid) {
+                index = _watched.erase(index);
+            } else {
+                index++;
+            }
+        }
+
+        _adminLock.Unlock();
+    }
+
+    bool ProcessObserver::IsWatched(const uint32_t pid) const
+    {
+        _adminLock.Lock();
+
+        bool result = (_watched.find(pid) != _watched.end());
+
+        _adminLock.Unlock();
+
+        return (result);
+    }
+
+    void ProcessObserver::Event(const struct proc_event& event)
+    {
+        switch (event.what) {
+        case proc_event::PROC_EVENT_FORK: {
+            const uint32_t parent = event.event_data.fork.parent_tgid;
+            const uint32_t child = event.event_data.fork.child_tgid;
+
+            // A new thread reports the same thread group as its parent, skip those.
+            if (event.event_data.fork.child_pid == event.event_data.fork.child_tgid) {
+
+                _adminLock.Lock();
+
+                WatchMap::const_iterator index(_watched.find(parent));
+                bool watched = (index != _watched.end());
+
+                if (watched == true) {
+                    _watched[child] = index->second;
+                }
+
+                _adminLock.Unlock();
+
+                if (watched == true) {
+                    _callback->Forked(parent, child);
+                }
+            }
+            break;
+        }
+        case proc_event::PROC_EVENT_EXEC: {
+            const uint32_t pid = event.event_data.exec.process_tgid;
+
+            if (IsWatched(pid) == true) {
+                _callback->Executed(pid);
+            }
+            break;
+        }
+        case proc_event::PROC_EVENT_EXIT: {
+            const uint32_t pid = event.event_data.exit.process_tgid;
+
+            // Only the exit of the thread group leader means the process is gone.
+            if (event.event_data.exit.process_pid == event.event_data.exit.process_tgid) {
+
+                _adminLock.Lock();
+
+                WatchMap::iterator index(_watched.find(pid));
+                bool watched = (index != _watched.end());
+
+                if (watched == true) {
+                    _watched.erase(index);
+                }
+
+                _adminLock.Unlock();
+
+                if (watched == true) {
+                    _callback->Exited(pid, event.event_data.exit.exit_code);
+                }
+            }
+            break;
+        }
+        default:
+            break;
+        }
+    }
+}
+} // namespace WPEFramework::Core
@@ -0,0 +1,161 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2020 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef __PROCESSOBSERVER_H
+#define __PROCESSOBSERVER_H
+
+#ifndef __WINDOWS__
+
+#include "Module.h"
+#include "Netlink.h"
+#include "Portability.h"
+#include "Sync.h"
+
+#include <linux/cn_proc.h>
+#include <map>
+
+namespace WPEFramework {
+namespace Core {
+
+    // Listens on the kernel process connector (NETLINK_CONNECTOR, CN_IDX_PROC) and reports
+    // the fork/exec/exit events of the process trees that are watched. Subscribing to these
+    // events requires CAP_NET_ADMIN, if that is not granted, Open() fails and the users
+    // should fall back to polling the process state.
+    class EXTERNAL ProcessObserver {
+    private:
+        ProcessObserver() = delete;
+        ProcessObserver(const ProcessObserver&) = delete;
+        ProcessObserver& operator=(const ProcessObserver&) = delete;
+
+    public:
+        struct INotification {
+            virtual ~INotification() {}
+
+            // All pids reported are thread group ids (processes), thread events are filtered out.
+            // The exitCode is the status as it would be returned by waitpid().
+            virtual void Forked(const uint32_t parent, const uint32_t child) = 0;
+            virtual void Executed(const uint32_t pid) = 0;
+            virtual void Exited(const uint32_t pid, const uint32_t exitCode) = 0;
+        };
+
+    private:
+        class Subscription : public ConnectorType<CN_IDX_PROC, CN_VAL_PROC> {
+        private:
+            Subscription() = delete;
+            Subscription(const Subscription&) = delete;
+            Subscription& operator=(const Subscription&) = delete;
+
+        public:
+            Subscription(const bool listen)
+                : ConnectorType<CN_IDX_PROC, CN_VAL_PROC>()
+                , _operation(listen == true ? PROC_CN_MCAST_LISTEN : PROC_CN_MCAST_IGNORE)
+            {
+            }
+            ~Subscription() override
+            {
+            }
+
+        private:
+            uint16_t Message(uint8_t stream[], const uint16_t length) const override
+            {
+                uint16_t result = 0;
+
+                if (length >= sizeof(_operation)) {
+                    ::memcpy(stream, &_operation, sizeof(_operation));
+                    result = sizeof(_operation);
+                }
+
+                return (result);
+            }
+            uint16_t Message(const uint8_t[], const uint16_t) override
+            {
+                return (0);
+            }
+
+        private:
+            const uint32_t _operation;
+        };
+
+        class Channel : public SocketNetlink {
+        private:
+            Channel() = delete;
+            Channel(const Channel&) = delete;
+            Channel& operator=(const Channel&) = delete;
+
+        public:
+            Channel(ProcessObserver& parent)
+                : SocketNetlink(Core::NodeId(NETLINK_CONNECTOR, 0, CN_IDX_PROC))
+                , _parent(parent)
+            {
+            }
+            ~Channel() override
+            {
+            }
+
+        public:
+            uint16_t Deserialize(const uint8_t dataFrame[], const uint16_t receivedSize) override;
+
+        private:
+            ProcessObserver& _parent;
+        };
+
+        // pid -> pid of the root of the watched tree it belongs to.
+        typedef std::map<uint32_t, uint32_t> WatchMap;
+
+    public:
+        ProcessObserver(INotification* callback);
+        ~ProcessObserver();
+
+    public:
+        inline bool IsOpen() const
+        {
+            return (_channel.IsOpen());
+        }
+
+        uint32_t Open(const uint32_t waitTime);
+        uint32_t Close(const uint32_t waitTime);
+
+        // Watch the given process and every process it will fork from now on.
+        void Watch(const uint32_t pid);
+        // Stop watching the tree that was started with Watch(pid).
+        void Unwatch(const uint32_t pid);
+        bool IsWatched(const uint32_t pid) const;
+
+    protected:
+        // The kernel frames come in here, derived classes (e.g. tests) may feed it their own.
+        inline SocketNetlink& Link()
+        {
+            return (_channel);
+        }
+
+    private:
+        void Event(const struct proc_event& event);
+
+    private:
+        mutable Core::CriticalSection _adminLock;
+        INotification* _callback;
+        WatchMap _watched;
+        Channel _channel;
+    };
+}
+} // namespace WPEFramework::Core
+
+#endif // __WINDOWS__
+
+#endif // __PROCESSOBSERVER_H
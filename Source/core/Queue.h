@@ -28,11 +28,13 @@
 #define __QUEUE_H
 
 #include <algorithm>
+#include <iterator>
 #include <queue>
 
 #include "Module.h"
 #include "StateTrigger.h"
 #include "Sync.h"
+#include "Time.h"
 
 namespace WPEFramework {
 namespace Core {
@@ -295,6 +297,367 @@ namespace Core {
         CriticalSection m_Admin;
         uint32_t m_MaxSlots;
     };
+
+    // -------------------------------------------------------------------
+    // Same Producer-Consumer contract as the QueueType, but every entry is
+    // posted in one of LANES lanes, lane 0 being the most urgent one.
+    // Extract takes from the most urgent lane holding entries. Within a
+    // lane, the entry with the earliest deadline goes first. Entries that
+    // come without a deadline get one of "now + ageing time of the lane",
+    // so among themselves they stay FIFO.
+    // Deadlines are in microseconds of a monotonic clock (see Now()), so
+    // setting the wall clock does not reorder or age the queue.
+    // To keep the less urgent lanes from starving, once the first entry of
+    // such a lane is past its deadline, it is taken after at most MaxStreak
+    // entries from more urgent lanes.
+    // The highwatermark holds for all lanes together, except for lane 0:
+    // urgent work never waits for room in the queue.
+    // -------------------------------------------------------------------
+    template <typename CONTEXT, const uint8_t LANES>
+    class PriorityQueueType {
+    private:
+        static constexpr uint8_t MaxStreak = 8;
+
+        struct Entry {
+            Entry(const CONTEXT& context, const uint64_t deadline)
+                : Context(context)
+                , Deadline(deadline)
+            {
+            }
+
+            CONTEXT Context;
+            uint64_t Deadline;
+        };
+
+        struct Lane {
+            Lane()
+                : Entries()
+                , Ageing(0)
+                , Peak(0)
+            {
+            }
+
+            std::list<Entry> Entries;
+            uint64_t Ageing; // microseconds
+            uint32_t Peak;
+        };
+
+    public:
+        PriorityQueueType() = delete;
+        PriorityQueueType(const PriorityQueueType<CONTEXT, LANES>&) = delete;
+        PriorityQueueType<CONTEXT, LANES>& operator=(const PriorityQueueType<CONTEXT, LANES>&) = delete;
+
+        // Ageing time per lane in milliseconds.
+        PriorityQueueType(const uint32_t highWaterMark, const uint32_t (&ageing)[LANES])
+            : _lanes()
+            , _state(EMPTY)
+            , _admin()
+            , _maxSlots(highWaterMark)
+            , _length(0)
+            , _streak(0)
+            , _promoted(0)
+        {
+            // A highwatermark of 0 is bullshit.
+            ASSERT(_maxSlots != 0);
+
+            for (uint8_t index = 0; index < LANES; index++) {
+                _lanes[index].Ageing = static_cast<uint64_t>(ageing[index]) * 1000;
+            }
+        }
+        ~PriorityQueueType()
+        {
+            // Disable the queue and flush all entries.
+            Disable();
+        }
+
+        typedef enum {
+            EMPTY = 0x0001,
+            ENTRIES = 0x0002,
+            LIMITED = 0x0004,
+            DISABLED = 0x0008
+
+        } enumQueueState;
+
+    public:
+        bool Remove(const CONTEXT& entry)
+        {
+            bool removed = false;
+
+            _admin.Lock();
+
+            if (_state != DISABLED) {
+                for (uint8_t index = 0; (index < LANES) && (removed == false); index++) {
+                    std::list<Entry>& entries(_lanes[index].Entries);
+                    typename std::list<Entry>::iterator loop(entries.begin());
+
+                    while ((loop != entries.end()) && !(loop->Context == entry)) {
+                        loop++;
+                    }
+                    if (loop != entries.end()) {
+                        entries.erase(loop);
+                        _length--;
+                        removed = true;
+                    }
+                }
+
+                _state.SetState(IsEmpty() ? EMPTY : (IsFull() ? LIMITED : ENTRIES));
+            }
+
+            _admin.Unlock();
+
+            return (removed);
+        }
+        bool Post(const CONTEXT& entry, const uint8_t lane = (LANES / 2), const uint64_t deadline = 0)
+        {
+            bool result = false;
+
+            _admin.Lock();
+
+            if (_state != DISABLED) {
+                Add(entry, lane, deadline);
+
+                _state.SetState(IsFull() ? LIMITED : ENTRIES);
+
+                result = true;
+            }
+
+            _admin.Unlock();
+
+            return (result);
+        }
+        // A deadline is an absolute time, in Now() ticks, 0 is no deadline.
+        bool Insert(const CONTEXT& entry, uint32_t waitTime, const uint8_t lane = (LANES / 2), const uint64_t deadline = 0)
+        {
+            bool posted = false;
+            bool triggered = true;
+
+            ASSERT(lane < LANES);
+
+            _admin.Lock();
+
+            if (_state != DISABLED) {
+                do {
+                    if ((_state != LIMITED) || (lane == 0)) {
+                        posted = true;
+
+                        Add(entry, lane, deadline);
+
+                        _state.SetState(IsFull() ? LIMITED : ENTRIES);
+                    } else {
+                        // We are moving into a wait, release the lock.
+                        _admin.Unlock();
+
+                        // Wait till the status of the queue changes.
+                        triggered = _state.WaitState(DISABLED | ENTRIES | EMPTY, waitTime);
+
+                        _admin.Lock();
+
+                        // If we were reset, that is assumed to be also a timeout
+                        triggered = triggered && (_state != DISABLED);
+                    }
+
+                } while ((posted == false) && (triggered != false));
+            }
+
+            _admin.Unlock();
+
+            return (posted);
+        }
+        bool Extract(CONTEXT& result, uint32_t waitTime)
+        {
+            bool received = false;
+            bool triggered = true;
+
+            _admin.Lock();
+
+            if (_state != DISABLED) {
+                do {
+                    if (_state != EMPTY) {
+                        received = true;
+
+                        std::list<Entry>& entries(Next());
+
+                        result = entries.front().Context;
+                        entries.pop_front();
+                        _length--;
+
+                        _state.SetState(IsEmpty() ? EMPTY : (IsFull() ? LIMITED : ENTRIES));
+                    } else {
+                        // We are moving into a wait, release the lock.
+                        _admin.Unlock();
+
+                        // Wait till the status of the queue changes.
+                        triggered = _state.WaitState(DISABLED | ENTRIES | LIMITED, waitTime);
+
+                        _admin.Lock();
+
+                        // If we were reset, that is assumed to be also a timeout
+                        triggered = triggered && (_state != DISABLED);
+                    }
+
+                } while ((received == false) && (triggered != false));
+            }
+
+            _admin.Unlock();
+
+            return (received);
+        }
+        void Enable()
+        {
+            _admin.Lock();
+
+            if (_state == DISABLED) {
+                _state.SetState(IsEmpty() ? EMPTY : (IsFull() ? LIMITED : ENTRIES));
+            }
+
+            _admin.Unlock();
+        }
+        void Disable()
+        {
+            _admin.Lock();
+
+            if (_state != DISABLED) {
+                _state.SetState(DISABLED);
+            }
+
+            _admin.Unlock();
+        }
+        void Flush()
+        {
+            // Clear is only possible in a "DISABLED" state !!
+            ASSERT(_state == DISABLED);
+
+            _admin.Lock();
+
+            for (uint8_t index = 0; index < LANES; index++) {
+                _lanes[index].Entries.clear();
+            }
+            _length = 0;
+
+            _admin.Unlock();
+        }
+
+        inline bool IsEmpty() const
+        {
+            return (_length == 0);
+        }
+        inline bool IsFull() const
+        {
+            return (_length >= _maxSlots);
+        }
+        inline uint32_t Length() const
+        {
+            return (_length);
+        }
+        inline uint32_t Length(const uint8_t lane) const
+        {
+            ASSERT(lane < LANES);
+
+            _admin.Lock();
+            uint32_t result = static_cast<uint32_t>(_lanes[lane].Entries.size());
+            _admin.Unlock();
+
+            return (result);
+        }
+        // Highest number of entries ever waiting in the lane.
+        inline uint32_t Peak(const uint8_t lane) const
+        {
+            ASSERT(lane < LANES);
+
+            _admin.Lock();
+            uint32_t result = _lanes[lane].Peak;
+            _admin.Unlock();
+
+            return (result);
+        }
+        // Number of times an overdue entry was taken ahead of more urgent ones.
+        inline uint32_t Promoted() const
+        {
+            _admin.Lock();
+            uint32_t result = _promoted;
+            _admin.Unlock();
+
+            return (result);
+        }
+        // The clock the deadlines are in, microseconds since an arbitrary moment.
+        static uint64_t Now()
+        {
+#ifdef __WINDOWS__
+            return (static_cast<uint64_t>(::GetTickCount64()) * 1000);
+#else
+            struct timespec now;
+            clock_gettime(CLOCK_MONOTONIC, &now);
+            return ((static_cast<uint64_t>(now.tv_sec) * 1000000) + (now.tv_nsec / 1000));
+#endif
+        }
+
+    private:
+        void Add(const CONTEXT& context, const uint8_t lane, uint64_t deadline)
+        {
+            ASSERT(lane < LANES);
+
+            Lane& entry(_lanes[lane]);
+
+            if (deadline == 0) {
+                deadline = Now() + entry.Ageing;
+            }
+
+            // Mostly the deadlines come in order, so search from the back.
+            typename std::list<Entry>::iterator position(entry.Entries.end());
+
+            while ((position != entry.Entries.begin()) && (std::prev(position)->Deadline > deadline)) {
+                position--;
+            }
+
+            entry.Entries.emplace(position, context, deadline);
+            _length++;
+
+            if (entry.Entries.size() > entry.Peak) {
+                entry.Peak = static_cast<uint32_t>(entry.Entries.size());
+            }
+        }
+        // Must be called with the lock taken and at least one entry available.
+        std::list<Entry>& Next()
+        {
+            uint8_t lane = 0;
+
+            while (_lanes[lane].Entries.empty() == true) {
+                lane++;
+                ASSERT(lane < LANES);
+            }
+
+            // Is anyone less urgent waiting beyond its deadline ?
+            const uint64_t now = Now();
+            uint8_t overdue = LANES;
+
+            for (uint8_t index = LANES - 1; index > lane; index--) {
+                if ((_lanes[index].Entries.empty() == false) && (_lanes[index].Entries.front().Deadline <= now)) {
+                    overdue = index;
+                }
+            }
+
+            if (overdue == LANES) {
+                _streak = 0;
+            } else if (_streak < MaxStreak) {
+                _streak++;
+            } else {
+                _streak = 0;
+                _promoted++;
+                lane = overdue;
+            }
+
+            return (_lanes[lane].Entries);
+        }
+
+    private:
+        Lane _lanes[LANES];
+        StateTrigger<enumQueueState> _state;
+        mutable CriticalSection _admin;
+        uint32_t _maxSlots;
+        uint32_t _length;
+        uint8_t _streak;
+        uint32_t _promoted;
+    };
 }
 } // namespace Core
 
@@ -0,0 +1,433 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2020 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "ReadWriteLock.h"
+#include "Time.h"
+
+#if defined(__LINUX__) && !defined(__APPLE__)
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <time.h>
+#include <unistd.h>
+#endif
+
+#include <climits>
+#include <cstdlib>
+#include <new>
+
+namespace WPEFramework {
+namespace Core {
+
+    namespace {
+
+        // A revoked bias stays off for this many times what the revocation took (BRAVO uses 9).
+        constexpr uint8_t InhibitMultiplier = 9;
+
+        // Threads are spread round robin over the slots, in the order they first take a read lock.
+        inline uint8_t ThreadSlot(const uint8_t slots)
+        {
+            static std::atomic<uint32_t> tickets(0);
+            static thread_local const uint32_t ticket = tickets.fetch_add(1, std::memory_order_relaxed);
+
+            return (static_cast<uint8_t>(ticket % slots));
+        }
+
+        // Every slot has a cache line of its own, so the block holding them has to start on one.
+        constexpr size_t CacheLine = 64;
+
+        void* AllocateLines(const size_t size)
+        {
+            void* result = nullptr;
+
+#ifdef __WINDOWS__
+            result = ::_aligned_malloc(size, CacheLine);
+#else
+            if (::posix_memalign(&result, CacheLine, size) != 0) {
+                result = nullptr;
+            }
+#endif
+            ASSERT(result != nullptr);
+
+            return (result);
+        }
+        void FreeLines(void* memory)
+        {
+#ifdef __WINDOWS__
+            ::_aligned_free(memory);
+#else
+            ::free(memory);
+#endif
+        }
+    }
+
+    ReadWriteLock::ReadWriteLock()
+        : ReadWriteLock(READER, false)
+    {
+    }
+
+    ReadWriteLock::ReadWriteLock(const preference mode, const bool biased)
+        : _state(0)
+        , _bias(biased ? BIAS_ON : BIAS_OFF)
+        , _drained(0)
+        , _preference(mode)
+        , _slots(biased ? static_cast<Slot*>(AllocateLines(sizeof(Slot) * Slots)) : nullptr)
+        , _inhibitUntil(0)
+        , _readAcquired(0)
+        , _readContended(0)
+        , _writeAcquired(0)
+        , _writeContended(0)
+        , _waitTime(0)
+        , _revocations(0)
+    {
+        if (_slots != nullptr) {
+            for (uint8_t index = 0; index < Slots; index++) {
+                new (&(_slots[index])) Slot();
+                _slots[index].Readers.store(0, std::memory_order_relaxed);
+                _slots[index].Acquired.store(0, std::memory_order_relaxed);
+            }
+        }
+    }
+
+    ReadWriteLock::~ReadWriteLock()
+    {
+        ASSERT((_state.load(std::memory_order_relaxed) & (WRITER_LOCKED | READERS)) == 0);
+
+        if (_slots != nullptr) {
+            for (uint8_t index = 0; index < Slots; index++) {
+                _slots[index].~Slot();
+            }
+            FreeLines(_slots);
+        }
+    }
+
+    bool ReadWriteLock::ReadLock(const uint32_t waitTime)
+    {
+        bool result = ((_slots != nullptr) && (_bias.load(std::memory_order_relaxed) == BIAS_ON) && (SlotLock(_slots[ThreadSlot(Slots)]) == true));
+
+        if ((result == false) && ((result = WordLock(waitTime)) == true)) {
+            if ((_slots != nullptr) && (_bias.load(std::memory_order_acquire) == BIAS_ON)) {
+                // The bias came back while we were waiting for the writer. As long as we hold the
+                // word it can not change again, so move over to our slot, ReadUnlock expects us there.
+                Slot& slot(_slots[ThreadSlot(Slots)]);
+
+                slot.Readers.fetch_add(1, std::memory_order_seq_cst);
+                slot.Acquired.fetch_add(1, std::memory_order_relaxed);
+
+                WordUnlock();
+            } else {
+                _readAcquired.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+
+        return (result);
+    }
+
+    void ReadWriteLock::ReadUnlock()
+    {
+        // Readers that came in over a slot see the bias on (or being revoked, the writer waits for
+        // us), readers on the lock word see it off, it can only be turned on by a writer.
+        if ((_slots != nullptr) && (_bias.load(std::memory_order_acquire) != BIAS_OFF)) {
+            Slot& slot(_slots[ThreadSlot(Slots)]);
+
+            ASSERT(slot.Readers.load(std::memory_order_relaxed) > 0);
+
+            slot.Readers.fetch_sub(1, std::memory_order_seq_cst);
+
+            if (_bias.load(std::memory_order_seq_cst) == BIAS_REVOKING) {
+                _drained.fetch_add(1, std::memory_order_seq_cst);
+                Unpark(_drained);
+            }
+        } else {
+            WordUnlock();
+        }
+    }
+
+    bool ReadWriteLock::WriteLock(const uint32_t waitTime)
+    {
+        uint64_t start = 0;
+        uint32_t state = _state.load(std::memory_order_relaxed);
+        bool result = false;
+        bool done = false;
+
+        while (done == false) {
+            if ((state & (WRITER_LOCKED | READERS)) == 0) {
+                // Keep the waiting flags, the ones that set them are still parked.
+                if (_state.compare_exchange_weak(state, (WRITER_LOCKED | (state & (WRITER_WAITING | READER_WAITING))), std::memory_order_acquire, std::memory_order_relaxed) == true) {
+                    result = true;
+                    done = true;
+                }
+            } else if ((state & WRITER_WAITING) == 0) {
+                if (_state.compare_exchange_weak(state, (state | WRITER_WAITING), std::memory_order_relaxed) == true) {
+                    state |= WRITER_WAITING;
+                }
+            } else if (Park(_state, state, waitTime, start) == true) {
+                state = _state.load(std::memory_order_relaxed);
+            } else {
+                // Other writers that are still waiting raise the flag again, once woken up.
+                _state.fetch_and(~WRITER_WAITING, std::memory_order_relaxed);
+                Unpark(_state);
+                done = true;
+            }
+        }
+
+        if ((result == true) && (_slots != nullptr) && (_bias.load(std::memory_order_relaxed) == BIAS_ON)) {
+            result = Revoke(waitTime, start);
+        }
+
+        if (start != 0) {
+            _writeContended.fetch_add(1, std::memory_order_relaxed);
+            _waitTime.fetch_add(Core::Time::Now().Ticks() - start, std::memory_order_relaxed);
+        }
+        if (result == true) {
+            _writeAcquired.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        return (result);
+    }
+
+    void ReadWriteLock::WriteUnlock()
+    {
+        ASSERT((_state.load(std::memory_order_relaxed) & WRITER_LOCKED) != 0);
+
+        if ((_slots != nullptr) && (_bias.load(std::memory_order_relaxed) == BIAS_OFF) && (Core::Time::Now().Ticks() >= _inhibitUntil)) {
+            _bias.store(BIAS_ON, std::memory_order_release);
+        }
+
+        Release();
+    }
+
+    ReadWriteLock::Contention ReadWriteLock::Statistics() const
+    {
+        Contention result;
+
+        result.ReadAcquired = _readAcquired.load(std::memory_order_relaxed);
+        result.ReadContended = _readContended.load(std::memory_order_relaxed);
+        result.WriteAcquired = _writeAcquired.load(std::memory_order_relaxed);
+        result.WriteContended = _writeContended.load(std::memory_order_relaxed);
+        result.WaitTime = _waitTime.load(std::memory_order_relaxed);
+        result.Revocations = _revocations.load(std::memory_order_relaxed);
+
+        if (_slots != nullptr) {
+            for (uint8_t index = 0; index < Slots; index++) {
+                result.ReadAcquired += _slots[index].Acquired.load(std::memory_order_relaxed);
+            }
+        }
+
+        return (result);
+    }
+
+    void ReadWriteLock::ResetStatistics()
+    {
+        _readAcquired.store(0, std::memory_order_relaxed);
+        _readContended.store(0, std::memory_order_relaxed);
+        _writeAcquired.store(0, std::memory_order_relaxed);
+        _writeContended.store(0, std::memory_order_relaxed);
+        _waitTime.store(0, std::memory_order_relaxed);
+        _revocations.store(0, std::memory_order_relaxed);
+
+        if (_slots != nullptr) {
+            for (uint8_t index = 0; index < Slots; index++) {
+                _slots[index].Acquired.store(0, std::memory_order_relaxed);
+            }
+        }
+    }
+
+    bool ReadWriteLock::SlotLock(Slot& slot)
+    {
+        bool result = false;
+
+        // Announce ourselves before checking the bias, a revoking writer either sees us in the slot
+        // or we see it revoking.
+        slot.Readers.fetch_add(1, std::memory_order_seq_cst);
+
+        const uint32_t bias = _bias.load(std::memory_order_seq_cst);
+
+        if (bias == BIAS_ON) {
+            slot.Acquired.fetch_add(1, std::memory_order_relaxed);
+            result = true;
+        } else {
+            slot.Readers.fetch_sub(1, std::memory_order_seq_cst);
+
+            if (bias == BIAS_REVOKING) {
+                _drained.fetch_add(1, std::memory_order_seq_cst);
+                Unpark(_drained);
+            }
+        }
+
+        return (result);
+    }
+
+    bool ReadWriteLock::WordLock(const uint32_t waitTime)
+    {
+        uint64_t start = 0;
+        uint32_t state = _state.load(std::memory_order_relaxed);
+        bool result = false;
+        bool done = false;
+
+        while (done == false) {
+            const bool blocked = ((state & WRITER_LOCKED) != 0) || ((Preference() == WRITER) && ((state & WRITER_WAITING) != 0));
+
+            if (blocked == false) {
+                ASSERT((state & READERS) != READERS);
+
+                if (_state.compare_exchange_weak(state, state + 1, std::memory_order_acquire, std::memory_order_relaxed) == true) {
+                    result = true;
+                    done = true;
+                }
+            } else if ((state & READER_WAITING) == 0) {
+                if (_state.compare_exchange_weak(state, (state | READER_WAITING), std::memory_order_relaxed) == true) {
+                    state |= READER_WAITING;
+                }
+            } else if (Park(_state, state, waitTime, start) == true) {
+                state = _state.load(std::memory_order_relaxed);
+            } else {
+                done = true;
+            }
+        }
+
+        if (start != 0) {
+            _readContended.fetch_add(1, std::memory_order_relaxed);
+            _waitTime.fetch_add(Core::Time::Now().Ticks() - start, std::memory_order_relaxed);
+        }
+
+        return (result);
+    }
+
+    void ReadWriteLock::WordUnlock()
+    {
+        const uint32_t previous = _state.fetch_sub(1, std::memory_order_release);
+
+        ASSERT(((previous & READERS) != 0) && ((previous & WRITER_LOCKED) == 0));
+
+        if (((previous & READERS) == 1) && ((previous & WRITER_WAITING) != 0)) {
+            Unpark(_state);
+        }
+    }
+
+    // Called with the lock word held exclusively, so no reader can come in over the word and no
+    // other writer can touch the bias.
+    bool ReadWriteLock::Revoke(const uint32_t waitTime, uint64_t& start)
+    {
+        const uint64_t begin = Core::Time::Now().Ticks();
+        bool result = true;
+
+        _bias.store(BIAS_REVOKING, std::memory_order_seq_cst);
+
+        while (result == true) {
+            const uint32_t drained = _drained.load(std::memory_order_seq_cst);
+            uint32_t readers = 0;
+
+            for (uint8_t index = 0; index < Slots; index++) {
+                readers += _slots[index].Readers.load(std::memory_order_seq_cst);
+            }
+
+            if (readers == 0) {
+                break;
+            }
+
+            result = Park(_drained, drained, waitTime, start);
+        }
+
+        if (result == true) {
+            const uint64_t end = Core::Time::Now().Ticks();
+
+            _bias.store(BIAS_OFF, std::memory_order_release);
+            _inhibitUntil = end + ((end - begin) * InhibitMultiplier);
+            _revocations.fetch_add(1, std::memory_order_relaxed);
+        } else {
+            // The slot readers are still in, hand the lock back to them.
+            _bias.store(BIAS_ON, std::memory_order_release);
+            Release();
+        }
+
+        return (result);
+    }
+
+    void ReadWriteLock::Release()
+    {
+        const uint32_t previous = _state.exchange(0, std::memory_order_release);
+
+        if ((previous & (WRITER_WAITING | READER_WAITING)) != 0) {
+            Unpark(_state);
+        }
+    }
+
+    // Returns false once the waitTime, counted from the first time we parked, is over.
+    bool ReadWriteLock::Park(std::atomic<uint32_t>& word, const uint32_t expected, const uint32_t waitTime, uint64_t& start)
+    {
+        const uint64_t now = Core::Time::Now().Ticks();
+        uint64_t remaining = ~0;
+        bool result = true;
+
+        if (start == 0) {
+            start = now;
+        }
+
+        if (waitTime != Core::infinite) {
+            const uint64_t allowed = static_cast<uint64_t>(waitTime) * Core::Time::TicksPerMillisecond;
+            const uint64_t elapsed = (now > start ? now - start : 0);
+
+            if (elapsed >= allowed) {
+                result = false;
+            } else {
+                remaining = allowed - elapsed;
+            }
+        }
+
+        if (result == true) {
+#if defined(__LINUX__) && !defined(__APPLE__)
+            if (waitTime == Core::infinite) {
+                ::syscall(SYS_futex, reinterpret_cast<uint32_t*>(&word), FUTEX_WAIT | FUTEX_PRIVATE_FLAG, expected, nullptr, nullptr, 0);
+            } else {
+                struct timespec timeout;
+                timeout.tv_sec = static_cast<time_t>(remaining / 1000000);
+                timeout.tv_nsec = static_cast<long>((remaining % 1000000) * 1000);
+                ::syscall(SYS_futex, reinterpret_cast<uint32_t*>(&word), FUTEX_WAIT | FUTEX_PRIVATE_FLAG, expected, &timeout, nullptr, 0);
+            }
+#else
+            std::unique_lock<std::mutex> guard(_parkLock);
+
+            if (word.load(std::memory_order_relaxed) == expected) {
+                if (waitTime == Core::infinite) {
+                    _parked.wait(guard);
+                } else {
+                    _parked.wait_for(guard, std::chrono::microseconds(remaining));
+                }
+            }
+#endif
+        }
+
+        return (result);
+    }
+
+    void ReadWriteLock::Unpark(std::atomic<uint32_t>& word)
+    {
+#if defined(__LINUX__) && !defined(__APPLE__)
+        ::syscall(SYS_futex, reinterpret_cast<uint32_t*>(&word), FUTEX_WAKE | FUTEX_PRIVATE_FLAG, INT_MAX, nullptr, nullptr, 0);
+#else
+        // Taking the lock orders us after a parker that checked the word, but did not sleep yet.
+        {
+            std::lock_guard<std::mutex> guard(_parkLock);
+        }
+        _parked.notify_all();
+#endif
+    }
+
+} // namespace Core
+} // namespace WPEFramework
@@ -21,106 +21,127 @@
 #define __READWRITELOCK_H
 
 #include "Module.h"
+#include "Portability.h"
 
-#include "StateTrigger.h"
-#include "Sync.h"
+#include <atomic>
+
+#if !defined(__LINUX__) || defined(__APPLE__)
+#include <condition_variable>
+#include <mutex>
+#endif
 
 namespace WPEFramework {
 namespace Core {
 
+    // Reader/writer lock for read mostly data. A reader that finds the lock free, or held by other
+    // readers, gets in with a single compare-and-swap on the lock word; nobody parks unless the lock
+    // is held by the other kind, and parked threads sleep on the lock word itself (futex on Linux).
+    //
+    // On top of that the lock can be reader biased (BRAVO): readers then only touch one of a few
+    // cache line sized slots, picked per thread, so readers on different CPUs do not bounce the lock
+    // word between them. A writer revokes the bias and waits for the slots to drain. The bias only
+    // comes back after some multiple of what the revocation cost, so a write heavy lock settles on
+    // the plain path.
     class EXTERNAL ReadWriteLock {
-    private:
-        enum LockState {
-            READERS = 0x01,
-            WRITER = 0x02,
-            IDLE = 0x04
+    public:
+        enum preference : uint8_t {
+            // Readers get in as long as no writer holds the lock, writers might starve.
+            READER,
+            // New readers wait as soon as a writer waits.
+            WRITER
         };
 
-    private:
-        ReadWriteLock(const ReadWriteLock& copy);
-        ReadWriteLock& operator=(const ReadWriteLock& rhs);
+        struct Contention {
+            uint64_t ReadAcquired;
+            uint64_t ReadContended;
+            uint64_t WriteAcquired;
+            uint64_t WriteContended;
+            // Microseconds spent parked, readers and writers together.
+            uint64_t WaitTime;
+            // Number of times a writer had to revoke the reader bias.
+            uint64_t Revocations;
+        };
 
-    public:
-        ReadWriteLock()
-            : m_State(IDLE)
-            , m_Readers(0)
-        {
-        }
-        ~ReadWriteLock()
-        {
-            ASSERT((m_Readers == 0) && (m_State == IDLE));
-        }
+    private:
+        static constexpr uint32_t WRITER_LOCKED = 0x80000000;
+        static constexpr uint32_t WRITER_WAITING = 0x40000000;
+        static constexpr uint32_t READER_WAITING = 0x20000000;
+        static constexpr uint32_t READERS = 0x1FFFFFFF;
+
+        enum bias : uint32_t {
+            BIAS_OFF,
+            BIAS_ON,
+            BIAS_REVOKING
+        };
 
-    public:
-        bool ReadLock(const uint32_t waitTime = Core::infinite)
-        {
-            bool aquired = false;
+        static constexpr uint8_t Slots = 16;
 
-            while ((aquired == false) && (m_State.WaitState(IDLE | READERS, waitTime) == true)) {
-                m_State.Lock();
+        struct Slot {
+            std::atomic<uint32_t> Readers;
+            uint32_t Reserved;
+            std::atomic<uint64_t> Acquired;
+            uint8_t Padding[48];
+        };
+        static_assert(sizeof(Slot) == 64, "A slot should fill exactly one cache line");
 
-                if (m_State == IDLE) {
-                    m_State.SetState(READERS);
-                    m_Readers++;
-                    aquired = true;
-                } else if (m_State == READERS) {
-                    m_Readers++;
-                    aquired = true;
-                }
+    public:
+        ReadWriteLock(const ReadWriteLock&) = delete;
+        ReadWriteLock& operator=(const ReadWriteLock&) = delete;
 
-                m_State.Unlock();
-            }
+        ReadWriteLock();
+        ReadWriteLock(const preference mode, const bool biased);
+        ~ReadWriteLock();
 
-            return (aquired);
-        }
+    public:
+        bool ReadLock(const uint32_t waitTime = Core::infinite);
+        void ReadUnlock();
+        bool WriteLock(const uint32_t waitTime = Core::infinite);
+        void WriteUnlock();
 
-        void ReadUnlock()
+        inline preference Preference() const
         {
-            // If we want to unlock, we must have locked it and thus we must be in the READERS state
-            ASSERT((m_State == READERS) && (m_Readers > 0));
-
-            m_State.Lock();
-
-            m_Readers--;
-
-            if (m_Readers == 0) {
-                m_State.SetState(IDLE);
-            }
-
-            m_State.Unlock();
+            return (static_cast<preference>(_preference.load(std::memory_order_relaxed)));
         }
-
-        bool WriteLock(const uint32_t waitTime = Core::infinite)
+        inline void Preference(const preference mode)
         {
-            // Only 1 allowed, so we need to be in INDLE state
-            bool aquired = false;
-
-            while ((aquired == false) && (m_State.WaitState(IDLE, waitTime) == true)) {
-                m_State.Lock();
-
-                if (m_State == IDLE) {
-                    ASSERT(m_Readers == 0);
-
-                    m_State.SetState(WRITER);
-                    aquired = true;
-                }
-
-                m_State.Unlock();
-            }
-
-            return (aquired);
+            _preference.store(mode, std::memory_order_relaxed);
         }
-        void WriteUnlock()
+        inline bool IsBiased() const
         {
-            // If we want to unlock, we must have locked it and thus we must be in the WRITER state
-            ASSERT((m_State == WRITER) && (m_Readers == 0));
-
-            m_State.SetState(IDLE);
+            return (_slots != nullptr);
         }
 
+        Contention Statistics() const;
+        void ResetStatistics();
+
+    private:
+        bool SlotLock(Slot& slot);
+        bool WordLock(const uint32_t waitTime);
+        void WordUnlock();
+        bool Revoke(const uint32_t waitTime, uint64_t& start);
+        void Release();
+        bool Park(std::atomic<uint32_t>& word, const uint32_t expected, const uint32_t waitTime, uint64_t& start);
+        void Unpark(std::atomic<uint32_t>& word);
+
     private:
-        StateTrigger<LockState> m_State;
-        uint32_t m_Readers;
+        std::atomic<uint32_t> _state;
+        std::atomic<uint32_t> _bias;
+        std::atomic<uint32_t> _drained;
+        std::atomic<uint8_t> _preference;
+        Slot* _slots;
+        uint64_t _inhibitUntil;
+
+        std::atomic<uint64_t> _readAcquired;
+        std::atomic<uint64_t> _readContended;
+        std::atomic<uint64_t> _writeAcquired;
+        std::atomic<uint64_t> _writeContended;
+        std::atomic<uint64_t> _waitTime;
+        std::atomic<uint64_t> _revocations;
+
+#if !defined(__LINUX__) || defined(__APPLE__)
+        std::mutex _parkLock;
+        std::condition_variable _parked;
+#endif
     };
 }
 } // namespace Core
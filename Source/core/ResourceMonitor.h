@@ -96,6 +96,10 @@ namespace Core {
     public:
         ResourceMonitorType()
             : _monitor(nullptr)
+            , _policy(Thread::OTHER)
+            , _priority(0)
+            , _placed(false)
+            , _affinity(0)
             , _adminLock()
             , _resourceList()
             , _monitorRuns(0)
@@ -156,6 +160,33 @@ namespace Core {
         {
             return (_monitor != nullptr ? _monitor->Id() : 0);
         }
+        // The monitor thread is only created once the first resource registers, so remember these till then.
+        void Policy(const Thread::policy type, const int8_t priority)
+        {
+            _adminLock.Lock();
+
+            _policy = type;
+            _priority = priority;
+            _placed = true;
+
+            if (_monitor != nullptr) {
+                _monitor->Policy(_policy, _priority);
+            }
+
+            _adminLock.Unlock();
+        }
+        void Affinity(const uint64_t cpus)
+        {
+            _adminLock.Lock();
+
+            _affinity = cpus;
+
+            if ((_monitor != nullptr) && (_affinity != 0)) {
+                _monitor->Affinity(_affinity);
+            }
+
+            _adminLock.Unlock();
+        }
         uint32_t Count() const 
         {
             return (static_cast<uint32_t>(_resourceList.size()));
@@ -204,6 +235,13 @@ namespace Core {
 
                     // Wait till we are at least initialized
                     _monitor->Wait(Thread::BLOCKED | Thread::STOPPED);
+
+                    if (_placed == true) {
+                        _monitor->Policy(_policy, _priority);
+                    }
+                    if (_affinity != 0) {
+                        _monitor->Affinity(_affinity);
+                    }
                 }
 
                 _monitor->Run();
@@ -515,6 +553,10 @@ namespace Core {
 
     private:
         MonitorWorker* _monitor;
+        Thread::policy _policy;
+        int8_t _priority;
+        bool _placed;
+        uint64_t _affinity;
         mutable Core::CriticalSection _adminLock;
         std::list<RESOURCE*> _resourceList;
         uint32_t _monitorRuns;
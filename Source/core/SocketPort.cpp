@@ -44,6 +44,7 @@
 #include <execinfo.h>
 #include <signal.h>
 #include <sys/ioctl.h>
+#include <sys/sendfile.h>
 #include <sys/signalfd.h>
 #endif
 
@@ -195,6 +196,9 @@ namespace Core {
         , m_ReceivedNode()
         , m_SendBuffer(nullptr)
         , m_ReceiveBuffer(nullptr)
+        , m_SendFile(INVALID_HANDLE_VALUE)
+        , m_SendFileOffset(0)
+        , m_SendFileLength(0)
     {
         TRACE_L5("Constructor SocketPort (NodeId&) <%p>", (this));
     }
@@ -216,6 +220,9 @@ namespace Core {
         , m_ReceivedNode()
         , m_SendBuffer(nullptr)
         , m_ReceiveBuffer(nullptr)
+        , m_SendFile(INVALID_HANDLE_VALUE)
+        , m_SendFileOffset(0)
+        , m_SendFileLength(0)
     {
         NodeId::SocketInfo localAddress;
         socklen_t localSize = sizeof(localAddress);
@@ -306,6 +313,7 @@ namespace Core {
         m_ReadBytes = 0;
         m_SendBytes = 0;
         m_SendOffset = 0;
+        m_SendFileLength = 0;
 
         if ((m_State & (SocketPort::LINK | SocketPort::OPEN | SocketPort::MONITOR)) == (SocketPort::LINK | SocketPort::OPEN)) {
             // Open up an accepted socket, but not yet added to the monitor.
@@ -803,10 +811,10 @@ namespace Core {
         m_State &= (~(SocketPort::WRITE | SocketPort::WRITESLOT));
 
         while (((m_State & (SocketPort::WRITE | SocketPort::SHUTDOWN | SocketPort::OPEN | SocketPort::EXCEPTION)) == SocketPort::OPEN) && (dataLeftToSend == true)) {
-            if (m_SendOffset == m_SendBytes) {
+            if ((m_SendOffset == m_SendBytes) && (m_SendFileLength == 0)) {
                 m_SendBytes = SendData(m_SendBuffer, m_SendBufferSize);
                 m_SendOffset = 0;
-                dataLeftToSend = (m_SendOffset != m_SendBytes);
+                dataLeftToSend = ((m_SendOffset != m_SendBytes) || (m_SendFileLength != 0));
 
                 ASSERT(m_SendBytes <= m_SendBufferSize);
             }
@@ -814,9 +822,28 @@ namespace Core {
             if (dataLeftToSend == true) {
                 int32_t sendSize;
 
+                if (m_SendOffset == m_SendBytes) {
+#ifdef __LINUX__
+                    off_t offset = static_cast<off_t>(m_SendFileOffset);
+
+                    sendSize = static_cast<int32_t>(::sendfile(m_Socket, m_SendFile, &offset, m_SendFileLength));
+
+                    if (sendSize > 0) {
+                        m_SendFileOffset = static_cast<uint64_t>(offset);
+                        m_SendFileLength -= sendSize;
+                    } else if (sendSize == 0) {
+                        // The file got shorter than announced, nothing more we can do, the peer will notice.
+                        m_SendFileLength = 0;
+                    }
+#else
+                    ASSERT(false);
+                    sendSize = 0;
+                    m_SendFileLength = 0;
+#endif
+                }
                 // Sockets are non blocking the Send buffer size is equal to the buffer size. We only send
                 // if the buffer free (SEND flag) is active, so the buffer should always fit.
-                if (((m_State & SocketPort::LINK) == 0) && (m_RemoteNode.IsValid() == true)) {
+                else if (((m_State & SocketPort::LINK) == 0) && (m_RemoteNode.IsValid() == true)) {
                     ASSERT(m_RemoteNode.IsValid() == true);
 
                     sendSize = ::sendto(m_Socket,
@@ -825,15 +852,20 @@ namespace Core {
                         static_cast<const NodeId&>(m_RemoteNode),
                         m_RemoteNode.Size());
 
+                    if (sendSize >= 0) {
+                        m_SendOffset = m_SendBytes;
+                    }
                 } else {
                     sendSize = ::send(m_Socket,
                         reinterpret_cast<const char*>(&m_SendBuffer[m_SendOffset]),
                         m_SendBytes - m_SendOffset, 0);
+
+                    if (sendSize >= 0) {
+                        m_SendOffset = ((m_State & SocketPort::LINK) != 0 ? m_SendOffset + sendSize : m_SendBytes);
+                    }
                 }
 
-                if (sendSize >= 0) {
-                    m_SendOffset = ((m_State & SocketPort::LINK) != 0 ? m_SendOffset + sendSize : m_SendBytes);
-                } else {
+                if (sendSize < 0) {
                     uint32_t l_Result = __ERRORRESULT__;
 
                     if ((l_Result == __ERROR_WOULDBLOCK__) || (l_Result == __ERROR_AGAIN__) || (l_Result == __ERROR_INPROGRESS__)) {
@@ -850,6 +882,33 @@ namespace Core {
         m_syncAdmin.Unlock();
     }
 
+    bool SocketPort::SendFile(const File::Handle handle, const uint64_t offset, const uint32_t length)
+    {
+        bool result = false;
+
+#ifdef __LINUX__
+        m_syncAdmin.Lock();
+
+        ASSERT(m_SendFileLength == 0);
+
+        // Only connected streams, for anything else the framing is up to the data itself.
+        if (((m_State & SocketPort::LINK) != 0) && (SocketMode() == SOCK_STREAM) && (handle != INVALID_HANDLE_VALUE)) {
+            m_SendFile = handle;
+            m_SendFileOffset = offset;
+            m_SendFileLength = length;
+            result = true;
+        }
+
+        m_syncAdmin.Unlock();
+#else
+        DEBUG_VARIABLE(handle);
+        DEBUG_VARIABLE(offset);
+        DEBUG_VARIABLE(length);
+#endif
+
+        return (result);
+    }
+
     void SocketPort::Read()
     {
         m_syncAdmin.Lock();
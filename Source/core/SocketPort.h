@@ -24,6 +24,7 @@
 #ifndef __SOCKETPORT_H
 #define __SOCKETPORT_H
 
+#include "FileSystem.h"
 #include "Module.h"
 #include "NodeId.h"
 #include "Portability.h"
@@ -207,6 +208,12 @@ namespace Core {
         uint32_t Close(const uint32_t waitTime);
         void Trigger();
 
+        // Only to be called from within SendData. Once the data returned by that SendData call is out,
+        // the given part of the file follows, straight from the page cache (sendfile) instead of being
+        // copied through the send buffer. Returns false if this socket can not do so, the caller then
+        // has to send the content itself.
+        bool SendFile(const File::Handle handle, const uint64_t offset, const uint32_t length);
+
         // Methods to extract and insert data into the socket buffers
         virtual uint16_t SendData(uint8_t* dataFrame, const uint16_t maxSendSize) = 0;
         virtual uint16_t ReceiveData(uint8_t* dataFrame, const uint16_t receivedSize) = 0;
@@ -263,6 +270,9 @@ namespace Core {
         uint16_t m_ReadBytes;
         uint16_t m_SendBytes;
         uint16_t m_SendOffset;
+        File::Handle m_SendFile;
+        uint64_t m_SendFileOffset;
+        uint32_t m_SendFileLength;
     };
 
     class EXTERNAL SocketStream : public SocketPort {
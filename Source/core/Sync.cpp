@@ -44,10 +44,16 @@
 
 #if defined(__LINUX__) && !defined(__APPLE__)
 #include <asm/errno.h>
+#include <linux/futex.h>
+#include <sys/syscall.h>
 #include <time.h>
 #include <unistd.h>
 #endif
 
+#include <cinttypes>
+#include <climits>
+#include <thread>
+
 //----------------------------------------------------------------------------
 //----------------------------------------------------------------------------
 // GLOBAL INTERLOCKED METHODS
@@ -118,6 +124,184 @@ namespace Core {
 
 #endif
 
+//----------------------------------------------------------------------------
+//----------------------------------------------------------------------------
+// LockProfile class
+//----------------------------------------------------------------------------
+//----------------------------------------------------------------------------
+
+#if defined(CRITICAL_SECTION_PROFILE) && defined(__POSIX__)
+    // Lives in zero initialized static storage and never takes a lock itself, so it can be used
+    // by CriticalSections that are constructed during static initialization.
+    struct LockProfile::Entry {
+        std::atomic<const void*> Address;
+        std::atomic<uint64_t> Acquired;
+        std::atomic<uint64_t> Contended;
+        std::atomic<uint64_t> WaitTime;
+        std::atomic<uint64_t> MaxHoldTime;
+    };
+
+    namespace {
+
+        constexpr uint32_t ProfileSites = 1024;
+
+        // The last slot collects everything that does not fit anymore.
+        LockProfile::Entry _profile[ProfileSites + 1];
+    }
+
+    /* static */ LockProfile::Entry* LockProfile::Find(const void* address)
+    {
+        const uintptr_t hash = (reinterpret_cast<uintptr_t>(address) >> 2) * 2654435761u;
+        Entry* result = &_profile[ProfileSites];
+
+        for (uint32_t probe = 0; probe < ProfileSites; probe++) {
+            Entry& entry(_profile[(hash + probe) % ProfileSites]);
+            const void* current = entry.Address.load(std::memory_order_acquire);
+
+            if ((current == nullptr) && (entry.Address.compare_exchange_strong(current, address, std::memory_order_acq_rel) == true)) {
+                result = &entry;
+                break;
+            } else if (current == address) {
+                result = &entry;
+                break;
+            }
+        }
+
+        return (result);
+    }
+
+    /* static */ void LockProfile::Acquired(Entry* entry, const bool contended, const uint64_t waitTime)
+    {
+        entry->Acquired.fetch_add(1, std::memory_order_relaxed);
+
+        if (contended == true) {
+            entry->Contended.fetch_add(1, std::memory_order_relaxed);
+            entry->WaitTime.fetch_add(waitTime, std::memory_order_relaxed);
+        }
+    }
+
+    /* static */ void LockProfile::Released(Entry* entry, const uint64_t holdTime)
+    {
+        uint64_t current = entry->MaxHoldTime.load(std::memory_order_relaxed);
+
+        while ((holdTime > current) && (entry->MaxHoldTime.compare_exchange_weak(current, holdTime, std::memory_order_relaxed) == false)) {
+        }
+    }
+
+    /* static */ bool LockProfile::IsEnabled()
+    {
+        return (true);
+    }
+
+    /* static */ void LockProfile::Snapshot(std::vector<Site>& sites)
+    {
+        sites.clear();
+
+        for (uint32_t index = 0; index <= ProfileSites; index++) {
+            const Entry& entry(_profile[index]);
+            const uint64_t acquired = entry.Acquired.load(std::memory_order_relaxed);
+
+            if (acquired > 0) {
+                sites.push_back({ entry.Address.load(std::memory_order_relaxed),
+                    acquired,
+                    entry.Contended.load(std::memory_order_relaxed),
+                    entry.WaitTime.load(std::memory_order_relaxed),
+                    entry.MaxHoldTime.load(std::memory_order_relaxed) });
+            }
+        }
+
+        std::sort(sites.begin(), sites.end(), [](const Site& lhs, const Site& rhs) { return (lhs.WaitTime > rhs.WaitTime); });
+    }
+
+    /* static */ void LockProfile::Reset()
+    {
+        // The sites stay claimed, the CriticalSections hold on to them.
+        for (uint32_t index = 0; index <= ProfileSites; index++) {
+            _profile[index].Acquired.store(0, std::memory_order_relaxed);
+            _profile[index].Contended.store(0, std::memory_order_relaxed);
+            _profile[index].WaitTime.store(0, std::memory_order_relaxed);
+            _profile[index].MaxHoldTime.store(0, std::memory_order_relaxed);
+        }
+    }
+#else
+    /* static */ bool LockProfile::IsEnabled()
+    {
+        return (false);
+    }
+
+    /* static */ void LockProfile::Snapshot(std::vector<Site>& sites)
+    {
+        sites.clear();
+    }
+
+    /* static */ void LockProfile::Reset()
+    {
+    }
+#endif // CRITICAL_SECTION_PROFILE
+
+    /* static */ string LockProfile::Name(const void* address)
+    {
+        string result;
+
+        if (address == nullptr) {
+            result = _T("<other>");
+        } else {
+#ifdef __POSIX__
+            Dl_info info;
+
+            if (dladdr(address, &info) != 0) {
+                char offset[24];
+
+                if (info.dli_sname != nullptr) {
+                    int status = 0;
+                    char* demangled = abi::__cxa_demangle(info.dli_sname, nullptr, nullptr, &status);
+
+                    snprintf(offset, sizeof(offset), "+0x%zx", static_cast<size_t>(reinterpret_cast<const uint8_t*>(address) - reinterpret_cast<const uint8_t*>(info.dli_saddr)));
+                    result = string((status == 0) && (demangled != nullptr) ? demangled : info.dli_sname) + offset;
+
+                    ::free(demangled);
+                } else if (info.dli_fname != nullptr) {
+                    const char* module = ::strrchr(info.dli_fname, '/');
+
+                    snprintf(offset, sizeof(offset), "+0x%zx", static_cast<size_t>(reinterpret_cast<const uint8_t*>(address) - reinterpret_cast<const uint8_t*>(info.dli_fbase)));
+                    result = string(module != nullptr ? (module + 1) : info.dli_fname) + offset;
+                }
+            }
+#endif
+            if (result.empty() == true) {
+                char text[24];
+                snprintf(text, sizeof(text), "%p", address);
+                result = text;
+            }
+        }
+
+        return (result);
+    }
+
+    /* static */ void LockProfile::Dump(FILE* output, const uint16_t maxSites)
+    {
+        if (IsEnabled() == false) {
+            fprintf(output, "Lock profiling is not enabled in this build (LOCK_PROFILING).\n");
+        } else {
+            std::vector<Site> sites;
+            Snapshot(sites);
+
+            fprintf(output, "%12s %12s %14s %14s  %s\n", "acquired", "contended", "wait [us]", "max hold [us]", "site");
+
+            for (uint16_t index = 0; (index < sites.size()) && (index < maxSites); index++) {
+                const Site& site(sites[index]);
+                fprintf(output, "%12" PRIu64 " %12" PRIu64 " %14" PRIu64 " %14" PRIu64 "  %s\n",
+                    site.Acquired, site.Contended, site.WaitTime / 1000, site.MaxHoldTime / 1000, Name(site.Address).c_str());
+            }
+
+            if (sites.size() > maxSites) {
+                fprintf(output, "... %u more sites\n", static_cast<uint32_t>(sites.size() - maxSites));
+            }
+        }
+
+        fflush(output);
+    }
+
 //----------------------------------------------------------------------------
 //----------------------------------------------------------------------------
 // CriticalSection class
@@ -142,6 +326,12 @@ namespace Core {
         : _UsedStackEntries(0)
         , _LockingThread(0)
 #endif // CRITICAL_SECTION_LOCK_LOG
+#ifdef CRITICAL_SECTION_PROFILE
+        // The site is the code constructing the lock, the (possibly inlined) constructor of its owner.
+        : _site(LockProfile::Find(__builtin_return_address(0)))
+        , _depth(0)
+        , _acquired(0)
+#endif // CRITICAL_SECTION_PROFILE
     {
         TRACE_L5("Constructor CriticalSection <%p>", (this));
 
@@ -1042,6 +1232,145 @@ namespace Core {
         ::PulseEvent(m_syncEvent);
 #endif
     }
+
+    //----------------------------------------------------------------------------
+    //----------------------------------------------------------------------------
+    // AdaptiveEvent class (AVAILABLE WITHIN PROCESS SPACE)
+    //----------------------------------------------------------------------------
+    //----------------------------------------------------------------------------
+
+    namespace {
+
+        std::atomic<uint32_t>& DefaultSpinCount()
+        {
+            // Roughly 10-50us worth of spinning, depending on the cost of the pause instruction.
+            static std::atomic<uint32_t> rounds(std::thread::hardware_concurrency() > 1 ? 1000 : 0);
+
+            return (rounds);
+        }
+
+        inline void Relax()
+        {
+#if defined(__i386__) || defined(__x86_64__)
+            __builtin_ia32_pause();
+#elif defined(__aarch64__) || (defined(__ARM_ARCH) && (__ARM_ARCH >= 7))
+            __asm__ __volatile__("yield");
+#elif defined(__WINDOWS__)
+            YieldProcessor();
+#else
+            std::atomic_signal_fence(std::memory_order_seq_cst);
+#endif
+        }
+    }
+
+    //----------------------------------------------------------------------------
+    // CONSTRUCTOR & DESTRUCTOR
+    //----------------------------------------------------------------------------
+
+    AdaptiveEvent::AdaptiveEvent(const bool blSet)
+        : AdaptiveEvent(blSet, DefaultSpinCount().load(std::memory_order_relaxed))
+    {
+    }
+
+    AdaptiveEvent::AdaptiveEvent(const bool blSet, const uint32_t spinCount)
+        : _state(blSet ? 1 : 0)
+        , _waiters(0)
+        , _spinCount(spinCount)
+#if !defined(__LINUX__) || defined(__APPLE__)
+        , _event(blSet, true)
+#endif
+    {
+    }
+
+    AdaptiveEvent::~AdaptiveEvent()
+    {
+    }
+
+    //----------------------------------------------------------------------------
+    // PUBLIC METHODS
+    //----------------------------------------------------------------------------
+
+    /* static */ uint32_t AdaptiveEvent::SpinCount()
+    {
+        return (DefaultSpinCount().load(std::memory_order_relaxed));
+    }
+
+    /* static */ void AdaptiveEvent::SpinCount(const uint32_t rounds)
+    {
+        DefaultSpinCount().store(rounds, std::memory_order_relaxed);
+    }
+
+    uint32_t
+    AdaptiveEvent::Lock(const uint32_t nTime)
+    {
+        uint32_t nResult = Core::ERROR_NONE;
+        uint32_t rounds = (nTime != 0 ? _spinCount : 0);
+
+        while ((_state.load(std::memory_order_acquire) == 0) && (rounds != 0)) {
+            Relax();
+            rounds--;
+        }
+
+        if (_state.load(std::memory_order_acquire) == 0) {
+            if (nTime == 0) {
+                nResult = Core::ERROR_TIMEDOUT;
+            } else {
+#if defined(__LINUX__) && !defined(__APPLE__)
+                struct timespec structTime;
+
+                if (nTime != Core::infinite) {
+                    // FUTEX_WAIT_BITSET takes an absolute CLOCK_MONOTONIC time, so spurious wake ups
+                    // do not stretch the total wait.
+                    clock_gettime(CLOCK_MONOTONIC, &structTime);
+                    structTime.tv_nsec += ((nTime % 1000) * 1000 * 1000);
+                    structTime.tv_sec += (nTime / 1000) + (structTime.tv_nsec / 1000000000);
+                    structTime.tv_nsec = structTime.tv_nsec % 1000000000;
+                }
+
+                // Announce ourselves before the last check, SetEvent either sees us or we see the flag.
+                _waiters.fetch_add(1, std::memory_order_seq_cst);
+
+                while ((_state.load(std::memory_order_seq_cst) == 0) && (nResult == Core::ERROR_NONE)) {
+                    if ((::syscall(SYS_futex, reinterpret_cast<uint32_t*>(&_state), FUTEX_WAIT_BITSET | FUTEX_PRIVATE_FLAG, 0,
+                            (nTime == Core::infinite ? nullptr : &structTime), nullptr, FUTEX_BITSET_MATCH_ANY) != 0)
+                        && (errno == ETIMEDOUT)) {
+                        nResult = Core::ERROR_TIMEDOUT;
+                    }
+                }
+
+                _waiters.fetch_sub(1, std::memory_order_relaxed);
+#else
+                nResult = _event.Lock(nTime);
+#endif
+            }
+        }
+
+        return (nResult);
+    }
+
+    void
+    AdaptiveEvent::ResetEvent()
+    {
+        _state.store(0, std::memory_order_release);
+
+#if !defined(__LINUX__) || defined(__APPLE__)
+        _event.ResetEvent();
+#endif
+    }
+
+    void
+    AdaptiveEvent::SetEvent()
+    {
+#if defined(__LINUX__) && !defined(__APPLE__)
+        if ((_state.exchange(1, std::memory_order_seq_cst) == 0) && (_waiters.load(std::memory_order_seq_cst) != 0)) {
+            ::syscall(SYS_futex, reinterpret_cast<uint32_t*>(&_state), FUTEX_WAKE | FUTEX_PRIVATE_FLAG, INT_MAX, nullptr, nullptr, 0);
+        }
+#else
+        _state.store(1, std::memory_order_release);
+        _event.SetEvent();
+#endif
+    }
+
 #ifndef __WINDOWS__
 #if defined(CRITICAL_SECTION_LOCK_LOG)
     CriticalSection CriticalSection::_StdErrDumpMutex;
@@ -23,15 +23,71 @@
 #include "Module.h"
 #include "Trace.h"
 
+#include <atomic>
 #include <list>
+#include <vector>
 
 #ifdef __LINUX__
 #include <pthread.h>
 #include <semaphore.h>
 #endif
 
+#if defined(CRITICAL_SECTION_PROFILE) && defined(CRITICAL_SECTION_LOCK_LOG)
+#error "Lock profiling (CRITICAL_SECTION_PROFILE) can not be combined with deadlock detection (CRITICAL_SECTION_LOCK_LOG)."
+#endif
+
 namespace WPEFramework {
 namespace Core {
+    // ===========================================================================
+    // class LockProfile
+    // ===========================================================================
+
+    // Contention statistics of the CriticalSections, per place they are constructed: the code
+    // calling the CriticalSection constructor. That is the constructor of the class owning the lock,
+    // unless the compiler inlined it, then every place an owner is constructed is a site of its own,
+    // so with optimizations the instances of one class may be spread over several sites. Only
+    // collected if the core is built with CRITICAL_SECTION_PROFILE (cmake: LOCK_PROFILING), otherwise
+    // there are simply no sites.
+    class EXTERNAL LockProfile {
+    public:
+        struct Site {
+            const void* Address;
+            uint64_t Acquired;
+            uint64_t Contended;
+            // Nanoseconds.
+            uint64_t WaitTime;
+            uint64_t MaxHoldTime;
+        };
+
+    public:
+        LockProfile() = delete;
+        LockProfile(const LockProfile&) = delete;
+        LockProfile& operator=(const LockProfile&) = delete;
+
+        static bool IsEnabled();
+        // All sites that were used, the ones that waited the longest first.
+        static void Snapshot(std::vector<Site>& sites);
+        static void Reset();
+        // Function (and offset) the site is in, or the module and offset if there are no symbols.
+        static string Name(const void* address);
+        static void Dump(FILE* output, const uint16_t maxSites = 32);
+
+#if defined(CRITICAL_SECTION_PROFILE) && defined(__POSIX__)
+    public:
+        struct Entry;
+
+        static Entry* Find(const void* address);
+        static void Acquired(Entry* entry, const bool contended, const uint64_t waitTime);
+        static void Released(Entry* entry, const uint64_t holdTime);
+        static uint64_t Now()
+        {
+            struct timespec now;
+            clock_gettime(CLOCK_MONOTONIC, &now);
+            return ((static_cast<uint64_t>(now.tv_sec) * 1000000000) + now.tv_nsec);
+        }
+#endif
+    };
+
     // ===========================================================================
     // class CriticalSection
     // ===========================================================================
@@ -50,6 +106,20 @@ namespace Core {
 #ifdef __LINUX__
 #if defined(CRITICAL_SECTION_LOCK_LOG)
             TryLock();
+#elif defined(CRITICAL_SECTION_PROFILE)
+            // Only the contended case pays for the extra clock reads of the wait time.
+            const bool contended = (pthread_mutex_trylock(&m_syncMutex) != 0);
+            const uint64_t start = (contended ? LockProfile::Now() : 0);
+
+            if ((contended == true) && (pthread_mutex_lock(&m_syncMutex) != 0)) {
+                TRACE_L1("Probably creating a deadlock situation. <%d>", 0);
+            }
+
+            if (_depth++ == 0) {
+                _acquired = LockProfile::Now();
+            }
+
+            LockProfile::Acquired(_site, contended, (contended ? (LockProfile::Now() - start) : 0));
 #else
             if (pthread_mutex_lock(&m_syncMutex) != 0) {
                 TRACE_L1("Probably creating a deadlock situation. <%d>", 0);
@@ -65,6 +135,11 @@ namespace Core {
         inline void Unlock()
         {
 #ifdef __POSIX__
+#if defined(CRITICAL_SECTION_PROFILE) && defined(__LINUX__)
+            if (--_depth == 0) {
+                LockProfile::Released(_site, LockProfile::Now() - _acquired);
+            }
+#endif
             if (pthread_mutex_unlock(&m_syncMutex) != 0) {
                 TRACE_L1("Probably does the calling thread not own this CCriticalSection. <%d>", 0);
             }
@@ -97,6 +172,12 @@ namespace Core {
 
         static CriticalSection _StdErrDumpMutex;
 #endif // CRITICAL_SECTION_LOCK_LOG
+#if defined(CRITICAL_SECTION_PROFILE)
+        LockProfile::Entry* _site;
+        // Only touched by the owner, while holding the mutex.
+        uint32_t _depth;
+        uint64_t _acquired;
+#endif // CRITICAL_SECTION_PROFILE
 #endif
     };
 
@@ -210,6 +291,49 @@ namespace Core {
 #endif
     };
 
+    // ===========================================================================
+    // class AdaptiveEvent
+    // ===========================================================================
+
+    // Manual reset event for hand-offs that are usually over within microseconds, e.g. waiting for
+    // the answer on an IPC call. A waiter first spins on the flag for a bounded number of rounds and
+    // only then parks. On Linux the flag itself is the futex, so SetEvent is a single atomic exchange
+    // if nobody is parked, and one system call if somebody is.
+    class EXTERNAL AdaptiveEvent {
+    private:
+        AdaptiveEvent() = delete;
+        AdaptiveEvent(const AdaptiveEvent&) = delete;
+        AdaptiveEvent& operator=(const AdaptiveEvent&) = delete;
+
+    public: // Methods
+        AdaptiveEvent(const bool blSet);
+        AdaptiveEvent(const bool blSet, const uint32_t spinCount);
+        ~AdaptiveEvent();
+
+        // Time in milliseconds!
+        uint32_t Lock(const uint32_t nTime);
+        void ResetEvent();
+        void SetEvent();
+        inline bool IsSet() const
+        {
+            return (_state.load(std::memory_order_acquire) != 0);
+        }
+
+        // Rounds a waiter spins before it parks, for events created without an explicit count.
+        // Defaults to 0 on single CPU systems, where spinning only delays the thread we wait for.
+        static uint32_t SpinCount();
+        static void SpinCount(const uint32_t rounds);
+
+    protected: // Members
+        std::atomic<uint32_t> _state;
+        std::atomic<uint32_t> _waiters;
+        uint32_t _spinCount;
+
+#if !defined(__LINUX__) || defined(__APPLE__)
+        Event _event;
+#endif
+    };
+
     template <typename SYNCOBJECT>
     class SafeSyncType {
     private:
@@ -172,7 +172,7 @@ namespace Core {
             : CHANNEL(args...)
             , _adminLock()
             , _queue()
-            , _reevaluate(false, true)
+            , _reevaluate(false)
             , _waitCount(0)
         {
         }
@@ -351,9 +351,11 @@ namespace Core {
                 if (frame.IsSend() == false) {
                     result = frame.SendData(dataFrame, maxSendSize);
                     if (frame.CanBeRemoved() == true) {
+                        IOutbound::ICallback* callback = frame.Callback();
+                        const IOutbound& outbound = frame.Outbound();
                         _queue.pop_front();
-                        if (frame.Callback() != nullptr) {
-                            frame.Callback()->Updated(frame.Outbound(), Core::ERROR_NONE);
+                        if (callback != nullptr) {
+                            callback->Updated(outbound, Core::ERROR_NONE);
                         }
                         Reevaluate();
                     } else if (frame.IsSend() == true) {
@@ -382,9 +384,11 @@ namespace Core {
 
                 if (frame.CanBeRemoved() == true) {
                     ASSERT(frame.Inbound() != nullptr);
+                    IOutbound::ICallback* callback = frame.Callback();
+                    const IOutbound& outbound = frame.Outbound();
                     _queue.pop_front();
-                    if (frame.Callback() != nullptr) {
-                        frame.Callback()->Updated(frame.Outbound(), Core::ERROR_NONE);
+                    if (callback != nullptr) {
+                        callback->Updated(outbound, Core::ERROR_NONE);
                     }
                     if (_queue.size() > 0) {
                         CHANNEL::Trigger();
@@ -408,7 +412,7 @@ namespace Core {
     private:
         Core::CriticalSection _adminLock;
         std::list<Frame> _queue;
-        Core::Event _reevaluate;
+        Core::AdaptiveEvent _reevaluate;
         volatile std::atomic<uint32_t> _waitCount;
     };
 
@@ -27,6 +27,10 @@
 #include <process.h>
 #endif
 
+#ifdef __LINUX__
+#include <sys/syscall.h>
+#endif
+
 //-----------------------------------------------------------------------------------------------
 // CLASS: Thread
 //-----------------------------------------------------------------------------------------------
@@ -34,6 +38,50 @@
 namespace WPEFramework {
 namespace Core {
 
+    namespace {
+
+        constexpr int NoNiceLevel = INT_MAX;
+
+#ifdef __LINUX__
+        bool ReadLine(const char path[], string& line)
+        {
+            bool result = false;
+            FILE* fp = ::fopen(path, "r");
+
+            if (fp != nullptr) {
+                char buffer[256];
+
+                if (::fgets(buffer, sizeof(buffer), fp) != nullptr) {
+                    line = buffer;
+                    result = true;
+                }
+                ::fclose(fp);
+            }
+
+            return (result);
+        }
+        uint64_t CpuValue(const uint8_t cpu)
+        {
+            // Arm kernels report the relative capacity of a core, otherwise the maximum frequency tells big from little.
+            char path[96];
+            string line;
+            uint64_t result = 0;
+
+            ::snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu%d/cpu_capacity", cpu);
+
+            if (ReadLine(path, line) == false) {
+                ::snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu%d/cpufreq/cpuinfo_max_freq", cpu);
+                ReadLine(path, line);
+            }
+            if (line.empty() == false) {
+                result = ::strtoull(line.c_str(), nullptr, 10);
+            }
+
+            return (result);
+        }
+#endif
+    }
+
     /* static */ uint32_t Thread::_defaultStackSize = 0;
 
     Thread::Thread(const uint32_t stackSize, const TCHAR* threadName)
@@ -48,6 +96,8 @@ namespace Core {
 #else
         , m_hThreadInstance()
         , m_ThreadId(0)
+        , m_tid(0)
+        , m_nice(NoNiceLevel)
 #endif
     {
         TRACE_L5("Constructor Thread <%p>", (this));
@@ -145,6 +195,16 @@ namespace Core {
         pthread_sigmask(SIG_BLOCK, &mask, nullptr);
 #endif
 
+#ifdef __LINUX__
+        cClassPointer->m_tid = static_cast<pid_t>(::syscall(SYS_gettid));
+
+        // A nice level requested before we got here, is applied now.
+        const int nice = cClassPointer->m_nice;
+        if (nice != NoNiceLevel) {
+            ::setpriority(PRIO_PROCESS, cClassPointer->m_tid, nice);
+        }
+#endif
+
         StateTrigger<thread_state>& stateObject = cClassPointer->m_enumState;
 
         stateObject.WaitState(INITIALIZED | DEACTIVATE | RUNNING | STOPPED | STOPPING, Core::infinite);
@@ -319,6 +379,177 @@ namespace Core {
         return (result);
     }
 
+    bool Thread::Policy(const policy type, const int8_t priority)
+    {
+        bool result = false;
+
+#ifdef __POSIX__
+        const bool realtime = ((type == FIFO) || (type == ROUNDROBIN));
+        struct sched_param param;
+        int native = SCHED_OTHER;
+
+        switch (type) {
+        case FIFO:
+            native = SCHED_FIFO;
+            break;
+        case ROUNDROBIN:
+            native = SCHED_RR;
+            break;
+#ifdef __LINUX__
+        case BATCH:
+            native = SCHED_BATCH;
+            break;
+        case IDLE:
+            native = SCHED_IDLE;
+            break;
+#endif
+        default:
+            break;
+        }
+
+        param.sched_priority = (realtime == true ? priority : 0);
+        result = (::pthread_setschedparam(m_hThreadInstance, native, &param) == 0);
+
+#ifdef __LINUX__
+        if ((result == true) && (realtime == false)) {
+            m_nice = priority;
+
+            const pid_t tid = m_tid;
+            if (tid != 0) {
+                result = (::setpriority(PRIO_PROCESS, tid, priority) == 0);
+            }
+        }
+#endif
+
+        if (result == false) {
+            TRACE_L1("Failed to set scheduling policy %d with priority %d. Error: %d", type, priority, errno);
+        }
+#endif
+
+        return (result);
+    }
+
+    bool Thread::Affinity(const uint64_t cpus)
+    {
+        bool result = false;
+
+#ifdef __LINUX__
+        cpu_set_t set;
+        CPU_ZERO(&set);
+
+        for (uint8_t cpu = 0; cpu < 64; cpu++) {
+            if ((cpus & (1ULL << cpu)) != 0) {
+                CPU_SET(cpu, &set);
+            }
+        }
+
+        result = (::pthread_setaffinity_np(m_hThreadInstance, sizeof(set), &set) == 0);
+
+        if (result == false) {
+            TRACE_L1("Failed to set the affinity to 0x%llX. Error: %d", static_cast<unsigned long long>(cpus), errno);
+        }
+#endif
+#ifdef __WINDOWS__
+        result = (::SetThreadAffinityMask(m_hThreadInstance, static_cast<DWORD_PTR>(cpus)) != 0);
+#endif
+
+        return (result);
+    }
+
+    /* static */ uint64_t Thread::Cores(const string& list)
+    {
+        uint64_t result = 0;
+        const TCHAR* text = list.c_str();
+
+        while (*text != '\0') {
+            TCHAR* end;
+            unsigned long first = ::strtoul(text, &end, 10);
+            unsigned long last = first;
+
+            if (end == text) {
+                // Skip whatever is not a number, like the ',' or a trailing newline.
+                text++;
+            } else {
+                text = end;
+
+                if (*text == '-') {
+                    last = ::strtoul(text + 1, &end, 10);
+                    text = end;
+                }
+                for (; (first <= last) && (first < 64); first++) {
+                    result |= (1ULL << first);
+                }
+            }
+        }
+
+        return (result);
+    }
+
+    /* static */ uint64_t Thread::Cores(const cluster type)
+    {
+        uint64_t result = 0;
+
+#ifdef __LINUX__
+        string line;
+
+        if (ReadLine("/sys/devices/system/cpu/online", line) == true) {
+            result = Cores(line);
+
+            if (type != ALL) {
+                uint64_t values[64];
+                uint64_t highest = 0;
+                uint64_t lowest = ~0ULL;
+
+                for (uint8_t cpu = 0; cpu < 64; cpu++) {
+                    values[cpu] = ((result & (1ULL << cpu)) != 0 ? CpuValue(cpu) : 0);
+
+                    if (values[cpu] != 0) {
+                        highest = std::max(highest, values[cpu]);
+                        lowest = std::min(lowest, values[cpu]);
+                    }
+                }
+
+                // If we can not tell the cores apart, they are all in the same cluster.
+                if (highest != 0) {
+                    const uint64_t wanted = (type == PERFORMANCE ? highest : lowest);
+                    uint64_t selection = 0;
+
+                    for (uint8_t cpu = 0; cpu < 64; cpu++) {
+                        if (values[cpu] == wanted) {
+                            selection |= (1ULL << cpu);
+                        }
+                    }
+                    result = selection;
+                }
+            }
+        }
+#else
+        DEBUG_VARIABLE(type);
+#endif
+
+        return (result);
+    }
+
+    /* static */ uint64_t Thread::Node(const uint8_t node)
+    {
+        uint64_t result = 0;
+
+#ifdef __LINUX__
+        char path[64];
+        string line;
+
+        ::snprintf(path, sizeof(path), "/sys/devices/system/node/node%d/cpulist", node);
+
+        if (ReadLine(path, line) == true) {
+            result = Cores(line);
+        }
+#else
+        DEBUG_VARIABLE(node);
+#endif
+
+        return (result);
+    }
+
     bool Thread::Wait(const unsigned int enumState, unsigned int nTime) const
     {
         return (m_enumState.WaitState(enumState, nTime));
@@ -143,6 +143,21 @@ namespace Core {
 
         } thread_state;
 
+        enum policy : uint8_t {
+            OTHER,
+            BATCH,
+            IDLE,
+            FIFO,
+            ROUNDROBIN
+        };
+
+        // On heterogeneous (big.LITTLE) SoCs, the cores with the highest or lowest capacity.
+        enum cluster : uint8_t {
+            ALL,
+            PERFORMANCE,
+            EFFICIENCY
+        };
+
         static uint32_t DefaultStackSize()
         {
             return (_defaultStackSize);
@@ -175,6 +190,18 @@ namespace Core {
         int PriorityMin() const;
         int PriorityMax() const;
         bool Priority(int priority);
+
+        // For FIFO and ROUNDROBIN the priority is the real-time priority (1-99), for the others it is
+        // the nice level (-20-19).
+        bool Policy(const policy type, const int8_t priority);
+        // Bit n set allows the thread to run on cpu n.
+        bool Affinity(const uint64_t cpus);
+
+        // All cores in a cluster, or in a NUMA node, as an affinity mask (0 if unknown).
+        static uint64_t Cores(const cluster type);
+        static uint64_t Node(const uint8_t node);
+        // Cores in a list like "0-3,6", as used by the kernel in sysfs.
+        static uint64_t Cores(const string& list);
         inline ::ThreadId Id() const
         {
 #if defined(__WINDOWS__) || defined(__APPLE__)
@@ -238,6 +265,10 @@ namespace Core {
         Event m_sigExit;
         pthread_t m_hThreadInstance;
         uint32_t m_ThreadId;
+        // Kernel id of the thread and the nice level it should run at, a nice level can only be set
+        // once the thread itself reported its kernel id.
+        std::atomic<pid_t> m_tid;
+        std::atomic<int> m_nice;
 #endif
 
 #ifdef __WINDOWS__
@@ -251,7 +282,16 @@ namespace Core {
 
     class EXTERNAL ThreadPool {
     public:
-        typedef Core::QueueType< Core::ProxyType<IDispatch> > MessageQueue;
+        // Lanes in which jobs wait for a thread, the first lane that has jobs is served first.
+        enum priority : uint8_t {
+            HIGH,
+            NORMAL,
+            LOW
+        };
+
+        static constexpr uint8_t Priorities = LOW + 1;
+
+        typedef Core::PriorityQueueType< Core::ProxyType<IDispatch>, Priorities > MessageQueue;
 
         template<typename IMPLEMENTATION>
         class JobType {
@@ -470,7 +510,7 @@ namespace Core {
         ThreadPool& operator=(const ThreadPool& a_RHS) = delete;
 
         ThreadPool(const uint8_t count, const uint32_t stackSize, const uint32_t queueSize) 
-            : _queue(queueSize)
+            : _queue(queueSize, { 10, 100, 1000 })
         {
             const TCHAR* name = _T("WorkerPool::Thread");
             for (uint8_t index = 0; index < count; index++) {
@@ -491,6 +531,18 @@ namespace Core {
         {
             return (_queue.Length());
         }
+        uint32_t Pending(const priority lane) const
+        {
+            return (_queue.Length(lane));
+        }
+        uint32_t Peak(const priority lane) const
+        {
+            return (_queue.Peak(lane));
+        }
+        uint32_t Promoted() const
+        {
+            return (_queue.Promoted());
+        }
         void Runs(const uint8_t length, uint32_t* counters) const 
         {
             uint8_t count = 0;
@@ -525,9 +577,10 @@ namespace Core {
 
             return (ptr != _units.cend() ? ptr->Id() : 0);
         }
-        void Submit(const Core::ProxyType<IDispatch>& job, const uint32_t waitTime)
+        // A deadline is an absolute time in MessageQueue::Now() ticks, 0 means the job just waits its turn.
+        void Submit(const Core::ProxyType<IDispatch>& job, const uint32_t waitTime, const priority lane = NORMAL, const uint64_t deadline = 0)
         {
-            _queue.Insert(job, waitTime);
+            _queue.Insert(job, waitTime, lane, deadline);
         }
         uint32_t Revoke(const Core::ProxyType<IDispatch>& job, const uint32_t waitTime)
         {
@@ -551,6 +604,26 @@ namespace Core {
         MessageQueue& Queue() {
             return (_queue);
         }
+        bool Policy(const Thread::policy type, const int8_t priority)
+        {
+            bool result = true;
+            std::list<Executor>::iterator index = _units.begin();
+            while (index != _units.end()) {
+                result = index->Policy(type, priority) && result;
+                index++;
+            }
+            return (result);
+        }
+        bool Affinity(const uint64_t cpus)
+        {
+            bool result = true;
+            std::list<Executor>::iterator index = _units.begin();
+            while (index != _units.end()) {
+                result = index->Affinity(cpus) && result;
+                index++;
+            }
+            return (result);
+        }
         void Run()
         {
             _queue.Enable();
@@ -167,6 +167,89 @@ namespace Core {
         return (index);
     }
 
+    // Writes value as exactly "count" decimal digits (zero padded).
+    static TCHAR* ToDigits(TCHAR* location, uint32_t value, uint8_t count)
+    {
+        TCHAR* end = location + count;
+
+        while (count-- != 0) {
+            location[count] = static_cast<TCHAR>('0' + (value % 10));
+            value /= 10;
+        }
+
+        return (end);
+    }
+
+    static TCHAR* ToText(TCHAR* location, const TCHAR text[])
+    {
+        while (*text != '\0') {
+            *location++ = *text++;
+        }
+
+        return (location);
+    }
+
+    // Reads exactly "count" decimal digits, returns false if any of them is not a digit.
+    static bool FromDigits(const TCHAR text[], const uint8_t count, int& value)
+    {
+        uint8_t index = 0;
+
+        value = 0;
+
+        while ((index < count) && (text[index] >= '0') && (text[index] <= '9')) {
+            value = (value * 10) + (text[index] - '0');
+            index++;
+        }
+
+        return (index == count);
+    }
+
+    // Sun, 06 Nov 1994 08:49:37 GMT
+    static string FormatRFC1123(const Time& time, const TCHAR zone[])
+    {
+        TCHAR buffer[32];
+        TCHAR* location = ToText(buffer, time.WeekDayName());
+
+        *location++ = ',';
+        *location++ = ' ';
+        location = ToDigits(location, time.Day(), 2);
+        *location++ = ' ';
+        location = ToText(location, time.MonthName());
+        *location++ = ' ';
+        location = ToDigits(location, time.Year(), 4);
+        *location++ = ' ';
+        location = ToDigits(location, time.Hours(), 2);
+        *location++ = ':';
+        location = ToDigits(location, time.Minutes(), 2);
+        *location++ = ':';
+        location = ToDigits(location, time.Seconds(), 2);
+        *location++ = ' ';
+        location = ToText(location, zone);
+
+        return (string(buffer, location - buffer));
+    }
+
+    // 1994-11-06T08:49:37Z
+    static string FormatISO8601(const Time& time, const TCHAR zone[])
+    {
+        TCHAR buffer[32];
+        TCHAR* location = ToDigits(buffer, time.Year(), 4);
+
+        *location++ = '-';
+        location = ToDigits(location, time.Month(), 2);
+        *location++ = '-';
+        location = ToDigits(location, time.Day(), 2);
+        *location++ = 'T';
+        location = ToDigits(location, time.Hours(), 2);
+        *location++ = ':';
+        location = ToDigits(location, time.Minutes(), 2);
+        *location++ = ':';
+        location = ToDigits(location, time.Seconds(), 2);
+        location = ToText(location, zone);
+
+        return (string(buffer, location - buffer));
+    }
+
     const TCHAR* Time::WeekDayName() const
     {
         static const TCHAR _weekDayNames[] = _T("Sun\0Mon\0Tue\0Wed\0Thu\0Fri\0Sat\0???\0");
@@ -411,77 +494,78 @@ namespace Core {
         bool offsetNegative = false;
         bool localTime = false;
 
-        if ((buffer.length() >= 19) && ::isdigit(buffer[0])) {
-            const char *cbuffer = buffer.c_str();
-            char *endptr = nullptr;
-
-            year = std::strtol(cbuffer, &endptr, 10);
-            if ((year >= 1582) && (year <= 9999) && *endptr == '-') { // 1582 = start of Gregorian calendar
-                month = std::strtol(cbuffer + 5, &endptr, 10);
-                if ((month >= 1) && (month <= 12) && (*endptr == '-')) {
-                    day = std::strtol(cbuffer + 8, &endptr, 10);
-                    if ((day >= 1) && (day <= 31) && (*endptr == 'T')) {
-                        hours = std::strtol(cbuffer + 11, &endptr, 10);
-                        if ((hours >= 0) && (hours <= 23) && (*endptr == ':')) {
-                            minutes = std::strtol(cbuffer + 14, &endptr, 10);
-                            if ((minutes >= 0) && (minutes <= 59) && (*endptr == ':')) {
-                                seconds = std::strtol(cbuffer + 17, &endptr, 10);
-                                if ((seconds >= 0) && (seconds <= 59)) {
-                                    result = true; // date and time was OK
-
-                                    // Handle fractions of seconds
-                                    if (*endptr == '.') {
-                                        if (buffer.length() >= static_cast<size_t>((endptr - cbuffer) + 2)) {
-                                            miliseconds = static_cast<int>(floor(std::strtof(endptr, &endptr) * MilliSecondsPerSecond));
-                                        } else {
-                                            result = false;
-                                        }
-                                    }
-
-                                    if (result == true) {
-                                        if ((*endptr == ' ') || (*endptr == '\0')) {
-                                            // No timezone offset information, assume it's local time
-                                            localTime = true;
-                                        } else if ((*endptr == '+') || (*endptr == '-')) {
-                                            // Handle timezone
-                                            offsetNegative = (*endptr == '-');
-
-                                            if (buffer.length() >= static_cast<size_t>((endptr - cbuffer) + 3)) {
-                                                int timezoneHr = std::strtol(endptr + 1, &endptr, 10);
-                                                int timezoneMin = 0;
-                                                if (*endptr == ':') {
-                                                    if (buffer.length() >= static_cast<size_t>((endptr - cbuffer) + 3)) {
-                                                        timezoneMin = std::strtol(endptr + 1, &endptr, 10);
-                                                    } else {
-                                                        result = false;
-                                                    }
-                                                }
-
-                                                if (result == true) {
-                                                    if ((*endptr != ' ') && (*endptr != '\0')) {
-                                                        // Nothing more expected after timezone offset
-                                                        result = false;
-                                                    } else {
-                                                        if ((timezoneHr >= -23) && (timezoneHr <= 23) && (timezoneMin >= 0) && (timezoneMin <= 59)){
-                                                            offset = (timezoneHr * 60) + timezoneMin;
-                                                        } else {
-                                                            result = false;
-                                                        }
-                                                    }
-                                                }
-                                            }
-                                            else {
-                                                result = false;
-                                            }
-                                        }
-                                        else if (*endptr != 'Z') {
-                                            // Nothing else except time offset or 'Z' is allowed at the end of the string
-                                            result = false;
-                                        }
-                                    }
+        if (buffer.length() >= 19) {
+            const TCHAR* cbuffer = buffer.c_str();
+
+            // The fields have fixed positions, read them directly, no need for strtol().
+            if ((FromDigits(&cbuffer[0], 4, year) == true) && (year >= 1582) && (cbuffer[4] == '-') // 1582 = start of Gregorian calendar
+                && (FromDigits(&cbuffer[5], 2, month) == true) && (month >= 1) && (month <= 12) && (cbuffer[7] == '-')
+                && (FromDigits(&cbuffer[8], 2, day) == true) && (day >= 1) && (day <= 31) && (cbuffer[10] == 'T')
+                && (FromDigits(&cbuffer[11], 2, hours) == true) && (hours <= 23) && (cbuffer[13] == ':')
+                && (FromDigits(&cbuffer[14], 2, minutes) == true) && (minutes <= 59) && (cbuffer[16] == ':')
+                && (FromDigits(&cbuffer[17], 2, seconds) == true) && (seconds <= 59)) {
+
+                const TCHAR* endptr = &cbuffer[19];
+
+                result = true; // date and time was OK
+
+                // Handle fractions of seconds, only the milliseconds are of interest.
+                if (*endptr == '.') {
+                    uint32_t scale = MilliSecondsPerSecond;
+
+                    endptr++;
+
+                    if (::isdigit(*endptr) == 0) {
+                        result = false;
+                    }
+
+                    while (::isdigit(*endptr) != 0) {
+                        if (scale > 1) {
+                            scale /= 10;
+                            miliseconds += (*endptr - '0') * scale;
+                        }
+                        endptr++;
+                    }
+                }
+
+                if (result == true) {
+                    if ((*endptr == ' ') || (*endptr == '\0')) {
+                        // No timezone offset information, assume it's local time
+                        localTime = true;
+                    } else if ((*endptr == '+') || (*endptr == '-')) {
+                        // Handle timezone
+                        int timezoneHr = 0;
+                        int timezoneMin = 0;
+
+                        offsetNegative = (*endptr == '-');
+
+                        if (FromDigits(&endptr[1], 2, timezoneHr) == false) {
+                            result = false;
+                        } else {
+                            endptr += 3;
+
+                            if (*endptr == ':') {
+                                if (FromDigits(&endptr[1], 2, timezoneMin) == false) {
+                                    result = false;
+                                } else {
+                                    endptr += 3;
                                 }
                             }
                         }
+
+                        if (result == true) {
+                            if ((*endptr != ' ') && (*endptr != '\0')) {
+                                // Nothing more expected after timezone offset
+                                result = false;
+                            } else if ((timezoneHr <= 23) && (timezoneMin <= 59)) {
+                                offset = (timezoneHr * 60) + timezoneMin;
+                            } else {
+                                result = false;
+                            }
+                        }
+                    } else if (*endptr != 'Z') {
+                        // Nothing else except time offset or 'Z' is allowed at the end of the string
+                        result = false;
                     }
                 }
             }
@@ -665,8 +749,6 @@ namespace Core {
     string Time::ToRFC1123(const bool localTime) const
     {
         // Sun, 06 Nov 1994 08:49:37 GMT  ; RFC 822, updated by RFC 1123
-        TCHAR buffer[32];
-
         if (!IsValid())
             return string();
 
@@ -679,23 +761,14 @@ namespace Core {
             } else {
                 SystemTimeToTzSpecificLocalTime(nullptr, &_time, &convertedTime);
             }
-            Time converted(convertedTime, localTime);
-            _stprintf(buffer, _T("%s, %02d %s %04d %02d:%02d:%02d %s"), converted.WeekDayName(),
-                converted.Day(), converted.MonthName(), converted.Year(),
-                converted.Hours(), converted.Minutes(), converted.Seconds(), zone);
-        } else
-#pragma warning(disable : 4996)
-            _stprintf(buffer, _T("%s, %02d %s %04d %02d:%02d:%02d %s"), WeekDayName(), Day(), MonthName(), Year(),
-                Hours(), Minutes(), Seconds(), zone);
-#pragma warning(default : 4996)
+            return (FormatRFC1123(Time(convertedTime, localTime), zone));
+        }
 
-        return (string(buffer));
+        return (FormatRFC1123(*this, zone));
     }
 
     string Time::ToISO8601(const bool localTime) const
     {
-        TCHAR buffer[32];
-
         if (!IsValid())
             return string();
 
@@ -709,17 +782,10 @@ namespace Core {
                 SystemTimeToTzSpecificLocalTime(nullptr, &_time, &convertedTime);
             }
 
-            Time converted(convertedTime, localTime);
-#pragma warning(disable : 4996)
-            _stprintf(buffer, _T("%04d-%02d-%02dT%02d:%02d:%02d%s"), converted.Year(), converted.Month(), converted.Day(), converted.Hours(),
-                converted.Minutes(), converted.Seconds(), zone);
-#pragma warning(default : 4996)
-        } else
-#pragma warning(disable : 4996)
-            _stprintf(buffer, _T("%04d-%02d-%02dT%02d:%02d:%02d%s"), Year(), Month(), Day(), Hours(),Minutes(), Seconds(), zone);
-#pragma warning(default : 4996)
+            return (FormatISO8601(Time(convertedTime, localTime), zone));
+        }
 
-        return (string(buffer));
+        return (FormatISO8601(*this, zone));
     }
 
     /* static */ Time Time::Now()
@@ -734,14 +800,134 @@ namespace Core {
 #endif
 
 #ifdef __POSIX__
-    Time::Time(const struct timespec& time, bool localTime)
+    // Days since 1970-01-01 of the given civil date (proleptic Gregorian).
+    static int64_t DaysFromCivil(int64_t year, const uint32_t month, const uint32_t day)
     {
-        if (localTime) {
-            localtime_r(&time.tv_sec, &_time);
-        } else {
-            gmtime_r(&time.tv_sec, &_time);
+        year -= (month <= 2 ? 1 : 0);
+
+        const int64_t era = (year >= 0 ? year : year - 399) / 400;
+        const uint32_t yoe = static_cast<uint32_t>(year - (era * 400));
+        const uint32_t doy = ((153 * (month > 2 ? month - 3 : month + 9)) + 2) / 5 + day - 1;
+        const uint32_t doe = (yoe * 365) + (yoe / 4) - (yoe / 100) + doy;
+
+        return ((era * 146097) + static_cast<int64_t>(doe) - 719468);
+    }
+
+    // The calendar part of a broken down time only changes once a day, so it is kept per
+    // thread and only recalculated when the day changes. Converting to local time needs
+    // the offset from libc (localtime_r takes the time zone lock), that is cached per
+    // quarter of an hour, the granularity of all DST transitions. A change of the time
+    // zone itself (TZ or /etc/localtime) is looked for once a second, so it shows in the
+    // local times at most a second late.
+    class Calendar {
+    private:
+        static constexpr time_t ZoneWindow = 15 * SecondsPerMinute;
+
+        struct Date {
+            int64_t Days;
+            int Year;
+            int Month;
+            int Day;
+            int WeekDay;
+            int YearDay;
+        };
+
+        struct Zone {
+            time_t Window;
+            time_t Checked;
+            long Offset;
+            int DST;
+            const char* Name;
+        };
+
+        // Seconds, only to tell when a second has passed, so the coarse clock will do.
+        static time_t Uptime()
+        {
+            struct timespec now;
+#ifdef CLOCK_MONOTONIC_COARSE
+            clock_gettime(CLOCK_MONOTONIC_COARSE, &now);
+#else
+            clock_gettime(CLOCK_MONOTONIC, &now);
+#endif
+            return (now.tv_sec);
         }
 
+    public:
+        static void BreakDown(const time_t seconds, const bool localTime, struct tm& result)
+        {
+            static thread_local Date dates[2] = { { INT64_MIN, 0, 0, 0, 0, 0 }, { INT64_MIN, 0, 0, 0, 0, 0 } };
+            static thread_local Zone zone = { static_cast<time_t>(-1), static_cast<time_t>(-1), 0, 0, nullptr };
+            static const char gmt[] = "GMT";
+
+            long offset = 0;
+            int dst = 0;
+            const char* name = gmt;
+
+            if (localTime == true) {
+                const time_t window = seconds - (((seconds % ZoneWindow) + ZoneWindow) % ZoneWindow);
+                const time_t checked = Uptime();
+
+                if ((zone.Window != window) || (zone.Checked != checked) || (zone.Name == nullptr)) {
+                    struct tm local;
+
+                    // Unlike localtime, localtime_r does not have to look for a new time zone.
+                    tzset();
+                    localtime_r(&seconds, &local);
+
+                    zone.Window = window;
+                    zone.Checked = checked;
+                    zone.Offset = local.tm_gmtoff;
+                    zone.DST = local.tm_isdst;
+                    zone.Name = local.tm_zone;
+                }
+
+                offset = zone.Offset;
+                dst = zone.DST;
+                name = zone.Name;
+            }
+
+            const int64_t shifted = static_cast<int64_t>(seconds) + offset;
+            const int64_t days = (shifted >= 0 ? shifted / SecondsPerDay : ((shifted + 1) / SecondsPerDay) - 1);
+            const uint32_t remainder = static_cast<uint32_t>(shifted - (days * SecondsPerDay));
+            Date& date = dates[localTime == true ? 1 : 0];
+
+            if (date.Days != days) {
+                // civil_from_days, see http://howardhinnant.github.io/date_algorithms.html
+                const int64_t z = days + 719468;
+                const int64_t era = (z >= 0 ? z : z - 146096) / 146097;
+                const uint32_t doe = static_cast<uint32_t>(z - (era * 146097));
+                const uint32_t yoe = (doe - (doe / 1460) + (doe / 36524) - (doe / 146096)) / 365;
+                const uint32_t doy = doe - ((365 * yoe) + (yoe / 4) - (yoe / 100));
+                const uint32_t mp = ((5 * doy) + 2) / 153;
+                const uint32_t month = (mp < 10 ? mp + 3 : mp - 9);
+                const int64_t year = static_cast<int64_t>(yoe) + (era * 400) + (month <= 2 ? 1 : 0);
+
+                date.Days = days;
+                date.Year = static_cast<int>(year);
+                date.Month = static_cast<int>(month);
+                date.Day = static_cast<int>(doy - (((153 * mp) + 2) / 5) + 1);
+                date.WeekDay = static_cast<int>(((days % 7) + 11) % 7); // 1970-01-01 was a Thursday
+                date.YearDay = static_cast<int>(days - DaysFromCivil(year, 1, 1));
+            }
+
+            result.tm_sec = static_cast<int>(remainder % SecondsPerMinute);
+            result.tm_min = static_cast<int>((remainder / SecondsPerMinute) % MinutesPerHour);
+            result.tm_hour = static_cast<int>(remainder / SecondsPerHour);
+            result.tm_mday = date.Day;
+            result.tm_mon = date.Month - 1;
+            result.tm_year = date.Year - 1900;
+            result.tm_wday = date.WeekDay;
+            result.tm_yday = date.YearDay;
+            result.tm_isdst = dst;
+            result.tm_gmtoff = offset;
+            result.tm_zone = name;
+        }
+    };
+
+    Time::Time(const struct timespec& time, bool localTime)
+    {
+        Calendar::BreakDown(time.tv_sec, localTime, _time);
+
         // Calculate ticks..
         _ticks = (static_cast<uint64_t>(time.tv_sec) * MicroSecondsPerSecond) + (time.tv_nsec / NanoSecondsPerMicroSecond) + OffsetTicksForEpoch;
     }
@@ -813,11 +999,7 @@ namespace Core {
         else
             flatTime = mktimegm(&source);
 
-        if (localTime) {
-            localtime_r(&flatTime, &_time);
-        } else {
-            gmtime_r(&flatTime, &_time);
-        }
+        Calendar::BreakDown(flatTime, localTime, _time);
 
         // Calculate ticks..
         _ticks = (static_cast<uint64_t>(flatTime) * static_cast<uint64_t>(MicroSecondsPerSecond)) + (static_cast<uint64_t>(millisecond) * static_cast<uint64_t>(MicroSecondsPerMilliSecond)) + OffsetTicksForEpoch;
@@ -828,9 +1010,7 @@ namespace Core {
         _ticks = (static_cast<uint64_t>(info.tv_sec) * static_cast<uint64_t>(MicroSecondsPerSecond)) + static_cast<uint64_t>(info.tv_usec) + OffsetTicksForEpoch;
 
         // This is the seconds since 1970...
-        struct tm* ptm = gmtime(&info.tv_sec);
-
-        _time = *ptm;
+        Calendar::BreakDown(info.tv_sec, false, _time);
     }
     Time::Time(const uint64_t time, const bool localTime /*= false*/)
         : _time()
@@ -839,10 +1019,7 @@ namespace Core {
         // This is the seconds since 1970...
         time_t epochTimestamp = static_cast<time_t>((time - OffsetTicksForEpoch) / MicroSecondsPerSecond);
 
-        if (localTime)
-            localtime_r(&epochTimestamp, &_time);
-        else
-            gmtime_r(&epochTimestamp, &_time);
+        Calendar::BreakDown(epochTimestamp, localTime, _time);
     }
 
     uint64_t Time::Ticks() const
@@ -863,59 +1040,32 @@ namespace Core {
     string Time::ToRFC1123(const bool localTime) const
     {
         // Sun, 06 Nov 1994 08:49:37 GMT  ; RFC 822, updated by RFC 1123
-        TCHAR buffer[32];
         const TCHAR* zone = (localTime == false) ? _T("GMT") : _T("");
 
         if (!IsValid())
             return string();
 
         if (localTime != IsLocalTime()) {
-            // We need to convert from local to GMT or vv
-            time_t epochTimestamp;
-            struct tm originalTime = _time;
-            if (IsLocalTime())
-                epochTimestamp = mktime(&originalTime);
-            else
-                epochTimestamp = mktimegm(&originalTime);
-            timespec convertedTime{ epochTimestamp, 0 };
-            Time converted(convertedTime, localTime);
-            _stprintf(buffer, _T("%s, %02d %s %04d %02d:%02d:%02d %s"), converted.WeekDayName(),
-                converted.Day(), converted.MonthName(), converted.Year(),
-                converted.Hours(), converted.Minutes(), converted.Seconds(), zone);
-        } else {
-            _stprintf(buffer, _T("%s, %02d %s %04d %02d:%02d:%02d %s"), WeekDayName(), Day(), MonthName(), Year(), Hours(),
-                Minutes(), Seconds(), zone);
+            // The ticks are absolute, just present them in the other zone.
+            return (FormatRFC1123(Time(_ticks, localTime), zone));
         }
 
-        return (string(buffer));
+        return (FormatRFC1123(*this, zone));
     }
 
     string Time::ToISO8601(const bool localTime) const
     {
-        TCHAR buffer[32];
         const TCHAR* zone = (localTime == false) ? _T("Z") : _T("");
 
         if (!IsValid())
             return string();
 
         if (localTime != IsLocalTime()) {
-            // We need to convert from local to GMT or vv
-            time_t epochTimestamp;
-            struct tm originalTime = _time;
-            if (IsLocalTime())
-                epochTimestamp = mktime(&originalTime);
-            else
-                epochTimestamp = mktimegm(&originalTime);
-
-            timespec convertedTime{ epochTimestamp, 0 };
-            Time converted(convertedTime, localTime);
-            _stprintf(buffer, _T("%04d-%02d-%02dT%02d:%02d:%02d%s"), converted.Year(), converted.Month(), converted.Day(), converted.Hours(),
-                converted.Minutes(), converted.Seconds(), zone);
-        } else {
-            _stprintf(buffer, _T("%04d-%02d-%02dT%02d:%02d:%02d%s"), Year(), Month(), Day(), Hours(),Minutes(), Seconds(), zone);
+            // The ticks are absolute, just present them in the other zone.
+            return (FormatISO8601(Time(_ticks, localTime), zone));
         }
 
-        return (string(buffer));
+        return (FormatISO8601(*this, zone));
     }
 
     string Time::Format(const TCHAR* formatter) const
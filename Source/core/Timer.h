@@ -271,6 +271,14 @@ namespace Core {
         {
             return (m_TimerThread.Id());
         }
+        bool Policy(const Thread::policy type, const int8_t priority)
+        {
+            return (m_TimerThread.Policy(type, priority));
+        }
+        bool Affinity(const uint64_t cpus)
+        {
+            return (m_TimerThread.Affinity(cpus));
+        }
 
     protected:
         uint32_t Process()
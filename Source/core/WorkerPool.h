@@ -29,6 +29,8 @@ namespace WPEFramework {
 namespace Core {
 
     struct EXTERNAL IWorkerPool {
+        typedef ThreadPool::priority priority;
+
         virtual ~IWorkerPool(){};
 
         template <typename IMPLEMENTATION>
@@ -48,12 +50,12 @@ namespace Core {
             }
 
         public:
-            void Submit()
+            void Submit(const priority lane = ThreadPool::NORMAL)
             {
                 Core::ProxyType<Core::IDispatch> job(ThreadPool::JobType<IMPLEMENTATION>::Aquire());
 
                 if (job.IsValid()) {
-                    Core::IWorkerPool::Instance().Submit(job);
+                    Core::IWorkerPool::Instance().Submit(job, lane);
                 }
             }
             bool Schedule(const Core::Time& time)
@@ -78,6 +80,9 @@ namespace Core {
             uint32_t Occupation;
             uint8_t Slots;
             uint32_t* Slot;
+            uint32_t Lane[ThreadPool::Priorities];
+            uint32_t Peak[ThreadPool::Priorities];
+            uint32_t Promoted;
         };
 
         static void Assign(IWorkerPool* instance);
@@ -86,6 +91,8 @@ namespace Core {
 
         virtual ::ThreadId Id(const uint8_t index) const = 0;
         virtual void Submit(const Core::ProxyType<Core::IDispatch>& job) = 0;
+        // A deadline is an absolute time in ThreadPool::MessageQueue::Now() ticks, 0 is no deadline.
+        virtual void Submit(const Core::ProxyType<Core::IDispatch>& job, const priority lane, const uint64_t deadline = 0) = 0;
         virtual void Schedule(const Core::Time& time, const Core::ProxyType<Core::IDispatch>& job) = 0;
         virtual uint32_t Revoke(const Core::ProxyType<Core::IDispatch>& job, const uint32_t waitTime = Core::infinite) = 0;
         virtual void Join() = 0;
@@ -125,10 +132,12 @@ namespace Core {
             {
                 return (!operator==(RHS));
             }
-            uint64_t Timed(const uint64_t /* scheduledTime */)
+            uint64_t Timed(const uint64_t)
             {
                 ASSERT(_pool != nullptr);
-                _pool->Submit(_job);
+                // It is due now, so it goes before the jobs that still have time. The scheduled
+                // time is wall clock time, the queue deadlines are not, so do not hand that one in.
+                _pool->Submit(_job, ThreadPool::NORMAL, ThreadPool::MessageQueue::Now());
                 _job.Release();
 
                 // No need to reschedule, just drop it..
@@ -167,6 +176,10 @@ namespace Core {
         {
             _threadPool.Submit(job, Core::infinite);
         }
+        void Submit(const Core::ProxyType<Core::IDispatch>& job, const priority lane, const uint64_t deadline = 0) override
+        {
+            _threadPool.Submit(job, Core::infinite, lane, deadline);
+        }
         void Schedule(const Core::Time& time, const Core::ProxyType<Core::IDispatch>& job) override
         {
             _timer.Schedule(time, Timer(this, job));
@@ -208,10 +221,27 @@ namespace Core {
             _metadata.Occupation = _threadPool.Active();
             _metadata.Slot[0] = _external.Runs();
 
+            for (uint8_t lane = 0; lane < ThreadPool::Priorities; lane++) {
+                _metadata.Lane[lane] = _threadPool.Pending(static_cast<priority>(lane));
+                _metadata.Peak[lane] = _threadPool.Peak(static_cast<priority>(lane));
+            }
+            _metadata.Promoted = _threadPool.Promoted();
+
             _threadPool.Runs(_threadPool.Count(), &(_metadata.Slot[1]));
 
             return (_metadata);
         }
+        // Applies to the pool threads and the timer thread that feeds them.
+        bool Policy(const Thread::policy type, const int8_t priority)
+        {
+            bool result = _threadPool.Policy(type, priority);
+            return (_timer.Policy(type, priority) && result);
+        }
+        bool Affinity(const uint64_t cpus)
+        {
+            bool result = _threadPool.Affinity(cpus);
+            return (_timer.Affinity(cpus) && result);
+        }
         void Run()
         {
             _threadPool.Run();
@@ -49,9 +49,11 @@
 #include "Factory.h"
 #include "FileSystem.h"
 #include "Frame.h"
+#include "Histogram.h"
 #include "IPCMessage.h"
 #include "IPCChannel.h"
 #include "IPCConnector.h"
+#include "IPCRing.h"
 #include "ISO639.h"
 #include "JSON.h"
 #include "JSONRPC.h"
@@ -68,6 +70,7 @@
 #include "Parser.h"
 #include "Process.h"
 #include "ProcessInfo.h"
+#include "ProcessObserver.h"
 #include "Proxy.h"
 #include "Queue.h"
 #include "Range.h"
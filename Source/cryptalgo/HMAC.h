@@ -37,18 +37,21 @@ namespace Crypto {
     class HMACType {
     private:
         HMACType();
-        HMACType(const HMACType&);
-        HMACType& operator=(const HMACType&);
 
     public:
         HMACType(const string& key)
-            : _algorithm()
+            : _computed(false)
+            , _innerState()
+            , _outerState()
+            , _algorithm()
         {
+            uint8_t innerKeyPad[BlockSize];
+            uint8_t outerKeyPad[BlockSize];
             uint8_t keyLength;
             const uint8_t* encryptionKey;
             HASHALGORITHM hashKey;
 
-            if (key.length() > sizeof(_innerKeyPad)) {
+            if (key.length() > sizeof(innerKeyPad)) {
                 keyLength = HASHALGORITHM::Length;
 
                 // Calculate the Hash over the key to use that i.s.o. the actual key.
@@ -62,19 +65,25 @@ namespace Crypto {
             }
 
             // We have a suitable key, move it to the inner and outer pads
-            ::memset(&_innerKeyPad[keyLength], 0x36, sizeof(_innerKeyPad) - keyLength);
-            ::memset(&_outerKeyPad[keyLength], 0x5C, sizeof(_outerKeyPad) - keyLength);
+            ::memset(&innerKeyPad[keyLength], 0x36, sizeof(innerKeyPad) - keyLength);
+            ::memset(&outerKeyPad[keyLength], 0x5C, sizeof(outerKeyPad) - keyLength);
 
             /* XOR key with inner keypad and outer key pad values */
             for (uint8_t index = 0; index < keyLength; index++) {
-                _innerKeyPad[index] = encryptionKey[index] ^ 0x36;
-                _outerKeyPad[index] = encryptionKey[index] ^ 0x5c;
+                innerKeyPad[index] = encryptionKey[index] ^ 0x36;
+                outerKeyPad[index] = encryptionKey[index] ^ 0x5c;
             }
 
+            // The pads only depend on the key, hash them once and restart every
+            // calculation from these states.
+            _innerState.Input(innerKeyPad, sizeof(innerKeyPad));
+            _outerState.Input(outerKeyPad, sizeof(outerKeyPad));
+
             // Reset the algorithm. We start from scratch..
-            _algorithm.Input(_innerKeyPad, sizeof(_innerKeyPad));
-            _computed = false;
+            _algorithm = _innerState;
         }
+        HMACType(const HMACType<HASHALGORITHM>& copy) = default;
+        HMACType<HASHALGORITHM>& operator=(const HMACType<HASHALGORITHM>& rhs) = default;
         ~HMACType()
         {
         }
@@ -84,12 +93,11 @@ namespace Crypto {
         static const uint8_t Length = HASHALGORITHM::Length;
         inline static uint8_t BlockLength()
         {
-            return (sizeof(_innerKeyPad));
+            return (BlockSize);
         }
         void Reset()
         {
-            _algorithm.Reset();
-            _algorithm.Input(_innerKeyPad, sizeof(_innerKeyPad));
+            _algorithm = _innerState;
             _computed = false;
         }
         const uint8_t* Result()
@@ -102,8 +110,7 @@ namespace Crypto {
                 ::memcpy(hashKey, _algorithm.Result(), sizeof(hashKey));
 
                 // Now use the newly generated key to calulate the outer value..
-                _algorithm.Reset();
-                _algorithm.Input(_outerKeyPad, sizeof(_outerKeyPad));
+                _algorithm = _outerState;
                 _algorithm.Input(hashKey, sizeof(hashKey));
             }
 
@@ -139,9 +146,11 @@ namespace Crypto {
         }
 
     private:
+        static constexpr uint8_t BlockSize = 64;
+
         bool _computed;
-        uint8_t _innerKeyPad[64];
-        uint8_t _outerKeyPad[64];
+        HASHALGORITHM _innerState;
+        HASHALGORITHM _outerState;
         HASHALGORITHM _algorithm;
     };
 
@@ -81,11 +81,10 @@ namespace Crypto {
     };
 
     class EXTERNAL SHA1 {
-    private:
-        SHA1(const SHA1&);
-        SHA1& operator=(const SHA1&);
-
     public:
+        SHA1(const SHA1&) = default;
+        SHA1& operator=(const SHA1&) = default;
+
         inline SHA1()
         {
             Reset();
@@ -189,11 +188,10 @@ namespace Crypto {
     };
 
     class EXTERNAL MD5 {
-    private:
-        MD5(const MD5&);
-        MD5& operator=(const MD5&);
-
     public:
+        MD5(const MD5&) = default;
+        MD5& operator=(const MD5&) = default;
+
         typedef struct {
             uint32_t lo, hi;
             uint32_t a, b, c, d;
@@ -275,11 +273,10 @@ namespace Crypto {
             uint32_t h[8];
         } Context;
 
-    private:
-        SHA256(const SHA256&);
-        SHA256& operator=(const SHA256&);
-
     public:
+        SHA256(const SHA256&) = default;
+        SHA256& operator=(const SHA256&) = default;
+
         inline SHA256()
         {
             Reset();
@@ -325,11 +322,10 @@ namespace Crypto {
     };
 
     class EXTERNAL SHA224 {
-    private:
-        SHA224(const SHA224&);
-        SHA224& operator=(const SHA224&);
-
     public:
+        SHA224(const SHA224&) = default;
+        SHA224& operator=(const SHA224&) = default;
+
         inline SHA224()
         {
             Reset();
@@ -383,11 +379,10 @@ namespace Crypto {
             uint64_t h[8];
         } Context;
 
-    private:
-        SHA512(const SHA512&);
-        SHA512& operator=(const SHA512&);
-
     public:
+        SHA512(const SHA512&) = default;
+        SHA512& operator=(const SHA512&) = default;
+
         inline SHA512()
         {
             Reset();
@@ -433,11 +428,10 @@ namespace Crypto {
     };
 
     class EXTERNAL SHA384 {
-    private:
-        SHA384(const SHA384&);
-        SHA384& operator=(const SHA384&);
-
     public:
+        SHA384(const SHA384&) = default;
+        SHA384& operator=(const SHA384&) = default;
+
         inline SHA384()
         {
             Reset();
@@ -112,7 +112,17 @@ namespace PluginHost {
                 }
 
                 if (_current.IsValid() == true) {
-                    loaded = _current->Serialize(stream, length, _offset);
+                    if (_parent.IsMessagePack() == true) {
+                        const Core::JSON::IMessagePack* element = dynamic_cast<const Core::JSON::IMessagePack*>(&(*_current));
+
+                        ASSERT(element != nullptr);
+
+                        if (element != nullptr) {
+                            loaded = element->Serialize(reinterpret_cast<uint8_t*>(stream), length, _offset);
+                        }
+                    } else {
+                        loaded = _current->Serialize(stream, length, _offset);
+                    }
                     if ( (_offset == 0) || (loaded != length) ) {
                         _current.Release();
                     }
@@ -158,7 +168,15 @@ namespace PluginHost {
                     }
                 } 
 				if (_current.IsValid() == true) {
-                    loaded = _current->Deserialize(stream, length, _offset);
+                    if (_parent.IsMessagePack() == true) {
+                        Core::JSON::IMessagePack* element = dynamic_cast<Core::JSON::IMessagePack*>(&(*_current));
+
+                        ASSERT(element != nullptr);
+
+                        loaded = (element != nullptr ? element->Deserialize(reinterpret_cast<const uint8_t*>(stream), length, _offset) : length);
+                    } else {
+                        loaded = _current->Deserialize(stream, length, _offset);
+                    }
                     if ( (_offset == 0) || (loaded != length)) {
                         _parent.Received(_current);
                         _current.Release();
@@ -230,6 +248,11 @@ namespace PluginHost {
         {
             return ((_state & 0x8000) != 0);
         }
+        // JSON and JSONRPC channels negotiated as MessagePack exchange binary frames.
+        inline bool IsMessagePack() const
+        {
+            return ((_state & 0x1000) != 0);
+        }
         inline void Submit(const string& text)
         {
             if (IsOpen() == true) {
@@ -290,10 +313,12 @@ namespace PluginHost {
         {
             _nameOffset = offset;
         }
-        inline void State(const ChannelState state, const bool notification)
+        inline void State(const ChannelState state, const bool notification, const bool messagePack = false)
         {
-            Binary(state == RAW);
-            _state = state | (notification ? 0x8000 : 0x0000);
+            ASSERT((messagePack == false) || (state == JSON) || (state == JSONRPC));
+
+            Binary((state == RAW) || (messagePack == true));
+            _state = state | (notification ? 0x8000 : 0x0000) | (messagePack ? 0x1000 : 0x0000);
         }
         inline uint16_t Serialize(uint8_t* dataFrame, const uint16_t maxSendSize)
         {
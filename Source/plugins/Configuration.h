@@ -29,6 +29,14 @@
 namespace WPEFramework {
 namespace Plugin {
     class EXTERNAL Config : public Core::JSON::Container {
+    public:
+        // Order in which the framework hands the requests of plugins to the worker pool.
+        enum priority : uint8_t {
+            INTERACTIVE,
+            NORMAL,
+            BACKGROUND
+        };
+
     public:
         Config()
             : Core::JSON::Container()
@@ -42,6 +50,8 @@ namespace Plugin {
             , Precondition()
             , Termination()
             , Configuration(false)
+            , Priority(NORMAL)
+            , Concurrency(0)
         {
             Add(_T("callsign"), &Callsign);
             Add(_T("locator"), &Locator);
@@ -53,6 +63,8 @@ namespace Plugin {
             Add(_T("precondition"), &Precondition);
             Add(_T("termination"), &Termination);
             Add(_T("configuration"), &Configuration);
+            Add(_T("priority"), &Priority);
+            Add(_T("concurrency"), &Concurrency);
         }
         Config(const Config& copy)
             : Core::JSON::Container()
@@ -66,6 +78,8 @@ namespace Plugin {
             , Precondition(copy.Precondition)
             , Termination(copy.Termination)
             , Configuration(copy.Configuration)
+            , Priority(copy.Priority)
+            , Concurrency(copy.Concurrency)
         {
             Add(_T("callsign"), &Callsign);
             Add(_T("locator"), &Locator);
@@ -77,6 +91,8 @@ namespace Plugin {
             Add(_T("precondition"), &Precondition);
             Add(_T("termination"), &Termination);
             Add(_T("configuration"), &Configuration);
+            Add(_T("priority"), &Priority);
+            Add(_T("concurrency"), &Concurrency);
         }
         ~Config()
         {
@@ -94,6 +110,8 @@ namespace Plugin {
             Configuration = RHS.Configuration;
             Precondition = RHS.Precondition;
             Termination = RHS.Termination;
+            Priority = RHS.Priority;
+            Concurrency = RHS.Concurrency;
 
             return (*this);
         }
@@ -109,6 +127,9 @@ namespace Plugin {
         Core::JSON::ArrayType<Core::JSON::EnumType<PluginHost::ISubSystem::subsystem>> Precondition;
         Core::JSON::ArrayType<Core::JSON::EnumType<PluginHost::ISubSystem::subsystem>> Termination;
         Core::JSON::String Configuration;
+        Core::JSON::EnumType<priority> Priority;
+        // Maximum number of requests of this plugin handled at the same time, 0 is no limit.
+        Core::JSON::DecUInt8 Concurrency;
 
         static Core::NodeId IPV4UnicastNode(const string& ifname);
 
@@ -273,13 +273,15 @@ namespace PluginHost {
             Registration info;
             Core::ProxyType<Core::JSONRPC::Message> response(Message());
             Core::JSONRPC::Handler* source = nullptr;
+            const string designator(inbound.Designator.Value());
+            const Core::JSONRPC::Message::Designation designation(designator);
 
             if (inbound.Id.IsSet() == true) {
                 response->JSONRPC = Core::JSONRPC::Message::DefaultVersion;
                 response->Id = inbound.Id.Value();
             }
 
-            switch (Destination(inbound.Designator.Value(), source)) {
+            switch (Destination(designation, source)) {
             case STATE_INCORRECT_HANDLER:
                 response->Error.SetError(Core::ERROR_INVALID_DESIGNATOR);
                 response->Error.Text = _T("Destined invoke failed.");
@@ -309,12 +311,12 @@ namespace PluginHost {
                 break;
             case STATE_CUSTOM:
                 string result;
-                uint32_t code = source->Invoke(Core::JSONRPC::Connection(channelId, inbound.Id.Value()), inbound.FullMethod(), inbound.Parameters.Value(), result);
+                uint32_t code = source->Invoke(Core::JSONRPC::Connection(channelId, inbound.Id.Value()), designation, inbound.Parameters.Value(), result);
                 if (response.IsValid() == true) {
                     if (code == static_cast<uint32_t>(~0)) {
                         response.Release();
                     } else if (code == Core::ERROR_NONE) {
-                        response->Result = result;
+                        response->Result = std::move(result);
                     } else {
                         response->Error.Code = code;
                         response->Error.Text = Core::ErrorToString(code);
@@ -326,15 +328,15 @@ namespace PluginHost {
         }
 
     private:
-        state Destination(const string& designator, Core::JSONRPC::Handler*& source)
+        state Destination(const Core::JSONRPC::Message::Designation& designation, Core::JSONRPC::Handler*& source)
         {
             state result = STATE_INCORRECT_HANDLER;
-            string callsign(Core::JSONRPC::Message::Callsign(designator));
+            const Core::TextFragment callsign(designation.Callsign());
 
-            if (callsign.empty() || (callsign == _callsign)) {
+            if ((callsign.Length() == 0) || (callsign == _callsign.c_str())) {
                 // Seems we are on the right handler..
                 // now see if someone supports this version
-                uint8_t version = Core::JSONRPC::Message::Version(designator);
+                uint8_t version = designation.Version();
                 HandlerList::iterator index(_handlers.begin());
 
                 if (version != static_cast<uint8_t>(~0)) {
@@ -346,7 +348,7 @@ namespace PluginHost {
                 if (index == _handlers.end()) {
                     result = STATE_INCORRECT_VERSION;
                 } else {
-                    string method(Core::JSONRPC::Message::Method(designator));
+                    const string method(designation.Method().Text());
 
                     if (method == _T("register")) {
                         result = STATE_REGISTRATION;
@@ -46,6 +46,14 @@ ENUM_CONVERSION_BEGIN(PluginHost::MetaData::Channel::state)
 
     ENUM_CONVERSION_END(PluginHost::MetaData::Service::state)
 
+        ENUM_CONVERSION_BEGIN(Core::ThreadPool::priority)
+
+            { Core::ThreadPool::HIGH, _TXT("high") },
+    { Core::ThreadPool::NORMAL, _TXT("normal") },
+    { Core::ThreadPool::LOW, _TXT("low") },
+
+    ENUM_CONVERSION_END(Core::ThreadPool::priority)
+
         ENUM_CONVERSION_BEGIN(PluginHost::ISubSystem::IInternet::network_type)
 
             { PluginHost::ISubSystem::IInternet::UNKNOWN, _TXT("Unknown") },
@@ -96,6 +104,36 @@ ENUM_CONVERSION_BEGIN(PluginHost::MetaData::Channel::state)
         return (Core::JSON::EnumType<state>::Data());
     }
 
+    MetaData::Service::Usage::Usage()
+        : Core::JSON::Container()
+    {
+        Add(_T("cputime"), &CpuTime);
+        Add(_T("jobs"), &Jobs);
+        Add(_T("allocations"), &Allocations);
+        Add(_T("allocated"), &Allocated);
+        Add(_T("running"), &Running);
+        Add(_T("pending"), &Pending);
+    }
+    MetaData::Service::Usage::Usage(const Usage& copy)
+        : Core::JSON::Container()
+        , CpuTime(copy.CpuTime)
+        , Jobs(copy.Jobs)
+        , Allocations(copy.Allocations)
+        , Allocated(copy.Allocated)
+        , Running(copy.Running)
+        , Pending(copy.Pending)
+    {
+        Add(_T("cputime"), &CpuTime);
+        Add(_T("jobs"), &Jobs);
+        Add(_T("allocations"), &Allocations);
+        Add(_T("allocated"), &Allocated);
+        Add(_T("running"), &Running);
+        Add(_T("pending"), &Pending);
+    }
+    MetaData::Service::Usage::~Usage()
+    {
+    }
+
     MetaData::Service::Service()
         : Plugin::Config()
     {
@@ -109,6 +147,7 @@ ENUM_CONVERSION_BEGIN(PluginHost::MetaData::Channel::state)
 #endif
         Add(_T("module"), &Module);
         Add(_T("hash"), &Hash);
+        Add(_T("usage"), &Resources);
     }
     MetaData::Service::Service(const MetaData::Service& copy)
         : Plugin::Config(copy)
@@ -122,6 +161,7 @@ ENUM_CONVERSION_BEGIN(PluginHost::MetaData::Channel::state)
 #endif
         , Module(copy.Module)
         , Hash(copy.Hash)
+        , Resources(copy.Resources)
     {
         Add(_T("state"), &JSONState);
 #ifdef RUNTIME_STATISTICS
@@ -133,6 +173,7 @@ ENUM_CONVERSION_BEGIN(PluginHost::MetaData::Channel::state)
 #endif
         Add(_T("module"), &Module);
         Add(_T("hash"), &Hash);
+        Add(_T("usage"), &Resources);
     }
     MetaData::Service::~Service()
     {
@@ -221,11 +262,126 @@ ENUM_CONVERSION_BEGIN(PluginHost::MetaData::Channel::state)
     {
     }
 
+    MetaData::Latency::Histogram::Histogram()
+        : Core::JSON::Container()
+    {
+        Add(_T("count"), &Count);
+        Add(_T("average"), &Average);
+        Add(_T("p50"), &P50);
+        Add(_T("p90"), &P90);
+        Add(_T("p99"), &P99);
+        Add(_T("max"), &Max);
+    }
+    MetaData::Latency::Histogram::Histogram(const Histogram& copy)
+        : Core::JSON::Container()
+        , Count(copy.Count)
+        , Average(copy.Average)
+        , P50(copy.P50)
+        , P90(copy.P90)
+        , P99(copy.P99)
+        , Max(copy.Max)
+    {
+        Add(_T("count"), &Count);
+        Add(_T("average"), &Average);
+        Add(_T("p50"), &P50);
+        Add(_T("p90"), &P90);
+        Add(_T("p99"), &P99);
+        Add(_T("max"), &Max);
+    }
+    MetaData::Latency::Histogram::~Histogram()
+    {
+    }
+    void MetaData::Latency::Histogram::Set(const Core::LatencyHistogram& histogram)
+    {
+        Count = histogram.Count();
+        Average = histogram.Average();
+        P50 = histogram.Percentile(50);
+        P90 = histogram.Percentile(90);
+        P99 = histogram.Percentile(99);
+        Max = histogram.Max();
+    }
+
+    MetaData::Latency::Latency()
+        : Core::JSON::Container()
+    {
+        Add(_T("category"), &Category);
+        Add(_T("name"), &Name);
+        Add(_T("queue"), &Queue);
+        Add(_T("execution"), &Execution);
+        Add(_T("serialization"), &Serialization);
+    }
+    MetaData::Latency::Latency(const Core::LatencyStatistics::Metric& metric)
+        : Core::JSON::Container()
+    {
+        Add(_T("category"), &Category);
+        Add(_T("name"), &Name);
+        Add(_T("queue"), &Queue);
+        Add(_T("execution"), &Execution);
+        Add(_T("serialization"), &Serialization);
+
+        Category = metric.Category;
+        Name = metric.Name;
+        Queue.Set(metric.Queue);
+        Execution.Set(metric.Execution);
+        Serialization.Set(metric.Serialization);
+    }
+    MetaData::Latency::Latency(const Latency& copy)
+        : Core::JSON::Container()
+        , Category(copy.Category)
+        , Name(copy.Name)
+        , Queue(copy.Queue)
+        , Execution(copy.Execution)
+        , Serialization(copy.Serialization)
+    {
+        Add(_T("category"), &Category);
+        Add(_T("name"), &Name);
+        Add(_T("queue"), &Queue);
+        Add(_T("execution"), &Execution);
+        Add(_T("serialization"), &Serialization);
+    }
+    MetaData::Latency::~Latency()
+    {
+    }
+
+    MetaData::Server::Lane::Lane()
+        : Core::JSON::Container()
+    {
+        Core::JSON::Container::Add(_T("priority"), &Priority);
+        Core::JSON::Container::Add(_T("pending"), &Pending);
+        Core::JSON::Container::Add(_T("peak"), &Peak);
+    }
+    MetaData::Server::Lane::Lane(const Core::ThreadPool::priority priority, const uint32_t pending, const uint32_t peak)
+        : Core::JSON::Container()
+    {
+        Core::JSON::Container::Add(_T("priority"), &Priority);
+        Core::JSON::Container::Add(_T("pending"), &Pending);
+        Core::JSON::Container::Add(_T("peak"), &Peak);
+
+        Priority = priority;
+        Pending = pending;
+        Peak = peak;
+    }
+    MetaData::Server::Lane::Lane(const Lane& copy)
+        : Core::JSON::Container()
+        , Priority(copy.Priority)
+        , Pending(copy.Pending)
+        , Peak(copy.Peak)
+    {
+        Core::JSON::Container::Add(_T("priority"), &Priority);
+        Core::JSON::Container::Add(_T("pending"), &Pending);
+        Core::JSON::Container::Add(_T("peak"), &Peak);
+    }
+    MetaData::Server::Lane::~Lane()
+    {
+    }
+
     MetaData::Server::Server()
     {
         Core::JSON::Container::Add(_T("threads"), &ThreadPoolRuns);
         Core::JSON::Container::Add(_T("pending"), &PendingRequests);
         Core::JSON::Container::Add(_T("occupation"), &PoolOccupation);
+        Core::JSON::Container::Add(_T("lanes"), &Lanes);
+        Core::JSON::Container::Add(_T("promoted"), &Promoted);
     }
     MetaData::Server::~Server()
     {
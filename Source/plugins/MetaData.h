@@ -70,6 +70,25 @@ namespace PluginHost {
                 string Data() const;
             };
 
+            // What the requests of the plugin cost the framework worker pool.
+            class EXTERNAL Usage : public Core::JSON::Container {
+            private:
+                Usage& operator=(const Usage&) = delete;
+
+            public:
+                Usage();
+                Usage(const Usage& copy);
+                ~Usage();
+
+            public:
+                Core::JSON::DecUInt64 CpuTime;
+                Core::JSON::DecUInt32 Jobs;
+                Core::JSON::DecUInt64 Allocations;
+                Core::JSON::DecUInt64 Allocated;
+                Core::JSON::DecUInt32 Running;
+                Core::JSON::DecUInt32 Pending;
+            };
+
         public:
             Service();
             Service(const Service& copy);
@@ -88,6 +107,7 @@ namespace PluginHost {
 #endif
             Core::JSON::String Module;
             Core::JSON::String Hash;
+            Usage Resources;
         };
 
         class EXTERNAL Channel : public Core::JSON::Container {
@@ -151,7 +171,65 @@ namespace PluginHost {
             Core::JSON::Boolean Secure;
         };
 
+        class EXTERNAL Latency : public Core::JSON::Container {
+        public:
+            class EXTERNAL Histogram : public Core::JSON::Container {
+            private:
+                Histogram& operator=(const Histogram&) = delete;
+
+            public:
+                Histogram();
+                Histogram(const Histogram& copy);
+                ~Histogram();
+
+            public:
+                void Set(const Core::LatencyHistogram& histogram);
+
+            public:
+                Core::JSON::DecUInt32 Count;
+                Core::JSON::DecUInt64 Average;
+                Core::JSON::DecUInt64 P50;
+                Core::JSON::DecUInt64 P90;
+                Core::JSON::DecUInt64 P99;
+                Core::JSON::DecUInt64 Max;
+            };
+
+        private:
+            Latency& operator=(const Latency&) = delete;
+
+        public:
+            Latency();
+            Latency(const Core::LatencyStatistics::Metric& metric);
+            Latency(const Latency& copy);
+            ~Latency();
+
+        public:
+            Core::JSON::String Category;
+            Core::JSON::String Name;
+            Histogram Queue;
+            Histogram Execution;
+            Histogram Serialization;
+        };
+
         class EXTERNAL Server : public Core::JSON::Container {
+        public:
+            // Jobs waiting for a thread in one priority lane of the worker pool.
+            class EXTERNAL Lane : public Core::JSON::Container {
+            private:
+                Lane& operator=(const Lane&) = delete;
+
+            public:
+                Lane();
+                Lane(const Core::ThreadPool::priority priority, const uint32_t pending, const uint32_t peak);
+                Lane(const Lane& copy);
+                ~Lane();
+
+            public:
+                Core::JSON::EnumType<Core::ThreadPool::priority> Priority;
+                Core::JSON::DecUInt32 Pending;
+                Core::JSON::DecUInt32 Peak;
+            };
+
         private:
             Server(const Server& copy) = delete;
             Server& operator=(const Server&) = delete;
@@ -163,12 +241,15 @@ namespace PluginHost {
             inline void Clear()
             {
                 ThreadPoolRuns.Clear();
+                Lanes.Clear();
             }
 
         public:
             Core::JSON::ArrayType<Core::JSON::DecUInt32> ThreadPoolRuns;
             Core::JSON::DecUInt32 PendingRequests;
             Core::JSON::DecUInt32 PoolOccupation;
+            Core::JSON::ArrayType<Lane> Lanes;
+            Core::JSON::DecUInt32 Promoted;
         };
 
         class EXTERNAL SubSystem : public Core::JSON::Container {
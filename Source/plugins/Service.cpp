@@ -22,6 +22,14 @@
 
 namespace WPEFramework {
 
+ENUM_CONVERSION_BEGIN(Plugin::Config::priority)
+
+    { Plugin::Config::INTERACTIVE, _TXT("interactive") },
+    { Plugin::Config::NORMAL, _TXT("normal") },
+    { Plugin::Config::BACKGROUND, _TXT("background") },
+
+    ENUM_CONVERSION_END(Plugin::Config::priority)
+
 namespace PluginHost {
 
     PluginHost::Request::Request()
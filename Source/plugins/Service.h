@@ -267,6 +267,14 @@ namespace PluginHost {
         {
             return (_config.IsSupported(number));
         }
+        inline Plugin::Config::priority Priority() const
+        {
+            return (_config.Configuration().Priority.Value());
+        }
+        inline uint8_t Concurrency() const
+        {
+            return (_config.Configuration().Concurrency.Value());
+        }
         inline const Plugin::Config& Configuration() const
         {
             return (_config.Configuration());
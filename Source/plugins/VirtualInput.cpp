@@ -692,6 +692,7 @@ namespace PluginHost
 #endif
     IPCUserInput::IPCUserInput(const Core::NodeId& sourceName)
         : _service(*this, sourceName)
+        , _connector(sourceName.Type() == Core::NodeId::TYPE_DOMAIN ? sourceName.HostName() : string())
     {
         TRACE_L1("Constructing IPCUserInput for %s on %s", sourceName.HostAddress().c_str(), sourceName.HostName().c_str());
     }
@@ -594,6 +594,8 @@ namespace PluginHost {
             InputDataLink(const InputDataLink&) = delete;
             InputDataLink& operator=(const InputDataLink&) = delete;
 
+            static constexpr uint8_t RingAttempts = 10;
+
         public:
             InputDataLink(Core::IPCChannelType<Core::SocketPort, InputDataLink>*)
                 : _enabled(false)
@@ -602,10 +604,15 @@ namespace PluginHost {
                 , _parent(nullptr)
                 , _postLookup(nullptr)
                 , _replacement(Core::ProxyType<IVirtualInput::KeyMessage>::Create())
+                , _adminLock()
+                , _ring(nullptr)
             {
             }
             virtual ~InputDataLink()
             {
+                if (_ring != nullptr) {
+                    delete _ring;
+                }
             }
 
         public:
@@ -640,6 +647,19 @@ namespace PluginHost {
                             result = Core::ProxyType<Core::IIPC>(_replacement);
                         }
                     }
+
+                    // Clients with a shared ring get all events from there. Mixing in IPC messages would
+                    // deliver them on another thread, out of order, so if the ring stays full it is dropped.
+                    _adminLock.Lock();
+
+                    if ((_ring != nullptr) && (result.IsValid() == true)) {
+                        if (Post(*result) == false) {
+                            TRACE_L1("Event ring of %s is full, event dropped.", _name.c_str());
+                        }
+                        result.Release();
+                    }
+
+                    _adminLock.Unlock();
                 }
                 return (result);
             }
@@ -665,12 +685,73 @@ namespace PluginHost {
 
                 return ((index & _mode) != 0);
             }
+            bool Post(Core::IIPC& element) const
+            {
+                IVirtualInput::EventData event;
+                const uint32_t id(element.Label());
+
+                event.Timestamp = Core::Time::Now().Ticks();
+                event.Index = 0;
+                event.Code = 0;
+                event.X = 0;
+                event.Y = 0;
+
+                if (id == IVirtualInput::KeyMessage::Id()) {
+                    const IVirtualInput::KeyData& data(static_cast<IVirtualInput::KeyMessage&>(element).Parameters());
+                    event.Type = IVirtualInput::INPUT_KEY;
+                    event.Action = data.Action;
+                    event.Code = data.Code;
+                } else if (id == IVirtualInput::MouseMessage::Id()) {
+                    const IVirtualInput::MouseData& data(static_cast<IVirtualInput::MouseMessage&>(element).Parameters());
+                    event.Type = IVirtualInput::INPUT_MOUSE;
+                    event.Action = data.Action;
+                    event.Index = data.Button;
+                    event.X = data.Horizontal;
+                    event.Y = data.Vertical;
+                } else {
+                    ASSERT(id == IVirtualInput::TouchMessage::Id());
+                    const IVirtualInput::TouchData& data(static_cast<IVirtualInput::TouchMessage&>(element).Parameters());
+                    event.Type = IVirtualInput::INPUT_TOUCH;
+                    event.Action = data.Action;
+                    event.Index = data.Index;
+                    event.X = data.X;
+                    event.Y = data.Y;
+                }
+
+                // Give the client a moment to catch up before the event is given up on.
+                uint8_t attempts = RingAttempts;
+                bool posted;
+
+                while (((posted = _ring->Post(event)) == false) && (--attempts > 0)) {
+                    SleepMs(1);
+                }
+
+                return (posted);
+            }
             virtual void Dispatch(Core::IIPC& element) override
             {
                 ASSERT(dynamic_cast<IVirtualInput::NameMessage*>(&element) != nullptr);
 
-                _name = (static_cast<IVirtualInput::NameMessage&>(element).Response().Name);
-                _mode = (static_cast<IVirtualInput::NameMessage&>(element).Response().Mode);
+                const IVirtualInput::LinkInfo& info(static_cast<IVirtualInput::NameMessage&>(element).Response());
+
+                _name = info.Name;
+                _mode = info.Mode;
+
+                _adminLock.Lock();
+
+                if (((_mode & IVirtualInput::INPUT_SHARED) != 0) && (info.Version == IVirtualInput::LinkVersion) && (_parent->Connector().empty() == false) && (_ring == nullptr)) {
+                    IVirtualInput::EventRing* ring = new IVirtualInput::EventRing(_parent->Connector(), info.Ring, false);
+
+                    if (ring->IsValid() == true) {
+                        _ring = ring;
+                    } else {
+                        TRACE_L1("Could not open the event ring of %s, using IPC messages.", _name.c_str());
+                        delete ring;
+                    }
+                }
+
+                _adminLock.Unlock();
+
                 _enabled = true;
                 _postLookup = _parent->FindPostLookup(_name);
             }
@@ -682,6 +763,8 @@ namespace PluginHost {
             IPCUserInput* _parent;
             const PostLookupEntries* _postLookup;
             Core::ProxyType<IVirtualInput::KeyMessage> _replacement;
+            mutable Core::CriticalSection _adminLock;
+            IVirtualInput::EventRing* _ring;
         };
 
         class EXTERNAL VirtualInputChannelServer : public Core::IPCChannelServerType<InputDataLink, true> {
@@ -699,7 +782,12 @@ namespace PluginHost {
             {
                 TRACE_L1("VirtualInputChannelServer::Added -- %d", __LINE__);
 
-                Core::ProxyType<Core::IIPC> message(Core::ProxyType<IVirtualInput::NameMessage>::Create());
+                Core::ProxyType<IVirtualInput::NameMessage> request(Core::ProxyType<IVirtualInput::NameMessage>::Create());
+
+                // Older clients send a shorter LinkInfo, whatever they leave out must read as not filled in.
+                ::memset(&(request->Response()), 0, sizeof(IVirtualInput::LinkInfo));
+
+                Core::ProxyType<Core::IIPC> message(request);
 
                 // TODO: The reference to this should be held by the IPC mechanism.. Testing showed it did
                 //       not, to be further investigated..
@@ -807,6 +895,12 @@ namespace PluginHost {
         void MapChanges(ChangeIterator& updated) override;
         void LookupChanges(const string&) override;
 
+        // Base name of the shared event rings, empty if the channel is not a domain socket.
+        inline const string& Connector() const
+        {
+            return (_connector);
+        }
+
     private:
         void Send(const IVirtualInput::KeyData& data) override;
         void Send(const IVirtualInput::MouseData& data) override;
@@ -814,6 +908,7 @@ namespace PluginHost {
 
     private:
         VirtualInputChannelServer _service;
+        const string _connector;
     };
 
     class EXTERNAL InputHandler {
@@ -0,0 +1,336 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2020 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "CGroupStatistics.h"
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <fstream>
+#include <thread>
+
+namespace WPEFramework {
+namespace ProcessContainers {
+
+    namespace {
+
+        bool IsUnifiedHierarchy(const string& root)
+        {
+            return (::access((root + _T("/cgroup.controllers")).c_str(), F_OK) == 0);
+        }
+
+        // Parses an unsigned number and moves the cursor past it (and any trailing whitespace).
+        bool ParseNumber(const char*& position, const char* end, uint64_t& value)
+        {
+            const char* start = position;
+
+            value = 0;
+            while ((position < end) && (*position >= '0') && (*position <= '9')) {
+                value = (value * 10) + (*position - '0');
+                position++;
+            }
+
+            bool result = (position != start);
+
+            while ((position < end) && ((*position == ' ') || (*position == '\n') || (*position == '\t'))) {
+                position++;
+            }
+
+            return (result);
+        }
+
+        // Walks a "key value" per line file (memory.stat, cpu.stat) and hands out the values for
+        // the requested keys, it stops as soon as all of them have been found.
+        void ParseKeys(const char buffer[], const uint32_t length, const uint8_t count, const char* const keys[], uint64_t* const values[])
+        {
+            const char* position = buffer;
+            const char* end = buffer + length;
+            uint8_t found = 0;
+
+            while ((position < end) && (found < count)) {
+                const char* key = position;
+
+                while ((position < end) && (*position != ' ')) {
+                    position++;
+                }
+
+                const uint32_t keyLength = static_cast<uint32_t>(position - key);
+                uint64_t value;
+
+                if (position < end) {
+                    position++;
+                }
+                if (ParseNumber(position, end, value) == true) {
+                    for (uint8_t index = 0; index < count; index++) {
+                        if ((::strncmp(keys[index], key, keyLength) == 0) && (keys[index][keyLength] == '\0')) {
+                            *(values[index]) = value;
+                            found++;
+                            break;
+                        }
+                    }
+                } else {
+                    // Not a number, skip the rest of the line.
+                    while ((position < end) && (*position++ != '\n')) {
+                    }
+                }
+            }
+        }
+    }
+
+    CGroupStatistics::CGroupStatistics(const string& root)
+        : _adminLock()
+        , _root(root)
+        , _unified(IsUnifiedHierarchy(root))
+        , _memoryGroup()
+        , _cpuGroup()
+    {
+        for (uint8_t index = 0; index < FILE_COUNT; index++) {
+            _descriptors[index] = -1;
+        }
+    }
+
+    CGroupStatistics::~CGroupStatistics()
+    {
+        Detach();
+    }
+
+    void CGroupStatistics::Attach(const string& group)
+    {
+        _adminLock.Lock();
+
+        Detach();
+
+        _memoryGroup = group;
+        _cpuGroup = group;
+
+        _adminLock.Unlock();
+    }
+
+    bool CGroupStatistics::Attach(const uint32_t pid)
+    {
+        string memoryGroup;
+        string cpuGroup;
+
+        // Lines look like "<id>:<controllers>:<path>", the unified hierarchy has id 0 and no controllers.
+        std::ifstream file(_T("/proc/") + Core::NumberType<uint32_t>(pid).Text() + _T("/cgroup"));
+        string line;
+
+        while (std::getline(file, line)) {
+            const size_t first = line.find(':');
+            const size_t second = (first == string::npos ? string::npos : line.find(':', first + 1));
+
+            if (second != string::npos) {
+                const string controllers(line, first + 1, second - first - 1);
+                const string path(line, second + 1);
+
+                if (_unified == true) {
+                    if (controllers.empty() == true) {
+                        memoryGroup = path;
+                        cpuGroup = path;
+                    }
+                } else {
+                    const string list(_T(",") + controllers + _T(","));
+
+                    if (list.find(_T(",memory,")) != string::npos) {
+                        memoryGroup = path;
+                    }
+                    if (list.find(_T(",cpuacct,")) != string::npos) {
+                        cpuGroup = path;
+                    }
+                }
+            }
+        }
+
+        _adminLock.Lock();
+
+        Detach();
+
+        _memoryGroup = memoryGroup;
+        _cpuGroup = cpuGroup;
+
+        _adminLock.Unlock();
+
+        return (IsAttached());
+    }
+
+    void CGroupStatistics::Detach()
+    {
+        _adminLock.Lock();
+
+        for (uint8_t index = 0; index < FILE_COUNT; index++) {
+            if (_descriptors[index] != -1) {
+                ::close(_descriptors[index]);
+                _descriptors[index] = -1;
+            }
+        }
+
+        _memoryGroup.clear();
+        _cpuGroup.clear();
+
+        _adminLock.Unlock();
+    }
+
+    IContainer::MemoryInfo CGroupStatistics::Memory() const
+    {
+        IContainer::MemoryInfo result{ UINT64_MAX, UINT64_MAX, UINT64_MAX };
+
+        _adminLock.Lock();
+        Memory(result);
+        _adminLock.Unlock();
+
+        return (result);
+    }
+
+    IContainer::CPUInfo CGroupStatistics::Cpu() const
+    {
+        IContainer::CPUInfo result{ UINT64_MAX, std::vector<uint64_t>() };
+
+        _adminLock.Lock();
+        Cpu(result);
+        _adminLock.Unlock();
+
+        return (result);
+    }
+
+    void CGroupStatistics::Sample(IContainer::UsageInfo& usage) const
+    {
+        usage.memory = { UINT64_MAX, UINT64_MAX, UINT64_MAX };
+        usage.cpu.total = UINT64_MAX;
+        usage.cpu.cores.clear();
+
+        _adminLock.Lock();
+        Memory(usage.memory);
+        Cpu(usage.cpu);
+        _adminLock.Unlock();
+    }
+
+    string CGroupStatistics::Path(const file index) const
+    {
+        static const TCHAR* const legacy[] = { _T("memory.usage_in_bytes"), _T("memory.stat"), _T("cpuacct.usage"), _T("cpuacct.usage_percpu") };
+        static const TCHAR* const unified[] = { _T("memory.current"), _T("memory.stat"), _T("cpu.stat"), nullptr };
+
+        const bool memory = ((index == MEMORY_USAGE) || (index == MEMORY_STAT));
+        const string& group(memory == true ? _memoryGroup : _cpuGroup);
+        string result;
+
+        if (group.empty() == false) {
+            if (_unified == true) {
+                if (unified[index] != nullptr) {
+                    result = _root + '/' + group + '/' + unified[index];
+                }
+            } else {
+                result = _root + (memory == true ? _T("/memory/") : _T("/cpuacct/")) + group + '/' + legacy[index];
+            }
+        }
+
+        return (result);
+    }
+
+    // Must be called with the lock taken. Returns the number of bytes in _buffer.
+    uint32_t CGroupStatistics::Read(const file index) const
+    {
+        uint32_t result = 0;
+
+        if (_descriptors[index] == -1) {
+            // The group might not exist yet (container not started), just try again on the next sample.
+            const string path(Path(index));
+
+            if (path.empty() == false) {
+                _descriptors[index] = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+            }
+        }
+
+        if (_descriptors[index] != -1) {
+            const ssize_t loaded = ::pread(_descriptors[index], _buffer, sizeof(_buffer) - 1, 0);
+
+            if (loaded > 0) {
+                result = static_cast<uint32_t>(loaded);
+                _buffer[result] = '\0';
+            } else {
+                // The group is gone (ENODEV), reopen it once it shows up again.
+                ::close(_descriptors[index]);
+                _descriptors[index] = -1;
+            }
+        }
+
+        return (result);
+    }
+
+    void CGroupStatistics::Memory(IContainer::MemoryInfo& info) const
+    {
+        uint32_t length = Read(MEMORY_USAGE);
+
+        if (length > 0) {
+            const char* position = _buffer;
+            ParseNumber(position, _buffer + length, info.allocated);
+        } else {
+            TRACE_L1("Could not read the memory usage of cgroup %s", _memoryGroup.c_str());
+        }
+
+        length = Read(MEMORY_STAT);
+
+        if (length > 0) {
+            static const char* const legacyKeys[] = { "rss", "mapped_file" };
+            static const char* const unifiedKeys[] = { "anon", "file_mapped" };
+            uint64_t* const values[] = { &info.resident, &info.shared };
+
+            ParseKeys(_buffer, length, 2, (_unified == true ? unifiedKeys : legacyKeys), values);
+        }
+    }
+
+    void CGroupStatistics::Cpu(IContainer::CPUInfo& info) const
+    {
+        uint32_t length = Read(CPU_USAGE);
+
+        if (length > 0) {
+            if (_unified == true) {
+                static const char* const keys[] = { "usage_usec" };
+                uint64_t* const values[] = { &info.total };
+
+                ParseKeys(_buffer, length, 1, keys, values);
+
+                if (info.total != UINT64_MAX) {
+                    info.total *= 1000;
+                }
+            } else {
+                const char* position = _buffer;
+                ParseNumber(position, _buffer + length, info.total);
+            }
+        } else {
+            TRACE_L1("Could not read the cpu usage of cgroup %s", _cpuGroup.c_str());
+        }
+
+        // The unified hierarchy does not account per core.
+        length = (_unified == true ? 0 : Read(CPU_USAGE_PERCPU));
+
+        if (length > 0) {
+            const char* position = _buffer;
+            const char* end = _buffer + length;
+            uint64_t value;
+
+            info.cores.reserve(std::thread::hardware_concurrency());
+
+            while (ParseNumber(position, end, value) == true) {
+                info.cores.push_back(value);
+            }
+        }
+    }
+
+} // ProcessContainers
+} // WPEFramework
@@ -0,0 +1,92 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2020 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "Module.h"
+#include "ProcessContainer.h"
+
+namespace WPEFramework {
+namespace ProcessContainers {
+
+    // Reads the memory and cpu accounting of a control group. The statistic files are opened
+    // once and kept open, every sample is a pread on those descriptors, so periodic monitoring
+    // of many containers does not walk the cgroup filesystem over and over again.
+    // Both the legacy (v1) per-controller hierarchies and the unified (v2) hierarchy are supported.
+    class EXTERNAL CGroupStatistics {
+    private:
+        enum file : uint8_t {
+            MEMORY_USAGE,
+            MEMORY_STAT,
+            CPU_USAGE,
+            CPU_USAGE_PERCPU,
+            FILE_COUNT
+        };
+
+    public:
+        CGroupStatistics(const CGroupStatistics&) = delete;
+        CGroupStatistics& operator=(const CGroupStatistics&) = delete;
+
+        CGroupStatistics(const string& root = _T("/sys/fs/cgroup"));
+        ~CGroupStatistics();
+
+    public:
+        inline bool IsAttached() const
+        {
+            _adminLock.Lock();
+            const bool result = ((_memoryGroup.empty() == false) || (_cpuGroup.empty() == false));
+            _adminLock.Unlock();
+
+            return (result);
+        }
+        inline bool IsUnified() const
+        {
+            return (_unified);
+        }
+
+        // Attach to the group relative to the (controller) root, e.g. "lxc/container".
+        void Attach(const string& group);
+        // Attach to the group the given process lives in, as reported by /proc/<pid>/cgroup.
+        bool Attach(const uint32_t pid);
+        void Detach();
+
+        IContainer::MemoryInfo Memory() const;
+        IContainer::CPUInfo Cpu() const;
+
+        // All statistics of the group in a single pass over the open descriptors.
+        void Sample(IContainer::UsageInfo& usage) const;
+
+    private:
+        string Path(const file index) const;
+        uint32_t Read(const file index) const;
+        void Memory(IContainer::MemoryInfo& info) const;
+        void Cpu(IContainer::CPUInfo& info) const;
+
+    private:
+        mutable Core::CriticalSection _adminLock;
+        const string _root;
+        const bool _unified;
+        string _memoryGroup;
+        string _cpuGroup;
+        mutable int _descriptors[FILE_COUNT];
+        mutable char _buffer[4096];
+    };
+
+} // ProcessContainers
+} // WPEFramework
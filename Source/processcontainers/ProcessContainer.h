@@ -75,6 +75,11 @@ namespace ProcessContainers {
             std::vector<uint64_t> cores; // cpu usage per core in nanoseconds;
         };
 
+        struct UsageInfo {
+            MemoryInfo memory;
+            CPUInfo cpu;
+        };
+
         IContainer() = default;
         virtual ~IContainer() = default;
 
@@ -90,6 +95,16 @@ namespace ProcessContainers {
         // Return time of CPU spent in whole container
         virtual CPUInfo Cpu() const = 0;
 
+        // Return memory and CPU statistics of the whole container in one go. Implementations that
+        // can sample both at once (e.g. from the cgroup) override this, periodic monitors should use it.
+        virtual UsageInfo Usage() const
+        {
+            UsageInfo result;
+            result.memory = Memory();
+            result.cpu = Cpu();
+            return (result);
+        }
+
         // Return information on network status of the container
         virtual NetworkInterfaceIterator* NetworkInterfaces() const = 0;
 
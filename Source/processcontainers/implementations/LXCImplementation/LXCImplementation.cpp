@@ -128,6 +128,7 @@ namespace ProcessContainers {
         , _containerLogDir(containerLogDir)
         , _referenceCount(1)
         , _lxcContainer(lxcContainer)
+        , _statistics()
     {
         Config config;
         Core::OptionalType<Core::JSON::Error> error;
@@ -170,90 +171,39 @@ namespace ProcessContainers {
 
     LXCContainer::MemoryInfo LXCContainer::Memory() const  
     {
-        ASSERT(_lxcContainer != nullptr);
-
-        MemoryInfo result {UINT64_MAX, UINT64_MAX, UINT64_MAX};
-        char buffer[2048];
-        int32_t read = _lxcContainer->get_cgroup_item(_lxcContainer, "memory.usage_in_bytes", buffer, sizeof(buffer));
-
-        // Not sure if "read < sizeof(buffer)" is really needed, but it is checked in official lxc tools sources
-        if ((read > 0) && (read < sizeof(buffer))) {
-            int32_t scanned = sscanf(buffer, "%llu", &result.allocated);
-
-            if (scanned != 1) {
-                TRACE(Trace::Warning, ("Could not read allocated memory of LXC container"));
-            }
-        }
-
-        read = _lxcContainer->get_cgroup_item(_lxcContainer, "memory.stat", buffer, sizeof(buffer));
-
-        if ((read > 0) && (static_cast<uint32_t>(read) < sizeof(buffer))) {
-            char name[128];
-            uint64_t value;
-            uint32_t position = 0;
-
-            while (position < read) {
-                int32_t charsRead = 0;
-                int32_t scanned = sscanf(buffer + position, "%s %llu%n", name, &value, &charsRead);
-
-                if (scanned != 2) {
-                    break;
-                }
-
-                if (strcmp(name, "rss") == 0) {
-                    result.resident = value;
-                } else if (strcmp(name, "mapped_file") == 0) {
-                    result.shared = value;
-                }
-
-                position += charsRead;
-            }
-        } else {
-            TRACE(Trace::Warning, ("Could not read memory usage of LXC container"));
-        } 
-
-        return result;
+        return (Statistics().Memory());
     }
 
     LXCContainer::CPUInfo LXCContainer::Cpu() const
     {
-        ASSERT(_lxcContainer != nullptr);
-
-        CPUInfo result;
-        char buffer[512];
-        uint32_t read = _lxcContainer->get_cgroup_item(_lxcContainer, "cpuacct.usage", buffer, sizeof(buffer));
-
-        if (read != 0 && read < sizeof(buffer)) {
-            result.total = strtoll(buffer, nullptr, 10);
-        } else {
-            TRACE(Trace::Warning, ("Could not read total cpu usage of LXC container"));
-        } 
-
-        read = _lxcContainer->get_cgroup_item(_lxcContainer, "cpuacct.usage_percpu", buffer, sizeof(buffer));
+        return (Statistics().Cpu());
+    }
 
-        if ((read != 0) && (static_cast<uint32_t>(read) < sizeof(buffer))) {
-            char* pos = buffer;
-            char* end;
+    LXCContainer::UsageInfo LXCContainer::Usage() const
+    {
+        UsageInfo result;
+        Statistics().Sample(result);
+        return (result);
+    }
 
-            // We might know maximum number of cores in advance
-            static const uint32_t numCores = std::thread::hardware_concurrency();
-            if (numCores != 0)
-                result.cores.reserve(numCores);
+    const CGroupStatistics& LXCContainer::Statistics() const
+    {
+        ASSERT(_lxcContainer != nullptr);
 
-            while(true) {
-                uint64_t value = strtoull(pos, &end, 10);
+        _adminLock.Lock();
 
-                if (pos == end)
-                    break;
+        // The group of the container is only known once it runs, find it through its init process.
+        if (_statistics.IsAttached() == false) {
+            pid_t pid = _lxcContainer->init_pid(_lxcContainer);
 
-                result.cores.push_back(value);
-                pos = end;
+            if (pid > 0) {
+                _statistics.Attach(static_cast<uint32_t>(pid));
             }
-        } else {
-            TRACE(Trace::Warning, ("Could not per thread cpu-usage of LXC container"));
         }
 
-        return result;
+        _adminLock.Unlock();
+
+        return (_statistics);
     }
 
     NetworkInterfaceIterator* LXCContainer::NetworkInterfaces() const
@@ -305,6 +255,7 @@ namespace ProcessContainers {
 
         if( result == true )  {
             _pid = _lxcContainer->init_pid(_lxcContainer);
+            _statistics.Attach(_pid);
             TRACE(ProcessContainers::ProcessContainerization, (_T("Container [%s] was started successfully! pid=%u"), _name.c_str(), _pid));
         } else {
             TRACE(ProcessContainers::ProcessContainerization, (_T("Container [%s] could not be started!"), _name.c_str()));
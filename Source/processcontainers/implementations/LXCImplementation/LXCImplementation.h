@@ -27,6 +27,7 @@
 #include <thread>
 #include <cctype>
 #include "../../ProcessContainer.h"
+#include "../../CGroupStatistics.h"
 
 namespace WPEFramework {
 namespace ProcessContainers {
@@ -93,6 +94,7 @@ namespace ProcessContainers {
         uint32_t Pid() const override;
         MemoryInfo Memory() const override;
         CPUInfo Cpu() const override;
+        UsageInfo Usage() const override;
         NetworkInterfaceIterator* NetworkInterfaces() const override;
         bool IsRunning() const override;
 
@@ -105,6 +107,9 @@ namespace ProcessContainers {
     protected:
         void InheritRequestedEnvironment();
 
+    private:
+        const CGroupStatistics& Statistics() const;
+
     private:
         const string _name;
         uint32_t _pid;
@@ -113,6 +118,7 @@ namespace ProcessContainers {
         mutable Core::CriticalSection _adminLock;
         mutable uint32_t _referenceCount;
         LxcContainerType* _lxcContainer;
+        mutable CGroupStatistics _statistics;
 #ifdef __DEBUG__
         bool _attach;
 #endif
@@ -1,4 +1,5 @@
 #include "processcontainers/ProcessContainer.h"
+#include "processcontainers/CGroupStatistics.h"
 
 namespace WPEFramework {
 namespace ProcessContainers {
@@ -25,6 +26,7 @@ namespace ProcessContainers {
         uint32_t Pid() const override;
         MemoryInfo Memory() const override;
         CPUInfo Cpu() const override;
+        UsageInfo Usage() const override;
         NetworkInterfaceIterator* NetworkInterfaces() const override;
         bool IsRunning() const override;
         bool Start(const string& command, IStringIterator& parameters) override;
@@ -39,6 +41,7 @@ namespace ProcessContainers {
         string _name;
         string _path;
         mutable Core::OptionalType<uint32_t> _pid;
+        CGroupStatistics _statistics;
     };
 
     class RunCContainerAdministrator : public IContainerAdministrator 
@@ -28,12 +28,19 @@ namespace IVirtualInput {
     enum inputtypes : uint8_t {
         INPUT_KEY   = 0x01,
         INPUT_MOUSE = 0x02,
-        INPUT_TOUCH = 0x04
+        INPUT_TOUCH = 0x04,
+        INPUT_SHARED = 0x80 /* events are delivered through the shared EventRing */
     };
  
+    // Clients that predate LinkVersion only send Mode and Name, the fields behind them are only
+    // valid if Version is filled in.
+    static constexpr uint8_t LinkVersion = 1;
+
     struct LinkInfo {
         uint8_t Mode; /* input types activated */
         char Name[20];
+        uint8_t Version; /* LinkVersion */
+        uint32_t Ring; /* identifies the EventRing of the client, if INPUT_SHARED is set */
     };
 
     struct KeyData {
@@ -75,6 +82,89 @@ namespace IVirtualInput {
         uint16_t Y;
     };
 
+    // Entry of the EventRing, the union of KeyData, MouseData and TouchData.
+    struct EventData {
+        uint64_t Timestamp; /* Core::Time ticks at which the event was posted */
+        uint8_t Type; /* one of the inputtypes */
+        uint8_t Action;
+        uint16_t Index; /* mouse button or touch index */
+        uint32_t Code; /* key code */
+        int32_t X; /* mouse horizontal or touch x */
+        int32_t Y; /* mouse vertical or touch y */
+    };
+
+    // Events for a single client, written by the framework and read by the client. The ring is
+    // created by the client, the framework rings its doorbell only when the ring goes from empty
+    // to filled, so a burst of events costs the client a single wakeup.
+    class EventRing : public Core::CyclicBuffer {
+    public:
+        static constexpr uint32_t Capacity = 256;
+
+    public:
+        EventRing() = delete;
+        EventRing(const EventRing&) = delete;
+        EventRing& operator=(const EventRing&) = delete;
+
+        EventRing(const string& connector, const uint32_t ring, const bool create)
+            : Core::CyclicBuffer(FileName(connector, ring),
+                  Core::File::USER_READ | Core::File::USER_WRITE | Core::File::GROUP_READ | Core::File::GROUP_WRITE | Core::File::SHAREABLE,
+                  (create == true ? (Capacity * sizeof(EventData)) : 0), false)
+            , _doorBell((FileName(connector, ring) + _T(".doorbell")).c_str())
+        {
+        }
+        ~EventRing() override
+        {
+            _doorBell.Relinquish();
+        }
+
+    public:
+        static string FileName(const string& connector, const uint32_t ring)
+        {
+            return (connector + '.' + Core::NumberType<uint32_t>(ring).Text());
+        }
+
+        // Framework side
+        bool Post(const EventData& event)
+        {
+            return (Write(reinterpret_cast<const uint8_t*>(&event), sizeof(EventData)) == sizeof(EventData));
+        }
+
+        // Client side
+        uint32_t Take(EventData events[], const uint32_t count)
+        {
+            return (Read(reinterpret_cast<uint8_t*>(events), count * sizeof(EventData)) / sizeof(EventData));
+        }
+        uint32_t Wait(const uint32_t waitTime)
+        {
+            return (_doorBell.Wait(waitTime));
+        }
+        void Acknowledge()
+        {
+            _doorBell.Acknowledge();
+        }
+        void Ring()
+        {
+            _doorBell.Ring();
+        }
+
+    private:
+        void DataAvailable() override
+        {
+            _doorBell.Ring();
+        }
+        uint32_t GetReadSize(Cursor& cursor) override
+        {
+            // Only hand out complete events that are actually there.
+            const uint32_t used = Used();
+            const uint32_t available = (used - (used % sizeof(EventData)));
+
+            return (cursor.Size() < available ? (cursor.Size() - (cursor.Size() % sizeof(EventData))) : available);
+        }
+
+    private:
+        Core::DoorBell _doorBell;
+    };
+
     typedef Core::IPCMessageType<0, Core::Void, LinkInfo>   NameMessage;
     typedef Core::IPCMessageType<1, KeyData,    Core::Void> KeyMessage;
     typedef Core::IPCMessageType<2, MouseData,  Core::Void> MouseMessage;
@@ -116,9 +116,10 @@ namespace VirtualInput{
             NameEventHandler& operator=(const NameEventHandler&) = delete;
 
         public:
-            NameEventHandler(const string& name, const uint8_t mode)
+            NameEventHandler(const string& name, const uint8_t mode, const uint32_t ring)
                 : _name(name)
                 , _mode(mode)
+                , _ring(ring)
             {
             }
             virtual ~NameEventHandler()
@@ -133,12 +134,50 @@ namespace VirtualInput{
                 Core::ProxyType<IVirtualInput::NameMessage> message(data);
                 ::strncpy(message->Response().Name, _name.c_str(), sizeof(IVirtualInput::LinkInfo::Name));
                 message->Response().Mode = _mode;
+                message->Response().Version = IVirtualInput::LinkVersion;
+                message->Response().Ring = _ring;
                 source.ReportResponse(data);
             }
 
         private:
             string _name;
             uint8_t _mode;
+            uint32_t _ring;
+        };
+
+        class Dispatcher : public Core::Thread {
+        public:
+            Dispatcher() = delete;
+            Dispatcher(const Dispatcher&) = delete;
+            Dispatcher& operator=(const Dispatcher&) = delete;
+
+            Dispatcher(Controller& parent)
+                : Core::Thread(Core::Thread::DefaultStackSize(), _T("VirtualInputDispatcher"))
+                , _parent(parent)
+            {
+            }
+            ~Dispatcher() override
+            {
+                Stop();
+                Wait(Core::Thread::STOPPED, Core::infinite);
+            }
+
+        private:
+            uint32_t Worker() override
+            {
+                if (_parent._ring->Wait(Core::infinite) == Core::ERROR_NONE) {
+                    _parent._ring->Acknowledge();
+                }
+
+                if (IsRunning() == true) {
+                    _parent.Drain();
+                }
+
+                return (0);
+            }
+
+        private:
+            Controller& _parent;
         };
 
     private:
@@ -152,7 +191,38 @@ namespace VirtualInput{
             , _keyCallback((keyCallback != nullptr) ? (Core::ProxyType<Core::IIPCServer>(Core::ProxyType<KeyEventHandler>::Create(keyCallback))) : (Core::ProxyType<Core::IIPCServer>()))
             , _mouseCallback((mouseCallback != nullptr) ? (Core::ProxyType<Core::IIPCServer>(Core::ProxyType<MouseEventHandler>::Create(mouseCallback))) : (Core::ProxyType<Core::IIPCServer>()))
             , _touchCallback((touchCallback != nullptr) ? (Core::ProxyType<Core::IIPCServer>(Core::ProxyType<TouchEventHandler>::Create(touchCallback))) : (Core::ProxyType<Core::IIPCServer>()))
+            , _keyEvent(keyCallback)
+            , _mouseEvent(mouseCallback)
+            , _touchEvent(touchCallback)
+            , _ring(nullptr)
+            , _dispatcher(nullptr)
+            , _adminLock()
+            , _latencyTotal(0)
+            , _latencyCount(0)
+            , _latencyMaximum(0)
         {
+            uint32_t ring = 0;
+
+            // The shared event ring lives next to the domain socket, over other channels we only use IPC messages.
+            if (source.Type() == Core::NodeId::TYPE_DOMAIN) {
+                static uint32_t instances = 0;
+
+                ring = (Core::ProcessInfo().Id() << 8) | (Core::InterlockedIncrement(instances) & 0xFF);
+
+                _ring = new IVirtualInput::EventRing(source.HostName(), ring, true);
+
+                if (_ring->IsValid() == true) {
+                    // Bind the doorbell before the framework learns about the ring, no wakeup gets lost.
+                    _ring->Wait(0);
+                    _dispatcher = new Dispatcher(*this);
+                    _dispatcher->Run();
+                } else {
+                    delete _ring;
+                    _ring = nullptr;
+                    ring = 0;
+                }
+            }
+
             if (_keyCallback.IsValid() ==  true) {
                 _channel.CreateFactory<IVirtualInput::KeyMessage>(1);
                 _channel.Register(IVirtualInput::KeyMessage::Id(), _keyCallback);
@@ -169,7 +239,7 @@ namespace VirtualInput{
             }
 
             _channel.CreateFactory<IVirtualInput::NameMessage>(1);
-            _channel.Register(IVirtualInput::NameMessage::Id(), Core::ProxyType<Core::IIPCServer>(Core::ProxyType<NameEventHandler>::Create(name, Mode())));
+            _channel.Register(IVirtualInput::NameMessage::Id(), Core::ProxyType<Core::IIPCServer>(Core::ProxyType<NameEventHandler>::Create(name, Mode(), ring)));
 
             _channel.Open(2000); // Try opening this channel for 2S
         }
@@ -177,6 +247,18 @@ namespace VirtualInput{
         {
             _channel.Close(Core::infinite);
 
+            if (_dispatcher != nullptr) {
+                _dispatcher->Block();
+                _ring->Ring();
+                delete _dispatcher;
+            }
+            if (_ring != nullptr) {
+                const string name(_ring->Name());
+                delete _ring;
+                Core::File(name).Destroy();
+                Core::File(name + _T(".doorbell")).Destroy();
+            }
+
             if (_keyCallback.IsValid() == true) {
                 _channel.Unregister(IVirtualInput::KeyMessage::Id());
                 _channel.DestroyFactory<IVirtualInput::KeyMessage>();
@@ -203,13 +285,93 @@ namespace VirtualInput{
         {
             return (_keyCallback.IsValid()   ? IVirtualInput::INPUT_KEY   : 0) |
                    (_mouseCallback.IsValid() ? IVirtualInput::INPUT_MOUSE : 0) |
-                   (_touchCallback.IsValid() ? IVirtualInput::INPUT_TOUCH : 0) ;
+                   (_touchCallback.IsValid() ? IVirtualInput::INPUT_TOUCH : 0) |
+                   (_ring != nullptr         ? IVirtualInput::INPUT_SHARED : 0) ;
         }
+
+        // Time between posting an event in the framework and handing it to the callback, in
+        // microseconds, since the previous call.
+        void Latency(uint32_t& average, uint32_t& maximum)
+        {
+            _adminLock.Lock();
+
+            average = static_cast<uint32_t>(_latencyCount == 0 ? 0 : (_latencyTotal / _latencyCount));
+            maximum = static_cast<uint32_t>(_latencyMaximum);
+
+            _latencyTotal = 0;
+            _latencyCount = 0;
+            _latencyMaximum = 0;
+
+            _adminLock.Unlock();
+        }
+
+    private:
+        void Drain()
+        {
+            IVirtualInput::EventData events[32];
+            uint32_t count;
+
+            while ((count = _ring->Take(events, sizeof(events) / sizeof(IVirtualInput::EventData))) > 0) {
+                for (uint32_t index = 0; index < count; index++) {
+                    IVirtualInput::EventData& event(events[index]);
+
+                    if ((index + 1) < count) {
+                        IVirtualInput::EventData& next(events[index + 1]);
+
+                        // Intermediate motion is folded into the next motion of the same pointer, the
+                        // mouse moves relative, a touch point absolute.
+                        if ((event.Type == next.Type) && (event.Type != IVirtualInput::INPUT_KEY) && (event.Action == IVirtualInput::MouseData::MOTION) && (next.Action == IVirtualInput::MouseData::MOTION) && ((event.Type == IVirtualInput::INPUT_MOUSE) || (event.Index == next.Index))) {
+                            if (event.Type == IVirtualInput::INPUT_MOUSE) {
+                                next.X += event.X;
+                                next.Y += event.Y;
+                            }
+                            next.Timestamp = event.Timestamp;
+                            continue;
+                        }
+                    }
+
+                    Deliver(event);
+                }
+            }
+        }
+        void Deliver(const IVirtualInput::EventData& event)
+        {
+            const uint64_t now = Core::Time::Now().Ticks();
+            const uint64_t latency = (now > event.Timestamp ? (now - event.Timestamp) : 0);
+
+            _adminLock.Lock();
+            _latencyTotal += latency;
+            _latencyCount++;
+            if (latency > _latencyMaximum) {
+                _latencyMaximum = latency;
+            }
+            _adminLock.Unlock();
+
+            if ((event.Type == IVirtualInput::INPUT_KEY) && (_keyEvent != nullptr)) {
+                _keyEvent(static_cast<keyactiontype>(event.Action), event.Code);
+            } else if ((event.Type == IVirtualInput::INPUT_MOUSE) && (_mouseEvent != nullptr)) {
+                _mouseEvent(static_cast<mouseactiontype>(event.Action), event.Index,
+                    static_cast<short>(std::max(-32768, std::min(32767, event.X))),
+                    static_cast<short>(std::max(-32768, std::min(32767, event.Y))));
+            } else if ((event.Type == IVirtualInput::INPUT_TOUCH) && (_touchEvent != nullptr)) {
+                _touchEvent(static_cast<touchactiontype>(event.Action), event.Index, static_cast<unsigned short>(event.X), static_cast<unsigned short>(event.Y));
+            }
+        }
+
     private:
         Core::IPCChannelClientType<Core::Void, false, true> _channel;
         Core::ProxyType<Core::IIPCServer> _keyCallback;
         Core::ProxyType<Core::IIPCServer> _mouseCallback;
         Core::ProxyType<Core::IIPCServer> _touchCallback;
+        FNKeyEvent _keyEvent;
+        FNMouseEvent _mouseEvent;
+        FNTouchEvent _touchEvent;
+        IVirtualInput::EventRing* _ring;
+        Dispatcher* _dispatcher;
+        Core::CriticalSection _adminLock;
+        uint64_t _latencyTotal;
+        uint32_t _latencyCount;
+        uint64_t _latencyMaximum;
     };
 }
 }
@@ -235,6 +397,21 @@ void virtualinput_close(void* handle)
     delete reinterpret_cast<VirtualInput::Controller*>(handle);
 }
 
+void virtualinput_latency(void* handle, unsigned int* average, unsigned int* maximum)
+{
+    uint32_t averageTime;
+    uint32_t maximumTime;
+
+    reinterpret_cast<VirtualInput::Controller*>(handle)->Latency(averageTime, maximumTime);
+
+    if (average != nullptr) {
+        *average = averageTime;
+    }
+    if (maximum != nullptr) {
+        *maximum = maximumTime;
+    }
+}
+
 #ifdef __cplusplus
 }
 #endif
@@ -76,6 +76,10 @@ typedef void (*FNTouchEvent)(enum touchactiontype type, unsigned short index,  u
 EXTERNAL void* virtualinput_open(const char listenerName[], const char connector[], FNKeyEvent keyCallback, FNMouseEvent mouseCallback, FNTouchEvent touchCallback);
 EXTERNAL void  virtualinput_close(void* handle);
 
+// Average and worst time (in microseconds) between the framework posting an event and the callback
+// receiving it, since the previous call. Only events delivered through the shared event ring count.
+EXTERNAL void  virtualinput_latency(void* handle, unsigned int* average, unsigned int* maximum);
+
 #ifdef __cplusplus
 }
 #endif
@@ -127,12 +127,14 @@ namespace JSONRPC {
             private:
                 ChannelImpl(const ChannelImpl&) = delete;
                 ChannelImpl& operator=(const ChannelImpl&) = delete;
+
+                static constexpr bool IsMessagePack = std::is_same<INTERFACE, Core::JSON::IMessagePack>::value;
     
                 typedef Core::StreamJSONType<Web::WebSocketClientType<Core::SocketStream>, FactoryImpl&, INTERFACE> BaseClass;
     
             public:
                 ChannelImpl(CommunicationChannel* parent, const Core::NodeId& remoteNode, const string& callsign)
-                    : BaseClass(5, FactoryImpl::Instance(), callsign, _T("JSON"), "", "", false, false, false, remoteNode.AnyInterface(), remoteNode, 256, 256)
+                    : BaseClass(5, FactoryImpl::Instance(), callsign, (IsMessagePack ? _T("jsonrpc-msgpack") : _T("JSON")), "", "", IsMessagePack, false, false, remoteNode.AnyInterface(), remoteNode, 256, 256)
                     , _parent(*parent)
                 {
                 }
@@ -1140,14 +1142,15 @@ namespace JSONRPC {
                 _adminLock.Unlock();
             } else {
                 // check if we understand this message (correct callsign?)
-                string callsign(inbound->FullCallsign());
+                const string designator(inbound->Designator.Value());
+                const Core::JSONRPC::Message::Designation designation(designator);
 
-                if (callsign == _localSpace) {
+                if (designation.FullCallsign() == _localSpace.c_str()) {
                     // Looks like this is an event.
                     ASSERT(inbound->Id.IsSet() == false);
 
                     string response;
-                    _handler.Invoke(Core::JSONRPC::Connection(~0, ~0), inbound->FullMethod(), inbound->Parameters.Value(), response);
+                    _handler.Invoke(Core::JSONRPC::Connection(~0, ~0), designation, inbound->Parameters.Value(), response);
                 }
             }
 
@@ -1172,8 +1175,11 @@ namespace JSONRPC {
              std::vector<uint8_t> values;
              parameters->ToBuffer(values);
              if (values.empty() != true) {
-                 string strValues(values.begin(), values.end());
-                 message->Parameters = strValues;
+                 // The parameters are kept as JSON text, on the wire they are a native MessagePack value again.
+                 string text;
+                 if (Core::JSON::IMessagePack::Transcode(values.data(), static_cast<uint32_t>(values.size()), text) != 0) {
+                     message->Parameters = std::move(text);
+                 }
              }
              return;
         }
@@ -1192,8 +1198,8 @@ namespace JSONRPC {
         }
         void FromMessage(Core::JSON::IMessagePack* response, const Core::JSONRPC::Message& message)
         {
-            string value = message.Result.Value();
-            std::vector<uint8_t> result(value.begin(), value.end());
+            std::vector<uint8_t> result;
+            Core::JSON::IMessagePack::Transcode(message.Result.Value(), result);
             response->FromBuffer(result);
         }
 
@@ -63,9 +63,14 @@ namespace Web
         Core::JSON::EnumType<JSONWebToken::mode> Algorithm;
     };
 
-    JSONWebToken::JSONWebToken(const mode type, const uint8_t length, const uint8_t key[])
+    JSONWebToken::JSONWebToken(const mode type, const uint8_t length, const uint8_t key[], const uint8_t cacheSize)
         : _mode(type)
-        , _key(string(reinterpret_cast<const char*>(key), length))
+        , _header()
+        , _signer(string(reinterpret_cast<const char*>(key), length))
+        , _cacheSize(cacheSize)
+        , _adminLock()
+        , _validated()
+        , _signatures()
     {
         Core::EnumerateType<mode> modeData(type);
         string sourceBuffer(_T("{\"alg\":\"") + string(modeData.Data()) + _T("\",\"typ\":\"JWT\"}"));
@@ -98,7 +103,7 @@ namespace Web
 
 		if (_mode == JSONWebToken::SHA256) {
             TCHAR signature[((Crypto::SHA256HMAC::Length * 8) / 6) + 4];
-            Crypto::SHA256HMAC hash(_key);
+            Crypto::SHA256HMAC hash(_signer);
             hash.Input(reinterpret_cast<const uint8_t*>(token.c_str()), static_cast<uint16_t>(token.length()));
             const uint8_t* inputSignature = hash.Result(); // 32 length
            
@@ -114,38 +119,43 @@ namespace Web
     {
         uint16_t length = 0;
 
-		// Check what method to use
-        size_t pos = token.find_first_of('.');
+        if (Cached(token, maxLength, payload, length) == false) {
 
-		if (pos == string::npos) {
-            length = ~0;
-		} else {
+            // Check what method to use
+            size_t pos = token.find_first_of('.');
 
-			// Extract the header
-            string header(token.substr(0, pos));
-            TCHAR* output = reinterpret_cast<TCHAR*>(ALLOCA(header.length() * sizeof(TCHAR)));
+            if (pos == string::npos) {
+                length = ~0;
+            } else {
 
-            length = Core::URL::Base64Decode(
-				header.c_str(), 
-				static_cast<uint16_t>(header.length()), 
-				reinterpret_cast<uint8_t*>(output), 
-				static_cast<uint16_t>(header.length() * sizeof(TCHAR)), 
-				nullptr);
+                // Extract the header
+                string header(token.substr(0, pos));
+                TCHAR* output = reinterpret_cast<TCHAR*>(ALLOCA(header.length() * sizeof(TCHAR)));
 
-			JSONWebData info(output, length);
+                length = Core::URL::Base64Decode(
+                    header.c_str(), 
+                    static_cast<uint16_t>(header.length()), 
+                    reinterpret_cast<uint8_t*>(output), 
+                    static_cast<uint16_t>(header.length() * sizeof(TCHAR)), 
+                    nullptr);
 
-			length = ~0;
+                JSONWebData info(output, length);
 
-			if ((info.Type.Value() == _T("JWT")) && (info.Algorithm.IsSet() == true) && (ValidSignature(info.Algorithm.Value(), token) == true)) {
+                length = ~0;
 
-                // Check if the Hash is correct..
-                size_t sig_pos = token.find_last_of('.');
+                if ((info.Type.Value() == _T("JWT")) && (info.Algorithm.IsSet() == true) && (ValidSignature(info.Algorithm.Value(), token) == true)) {
 
-                if ( (sig_pos != string::npos) && (sig_pos > pos) ) {
+                    // Check if the Hash is correct..
+                    size_t sig_pos = token.find_last_of('.');
 
-                    length = static_cast<uint16_t>(sig_pos - pos);
-                    // Oke, this is a valid frame, let extract the payload..
-                    length = Core::URL::Base64Decode(token.substr(pos + 1).c_str(), length - 1, payload, maxLength, nullptr);
+                    if ( (sig_pos != string::npos) && (sig_pos > pos) ) {
+
+                        length = static_cast<uint16_t>(sig_pos - pos);
+                        // Oke, this is a valid frame, let extract the payload..
+                        length = Core::URL::Base64Decode(token.substr(pos + 1).c_str(), length - 1, payload, maxLength, nullptr);
+
+                        Cache(token, length, payload);
+                    }
                 }
             }
         }
@@ -163,14 +173,14 @@ namespace Web
         if (pos != string::npos) {
 		
             if (type == JSONWebToken::mode::SHA256) {
-                // Now calculate what we think it should be..
-                Crypto::SHA256HMAC hash(_key);
+                // Now calculate what we think it should be, starting from the pre-keyed state..
+                Crypto::SHA256HMAC hash(_signer);
 
                 // Extract the signature and convert it to a binary string.
 				uint8_t signature[Crypto::SHA256HMAC::Length];
                 if (Core::URL::Base64Decode(token.substr(pos + 1).c_str(), static_cast<uint16_t>(token.length() - pos - 1), signature, sizeof(signature), nullptr) == sizeof(signature)) {
 
-					hash.Input(reinterpret_cast<const uint8_t*>(token.substr(0, pos).c_str()), static_cast<uint16_t>(pos * sizeof(TCHAR)));
+					hash.Input(reinterpret_cast<const uint8_t*>(token.c_str()), static_cast<uint16_t>(pos * sizeof(TCHAR)));
 					result = (::memcmp(hash.Result(), signature, sizeof(signature)) == 0);
 				}
             }
@@ -179,6 +189,81 @@ namespace Web
 		return (result);
     }
 
+    bool JSONWebToken::Cached(const string& token, const uint16_t maxLength, uint8_t payload[], uint16_t& length) const
+    {
+        bool result = false;
+        size_t pos = token.find_last_of('.');
+
+        if ((_cacheSize != 0) && (pos != string::npos)) {
+
+            _adminLock.Lock();
+
+            ValidatedMap::iterator index(_signatures.find(token.substr(pos + 1)));
+
+            // The signature is only a key, the token must still match completely.
+            if ((index != _signatures.end()) && (index->second->Token == token) && (index->second->Payload.length() <= maxLength)) {
+                const string& data(index->second->Payload);
+
+                length = static_cast<uint16_t>(data.length());
+                ::memcpy(payload, data.c_str(), length);
+
+                // Most recently used, goes up front.
+                _validated.splice(_validated.begin(), _validated, index->second);
+                result = true;
+            }
+
+            _adminLock.Unlock();
+        }
+
+        return (result);
+    }
+
+    bool JSONWebToken::IsCached(const string& token) const
+    {
+        bool result = false;
+        size_t pos = token.find_last_of('.');
+
+        if (pos != string::npos) {
+
+            _adminLock.Lock();
+
+            ValidatedMap::const_iterator index(_signatures.find(token.substr(pos + 1)));
+            result = ((index != _signatures.end()) && (index->second->Token == token));
+
+            _adminLock.Unlock();
+        }
+
+        return (result);
+    }
+
+    void JSONWebToken::Cache(const string& token, const uint16_t length, const uint8_t payload[]) const
+    {
+        size_t pos = token.find_last_of('.');
+
+        if ((_cacheSize != 0) && (pos != string::npos) && (length != static_cast<uint16_t>(~0))) {
+            string signature(token.substr(pos + 1));
+
+            _adminLock.Lock();
+
+            ValidatedMap::iterator index(_signatures.find(signature));
+
+            if (index != _signatures.end()) {
+                _validated.erase(index->second);
+                _signatures.erase(index);
+            } else if (_validated.size() >= _cacheSize) {
+                // Drop the least recently used one.
+                const string& oldest(_validated.back().Token);
+                _signatures.erase(oldest.substr(oldest.find_last_of('.') + 1));
+                _validated.pop_back();
+            }
+
+            _validated.push_front({ token, string(reinterpret_cast<const char*>(payload), length) });
+            _signatures.emplace(signature, _validated.begin());
+
+            _adminLock.Unlock();
+        }
+    }
+
 	uint16_t JSONWebToken::PayloadLength(const string& token) const
     {
         uint16_t result = ~0;
@@ -36,21 +36,39 @@ namespace Web {
 			SHA256
 		};
 		
-		JSONWebToken(const mode type, const uint8_t length, const uint8_t key[]);
+		// Validated tokens are remembered (keyed on their signature) so a token that is
+		// presented over and over only needs to be hashed once. A cacheSize of 0 disables it.
+		JSONWebToken(const mode type, const uint8_t length, const uint8_t key[], const uint8_t cacheSize = 16);
         ~JSONWebToken();
 
 	public:
         uint16_t Encode(string& token, const uint16_t length, const uint8_t payload[]) const;
         uint16_t Decode(const string& token, const uint16_t maxLength, uint8_t payload[]) const;
         uint16_t PayloadLength(const string& token) const;
+        // Whether this exact token was validated before and is still remembered.
+        bool IsCached(const string& token) const;
 
 	private:
+        struct Validated {
+            string Token;
+            string Payload;
+        };
+
+        typedef std::list<Validated> ValidatedList;
+        typedef std::unordered_map<string, ValidatedList::iterator> ValidatedMap;
+
         bool ValidSignature(const mode type, const string& token) const;
+        bool Cached(const string& token, const uint16_t maxLength, uint8_t payload[], uint16_t& length) const;
+        void Cache(const string& token, const uint16_t length, const uint8_t payload[]) const;
 
 	private:
         mode _mode;
         string _header; 
-		string _key;
+		Crypto::SHA256HMAC _signer;
+        const uint8_t _cacheSize;
+        mutable Core::CriticalSection _adminLock;
+        mutable ValidatedList _validated;
+        mutable ValidatedMap _signatures;
     };
 
 } } // namespace WPEFramework::Web
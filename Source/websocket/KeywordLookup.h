@@ -0,0 +1,184 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2020 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef __KEYWORDLOOKUP_H
+#define __KEYWORDLOOKUP_H
+
+#include "Module.h"
+
+namespace WPEFramework {
+namespace Web {
+
+    // HTTP header names are case insensitive. Instead of upper casing every key and walking the
+    // enumeration table until it matches, the key is hashed (ASCII case folded) straight from
+    // the parser buffer into a slot table. The seed of the hash is chosen, once, such that every
+    // keyword of the table lands in its own slot, so a lookup is a single compare. If no such seed
+    // is found within MaxAttempts (the table is too crowded), lookups walk the table instead.
+    template <typename KEYWORD, const uint8_t SLOTS = 64>
+    class KeywordLookupType {
+    private:
+        KeywordLookupType(const KeywordLookupType<KEYWORD, SLOTS>&) = delete;
+        KeywordLookupType<KEYWORD, SLOTS>& operator=(const KeywordLookupType<KEYWORD, SLOTS>&) = delete;
+
+        static constexpr uint8_t Empty = 0xFF;
+        static constexpr uint32_t MaxAttempts = 4096;
+
+        static_assert(SLOTS > 1, "A lookup needs at least two slots");
+
+    public:
+        KeywordLookupType()
+            : _seed(0)
+        {
+            bool unique = false;
+            uint16_t count = 0;
+            uint16_t index = 0;
+            const Core::EnumerateConversion<KEYWORD>* entry;
+
+            // Keywords listed more than once need a single slot.
+            while ((entry = Core::EnumerateType<KEYWORD>::Entry(index)) != nullptr) {
+                uint16_t loop = 0;
+
+                while ((loop < index) && (Equal(*Core::EnumerateType<KEYWORD>::Entry(loop), *entry) == false)) {
+                    loop++;
+                }
+                if (loop == index) {
+                    count++;
+                }
+                index++;
+            }
+
+            // With as many keywords as slots, hardly any seed (or none at all) spreads them.
+            ASSERT(count < SLOTS);
+
+            while ((unique == false) && (_seed < MaxAttempts) && (count < SLOTS)) {
+                index = 0;
+
+                _seed++;
+                unique = true;
+                ::memset(_slots, Empty, sizeof(_slots));
+
+                while ((unique == true) && ((entry = Core::EnumerateType<KEYWORD>::Entry(index)) != nullptr)) {
+                    uint8_t& slot(_slots[Hash(entry->name, entry->length, _seed) % SLOTS]);
+
+                    if (slot == Empty) {
+                        slot = index;
+                    } else {
+                        // Some keywords are listed more than once, like the lookup through the table,
+                        // the first one wins.
+                        unique = Equal(*Core::EnumerateType<KEYWORD>::Entry(slot), *entry);
+                    }
+
+                    index++;
+                }
+
+                ASSERT(index < Empty);
+            }
+
+            // No seed spreads this table, lookups fall back to walking it. Better grow SLOTS.
+            ASSERT(unique == true);
+
+            if (unique == false) {
+                _seed = 0;
+            }
+        }
+        ~KeywordLookupType()
+        {
+        }
+
+        static const KeywordLookupType<KEYWORD, SLOTS>& Instance()
+        {
+            static KeywordLookupType<KEYWORD, SLOTS> singleton;
+
+            return (singleton);
+        }
+
+    public:
+        // The seed that gave every keyword a slot of its own, 0 if there is none.
+        uint32_t Seed() const
+        {
+            return (_seed);
+        }
+        bool Find(const TCHAR text[], const uint32_t length, KEYWORD& value) const
+        {
+            bool result = false;
+
+            if (_seed != 0) {
+                const uint8_t slot = _slots[Hash(text, length, _seed) % SLOTS];
+
+                result = ((slot != Empty) && (Matches(*Core::EnumerateType<KEYWORD>::Entry(slot), text, length, value) == true));
+            } else {
+                const Core::EnumerateConversion<KEYWORD>* entry;
+                uint16_t index = 0;
+
+                while ((result == false) && ((entry = Core::EnumerateType<KEYWORD>::Entry(index++)) != nullptr)) {
+                    result = Matches(*entry, text, length, value);
+                }
+            }
+
+            return (result);
+        }
+
+        static uint32_t Hash(const TCHAR text[], const uint32_t length, const uint32_t seed)
+        {
+            // FNV-1a on the lower cased (for letters) characters, seeded.
+            uint32_t hash = (2166136261U ^ seed);
+
+            for (uint32_t index = 0; index < length; index++) {
+                hash = (hash ^ static_cast<uint8_t>(text[index] | 0x20)) * 16777619U;
+            }
+
+            // The low bits of FNV hardly depend on the seed, fold the high bits in.
+            return (hash ^ (hash >> 16));
+        }
+
+    private:
+        static bool Equal(const Core::EnumerateConversion<KEYWORD>& lhs, const Core::EnumerateConversion<KEYWORD>& rhs)
+        {
+            return ((lhs.length == rhs.length) && (::memcmp(lhs.name, rhs.name, lhs.length * sizeof(TCHAR)) == 0));
+        }
+        static bool Matches(const Core::EnumerateConversion<KEYWORD>& entry, const TCHAR text[], const uint32_t length, KEYWORD& value)
+        {
+            bool result = false;
+
+            if (entry.length == length) {
+                uint32_t index = 0;
+
+                // Header bytes of 0x80 and up are negative chars, toupper only takes them as unsigned.
+                while ((index < length) && (::toupper(static_cast<unsigned char>(text[index])) == entry.name[index])) {
+                    index++;
+                }
+
+                if (index == length) {
+                    value = entry.value;
+                    result = true;
+                }
+            }
+
+            return (result);
+        }
+
+    private:
+        uint32_t _seed;
+        uint8_t _slots[SLOTS];
+    };
+
+} // namespace Web
+} // namespace WPEFramework
+
+#endif // __KEYWORDLOOKUP_H
@@ -72,6 +72,10 @@ namespace Web {
             }
 
         private:
+            virtual bool Splice(const Core::File::Handle handle, const uint64_t offset, const uint32_t length)
+            {
+                return (_parent.Splice(_parent, handle, offset, length));
+            }
             virtual void Serialized(const typename OUTBOUND::BaseElement& element)
             {
                 _lock.Lock();
@@ -438,6 +442,21 @@ namespace Web {
             return (_serializerImpl.Serialize(dataFrame, receivedSize));
         }
 
+        // A file body can only go out untouched over a socket and if we do not transform the data.
+        template <typename CLASSNAME>
+        inline typename Core::TypeTraits::enable_if<(std::is_base_of<Core::SocketPort, LINK>::value && !CLASSNAME::TraitSerializer::value), bool>::type
+        Splice(const CLASSNAME&, const Core::File::Handle handle, const uint64_t offset, const uint32_t length)
+        {
+            return (_channel.SendFile(handle, offset, length));
+        }
+
+        template <typename CLASSNAME>
+        inline typename Core::TypeTraits::enable_if<!(std::is_base_of<Core::SocketPort, LINK>::value && !CLASSNAME::TraitSerializer::value), bool>::type
+        Splice(const CLASSNAME&, const Core::File::Handle, const uint64_t, const uint32_t)
+        {
+            return (false);
+        }
+
     private:
         SerializerImpl _serializerImpl;
         DeserializerImpl _deserialiserImpl;
@@ -95,6 +95,13 @@ namespace Web {
         // The Serialize and Deserialize methods allow the content to be serialized/deserialized.
         virtual void Serialize(uint8_t[] /* stream*/, const uint16_t /* maxLength */) const = 0;
         virtual void Deserialize(const uint8_t[] /* stream*/, const uint16_t /* maxLength */) = 0;
+
+        // Bodies kept in a file report where their content starts (valid right after Serialize()), so the
+        // link can send it straight from the file instead of through Serialize.
+        virtual bool Storage(Core::File::Handle& /* handle */, uint64_t& /* offset */) const
+        {
+            return (false);
+        }
     };
 
     class EXTERNAL Signature {
@@ -313,6 +320,12 @@ namespace Web {
         public:
             virtual void Serialized(const Web::Request& element) = 0;
 
+            // Offer the link to send the (file based) body itself, once the data serialized so far is out.
+            virtual bool Splice(const Core::File::Handle /* handle */, const uint64_t /* offset */, const uint32_t /* length */)
+            {
+                return (false);
+            }
+
             void Flush()
             {
                 _lock.Lock();
@@ -151,6 +151,12 @@ namespace Web {
         public:
             virtual void Serialized(const Web::Response& element) = 0;
 
+            // Offer the link to send the (file based) body itself, once the data serialized so far is out.
+            virtual bool Splice(const Core::File::Handle /* handle */, const uint64_t /* offset */, const uint32_t /* length */)
+            {
+                return (false);
+            }
+
             void Flush()
             {
                 _lock.Lock();
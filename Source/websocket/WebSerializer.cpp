@@ -18,6 +18,7 @@
  */
 
 #include "WebSerializer.h"
+#include "KeywordLookup.h"
 
 namespace WPEFramework {
 namespace Web {
@@ -409,7 +410,7 @@ namespace Web
 
     static Signature ToSignature(const string& input)
     {
-        Core::TextFragment inputLine(input);
+        Core::TextFragment inputLine(input.c_str(), static_cast<uint32_t>(input.length()));
         Core::OptionalType<Crypto::EnumHashType> hashType;
         Core::OptionalType<Core::TextFragment> hashValue;
 
@@ -448,7 +449,7 @@ namespace Web
     {
         Core::OptionalType<Authorization::type> authorizationType;
         Core::OptionalType<Core::TextFragment> token;
-        Core::TextFragment inputLine(input);
+        Core::TextFragment inputLine(input.c_str(), static_cast<uint32_t>(input.length()));
 
         // Convert type and value
         Core::TextParser lineParser(inputLine);
@@ -863,6 +864,20 @@ namespace Web
                     break;
                 }
                 case BODY: {
+                    // The EOL marker leaves the offset at 1, so this is the first time we get here.
+                    if ((_offset != 0) && (_bodyLength != 0)) {
+                        Core::File::Handle handle;
+                        uint64_t offset;
+
+                        _offset = 0;
+
+                        ASSERT(_current->_body.IsValid() == true);
+
+                        if ((_current->_body->Storage(handle, offset) == true) && (Splice(handle, offset, _bodyLength) == true)) {
+                            _bodyLength = 0;
+                        }
+                    }
+
                     if (_bodyLength != 0) {
                         ASSERT(maxLength >= current);
                         uint32_t size = (static_cast<uint32_t>(maxLength - current) <= _bodyLength ? static_cast<uint32_t>(maxLength - current) : _bodyLength);
@@ -1242,6 +1257,20 @@ namespace Web
                     break;
                 }
                 case BODY: {
+                    // The EOL marker leaves the offset at 1, so this is the first time we get here.
+                    if ((_offset != 0) && (_bodyLength != 0)) {
+                        Core::File::Handle handle;
+                        uint64_t offset;
+
+                        _offset = 0;
+
+                        ASSERT(_current->_body.IsValid() == true);
+
+                        if ((_current->_body->Storage(handle, offset) == true) && (Splice(handle, offset, _bodyLength) == true)) {
+                            _bodyLength = 0;
+                        }
+                    }
+
                     if (_bodyLength != 0) {
                         ASSERT(maxLength >= current);
                         uint32_t size = (static_cast<uint32_t>(maxLength - current) <= _bodyLength ? static_cast<uint32_t>(maxLength - current) : _bodyLength);
@@ -1422,13 +1451,11 @@ namespace Web
                 }
             } else {
                 // See if we recognise this word...
-                Core::EnumerateType<Request::keywords> keyWord(buffer.c_str(), true);
-                if (keyWord.IsSet() == false) {
+                if (KeywordLookupType<Request::keywords>::Instance().Find(buffer.c_str(), static_cast<uint32_t>(buffer.length()), _keyWord) == false) {
                     //TRACE_L1("Could not resolve keyword %s", buffer.c_str());
                     _parser.FlushLine();
                 } else {
                     // Seems like we have a hit. Collect a new entry and start setting it.
-                    _keyWord = keyWord.Value();
                     _parser.CollectLine();
                     _state = PAIR_VALUE;
                 }
@@ -1497,7 +1524,7 @@ namespace Web
             }
             case Request::ACCEPT_ENCODING: {
                 // We only allow for GZIP, right now, so see if it is an allowed format, if so, use it.
-                Core::TextSegmentIterator entries(Core::TextFragment(buffer), true, ',');
+                Core::TextSegmentIterator entries(Core::TextFragment(buffer.c_str(), static_cast<uint32_t>(buffer.length())), true, ',');
 
                 while (entries.Next() != false) {
                     if (entries.Current().EqualText(__ENCODING_GZIP, 0, ((sizeof(__ENCODING_GZIP) / sizeof(TCHAR)) - 1), false) == true) {
@@ -1555,7 +1582,7 @@ namespace Web
             }
             case Request::ACCESS_CONTROL_REQUEST_METHOD: {
                 uint16_t value = 0;
-                Core::TextSegmentIterator index(Core::TextFragment(buffer), true, ',');
+                Core::TextSegmentIterator index(Core::TextFragment(buffer.c_str(), static_cast<uint32_t>(buffer.length())), true, ',');
                 while (index.Next()) {
                     Core::EnumerateType<Request::type> enumerate(index.Current().Text().c_str(), false);
 
@@ -1572,7 +1599,7 @@ namespace Web
             break;
         }
         case CHUNK_INIT: {
-            uint32_t chunkedSize = Core::NumberType<uint32_t>(Core::TextFragment(buffer));
+            uint32_t chunkedSize = Core::NumberType<uint32_t>(Core::TextFragment(buffer.c_str(), static_cast<uint32_t>(buffer.length())));
             if (chunkedSize == 0) {
                 _state = BODY_END;
                 _parser.FlushLine();
@@ -1630,7 +1657,7 @@ namespace Web
             _state = PAIR_KEY;
         }
         case PAIR_KEY: {
-            _parser.CollectWord(':', Parser::UPPERCASE);
+            _parser.CollectWord(':');
             break;
         }
         case CHUNK_END: {
@@ -1781,13 +1808,11 @@ namespace Web
                 break;
             } else {
                 // See if we recognise this word...
-                Core::EnumerateType<Response::keywords> keyWord(buffer.c_str(), true);
-                if (keyWord.IsSet() == false) {
+                if (KeywordLookupType<Response::keywords>::Instance().Find(buffer.c_str(), static_cast<uint32_t>(buffer.length()), _keyWord) == false) {
                     //TRACE_L1("Could not resolve keyword %s", buffer.c_str());
                     _parser.FlushLine();
                 } else {
                     // Seems like we have a hit. Collect a new entry and start setting it.
-                    _keyWord = keyWord.Value();
                     _parser.CollectLine();
                     _state = PAIR_VALUE;
                 }
@@ -1863,7 +1888,7 @@ namespace Web
             }
             case Response::ALLOW: {
                 uint16_t value = 0;
-                Core::TextSegmentIterator index(Core::TextFragment(buffer), true, ',');
+                Core::TextSegmentIterator index(Core::TextFragment(buffer.c_str(), static_cast<uint32_t>(buffer.length())), true, ',');
                 while (index.Next()) {
                     Core::EnumerateType<Request::type> enumerate(index.Current().Text().c_str(), false);
 
@@ -1878,7 +1903,7 @@ namespace Web
             }
             case Response::ACCESS_CONTROL_ALLOW_METHODS: {
                 uint16_t value = 0;
-                Core::TextSegmentIterator index(Core::TextFragment(buffer), true, ',');
+                Core::TextSegmentIterator index(Core::TextFragment(buffer.c_str(), static_cast<uint32_t>(buffer.length())), true, ',');
                 while (index.Next()) {
                     Core::EnumerateType<Request::type> enumerate(index.Current().Text().c_str(), false);
 
@@ -1949,7 +1974,7 @@ namespace Web
             break;
         }
         case CHUNK_INIT: {
-            uint32_t chunkedSize = Core::NumberType<uint32_t>(Core::TextFragment(buffer), NumberBase::BASE_HEXADECIMAL);
+            uint32_t chunkedSize = Core::NumberType<uint32_t>(Core::TextFragment(buffer.c_str(), static_cast<uint32_t>(buffer.length())), NumberBase::BASE_HEXADECIMAL);
             if (chunkedSize == 0) {
                 _parser.FlushLine();
                 _state = BODY_END;
@@ -2002,7 +2027,7 @@ namespace Web
             // Thats fine than the error code was the last item..
             _current->Message.clear();
             _state = PAIR_KEY;
-            _parser.CollectWord(':', Parser::UPPERCASE);
+            _parser.CollectWord(':');
             break;
         }
         case CHUNK_END: {
@@ -2014,7 +2039,7 @@ namespace Web
             _state = PAIR_KEY;
         }
         case PAIR_KEY: {
-            _parser.CollectWord(':', Parser::UPPERCASE);
+            _parser.CollectWord(':');
             break;
         }
         case BODY_END: {
@@ -204,6 +204,13 @@ namespace Web {
         {
             Core::File::Write(stream, maxLength);
         }
+        virtual bool Storage(Core::File::Handle& handle, uint64_t& offset) const override
+        {
+            handle = const_cast<FileBody*>(this)->operator Core::File::Handle();
+            offset = Core::File::Position();
+
+            return (handle != INVALID_HANDLE_VALUE);
+        }
         virtual void End() const override
         {
             if (Core::File::IsOpen() == true) {
@@ -264,16 +271,32 @@ namespace Web {
         {
             _hash.Reset();
 
-            // Read all Data
             uint32_t length = FileBody::Serialize();
 
-            uint8_t buffer[64];
+            if (length > 0) {
+                // Hash it from a mapping, in one go. That also pulls the file into the page cache for the
+                // transfer that follows, so it is only read from storage once.
+                Core::DataElementFile mapped(Core::File::Name(), Core::File::USER_READ);
 
-            while (length > 0) {
-                uint16_t size = (length > 64 ? 64 : length);
-                FileBody::Serialize(buffer, size);
-                _hash.Input(buffer, size);
-                length -= size;
+                if ((mapped.IsValid() == true) && (mapped.Size() >= length)) {
+                    const uint8_t* start = &(mapped.Buffer()[mapped.Size() - length]);
+
+                    while (length > 0) {
+                        uint16_t size = (length > 0xFFFF ? 0xFFFF : static_cast<uint16_t>(length));
+                        _hash.Input(start, size);
+                        start += size;
+                        length -= size;
+                    }
+                } else {
+                    uint8_t buffer[1024];
+
+                    while (length > 0) {
+                        uint16_t size = (length > sizeof(buffer) ? sizeof(buffer) : length);
+                        FileBody::Serialize(buffer, size);
+                        _hash.Input(buffer, size);
+                        length -= size;
+                    }
+                }
             }
 
             FileBody::End();
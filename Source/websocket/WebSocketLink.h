@@ -258,6 +258,10 @@ namespace Web {
                 }
 
             private:
+                virtual bool Splice(const Core::File::Handle handle, const uint64_t offset, const uint32_t length)
+                {
+                    return (_parent.Splice(handle, offset, length));
+                }
                 virtual void Serialized(const typename OUTBOUND::BaseElement& element)
                 {
                     _adminLock.Lock();
@@ -917,6 +921,22 @@ namespace Web {
             {
                 UpgradeCompleted(TemplateIntToType<Core::TypeTraits::same_or_inherits<Web::Request, INBOUND>::value>());
             }
+            inline bool Splice(const Core::File::Handle handle, const uint64_t offset, const uint32_t length)
+            {
+                return (Splice(handle, offset, length, TemplateIntToType<std::is_base_of<Core::SocketPort, ACTUALLINK>::value>()));
+            }
+
+            // ----------------------------------------------------------------------------------------------
+            // File bodies can be sent straight from the file, if we are on a socket.
+            // ----------------------------------------------------------------------------------------------
+            inline bool Splice(const Core::File::Handle handle, const uint64_t offset, const uint32_t length, const TemplateIntToType<1>& /* For compile time diffrentiation */)
+            {
+                return (ACTUALLINK::SendFile(handle, offset, length));
+            }
+            inline bool Splice(const Core::File::Handle, const uint64_t, const uint32_t, const TemplateIntToType<0>& /* For compile time diffrentiation */)
+            {
+                return (false);
+            }
 
             // ----------------------------------------------------------------------------------------------
             // SERVER upgrade to WebSocket, Diffrentiation via compiletime type: const TemplateIntToType<1>&
@@ -24,6 +24,7 @@
 
 #include "URL.h"
 #include "JSONWebToken.h"
+#include "KeywordLookup.h"
 #include "JSONRPCLink.h"
 #include "WebLink.h"
 #include "WebRequest.h"
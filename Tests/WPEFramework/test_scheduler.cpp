@@ -0,0 +1,350 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2020 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+#include <WPEFramework/Scheduler.h>
+
+namespace WPEFramework {
+namespace Tests {
+
+    struct TestResources {
+        TestResources()
+            : CpuTime(0)
+            , Jobs(0)
+            , Allocations(0)
+            , Allocated(0)
+            , Running(0)
+            , Pending(0)
+        {
+        }
+
+        uint64_t CpuTime;
+        uint32_t Jobs;
+        uint64_t Allocations;
+        uint64_t Allocated;
+        uint32_t Running;
+        uint32_t Pending;
+    };
+
+    struct TestUsage {
+        uint64_t CpuTime;
+        uint64_t Allocations;
+        uint64_t Allocated;
+
+        static TestUsage Now()
+        {
+            TestUsage result = { 0, 0, 0 };
+            return (result);
+        }
+    };
+
+    class TestService {
+    public:
+        TestService() = delete;
+        TestService(const TestService&) = delete;
+        TestService& operator=(const TestService&) = delete;
+
+        TestService(const uint8_t priority, const uint8_t concurrency)
+            : _priority(priority)
+            , _concurrency(concurrency)
+            , _resources()
+        {
+        }
+        ~TestService()
+        {
+        }
+
+    public:
+        uint8_t Priority() const
+        {
+            return (_priority);
+        }
+        uint8_t Concurrency() const
+        {
+            return (_concurrency);
+        }
+        TestResources& Budget()
+        {
+            return (_resources);
+        }
+
+    private:
+        const uint8_t _priority;
+        const uint8_t _concurrency;
+        TestResources _resources;
+    };
+
+    // Keeps what is submitted, so the test decides when (and which) job runs.
+    class TestPool : public Core::IWorkerPool {
+    public:
+        TestPool(const TestPool&) = delete;
+        TestPool& operator=(const TestPool&) = delete;
+
+        TestPool()
+            : _jobs()
+            , _metadata()
+        {
+        }
+        ~TestPool() override
+        {
+        }
+
+    public:
+        uint32_t Waiting() const
+        {
+            return (static_cast<uint32_t>(_jobs.size()));
+        }
+        Core::IWorkerPool::priority Lane(const uint32_t index) const
+        {
+            return (_jobs[index].second);
+        }
+        // Run the job that was handed out as index, the order of the others is kept.
+        void Run(const uint32_t index = 0)
+        {
+            Core::ProxyType<Core::IDispatch> job(_jobs[index].first);
+
+            _jobs.erase(_jobs.begin() + index);
+            job->Dispatch();
+        }
+
+        ::ThreadId Id(const uint8_t) const override
+        {
+            return (0);
+        }
+        void Submit(const Core::ProxyType<Core::IDispatch>& job) override
+        {
+            Submit(job, Core::ThreadPool::NORMAL, 0);
+        }
+        void Submit(const Core::ProxyType<Core::IDispatch>& job, const priority lane, const uint64_t) override
+        {
+            _jobs.emplace_back(job, lane);
+        }
+        void Schedule(const Core::Time&, const Core::ProxyType<Core::IDispatch>&) override
+        {
+        }
+        uint32_t Revoke(const Core::ProxyType<Core::IDispatch>&, const uint32_t) override
+        {
+            return (Core::ERROR_UNKNOWN_KEY);
+        }
+        void Join() override
+        {
+        }
+        const Metadata& Snapshot() const override
+        {
+            return (_metadata);
+        }
+
+    private:
+        std::vector<std::pair<Core::ProxyType<Core::IDispatch>, priority>> _jobs;
+        Metadata _metadata;
+    };
+
+    // Writes its tag in the log when it runs.
+    class TestJob : public Core::IDispatch {
+    public:
+        TestJob() = delete;
+        TestJob(const TestJob&) = delete;
+        TestJob& operator=(const TestJob&) = delete;
+
+        TestJob(std::vector<uint32_t>& log, const uint32_t tag)
+            : _log(log)
+            , _tag(tag)
+        {
+        }
+        ~TestJob() override
+        {
+        }
+
+    public:
+        void Dispatch() override
+        {
+            _log.push_back(_tag);
+        }
+
+    private:
+        std::vector<uint32_t>& _log;
+        const uint32_t _tag;
+    };
+
+    typedef PluginHost::SchedulerType<TestService, TestResources, TestUsage, 3> TestScheduler;
+
+    static Core::ProxyType<Core::IDispatch> Job(std::vector<uint32_t>& log, const uint32_t tag)
+    {
+        return (Core::ProxyType<Core::IDispatch>(Core::ProxyType<TestJob>::Create(log, tag)));
+    }
+
+    TEST(PluginHost_Scheduler, SlotsLimitTheWork)
+    {
+        TestPool pool;
+        std::vector<uint32_t> log;
+        Core::ProxyType<TestService> service(Core::ProxyType<TestService>::Create(1, 0));
+
+        {
+            TestScheduler scheduler(pool, 2);
+
+            for (uint32_t index = 0; index < 5; index++) {
+                scheduler.Submit(service, Job(log, index));
+            }
+
+            EXPECT_EQ(pool.Waiting(), 2u);
+            EXPECT_EQ(service->Budget().Running, 2u);
+            EXPECT_EQ(service->Budget().Pending, 3u);
+
+            // Every completion makes room for the next one, in the order submitted.
+            while (pool.Waiting() > 0) {
+                EXPECT_LE(pool.Waiting(), 2u);
+                pool.Run();
+            }
+        }
+
+        EXPECT_EQ(log, std::vector<uint32_t>({ 0, 1, 2, 3, 4 }));
+        EXPECT_EQ(service->Budget().Jobs, 5u);
+        EXPECT_EQ(service->Budget().Running, 0u);
+        EXPECT_EQ(service->Budget().Pending, 0u);
+    }
+
+    TEST(PluginHost_Scheduler, ClassesInOrder)
+    {
+        TestPool pool;
+        std::vector<uint32_t> log;
+        Core::ProxyType<TestService> interactive(Core::ProxyType<TestService>::Create(0, 0));
+        Core::ProxyType<TestService> normal(Core::ProxyType<TestService>::Create(1, 0));
+        Core::ProxyType<TestService> background(Core::ProxyType<TestService>::Create(2, 0));
+
+        {
+            TestScheduler scheduler(pool, 1);
+
+            // The first one takes the only slot, the others wait for it.
+            scheduler.Submit(normal, Job(log, 0));
+            scheduler.Submit(background, Job(log, 1));
+            scheduler.Submit(normal, Job(log, 2));
+            scheduler.Submit(interactive, Job(log, 3));
+
+            ASSERT_EQ(pool.Waiting(), 1u);
+            EXPECT_EQ(pool.Lane(0), Core::ThreadPool::NORMAL);
+
+            pool.Run();
+            ASSERT_EQ(pool.Waiting(), 1u);
+            EXPECT_EQ(pool.Lane(0), Core::ThreadPool::HIGH);
+
+            pool.Run();
+            pool.Run();
+            ASSERT_EQ(pool.Waiting(), 1u);
+            EXPECT_EQ(pool.Lane(0), Core::ThreadPool::LOW);
+            pool.Run();
+        }
+
+        EXPECT_EQ(log, std::vector<uint32_t>({ 0, 3, 2, 1 }));
+    }
+
+    TEST(PluginHost_Scheduler, ConcurrencyPerService)
+    {
+        TestPool pool;
+        std::vector<uint32_t> log;
+        Core::ProxyType<TestService> single(Core::ProxyType<TestService>::Create(0, 1));
+        Core::ProxyType<TestService> other(Core::ProxyType<TestService>::Create(1, 0));
+
+        {
+            TestScheduler scheduler(pool, 4);
+
+            scheduler.Submit(single, Job(log, 0));
+            scheduler.Submit(single, Job(log, 1));
+            scheduler.Submit(other, Job(log, 2));
+
+            // There is room, but the second request of single has to wait for its first one, other passes it.
+            ASSERT_EQ(pool.Waiting(), 2u);
+            EXPECT_EQ(single->Budget().Running, 1u);
+            EXPECT_EQ(single->Budget().Pending, 1u);
+
+            pool.Run(1);
+            EXPECT_EQ(pool.Waiting(), 1u);
+
+            pool.Run(0);
+            ASSERT_EQ(pool.Waiting(), 1u);
+            pool.Run(0);
+        }
+
+        EXPECT_EQ(log, std::vector<uint32_t>({ 2, 0, 1 }));
+    }
+
+    TEST(PluginHost_Scheduler, LowerClassesDoNotStarve)
+    {
+        TestPool pool;
+        std::vector<uint32_t> log;
+        Core::ProxyType<TestService> interactive(Core::ProxyType<TestService>::Create(0, 0));
+        Core::ProxyType<TestService> background(Core::ProxyType<TestService>::Create(2, 0));
+
+        {
+            TestScheduler scheduler(pool, 1);
+
+            scheduler.Submit(interactive, Job(log, 0));
+            scheduler.Submit(background, Job(log, 1000));
+
+            // A steady stream of interactive requests, there is always one waiting.
+            for (uint32_t index = 1; index <= 20; index++) {
+                scheduler.Submit(interactive, Job(log, index));
+                pool.Run();
+            }
+            scheduler.Flush();
+            while (pool.Waiting() > 0) {
+                pool.Run();
+            }
+        }
+
+        ASSERT_EQ(log.size(), 22u);
+        // After eight interactive picks that skipped it, the background request gets its turn.
+        EXPECT_EQ(std::find(log.begin(), log.end(), 1000u) - log.begin(), 9);
+    }
+
+    TEST(PluginHost_Scheduler, FlushHandsOutEverything)
+    {
+        TestPool pool;
+        std::vector<uint32_t> log;
+        Core::ProxyType<TestService> limited(Core::ProxyType<TestService>::Create(1, 1));
+
+        {
+            TestScheduler scheduler(pool, 1);
+
+            // More than fit in a byte, none of the counters may wrap.
+            for (uint32_t index = 0; index < 300; index++) {
+                scheduler.Submit(limited, Job(log, index));
+            }
+
+            EXPECT_EQ(pool.Waiting(), 1u);
+            EXPECT_EQ(limited->Budget().Pending, 299u);
+
+            scheduler.Flush();
+
+            EXPECT_EQ(pool.Waiting(), 300u);
+            EXPECT_EQ(limited->Budget().Running, 300u);
+            EXPECT_EQ(limited->Budget().Pending, 0u);
+
+            // Nothing is waiting anymore, completing them hands out nothing new.
+            while (pool.Waiting() > 0) {
+                pool.Run();
+            }
+        }
+
+        EXPECT_EQ(log.size(), 300u);
+        EXPECT_EQ(limited->Budget().Running, 0u);
+        EXPECT_EQ(limited->Budget().Jobs, 300u);
+    }
+
+} // Tests
+} // WPEFramework
@@ -0,0 +1,89 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2020 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <core/core.h>
+#include <com/com.h>
+
+namespace WPEFramework {
+namespace Benchmarks {
+
+    static const TCHAR* Connector = _T("/tmp/benchmark_communicator");
+
+    class LoopbackServer : public RPC::Communicator {
+    public:
+        LoopbackServer() = delete;
+        LoopbackServer(const LoopbackServer&) = delete;
+        LoopbackServer& operator=(const LoopbackServer&) = delete;
+
+        LoopbackServer(const Core::NodeId& source, const uint32_t ringSize)
+            : RPC::Communicator(source, _T(""))
+        {
+            Shortcut(ringSize);
+            Open(Core::infinite);
+        }
+        ~LoopbackServer()
+        {
+            Close(Core::infinite);
+        }
+
+    private:
+        void* Aquire(const string&, const uint32_t interfaceId, const uint32_t) override
+        {
+            void* result = nullptr;
+
+            if (interfaceId == RPC::IValueIterator::ID) {
+                const std::list<uint32_t> values({ 1, 2, 3, 4 });
+                result = Core::Service<RPC::ValueIterator>::Create<RPC::IValueIterator>(values);
+            }
+
+            return (result);
+        }
+    };
+
+    // A full round trip over the COM-RPC channel, both ends live in this process. The argument is
+    // the size of the shared memory rings, 0 keeps the channel on the socket.
+    static void CommunicatorLoopback(benchmark::State& state)
+    {
+        const Core::NodeId node(Connector);
+        LoopbackServer server(node, static_cast<uint32_t>(state.range(0)));
+
+        Core::ProxyType<RPC::InvokeServerType<1, 0, 4>> engine(Core::ProxyType<RPC::InvokeServerType<1, 0, 4>>::Create());
+        Core::ProxyType<RPC::CommunicatorClient> client(Core::ProxyType<RPC::CommunicatorClient>::Create(node, Core::ProxyType<Core::IIPCServer>(engine)));
+        engine->Announcements(client->Announcement());
+
+        RPC::IValueIterator* iterator = client->Open<RPC::IValueIterator>(_T("ValueIterator"));
+
+        if (iterator == nullptr) {
+            state.SkipWithError("Could not open the loopback interface");
+        } else {
+            for (auto _ : state) {
+                benchmark::DoNotOptimize(iterator->Count());
+            }
+
+            iterator->Release();
+        }
+
+        client->Close(Core::infinite);
+    }
+    BENCHMARK(CommunicatorLoopback)->Arg(0)->Arg(64 * 1024)->UseRealTime();
+
+} // Benchmarks
+} // WPEFramework
@@ -0,0 +1,293 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2020 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <core/core.h>
+
+#include <chrono>
+#include <thread>
+
+namespace WPEFramework {
+namespace Benchmarks {
+
+    class Signal : public Core::IDispatch {
+    public:
+        Signal(const Signal&) = delete;
+        Signal& operator=(const Signal&) = delete;
+
+        Signal()
+            : _event(false, true)
+        {
+        }
+        ~Signal() override
+        {
+        }
+
+    public:
+        uint32_t Wait()
+        {
+            uint32_t result = _event.Lock(Core::infinite);
+            _event.ResetEvent();
+            return (result);
+        }
+        void Dispatch() override
+        {
+            _event.SetEvent();
+        }
+
+    private:
+        Core::Event _event;
+    };
+
+    // Time from submitting a job until it has run on one of the pool threads.
+    static void WorkerPoolSubmit(benchmark::State& state)
+    {
+        Core::WorkerPool pool(static_cast<uint8_t>(state.range(0)), Core::Thread::DefaultStackSize(), 16);
+        Core::ProxyType<Signal> job(Core::ProxyType<Signal>::Create());
+
+        for (auto _ : state) {
+            pool.Submit(Core::ProxyType<Core::IDispatch>(job));
+            job->Wait();
+        }
+
+        pool.Stop();
+    }
+    BENCHMARK(WorkerPoolSubmit)->Arg(1)->Arg(4)->UseRealTime();
+
+    class TimedJob {
+    public:
+        TimedJob()
+            : _id(0)
+        {
+        }
+        TimedJob(const uint32_t id)
+            : _id(id)
+        {
+        }
+        TimedJob(const TimedJob& copy)
+            : _id(copy._id)
+        {
+        }
+        ~TimedJob()
+        {
+        }
+
+        TimedJob& operator=(const TimedJob& rhs)
+        {
+            _id = rhs._id;
+            return (*this);
+        }
+        bool operator==(const TimedJob& rhs) const
+        {
+            return (_id == rhs._id);
+        }
+        bool operator!=(const TimedJob& rhs) const
+        {
+            return (!operator==(rhs));
+        }
+
+    public:
+        uint64_t Timed(const uint64_t /* scheduledTime */)
+        {
+            return (0);
+        }
+
+    private:
+        uint32_t _id;
+    };
+
+    // Schedule and revoke a timer while a number of others are pending.
+    static void TimerScheduleRevoke(benchmark::State& state)
+    {
+        Core::TimerType<TimedJob> timer(Core::Thread::DefaultStackSize(), _T("BenchmarkTimer"));
+        const uint32_t pending = static_cast<uint32_t>(state.range(0));
+        const Core::Time future(Core::Time::Now().Add(60 * 60 * 1000));
+
+        for (uint32_t index = 0; index < pending; index++) {
+            timer.Schedule(Core::Time(future).Add(index), TimedJob(index + 1));
+        }
+
+        uint32_t id = pending + 1;
+
+        for (auto _ : state) {
+            timer.Schedule(Core::Time(future).Add(id % 1000), TimedJob(id));
+            timer.Revoke(TimedJob(id));
+            id++;
+        }
+    }
+    BENCHMARK(TimerScheduleRevoke)->Arg(0)->Arg(64)->Arg(1024);
+
+    static void CyclicBufferWriteRead(benchmark::State& state)
+    {
+        const string fileName(_T("/tmp/benchmark_cyclicbuffer"));
+        Core::CyclicBuffer buffer(fileName, 64 * 1024, false);
+        std::vector<uint8_t> data(static_cast<size_t>(state.range(0)), 0x55);
+        std::vector<uint8_t> result(data.size());
+
+        for (auto _ : state) {
+            buffer.Write(data.data(), static_cast<uint32_t>(data.size()));
+            benchmark::DoNotOptimize(buffer.Read(result.data(), static_cast<uint32_t>(result.size())));
+        }
+
+        state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * data.size());
+
+        Core::File(fileName).Destroy();
+    }
+    BENCHMARK(CyclicBufferWriteRead)->Arg(16)->Arg(256)->Arg(4096);
+
+    class Element {
+    public:
+        Element(const Element&) = delete;
+        Element& operator=(const Element&) = delete;
+
+        Element()
+            : _data()
+        {
+        }
+        ~Element()
+        {
+        }
+
+    public:
+        uint8_t* Data()
+        {
+            return (_data);
+        }
+
+    private:
+        uint8_t _data[128];
+    };
+
+    static void ProxyPoolElement(benchmark::State& state)
+    {
+        Core::ProxyPoolType<Element> pool(4);
+
+        for (auto _ : state) {
+            Core::ProxyType<Element> element(pool.Element());
+            benchmark::DoNotOptimize(element->Data());
+        }
+    }
+    BENCHMARK(ProxyPoolElement);
+
+    // The same allocation without the pool, as a reference.
+    static void ProxyTypeCreate(benchmark::State& state)
+    {
+        for (auto _ : state) {
+            Core::ProxyType<Element> element(Core::ProxyType<Element>::Create());
+            benchmark::DoNotOptimize(element->Data());
+        }
+    }
+    BENCHMARK(ProxyTypeCreate);
+
+    // Start (and reap) a trivial child while the parent has the given number of MiB resident,
+    // the cost of copying page tables on fork grows with it.
+    static void ProcessLaunch(benchmark::State& state)
+    {
+        std::vector<uint8_t> resident(static_cast<size_t>(state.range(0)) * 1024 * 1024, 0x55);
+        const Core::Process::Options options(_T("/bin/true"));
+
+        benchmark::DoNotOptimize(resident.data());
+
+        for (auto _ : state) {
+            Core::Process process(false);
+            uint32_t pid;
+
+            if (process.Launch(options, &pid) != Core::ERROR_NONE) {
+                state.SkipWithError("Could not launch /bin/true");
+                break;
+            }
+
+            int status;
+            ::waitpid(static_cast<pid_t>(pid), &status, 0);
+        }
+    }
+    BENCHMARK(ProcessLaunch)->Arg(0)->Arg(256)->Arg(1024)->UseRealTime();
+
+    // Round trip between two threads over a pair of events, the way a caller waits for the answer
+    // on an IPC channel. Next to the mean, the distribution (in nanoseconds) is reported, as the
+    // gain of spinning is mostly in the common, fast, case.
+    template <typename EVENT>
+    static void EventPingPong(benchmark::State& state)
+    {
+        EVENT request(false);
+        EVENT reply(false);
+        Core::LatencyHistogram histogram;
+        std::atomic<bool> stop(false);
+
+        std::thread partner([&]() {
+            while (true) {
+                request.Lock(Core::infinite);
+                request.ResetEvent();
+                if (stop == true) {
+                    break;
+                }
+                reply.SetEvent();
+            }
+        });
+
+        for (auto _ : state) {
+            const auto start = std::chrono::steady_clock::now();
+
+            reply.ResetEvent();
+            request.SetEvent();
+            reply.Lock(Core::infinite);
+
+            histogram.Record(static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count()));
+        }
+
+        stop = true;
+        request.SetEvent();
+        partner.join();
+
+        state.counters["p50_ns"] = static_cast<double>(histogram.Percentile(50));
+        state.counters["p99_ns"] = static_cast<double>(histogram.Percentile(99));
+        state.counters["max_ns"] = static_cast<double>(histogram.Max());
+    }
+
+    // Core::Event has no single argument constructor, give it the manual reset flavour.
+    class ManualResetEvent : public Core::Event {
+    public:
+        ManualResetEvent(const bool set)
+            : Core::Event(set, true)
+        {
+        }
+    };
+
+    BENCHMARK_TEMPLATE(EventPingPong, ManualResetEvent)->UseRealTime();
+    BENCHMARK_TEMPLATE(EventPingPong, Core::AdaptiveEvent)->UseRealTime();
+
+    // Read side of a read mostly lock, taken by a growing number of threads at the same time.
+    static Core::ReadWriteLock plainLock;
+    static Core::ReadWriteLock biasedLock(Core::ReadWriteLock::WRITER, true);
+
+    static void ReadWriteLockRead(benchmark::State& state)
+    {
+        Core::ReadWriteLock& lock(state.range(0) == 0 ? plainLock : biasedLock);
+
+        for (auto _ : state) {
+            lock.ReadLock();
+            benchmark::ClobberMemory();
+            lock.ReadUnlock();
+        }
+    }
+    BENCHMARK(ReadWriteLockRead)->Arg(0)->Arg(1)->ThreadRange(1, 8)->UseRealTime();
+
+} // Benchmarks
+} // WPEFramework
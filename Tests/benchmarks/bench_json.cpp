@@ -0,0 +1,305 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2020 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include "JSON.h"
+#include "JSONRPC.h"
+
+namespace WPEFramework {
+namespace Benchmarks {
+
+    class Settings : public Core::JSON::Container {
+    public:
+        class Entry : public Core::JSON::Container {
+        public:
+            Entry& operator=(const Entry&) = delete;
+
+            Entry()
+                : Core::JSON::Container()
+                , Name()
+                , Value(0)
+                , Enabled(false)
+            {
+                Init();
+            }
+            Entry(const Entry& copy)
+                : Core::JSON::Container()
+                , Name(copy.Name)
+                , Value(copy.Value)
+                , Enabled(copy.Enabled)
+            {
+                Init();
+            }
+            ~Entry() override
+            {
+            }
+
+        private:
+            void Init()
+            {
+                Add(_T("name"), &Name);
+                Add(_T("value"), &Value);
+                Add(_T("enabled"), &Enabled);
+            }
+
+        public:
+            Core::JSON::String Name;
+            Core::JSON::DecSInt32 Value;
+            Core::JSON::Boolean Enabled;
+        };
+
+    public:
+        Settings(const Settings&) = delete;
+        Settings& operator=(const Settings&) = delete;
+
+        Settings()
+            : Core::JSON::Container()
+            , Callsign()
+            , Locator()
+            , Priority(0)
+            , Entries()
+        {
+            Add(_T("callsign"), &Callsign);
+            Add(_T("locator"), &Locator);
+            Add(_T("priority"), &Priority);
+            Add(_T("entries"), &Entries);
+        }
+        ~Settings() override
+        {
+        }
+
+    public:
+        Core::JSON::String Callsign;
+        Core::JSON::String Locator;
+        Core::JSON::DecUInt8 Priority;
+        Core::JSON::ArrayType<Entry> Entries;
+    };
+
+    static string SettingsText(const uint32_t entries)
+    {
+        Settings settings;
+        string text;
+
+        settings.Callsign = _T("Benchmark");
+        settings.Locator = _T("libWPEFrameworkBenchmark.so");
+        settings.Priority = 5;
+
+        for (uint32_t index = 0; index < entries; index++) {
+            Settings::Entry& entry(settings.Entries.Add());
+            entry.Name = _T("entry_") + Core::NumberType<uint32_t>(index).Text();
+            entry.Value = static_cast<int32_t>(index * 7) - 100;
+            entry.Enabled = ((index & 1) == 0);
+        }
+
+        settings.ToString(text);
+
+        return (text);
+    }
+
+    static void JSONContainerParse(benchmark::State& state)
+    {
+        const string text(SettingsText(static_cast<uint32_t>(state.range(0))));
+        Settings settings;
+
+        for (auto _ : state) {
+            settings.Clear();
+            settings.FromString(text);
+        }
+
+        state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * text.length());
+    }
+    BENCHMARK(JSONContainerParse)->Arg(1)->Arg(16)->Arg(256);
+
+    // Same document, but only one entry is in memory at a time.
+    static void JSONReaderStream(benchmark::State& state)
+    {
+        const string text(SettingsText(static_cast<uint32_t>(state.range(0))));
+        Core::JSON::Reader reader;
+        Settings::Entry entry;
+        uint32_t entries = 0;
+
+        for (auto _ : state) {
+            reader.Reset();
+
+            for (uint32_t position = 0; position < text.length(); position += 1024) {
+                reader.Feed(&(text[position]), std::min(1024u, static_cast<uint32_t>(text.length() - position)));
+
+                Core::JSON::Reader::token token;
+                while ((token = reader.Next()) != Core::JSON::Reader::NONE) {
+                    if ((token == Core::JSON::Reader::BEGIN_ARRAY) || (token == Core::JSON::Reader::ELEMENT)) {
+                        entries += (token == Core::JSON::Reader::ELEMENT ? 1 : 0);
+                        reader.Load(entry);
+                    }
+                }
+            }
+        }
+
+        benchmark::DoNotOptimize(entries);
+        state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * text.length());
+    }
+    BENCHMARK(JSONReaderStream)->Arg(1)->Arg(16)->Arg(256);
+
+    template <typename STORAGE>
+    static void JSONArrayBuild(benchmark::State& state)
+    {
+        const uint32_t entries = static_cast<uint32_t>(state.range(0));
+
+        for (auto _ : state) {
+            Core::JSON::ArrayType<Core::JSON::DecSInt32, STORAGE> array;
+            array.Reserve(entries);
+
+            for (uint32_t index = 0; index < entries; index++) {
+                array.Add() = static_cast<int32_t>(index);
+            }
+
+            benchmark::DoNotOptimize(&array);
+        }
+
+        state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * entries);
+    }
+    BENCHMARK_TEMPLATE(JSONArrayBuild, std::list<Core::JSON::DecSInt32>)->Arg(16)->Arg(4096);
+    BENCHMARK_TEMPLATE(JSONArrayBuild, std::deque<Core::JSON::DecSInt32>)->Arg(16)->Arg(4096);
+    BENCHMARK_TEMPLATE(JSONArrayBuild, std::vector<Core::JSON::DecSInt32>)->Arg(16)->Arg(4096);
+
+    template <typename STORAGE>
+    static void JSONArraySerialize(benchmark::State& state)
+    {
+        const uint32_t entries = static_cast<uint32_t>(state.range(0));
+        Core::JSON::ArrayType<Core::JSON::DecSInt32, STORAGE> array;
+        string text;
+
+        for (uint32_t index = 0; index < entries; index++) {
+            array.Add() = static_cast<int32_t>(index);
+        }
+
+        for (auto _ : state) {
+            array.ToString(text);
+            benchmark::DoNotOptimize(text.data());
+        }
+
+        state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * entries);
+    }
+    BENCHMARK_TEMPLATE(JSONArraySerialize, std::list<Core::JSON::DecSInt32>)->Arg(4096);
+    BENCHMARK_TEMPLATE(JSONArraySerialize, std::vector<Core::JSON::DecSInt32>)->Arg(4096);
+
+    template <typename STORAGE>
+    static void JSONArrayIndex(benchmark::State& state)
+    {
+        const uint32_t entries = static_cast<uint32_t>(state.range(0));
+        Core::JSON::ArrayType<Core::JSON::DecUInt32, STORAGE> array;
+        uint64_t sum = 0;
+
+        for (uint32_t index = 0; index < entries; index++) {
+            array.Add() = index;
+        }
+
+        for (auto _ : state) {
+            for (uint32_t index = 0; index < entries; index++) {
+                sum += array[index].Value();
+            }
+        }
+
+        benchmark::DoNotOptimize(sum);
+        state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * entries);
+    }
+    BENCHMARK_TEMPLATE(JSONArrayIndex, std::list<Core::JSON::DecUInt32>)->Arg(16)->Arg(4096);
+    BENCHMARK_TEMPLATE(JSONArrayIndex, std::deque<Core::JSON::DecUInt32>)->Arg(16)->Arg(4096);
+    BENCHMARK_TEMPLATE(JSONArrayIndex, std::vector<Core::JSON::DecUInt32>)->Arg(16)->Arg(4096);
+
+    static void JSONContainerSerialize(benchmark::State& state)
+    {
+        const string text(SettingsText(static_cast<uint32_t>(state.range(0))));
+        Settings settings;
+        string result;
+
+        settings.FromString(text);
+
+        for (auto _ : state) {
+            settings.ToString(result);
+            benchmark::DoNotOptimize(result.data());
+        }
+
+        state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * text.length());
+    }
+    BENCHMARK(JSONContainerSerialize)->Arg(1)->Arg(16)->Arg(256);
+
+    class Point : public Core::JSON::Container {
+    public:
+        Point(const Point&) = delete;
+        Point& operator=(const Point&) = delete;
+
+        Point()
+            : Core::JSON::Container()
+            , X(0)
+            , Y(0)
+        {
+            Add(_T("x"), &X);
+            Add(_T("y"), &Y);
+        }
+        ~Point() override
+        {
+        }
+
+    public:
+        Core::JSON::DecSInt32 X;
+        Core::JSON::DecSInt32 Y;
+    };
+
+    static void JSONRPCInvokeRaw(benchmark::State& state)
+    {
+        Core::JSONRPC::Handler handler([](const uint32_t, const string&, const string&) {}, { 1 });
+        const string designator(_T("Benchmark.1.echo"));
+        const string parameters(_T("{\"x\":1,\"y\":2}"));
+        string response;
+
+        handler.Register(_T("echo"), [](const string&, const string& parameters, string& response) -> uint32_t {
+            response = parameters;
+            return (Core::ERROR_NONE);
+        });
+
+        for (auto _ : state) {
+            handler.Invoke(Core::JSONRPC::Connection(1, 1), Core::JSONRPC::Message::Designation(designator), parameters, response);
+            benchmark::DoNotOptimize(response.data());
+        }
+    }
+    BENCHMARK(JSONRPCInvokeRaw);
+
+    static void JSONRPCInvokeTyped(benchmark::State& state)
+    {
+        Core::JSONRPC::Handler handler([](const uint32_t, const string&, const string&) {}, { 1 });
+        const string designator(_T("Benchmark.1.swap"));
+        const string parameters(_T("{\"x\":1,\"y\":2}"));
+        string response;
+
+        handler.Register<Point, Point>(_T("swap"), [](const Point& inbound, Point& outbound) -> uint32_t {
+            outbound.X = inbound.Y.Value();
+            outbound.Y = inbound.X.Value();
+            return (Core::ERROR_NONE);
+        });
+
+        for (auto _ : state) {
+            handler.Invoke(Core::JSONRPC::Connection(1, 1), Core::JSONRPC::Message::Designation(designator), parameters, response);
+            benchmark::DoNotOptimize(response.data());
+        }
+    }
+    BENCHMARK(JSONRPCInvokeTyped);
+
+} // Benchmarks
+} // WPEFramework
@@ -0,0 +1,138 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2020 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include "JSON.h"
+#include "Number.h"
+
+namespace WPEFramework {
+namespace Benchmarks {
+
+    static const uint64_t Values[] = { 7, 42, 65535, 1588888888, 4294967295ull, 1234567890123ull, 18446744073709551615ull };
+    static const char* Texts[] = { "7", "42", "65535", "1588888888", "4294967295", "1234567890123", "18446744073709551615" };
+
+    // The digit-at-a-time conversion as it was used before, as a reference.
+    static char* LegacyDecimal(char* end, uint64_t value)
+    {
+        do {
+            *(--end) = static_cast<char>('0' + (value % 10));
+            value /= 10;
+        } while (value != 0);
+
+        return (end);
+    }
+
+    static uint64_t LegacyParse(const char text[], const uint32_t length)
+    {
+        uint64_t value = 0;
+
+        for (uint32_t index = 0; (index < length) && (isdigit(text[index])); index++) {
+            value = (value * 10) + (text[index] - '0');
+        }
+
+        return (value);
+    }
+
+    static void NumberFormatLegacy(benchmark::State& state)
+    {
+        char buffer[24];
+
+        for (auto _ : state) {
+            for (const uint64_t value : Values) {
+                benchmark::DoNotOptimize(LegacyDecimal(&buffer[sizeof(buffer)], value));
+            }
+        }
+    }
+    BENCHMARK(NumberFormatLegacy);
+
+    static void NumberFormat(benchmark::State& state)
+    {
+        char buffer[24];
+
+        for (auto _ : state) {
+            for (const uint64_t value : Values) {
+                benchmark::DoNotOptimize(Core::NumberConversion::Decimal(&buffer[sizeof(buffer)], value));
+            }
+        }
+    }
+    BENCHMARK(NumberFormat);
+
+    static void NumberParseLegacy(benchmark::State& state)
+    {
+        for (auto _ : state) {
+            for (const char* text : Texts) {
+                benchmark::DoNotOptimize(LegacyParse(text, static_cast<uint32_t>(strlen(text))));
+            }
+        }
+    }
+    BENCHMARK(NumberParseLegacy);
+
+    static void NumberParseEightDigits(benchmark::State& state)
+    {
+        for (auto _ : state) {
+            for (const char* text : Texts) {
+                const uint32_t length = static_cast<uint32_t>(strlen(text));
+                uint64_t value = 0;
+                uint32_t chunk;
+                uint32_t index = 0;
+
+                while (((length - index) >= 8) && (Core::NumberConversion::EightDigits(&text[index], chunk) == true)) {
+                    value = (value * 100000000) + chunk;
+                    index += 8;
+                }
+                benchmark::DoNotOptimize(value + LegacyParse(&text[index], length - index));
+            }
+        }
+    }
+    BENCHMARK(NumberParseEightDigits);
+
+    static void NumberParse(benchmark::State& state)
+    {
+        uint64_t value;
+
+        for (auto _ : state) {
+            for (const char* text : Texts) {
+                Core::NumberType<uint64_t>::Convert(text, static_cast<uint32_t>(strlen(text)), value, BASE_DECIMAL);
+                benchmark::DoNotOptimize(value);
+            }
+        }
+    }
+    BENCHMARK(NumberParse);
+
+    static void JSONNumberRoundTrip(benchmark::State& state)
+    {
+        Core::JSON::ArrayType<Core::JSON::DecUInt64> list;
+        string text;
+
+        for (const uint64_t value : Values) {
+            list.Add(Core::JSON::DecUInt64(value, true));
+        }
+
+        for (auto _ : state) {
+            list.ToString(text);
+            list.Clear();
+            list.FromString(text);
+        }
+    }
+    BENCHMARK(JSONNumberRoundTrip);
+
+} // Benchmarks
+} // WPEFramework
+
@@ -0,0 +1,88 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2020 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include "Time.h"
+
+namespace WPEFramework {
+namespace Benchmarks {
+
+    static void TimeNow(benchmark::State& state)
+    {
+        for (auto _ : state) {
+            benchmark::DoNotOptimize(Core::Time::Now());
+        }
+    }
+    BENCHMARK(TimeNow);
+
+    static void TimeLocal(benchmark::State& state)
+    {
+        const uint64_t now = Core::Time::Now().Ticks();
+
+        for (auto _ : state) {
+            benchmark::DoNotOptimize(Core::Time(now, true));
+        }
+    }
+    BENCHMARK(TimeLocal);
+
+    static void TimeToRFC1123(benchmark::State& state)
+    {
+        const Core::Time now(Core::Time::Now());
+
+        for (auto _ : state) {
+            benchmark::DoNotOptimize(now.ToRFC1123(false));
+        }
+    }
+    BENCHMARK(TimeToRFC1123);
+
+    static void TimeToISO8601(benchmark::State& state)
+    {
+        const Core::Time now(Core::Time::Now());
+
+        for (auto _ : state) {
+            benchmark::DoNotOptimize(now.ToISO8601(false));
+        }
+    }
+    BENCHMARK(TimeToISO8601);
+
+    static void TimeFromRFC1123(benchmark::State& state)
+    {
+        const string text(_T("Sun, 06 Nov 1994 08:49:37 GMT"));
+        Core::Time time;
+
+        for (auto _ : state) {
+            benchmark::DoNotOptimize(time.FromRFC1123(text));
+        }
+    }
+    BENCHMARK(TimeFromRFC1123);
+
+    static void TimeFromISO8601(benchmark::State& state)
+    {
+        const string text(_T("1994-11-06T08:49:37.123Z"));
+        Core::Time time;
+
+        for (auto _ : state) {
+            benchmark::DoNotOptimize(time.FromISO8601(text));
+        }
+    }
+    BENCHMARK(TimeFromISO8601);
+
+} // Benchmarks
+} // WPEFramework
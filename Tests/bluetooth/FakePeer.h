@@ -0,0 +1,305 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2020 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <core/core.h>
+
+#include <sys/un.h>
+
+#include <atomic>
+#include <thread>
+
+namespace WPEFramework {
+namespace Tests {
+
+    // Serves an attribute database over a SEQPACKET domain socket, answering the ATT PDUs a
+    // GATTSocket sends, so the whole exchange can run without a Bluetooth controller.
+    class FakePeer {
+    public:
+        struct Attribute {
+            uint16_t Handle;
+            uint16_t Type;
+            uint16_t Group;
+            std::vector<uint8_t> Value;
+        };
+
+    public:
+        FakePeer() = delete;
+        FakePeer(const FakePeer&) = delete;
+        FakePeer& operator=(const FakePeer&) = delete;
+
+        FakePeer(const string& connector, const std::vector<Attribute>& database, const uint16_t mtu = 23)
+            : _adminLock()
+            , _connector(connector)
+            , _database(database)
+            , _prepared()
+            , _streamed()
+            , _maxMTU(mtu)
+            , _mtu(23)
+            , _listener(::socket(AF_UNIX, SOCK_SEQPACKET, 0))
+            , _connection(-1)
+            , _requests(0)
+            , _confirmations(0)
+            , _thread()
+        {
+            struct sockaddr_un address;
+            ::memset(&address, 0, sizeof(address));
+            address.sun_family = AF_UNIX;
+            ::strncpy(address.sun_path, _connector.c_str(), sizeof(address.sun_path) - 1);
+            ::unlink(_connector.c_str());
+            ::bind(_listener, reinterpret_cast<struct sockaddr*>(&address), sizeof(address));
+            ::listen(_listener, 1);
+
+            ::memset(_opcodes, 0, sizeof(_opcodes));
+
+            _thread = std::thread([this]() { Accept(); });
+        }
+        ~FakePeer()
+        {
+            ::shutdown(_listener, SHUT_RDWR);
+            _thread.join();
+            ::close(_listener);
+            ::unlink(_connector.c_str());
+        }
+
+    public:
+        // All requests and commands, except the MTU exchange and confirmations.
+        uint32_t Requests() const
+        {
+            return (_requests.load());
+        }
+        uint32_t Requests(const uint8_t opcode) const
+        {
+            return (_opcodes[opcode].load());
+        }
+        uint32_t Confirmations() const
+        {
+            return (_confirmations.load());
+        }
+        uint16_t MTU() const
+        {
+            return (_mtu);
+        }
+        void Reset()
+        {
+            _requests = 0;
+            for (std::atomic<uint32_t>& entry : _opcodes) {
+                entry = 0;
+            }
+        }
+        std::vector<uint8_t> Value(const uint16_t handle)
+        {
+            std::vector<uint8_t> result;
+
+            _adminLock.Lock();
+            for (const Attribute& entry : _database) {
+                if (entry.Handle == handle) {
+                    result = entry.Value;
+                }
+            }
+            _adminLock.Unlock();
+
+            return (result);
+        }
+        void Value(const uint16_t handle, const std::vector<uint8_t>& value)
+        {
+            _adminLock.Lock();
+            for (Attribute& entry : _database) {
+                if (entry.Handle == handle) {
+                    entry.Value = value;
+                }
+            }
+            _adminLock.Unlock();
+        }
+        // Everything written with Write Without Response, in order of arrival.
+        std::vector<uint8_t> Streamed()
+        {
+            _adminLock.Lock();
+            std::vector<uint8_t> result(_streamed);
+            _adminLock.Unlock();
+
+            return (result);
+        }
+        void Indicate(const uint16_t handle, const std::vector<uint8_t>& value)
+        {
+            std::vector<uint8_t> message({ 0x1D, static_cast<uint8_t>(handle & 0xFF), static_cast<uint8_t>(handle >> 8) });
+            message.insert(message.end(), value.begin(), value.end());
+            ::send(_connection, message.data(), message.size(), 0);
+        }
+
+    private:
+        void Accept()
+        {
+            int connection;
+
+            while ((connection = ::accept(_listener, nullptr, nullptr)) != -1) {
+                uint8_t request[1024];
+                ssize_t size;
+
+                _connection = connection;
+
+                while ((size = ::recv(connection, request, sizeof(request), 0)) > 0) {
+                    std::vector<uint8_t> response;
+
+                    _adminLock.Lock();
+                    Handle(request, static_cast<uint16_t>(size), response);
+                    _adminLock.Unlock();
+
+                    if (response.empty() == false) {
+                        ::send(connection, response.data(), response.size(), 0);
+                    }
+                }
+
+                _connection = -1;
+                ::close(connection);
+            }
+        }
+        Attribute* Find(const uint16_t handle)
+        {
+            Attribute* result = nullptr;
+            for (Attribute& entry : _database) {
+                if (entry.Handle == handle) {
+                    result = &entry;
+                }
+            }
+            return (result);
+        }
+        void Handle(const uint8_t request[], const uint16_t size, std::vector<uint8_t>& response)
+        {
+            const uint16_t start = (size >= 3 ? (request[1] | (request[2] << 8)) : 0);
+            const uint16_t end = (size >= 5 ? (request[3] | (request[4] << 8)) : 0);
+            const uint16_t type = (size >= 7 ? (request[5] | (request[6] << 8)) : 0);
+
+            if (request[0] == 0x1E) {
+                _confirmations++;
+            } else if (request[0] == 0x02) {
+                _mtu = std::max(static_cast<uint16_t>(23), std::min(_maxMTU, static_cast<uint16_t>(start)));
+                response = { 0x03, static_cast<uint8_t>(_maxMTU & 0xFF), static_cast<uint8_t>(_maxMTU >> 8) };
+            } else {
+                _requests++;
+                _opcodes[request[0]]++;
+
+                if ((request[0] == 0x10) || (request[0] == 0x08)) {
+                    // Read By Group Type and Read By Type, all entries in a response have the same length.
+                    response = { static_cast<uint8_t>(request[0] + 1), 0 };
+                    for (const Attribute& entry : _database) {
+                        if ((entry.Handle >= start) && (entry.Handle <= end) && (entry.Type == type)) {
+                            const uint8_t length = static_cast<uint8_t>((request[0] == 0x10 ? 4 : 2) + entry.Value.size());
+                            if ((response[1] != 0) && ((response[1] != length) || ((response.size() + length) > _mtu))) {
+                                break;
+                            }
+                            response[1] = length;
+                            response.push_back(entry.Handle & 0xFF);
+                            response.push_back(entry.Handle >> 8);
+                            if (request[0] == 0x10) {
+                                response.push_back(entry.Group & 0xFF);
+                                response.push_back(entry.Group >> 8);
+                            }
+                            response.insert(response.end(), entry.Value.begin(), entry.Value.end());
+                        }
+                    }
+                } else if (request[0] == 0x04) {
+                    // Find Information, only 16 bit types in here.
+                    response = { 0x05, 0x01 };
+                    for (const Attribute& entry : _database) {
+                        if ((entry.Handle >= start) && (entry.Handle <= end) && ((response.size() + 4) <= _mtu)) {
+                            response.push_back(entry.Handle & 0xFF);
+                            response.push_back(entry.Handle >> 8);
+                            response.push_back(entry.Type & 0xFF);
+                            response.push_back(entry.Type >> 8);
+                        }
+                    }
+                } else if ((request[0] == 0x0A) || (request[0] == 0x0C)) {
+                    // Read and Read Blob, a response is cut off at the MTU.
+                    const Attribute* entry = Find(start);
+                    const uint16_t offset = (request[0] == 0x0C ? end : 0);
+                    if ((entry != nullptr) && (offset <= entry->Value.size())) {
+                        const uint16_t length = std::min(static_cast<uint16_t>(entry->Value.size() - offset), static_cast<uint16_t>(_mtu - 1));
+                        response = { static_cast<uint8_t>(request[0] + 1) };
+                        response.insert(response.end(), entry->Value.begin() + offset, entry->Value.begin() + offset + length);
+                    }
+                } else if (request[0] == 0x0E) {
+                    response = { 0x0F };
+                    for (uint16_t index = 1; (index + 1) < size; index += 2) {
+                        const Attribute* entry = Find(request[index] | (request[index + 1] << 8));
+                        if (entry != nullptr) {
+                            response.insert(response.end(), entry->Value.begin(), entry->Value.end());
+                        }
+                    }
+                    response.resize(std::min(static_cast<uint16_t>(response.size()), _mtu));
+                } else if (request[0] == 0x12) {
+                    Attribute* entry = Find(start);
+                    if (entry != nullptr) {
+                        entry->Value.assign(&request[3], &request[size]);
+                        response = { 0x13 };
+                    }
+                } else if (request[0] == 0x52) {
+                    _streamed.insert(_streamed.end(), &request[3], &request[size]);
+                } else if (request[0] == 0xD2) {
+                    // The signature is not checked, only stripped.
+                    Attribute* entry = Find(start);
+                    if ((entry != nullptr) && (size >= (3 + 12))) {
+                        entry->Value.assign(&request[3], &request[size - 12]);
+                    }
+                } else if (request[0] == 0x16) {
+                    _prepared.push_back(std::vector<uint8_t>(&request[1], &request[size]));
+                    response.assign(&request[0], &request[size]);
+                    response[0] = 0x17;
+                } else if (request[0] == 0x18) {
+                    if (request[1] == 0x01) {
+                        for (const std::vector<uint8_t>& part : _prepared) {
+                            Attribute* entry = Find(part[0] | (part[1] << 8));
+                            const uint16_t offset = (part[2] | (part[3] << 8));
+                            if (entry != nullptr) {
+                                entry->Value.resize(std::max(entry->Value.size(), static_cast<size_t>(offset + part.size() - 4)));
+                                std::copy(part.begin() + 4, part.end(), entry->Value.begin() + offset);
+                            }
+                        }
+                    }
+                    _prepared.clear();
+                    response = { 0x19 };
+                }
+
+                // Commands are never answered, a request the database can not serve gets an error.
+                const bool listing = ((request[0] == 0x10) || (request[0] == 0x08) || (request[0] == 0x04));
+                if ((request[0] != 0x52) && (request[0] != 0xD2) && ((response.empty() == true) || ((listing == true) && (response.size() <= 2)))) {
+                    response = { 0x01, request[0], static_cast<uint8_t>(start & 0xFF), static_cast<uint8_t>(start >> 8), 0x0A };
+                }
+            }
+        }
+
+    private:
+        Core::CriticalSection _adminLock;
+        const string _connector;
+        std::vector<Attribute> _database;
+        std::list<std::vector<uint8_t>> _prepared;
+        std::vector<uint8_t> _streamed;
+        const uint16_t _maxMTU;
+        uint16_t _mtu;
+        int _listener;
+        std::atomic<int> _connection;
+        std::atomic<uint32_t> _requests;
+        std::atomic<uint32_t> _confirmations;
+        std::atomic<uint32_t> _opcodes[256];
+        std::thread _thread;
+    };
+
+} // Tests
+} // WPEFramework
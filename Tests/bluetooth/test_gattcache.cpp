@@ -0,0 +1,276 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2020 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include <core/core.h>
+#include <bluetooth/GATTSocket.h>
+#include <bluetooth/Profile.h>
+
+#include "FakePeer.h"
+
+namespace WPEFramework {
+namespace Tests {
+
+    static const TCHAR* PeerConnector = _T("/tmp/test_gattcache_peer");
+    static const TCHAR* CacheStorage = _T("/tmp/test_gattcache/");
+
+    class Client : public Bluetooth::GATTSocket {
+    public:
+        Client() = delete;
+        Client(const Client&) = delete;
+        Client& operator=(const Client&) = delete;
+
+        Client(const Core::NodeId& remote, Bluetooth::Profile& profile)
+            : Bluetooth::GATTSocket(remote.AnyInterface(), remote, 64)
+            , _profile(profile)
+            , _operational(false, true)
+            , _changed(false, true)
+        {
+        }
+        ~Client() override
+        {
+            Close(Core::infinite);
+        }
+
+    public:
+        bool IsOperational(const uint32_t waitTime)
+        {
+            return (_operational.Lock(waitTime) == Core::ERROR_NONE);
+        }
+        bool IsChanged(const uint32_t waitTime)
+        {
+            return (_changed.Lock(waitTime) == Core::ERROR_NONE);
+        }
+        uint32_t Discover()
+        {
+            Core::Event done(false, true);
+            uint32_t result = Core::ERROR_TIMEDOUT;
+
+            if (_profile.Discover(2000, *this, [&](const uint32_t outcome) { result = outcome; done.SetEvent(); }) == Core::ERROR_NONE) {
+                done.Lock(3000);
+            }
+
+            return (result);
+        }
+
+    private:
+        void Notification(const uint16_t handle, const uint8_t[], const uint16_t) override
+        {
+            if (_profile.Changed(handle) == true) {
+                _changed.SetEvent();
+            }
+        }
+        void Operational() override
+        {
+            _operational.SetEvent();
+        }
+
+    private:
+        Bluetooth::Profile& _profile;
+        Core::Event _operational;
+        Core::Event _changed;
+    };
+
+    static std::vector<FakePeer::Attribute> Database()
+    {
+        return (std::vector<FakePeer::Attribute>({
+            { 0x0001, 0x2800, 0x0006, { 0x01, 0x18 } },
+            { 0x0002, 0x2803, 0, { 0x20, 0x03, 0x00, 0x05, 0x2A } },
+            { 0x0003, 0x2A05, 0, { 0x01, 0x00, 0xFF, 0xFF } },
+            { 0x0004, 0x2902, 0, { 0x02, 0x00 } },
+            { 0x0005, 0x2901, 0, { 'S', 'C' } },
+            { 0x0006, 0x2803, 0, { 0x02, 0x07, 0x00, 0x2A, 0x2B } },
+            { 0x0007, 0x2B2A, 0, { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15 } },
+            { 0x0008, 0x2800, 0x000A, { 0x00, 0x18 } },
+            { 0x0009, 0x2803, 0, { 0x02, 0x0A, 0x00, 0x00, 0x2A } },
+            { 0x000A, 0x2A00, 0, { 'F', 'a', 'k', 'e', ' ', 'p', 'e', 'e', 'r' } }
+        }));
+    }
+
+    static void ClearCache()
+    {
+        Core::Directory storage(CacheStorage);
+        storage.CreatePath();
+        while (storage.Next() == true) {
+            if (storage.IsDirectory() == false) {
+                Core::File(storage.Current()).Destroy();
+            }
+        }
+    }
+
+    static uint32_t Discover(FakePeer& peer, Bluetooth::Profile& profile)
+    {
+        Client client(Core::NodeId(PeerConnector), profile);
+        uint32_t result = Core::ERROR_UNAVAILABLE;
+
+        peer.Reset();
+
+        if ((client.Open(1000) == Core::ERROR_NONE) && (client.IsOperational(1000) == true)) {
+            result = client.Discover();
+        }
+
+        return (result);
+    }
+
+    static void Verify(const Bluetooth::Profile& profile)
+    {
+        const Bluetooth::Profile::Service* access = profile[Bluetooth::UUID(Bluetooth::Profile::Service::GenericAccess)];
+        ASSERT_NE(access, nullptr);
+        EXPECT_EQ(access->Handle(), 0x0008);
+        EXPECT_EQ(access->Max(), 0x000A);
+
+        const Bluetooth::Profile::Service::Characteristic* name = (*access)[Bluetooth::UUID(Bluetooth::Profile::Service::Characteristic::DeviceName)];
+        ASSERT_NE(name, nullptr);
+        EXPECT_EQ(name->Handle(), 0x000A);
+        EXPECT_EQ(name->Rights(), 0x02);
+        EXPECT_EQ(name->ToString(), _T("Fake peer"));
+
+        const Bluetooth::Profile::Service* attribute = profile[Bluetooth::UUID(Bluetooth::Profile::Service::GenericAttribute)];
+        ASSERT_NE(attribute, nullptr);
+
+        const Bluetooth::Profile::Service::Characteristic* changed = (*attribute)[Bluetooth::UUID(Bluetooth::Profile::Service::Characteristic::ServiceChanged)];
+        ASSERT_NE(changed, nullptr);
+        EXPECT_EQ(changed->Handle(), 0x0003);
+        EXPECT_NE((*changed)[Bluetooth::UUID(Bluetooth::Profile::Service::Characteristic::Descriptor::ClientCharacteristicConfiguration)], nullptr);
+        EXPECT_NE((*changed)[Bluetooth::UUID(Bluetooth::Profile::Service::Characteristic::Descriptor::CharacteristicUserDescription)], nullptr);
+    }
+
+    TEST(Bluetooth_GATTCache, ReconnectSkipsDiscovery)
+    {
+        ClearCache();
+        FakePeer peer(PeerConnector, Database());
+
+        Bluetooth::Profile first(false, CacheStorage);
+        ASSERT_EQ(Discover(peer, first), Core::ERROR_NONE);
+        EXPECT_FALSE(first.IsCached());
+        const uint32_t discovery = peer.Requests();
+        Verify(first);
+
+        // The Database Hash is read (the second request finds no more of them) and the values of the
+        // three characteristics, there is no walk over the services, characteristics and descriptors.
+        Bluetooth::Profile second(false, CacheStorage);
+        ASSERT_EQ(Discover(peer, second), Core::ERROR_NONE);
+        EXPECT_TRUE(second.IsCached());
+        EXPECT_EQ(peer.Requests(), 5u);
+        EXPECT_EQ(peer.Requests(0x0A), 3u);
+        EXPECT_EQ(peer.Requests(0x04), 0u);
+        EXPECT_GT(discovery, peer.Requests());
+        Verify(second);
+
+        // Without storage, nothing is cached.
+        Bluetooth::Profile uncached(false);
+        ASSERT_EQ(Discover(peer, uncached), Core::ERROR_NONE);
+        EXPECT_FALSE(uncached.IsCached());
+        EXPECT_EQ(peer.Requests(), discovery - 2);
+    }
+
+    TEST(Bluetooth_GATTCache, ValuesAreReadAgain)
+    {
+        ClearCache();
+        FakePeer peer(PeerConnector, Database());
+
+        Bluetooth::Profile profile(false, CacheStorage);
+        ASSERT_EQ(Discover(peer, profile), Core::ERROR_NONE);
+
+        // A value is not part of the Database Hash, the cached layout must not hand out the old one.
+        peer.Value(0x000A, { 'R', 'e', 'n', 'a', 'm', 'e', 'd' });
+
+        ASSERT_EQ(Discover(peer, profile), Core::ERROR_NONE);
+        EXPECT_TRUE(profile.IsCached());
+
+        const Bluetooth::Profile::Service* access = profile[Bluetooth::UUID(Bluetooth::Profile::Service::GenericAccess)];
+        ASSERT_NE(access, nullptr);
+        ASSERT_NE((*access)[Bluetooth::UUID(Bluetooth::Profile::Service::Characteristic::DeviceName)], nullptr);
+        EXPECT_EQ((*access)[Bluetooth::UUID(Bluetooth::Profile::Service::Characteristic::DeviceName)]->ToString(), _T("Renamed"));
+    }
+
+    TEST(Bluetooth_GATTCache, HashMismatch)
+    {
+        ClearCache();
+        FakePeer peer(PeerConnector, Database());
+
+        Bluetooth::Profile profile(false, CacheStorage);
+        ASSERT_EQ(Discover(peer, profile), Core::ERROR_NONE);
+        const uint32_t discovery = peer.Requests();
+
+        peer.Value(0x0007, { 15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0 });
+        peer.Value(0x000A, { 'R', 'e', 'n', 'a', 'm', 'e', 'd' });
+
+        ASSERT_EQ(Discover(peer, profile), Core::ERROR_NONE);
+        EXPECT_FALSE(profile.IsCached());
+        EXPECT_EQ(peer.Requests(), discovery);
+
+        const Bluetooth::Profile::Service* access = profile[Bluetooth::UUID(Bluetooth::Profile::Service::GenericAccess)];
+        ASSERT_NE(access, nullptr);
+        ASSERT_NE((*access)[Bluetooth::UUID(Bluetooth::Profile::Service::Characteristic::DeviceName)], nullptr);
+        EXPECT_EQ((*access)[Bluetooth::UUID(Bluetooth::Profile::Service::Characteristic::DeviceName)]->ToString(), _T("Renamed"));
+
+        // The new database is the cached one now.
+        ASSERT_EQ(Discover(peer, profile), Core::ERROR_NONE);
+        EXPECT_TRUE(profile.IsCached());
+        EXPECT_EQ((*profile[Bluetooth::UUID(Bluetooth::Profile::Service::GenericAccess)])[Bluetooth::UUID(Bluetooth::Profile::Service::Characteristic::DeviceName)]->ToString(), _T("Renamed"));
+    }
+
+    TEST(Bluetooth_GATTCache, ServiceChanged)
+    {
+        ClearCache();
+        FakePeer peer(PeerConnector, Database());
+
+        Bluetooth::Profile profile(false, CacheStorage);
+        Client client(Core::NodeId(PeerConnector), profile);
+        ASSERT_EQ(client.Open(1000), Core::ERROR_NONE);
+        ASSERT_TRUE(client.IsOperational(1000));
+        ASSERT_EQ(client.Discover(), Core::ERROR_NONE);
+
+        // Any other notification leaves the cache alone.
+        peer.Indicate(0x000A, { 0x00 });
+        EXPECT_FALSE(client.IsChanged(200));
+
+        peer.Indicate(0x0003, { 0x01, 0x00, 0xFF, 0xFF });
+        EXPECT_TRUE(client.IsChanged(1000));
+
+        uint8_t retries = 100;
+        while ((peer.Confirmations() < 2) && (--retries != 0)) {
+            SleepMs(10);
+        }
+        EXPECT_EQ(peer.Confirmations(), 2u);
+
+        // Indications that arrive before the previous one is confirmed each get their own confirmation.
+        peer.Indicate(0x000A, { 0x01 });
+        peer.Indicate(0x000A, { 0x02 });
+        peer.Indicate(0x000A, { 0x03 });
+
+        retries = 100;
+        while ((peer.Confirmations() < 5) && (--retries != 0)) {
+            SleepMs(10);
+        }
+        EXPECT_EQ(peer.Confirmations(), 5u);
+
+        client.Close(Core::infinite);
+
+        // The hash did not change, but the cache was dropped, so it all is discovered again.
+        Bluetooth::Profile next(false, CacheStorage);
+        ASSERT_EQ(Discover(peer, next), Core::ERROR_NONE);
+        EXPECT_FALSE(next.IsCached());
+        Verify(next);
+    }
+
+} // Tests
+} // WPEFramework
@@ -0,0 +1,215 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2020 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include <core/core.h>
+#include <bluetooth/GATTSocket.h>
+
+#include "FakePeer.h"
+
+namespace WPEFramework {
+namespace Tests {
+
+    static const TCHAR* SocketConnector = _T("/tmp/test_gattsocket_peer");
+
+    static constexpr uint16_t LongHandle = 0x0020;
+    static constexpr uint16_t ShortHandle = 0x0021;
+    static constexpr uint16_t OtherHandle = 0x0022;
+
+    class Connection : public Bluetooth::GATTSocket {
+    public:
+        Connection() = delete;
+        Connection(const Connection&) = delete;
+        Connection& operator=(const Connection&) = delete;
+
+        Connection(const Core::NodeId& remote, const uint16_t mtu)
+            : Bluetooth::GATTSocket(remote.AnyInterface(), remote, mtu)
+            , _operational(false, true)
+        {
+        }
+        ~Connection() override
+        {
+            Close(Core::infinite);
+        }
+
+    public:
+        bool Connect()
+        {
+            return ((Open(1000) == Core::ERROR_NONE) && (_operational.Lock(2000) == Core::ERROR_NONE));
+        }
+        // Runs the command to completion, returns its error and the value it collected.
+        uint32_t Run(Bluetooth::GATTSocket::Command& cmd, std::vector<uint8_t>& value)
+        {
+            Core::Event done(false, true);
+            uint32_t result = Core::ERROR_TIMEDOUT;
+
+            Execute(2000, cmd, [&](const Bluetooth::GATTSocket::Command& completed) {
+                result = completed.Error();
+                value.assign(completed.Result().Data(), completed.Result().Data() + completed.Result().Length());
+                done.SetEvent();
+            });
+
+            done.Lock(3000);
+
+            return (result);
+        }
+
+    private:
+        void Notification(const uint16_t, const uint8_t[], const uint16_t) override
+        {
+        }
+        void Operational() override
+        {
+            _operational.SetEvent();
+        }
+
+    private:
+        Core::Event _operational;
+    };
+
+    static std::vector<uint8_t> Pattern(const uint16_t length, const uint8_t seed)
+    {
+        std::vector<uint8_t> result(length);
+        for (uint16_t index = 0; index < length; index++) {
+            result[index] = static_cast<uint8_t>(seed + (index * 7));
+        }
+        return (result);
+    }
+
+    static std::vector<FakePeer::Attribute> Values()
+    {
+        return (std::vector<FakePeer::Attribute>({
+            { LongHandle, 0x2A00, 0, Pattern(100, 1) },
+            { ShortHandle, 0x2A01, 0, { 0x11, 0x22 } },
+            { OtherHandle, 0x2A02, 0, { 0x33, 0x44, 0x55 } } }));
+    }
+
+    TEST(Bluetooth_GATTSocket, NegotiatesLowestMTU)
+    {
+        FakePeer peer(SocketConnector, Values(), 185);
+        Connection connection(Core::NodeId(SocketConnector), 64);
+
+        ASSERT_TRUE(connection.Connect());
+        EXPECT_EQ(connection.MTU(), 64);
+        EXPECT_EQ(peer.MTU(), 64);
+    }
+
+    TEST(Bluetooth_GATTSocket, LongReadContinuesWithBlobs)
+    {
+        FakePeer peer(SocketConnector, Values());
+        Connection connection(Core::NodeId(SocketConnector), 64);
+        Bluetooth::GATTSocket::Command cmd;
+        std::vector<uint8_t> value;
+
+        ASSERT_TRUE(connection.Connect());
+        ASSERT_EQ(connection.MTU(), 23);
+
+        cmd.Read(LongHandle);
+        EXPECT_EQ(connection.Run(cmd, value), Core::ERROR_NONE);
+        EXPECT_EQ(value, Pattern(100, 1));
+
+        // 22 bytes per response, so 4 blobs after the first read, the last one short.
+        EXPECT_EQ(peer.Requests(0x0A), 1u);
+        EXPECT_EQ(peer.Requests(0x0C), 4u);
+    }
+
+    TEST(Bluetooth_GATTSocket, ReadMultipleInOneRequest)
+    {
+        FakePeer peer(SocketConnector, Values());
+        Connection connection(Core::NodeId(SocketConnector), 64);
+        Bluetooth::GATTSocket::Command cmd;
+        std::vector<uint8_t> value;
+        const uint16_t handles[] = { ShortHandle, OtherHandle };
+
+        ASSERT_TRUE(connection.Connect());
+
+        cmd.ReadMultiple(2, handles);
+        EXPECT_EQ(connection.Run(cmd, value), Core::ERROR_NONE);
+        EXPECT_EQ(value, std::vector<uint8_t>({ 0x11, 0x22, 0x33, 0x44, 0x55 }));
+        EXPECT_EQ(peer.Requests(), 1u);
+    }
+
+    TEST(Bluetooth_GATTSocket, ShortWriteIsSingleRequest)
+    {
+        FakePeer peer(SocketConnector, Values());
+        Connection connection(Core::NodeId(SocketConnector), 64);
+        Bluetooth::GATTSocket::Command cmd;
+        std::vector<uint8_t> value;
+        const std::vector<uint8_t> data({ 0xAA, 0xBB, 0xCC });
+
+        ASSERT_TRUE(connection.Connect());
+
+        cmd.Write(ShortHandle, static_cast<uint16_t>(data.size()), data.data());
+        EXPECT_EQ(connection.Run(cmd, value), Core::ERROR_NONE);
+        EXPECT_EQ(peer.Value(ShortHandle), data);
+        EXPECT_EQ(peer.Requests(0x12), 1u);
+        EXPECT_EQ(peer.Requests(0x16), 0u);
+    }
+
+    TEST(Bluetooth_GATTSocket, LongWriteIsPreparedAndExecuted)
+    {
+        FakePeer peer(SocketConnector, Values());
+        Connection connection(Core::NodeId(SocketConnector), 64);
+        Bluetooth::GATTSocket::Command cmd;
+        std::vector<uint8_t> value;
+        const std::vector<uint8_t> data(Pattern(200, 9));
+
+        ASSERT_TRUE(connection.Connect());
+
+        cmd.Write(LongHandle, static_cast<uint16_t>(data.size()), data.data());
+        EXPECT_EQ(connection.Run(cmd, value), Core::ERROR_NONE);
+        EXPECT_EQ(peer.Value(LongHandle), data);
+
+        // 18 bytes per Prepare Write at an MTU of 23.
+        EXPECT_EQ(peer.Requests(0x16), 12u);
+        EXPECT_EQ(peer.Requests(0x18), 1u);
+        EXPECT_EQ(peer.Requests(0x12), 0u);
+    }
+
+    TEST(Bluetooth_GATTSocket, WriteCommandsStream)
+    {
+        FakePeer peer(SocketConnector, Values());
+        Connection connection(Core::NodeId(SocketConnector), 64);
+        Bluetooth::GATTSocket::Command first;
+        Bluetooth::GATTSocket::Command second;
+        Bluetooth::GATTSocket::Command read;
+        const std::vector<uint8_t> data(Pattern(1000, 3));
+        std::vector<uint8_t> value;
+        uint32_t completions = 0;
+
+        ASSERT_TRUE(connection.Connect());
+
+        // Queued back to back, the read behind them is answered once all chunks went out.
+        first.WriteCommand(OtherHandle, 500, data.data());
+        second.WriteCommand(OtherHandle, 500, data.data() + 500);
+        connection.Execute(2000, first, [&](const Bluetooth::GATTSocket::Command& cmd) { EXPECT_EQ(cmd.Error(), Core::ERROR_NONE); completions++; });
+        connection.Execute(2000, second, [&](const Bluetooth::GATTSocket::Command& cmd) { EXPECT_EQ(cmd.Error(), Core::ERROR_NONE); completions++; });
+
+        read.Read(ShortHandle);
+        EXPECT_EQ(connection.Run(read, value), Core::ERROR_NONE);
+
+        EXPECT_EQ(completions, 2u);
+        EXPECT_EQ(peer.Streamed(), data);
+        // 20 bytes per command at an MTU of 23.
+        EXPECT_EQ(peer.Requests(0x52), 50u);
+    }
+
+} // Tests
+} // WPEFramework
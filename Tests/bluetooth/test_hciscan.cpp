@@ -0,0 +1,392 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2020 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include <core/core.h>
+#include <bluetooth/HCISocket.h>
+
+#include <atomic>
+#include <thread>
+
+namespace WPEFramework {
+namespace Tests {
+
+    // A recorded HCI event stream: raw event packets and when they arrived, relative to the moment
+    // scanning was enabled.
+    class Recording {
+    public:
+        struct Frame {
+            uint32_t At; // ms
+            std::vector<uint8_t> Event;
+        };
+
+    public:
+        Recording(const Recording&) = delete;
+        Recording& operator=(const Recording&) = delete;
+
+        Recording()
+            : _frames()
+        {
+        }
+        ~Recording()
+        {
+        }
+
+    public:
+        // An LE Advertising Report event with a single report, as a controller sends it.
+        void Add(const uint32_t at, const uint8_t type, const uint8_t address, const std::vector<uint8_t>& payload, const int8_t rssi)
+        {
+            std::vector<uint8_t> event({ HCI_EVENT_PKT, EVT_LE_META_EVENT, 0, EVT_LE_ADVERTISING_REPORT, 1, type, 0x00, address, 0x00, 0x00, 0x00, 0x00, 0xC0 });
+            event.push_back(static_cast<uint8_t>(payload.size()));
+            event.insert(event.end(), payload.begin(), payload.end());
+            event.push_back(static_cast<uint8_t>(rssi));
+            event[2] = static_cast<uint8_t>(event.size() - 3);
+
+            Add(at, event);
+        }
+        // The same report every period, the RSSI wobbling within the given spread.
+        void Repeat(const uint32_t from, const uint32_t to, const uint32_t period, const uint8_t type, const uint8_t address, const std::vector<uint8_t>& payload, const int8_t rssi, const int8_t spread)
+        {
+            int8_t offset = 0;
+            for (uint32_t at = from; at < to; at += period) {
+                Add(at, type, address, payload, static_cast<int8_t>(rssi + offset));
+                offset = (offset == 0 ? spread : 0);
+            }
+        }
+        void Add(const uint32_t at, const std::vector<uint8_t>& event)
+        {
+            std::vector<Frame>::iterator index(_frames.begin());
+            while ((index != _frames.end()) && (index->At <= at)) {
+                index++;
+            }
+            _frames.insert(index, Frame({ at, event }));
+        }
+        const std::vector<Frame>& Frames() const
+        {
+            return (_frames);
+        }
+
+    private:
+        std::vector<Frame> _frames;
+    };
+
+    // Plays the controller at the other end of a socketpair: every command completes successfully and
+    // once scanning is enabled the recording is replayed, with its original timing.
+    class Controller {
+    public:
+        Controller() = delete;
+        Controller(const Controller&) = delete;
+        Controller& operator=(const Controller&) = delete;
+
+        Controller(const int descriptor, const Recording& recording)
+            : _descriptor(descriptor)
+            , _recording(recording)
+            , _scanning(false)
+            , _commands(0)
+            , _replay()
+            , _thread([this]() { Serve(); })
+        {
+        }
+        ~Controller()
+        {
+            _thread.join();
+            Stop();
+            ::close(_descriptor);
+        }
+
+    public:
+        uint32_t Commands() const
+        {
+            return (_commands.load());
+        }
+
+    private:
+        void Serve()
+        {
+            uint8_t command[260];
+            ssize_t size;
+
+            while ((size = ::recv(_descriptor, command, sizeof(command), 0)) > 0) {
+                if ((size >= 4) && (command[0] == HCI_COMMAND_PKT)) {
+                    const uint16_t opcode = (command[1] | (command[2] << 8));
+                    const uint8_t complete[] = { HCI_EVENT_PKT, EVT_CMD_COMPLETE, 4, 1, command[1], command[2], 0x00 };
+
+                    _commands++;
+
+                    if (opcode == cmd_opcode_pack(OGF_LE_CTL, OCF_LE_SET_SCAN_ENABLE)) {
+                        if (command[4] == 0) {
+                            Stop();
+                        }
+                        ::send(_descriptor, complete, sizeof(complete), 0);
+                        if (command[4] != 0) {
+                            Start();
+                        }
+                    } else {
+                        ::send(_descriptor, complete, sizeof(complete), 0);
+                    }
+                }
+            }
+        }
+        void Start()
+        {
+            Stop();
+
+            _scanning = true;
+            _replay = std::thread([this]() {
+                const uint64_t start = Core::Time::Now().Ticks();
+
+                for (const Recording::Frame& frame : _recording.Frames()) {
+                    while ((_scanning == true) && (((Core::Time::Now().Ticks() - start) / Core::Time::TicksPerMillisecond) < frame.At)) {
+                        SleepMs(1);
+                    }
+                    if (_scanning == false) {
+                        break;
+                    }
+                    ::send(_descriptor, frame.Event.data(), frame.Event.size(), 0);
+                }
+            });
+        }
+        void Stop()
+        {
+            _scanning = false;
+            if (_replay.joinable() == true) {
+                _replay.join();
+            }
+        }
+
+    private:
+        const int _descriptor;
+        const Recording& _recording;
+        std::atomic<bool> _scanning;
+        std::atomic<uint32_t> _commands;
+        std::thread _replay;
+        std::thread _thread;
+    };
+
+    class Scanner : public Bluetooth::HCISocket {
+    public:
+        Scanner() = delete;
+        Scanner(const Scanner&) = delete;
+        Scanner& operator=(const Scanner&) = delete;
+
+        Scanner(const SOCKET descriptor)
+            : Bluetooth::HCISocket(descriptor)
+            , _batches(0)
+            , _reports()
+        {
+            Batched(true);
+            Open(0);
+        }
+        ~Scanner() override
+        {
+            Close(Core::infinite);
+        }
+
+    public:
+        uint32_t Batches() const
+        {
+            return (_batches);
+        }
+        // How often each address (its least significant byte) was reported.
+        uint32_t Reported(const uint8_t address) const
+        {
+            uint32_t result = 0;
+            for (const Advertisement& entry : _reports) {
+                if (entry.Source().Data()->b[0] == address) {
+                    result++;
+                }
+            }
+            return (result);
+        }
+        const std::vector<Advertisement>& Reports() const
+        {
+            return (_reports);
+        }
+
+    private:
+        void Discovered(const std::vector<Advertisement>& batch) override
+        {
+            _batches++;
+            _reports.insert(_reports.end(), batch.begin(), batch.end());
+        }
+
+    private:
+        uint32_t _batches;
+        std::vector<Advertisement> _reports;
+    };
+
+    // Flags, a complete name and the Environmental Sensing service.
+    static const std::vector<uint8_t> Thermometer({ 0x02, 0x01, 0x06, 0x07, 0x09, 'T', 'h', 'e', 'r', 'm', 'o', 0x03, 0x03, 0x1A, 0x18 });
+    // Flags and manufacturer data of company 0x004C, an iBeacon frame (type 0x02, length 0x15) with a counter.
+    static std::vector<uint8_t> Beacon(const uint8_t counter)
+    {
+        return (std::vector<uint8_t>({ 0x02, 0x01, 0x06, 0x07, 0xFF, 0x4C, 0x00, 0x02, 0x15, 0xAA, counter }));
+    }
+
+    static constexpr uint8_t ThermometerAddress = 0x11;
+    static constexpr uint8_t BeaconAddress = 0x22;
+    static constexpr uint8_t WalkerAddress = 0x33;
+    static constexpr uint8_t ADV_IND = 0x00;
+    static constexpr uint8_t ADV_NONCONN_IND = 0x03;
+    static constexpr uint8_t SCAN_RSP = 0x04;
+
+    // A second of a busy environment: a thermometer advertising every 20ms and answering scan requests,
+    // a beacon every 30ms that changes its payload once, and someone walking towards the receiver.
+    static void Busy(Recording& recording)
+    {
+        recording.Repeat(0, 900, 20, ADV_IND, ThermometerAddress, Thermometer, -60, -2);
+        recording.Repeat(10, 900, 20, SCAN_RSP, ThermometerAddress, { 0x05, 0xFF, 0x59, 0x00, 0x01, 0x02 }, -61, 1);
+        recording.Repeat(5, 400, 30, ADV_NONCONN_IND, BeaconAddress, Beacon(1), -70, 1);
+        recording.Repeat(400, 900, 30, ADV_NONCONN_IND, BeaconAddress, Beacon(2), -70, 1);
+        for (uint32_t at = 0; at < 900; at += 25) {
+            recording.Add(at, ADV_NONCONN_IND, WalkerAddress, { 0x02, 0x01, 0x04 }, static_cast<int8_t>(-90 + (at / 25)));
+        }
+    }
+
+    static uint32_t Replay(const Recording& recording, const std::function<void(Bluetooth::HCISocket::Advertisements&)>& configure, Scanner*& result)
+    {
+        int descriptors[2];
+        EXPECT_EQ(::socketpair(AF_UNIX, SOCK_SEQPACKET, 0, descriptors), 0);
+
+        Controller controller(descriptors[1], recording);
+        result = new Scanner(descriptors[0]);
+
+        result->Scanned().Configure(Bluetooth::HCISocket::Advertisements::TIME_TO_LIVE, 100, Bluetooth::HCISocket::Advertisements::THRESHOLD);
+        configure(result->Scanned());
+        result->Scan(1, false, false);
+
+        uint32_t commands = controller.Commands();
+        result->Close(Core::infinite);
+
+        return (commands);
+    }
+
+    TEST(Bluetooth_HCIScan, RepeatedReportsCollapse)
+    {
+        Recording recording;
+        Scanner* scanner = nullptr;
+
+        Busy(recording);
+        // Scan parameters, enable and disable.
+        EXPECT_EQ(Replay(recording, [](Bluetooth::HCISocket::Advertisements&) {}, scanner), 3u);
+
+        // Over 90 reports of the thermometer, its name and scan response only show up once.
+        EXPECT_EQ(scanner->Reported(ThermometerAddress), 1u);
+        // The payload changed once.
+        EXPECT_EQ(scanner->Reported(BeaconAddress), 2u);
+        // 36 dB closer over the second, but at least a threshold apart every time.
+        EXPECT_GE(scanner->Reported(WalkerAddress), 2u);
+        EXPECT_LE(scanner->Reported(WalkerAddress), 7u);
+
+        // Delivered every interval at most, not per report.
+        EXPECT_LE(scanner->Batches(), 11u);
+        EXPECT_EQ(scanner->Scanned().Count(), 3u);
+
+        for (const Bluetooth::HCISocket::Advertisement& entry : scanner->Reports()) {
+            if (entry.Source().Data()->b[0] == ThermometerAddress) {
+                string name;
+                EXPECT_EQ(entry.Name(name), 0x09);
+                EXPECT_EQ(name, _T("Thermo"));
+                EXPECT_EQ(entry.Type(), ADV_IND);
+                EXPECT_EQ(entry.ResponseLength(), 6);
+                EXPECT_GE(entry.RSSI(), -62);
+                EXPECT_LE(entry.RSSI(), -60);
+            }
+        }
+
+        delete scanner;
+    }
+
+    TEST(Bluetooth_HCIScan, FilterOnService)
+    {
+        Recording recording;
+        Scanner* scanner = nullptr;
+
+        Busy(recording);
+        Replay(recording, [](Bluetooth::HCISocket::Advertisements& advertisements) { advertisements.Filter(Bluetooth::UUID(0x181A)); }, scanner);
+
+        EXPECT_EQ(scanner->Reported(ThermometerAddress), 1u);
+        EXPECT_EQ(scanner->Reports().size(), 1u);
+
+        delete scanner;
+    }
+
+    TEST(Bluetooth_HCIScan, FilterOnManufacturer)
+    {
+        Recording recording;
+        Scanner* scanner = nullptr;
+        const uint8_t iBeacon[] = { 0x02, 0x15 };
+
+        Busy(recording);
+        Replay(recording, [&](Bluetooth::HCISocket::Advertisements& advertisements) { advertisements.Filter(0x004C, sizeof(iBeacon), iBeacon); }, scanner);
+
+        EXPECT_EQ(scanner->Reported(BeaconAddress), 2u);
+        EXPECT_EQ(scanner->Reports().size(), 2u);
+
+        delete scanner;
+    }
+
+    TEST(Bluetooth_HCIScan, TruncatedReportIsDropped)
+    {
+        Recording recording;
+        Scanner* scanner = nullptr;
+
+        // Claims 20 bytes of payload, but the event ends after 3 of them.
+        recording.Add(0, { HCI_EVENT_PKT, EVT_LE_META_EVENT, 14, EVT_LE_ADVERTISING_REPORT, 1, ADV_IND, 0x00, 0x44, 0x00, 0x00, 0x00, 0x00, 0xC0, 20, 0x02, 0x01, 0x06 });
+        recording.Add(50, ADV_IND, ThermometerAddress, Thermometer, -60);
+        Replay(recording, [](Bluetooth::HCISocket::Advertisements&) {}, scanner);
+
+        EXPECT_EQ(scanner->Reported(0x44), 0u);
+        EXPECT_EQ(scanner->Reported(ThermometerAddress), 1u);
+
+        delete scanner;
+    }
+
+    TEST(Bluetooth_HCIScan, ExpiredAddressesAreForgotten)
+    {
+        Bluetooth::HCISocket::Advertisements advertisements;
+        std::vector<Bluetooth::HCISocket::Advertisement> batch;
+        uint8_t report[sizeof(le_advertising_info) + 3 + 1] = { ADV_IND, 0x00, 0x55, 0x00, 0x00, 0x00, 0x00, 0xC0, 3, 0x02, 0x01, 0x06, static_cast<uint8_t>(-50) };
+        const le_advertising_info& info(*reinterpret_cast<const le_advertising_info*>(report));
+        const uint64_t second = 1000 * Core::Time::TicksPerMillisecond;
+
+        advertisements.Configure(2000, 100, 6);
+
+        EXPECT_TRUE(advertisements.Update(info, 1 * second));
+        EXPECT_FALSE(advertisements.Update(info, 2 * second));
+        advertisements.Collect(2 * second, batch);
+        EXPECT_EQ(batch.size(), 1u);
+        EXPECT_EQ(batch.front().RSSI(), -50);
+
+        // Seen again within the time to live, nothing new.
+        EXPECT_FALSE(advertisements.Update(info, 3 * second));
+        batch.clear();
+        advertisements.Collect(4 * second, batch);
+        EXPECT_TRUE(batch.empty());
+        EXPECT_EQ(advertisements.Count(), 1u);
+
+        // Silent for longer than that, gone, and reported again when it comes back.
+        advertisements.Collect(6 * second, batch);
+        EXPECT_EQ(advertisements.Count(), 0u);
+        EXPECT_TRUE(advertisements.Update(info, 7 * second));
+    }
+
+} // Tests
+} // WPEFramework
@@ -0,0 +1,88 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2020 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+#include <core/core.h>
+
+#include <thread>
+
+namespace WPEFramework {
+namespace Tests {
+
+    TEST(Core_AdaptiveEvent, SetAndReset)
+    {
+        Core::AdaptiveEvent event(true, 0);
+
+        EXPECT_TRUE(event.IsSet());
+        EXPECT_EQ(event.Lock(0), Core::ERROR_NONE);
+        // Manual reset, so it stays set.
+        EXPECT_EQ(event.Lock(Core::infinite), Core::ERROR_NONE);
+
+        event.ResetEvent();
+        EXPECT_FALSE(event.IsSet());
+        EXPECT_EQ(event.Lock(0), Core::ERROR_TIMEDOUT);
+    }
+
+    TEST(Core_AdaptiveEvent, TimesOut)
+    {
+        Core::AdaptiveEvent event(false, 100);
+
+        const uint64_t start = Core::Time::Now().Ticks();
+        EXPECT_EQ(event.Lock(50), Core::ERROR_TIMEDOUT);
+        EXPECT_GE(Core::Time::Now().Ticks() - start, 50u * Core::Time::TicksPerMillisecond);
+    }
+
+    TEST(Core_AdaptiveEvent, WakesAllParkedWaiters)
+    {
+        Core::AdaptiveEvent event(false, 0);
+        std::atomic<uint32_t> woken(0);
+        std::vector<std::thread> waiters;
+
+        for (uint8_t index = 0; index < 4; index++) {
+            waiters.emplace_back([&]() {
+                if (event.Lock(5000) == Core::ERROR_NONE) {
+                    woken++;
+                }
+            });
+        }
+
+        ::SleepMs(50);
+        EXPECT_EQ(woken.load(), 0u);
+
+        event.SetEvent();
+
+        for (std::thread& waiter : waiters) {
+            waiter.join();
+        }
+
+        EXPECT_EQ(woken.load(), 4u);
+    }
+
+    TEST(Core_AdaptiveEvent, SpinCountIsConfigurable)
+    {
+        const uint32_t original = Core::AdaptiveEvent::SpinCount();
+
+        Core::AdaptiveEvent::SpinCount(12345);
+        EXPECT_EQ(Core::AdaptiveEvent::SpinCount(), 12345u);
+
+        Core::AdaptiveEvent::SpinCount(original);
+    }
+
+} // Tests
+} // WPEFramework
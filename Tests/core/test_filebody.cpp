@@ -0,0 +1,163 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2020 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include <core/core.h>
+#include <cryptalgo/cryptalgo.h>
+#include <websocket/websocket.h>
+
+#include <sys/un.h>
+
+namespace WPEFramework {
+namespace Tests {
+
+    static const TCHAR* FileBodyConnector = _T("/tmp/test_filebody");
+    static const TCHAR* FileBodyContent = _T("/tmp/test_filebody.bin");
+
+    class Uploader : public Web::WebLinkType<Core::SocketStream, Web::Response, Web::Request, Core::ProxyPoolType<Web::Response>&> {
+    private:
+        typedef Web::WebLinkType<Core::SocketStream, Web::Response, Web::Request, Core::ProxyPoolType<Web::Response>&> BaseClass;
+
+    public:
+        Uploader() = delete;
+        Uploader(const Uploader&) = delete;
+        Uploader& operator=(const Uploader&) = delete;
+
+        Uploader(Core::ProxyPoolType<Web::Response>& pool, const Core::NodeId& remote)
+            : BaseClass(2, pool, false, remote.AnyInterface(), remote, 1024, 1024)
+            , _sent(false, true)
+        {
+        }
+        ~Uploader() override
+        {
+            Close(Core::infinite);
+        }
+
+    public:
+        bool IsSent(const uint32_t waitTime)
+        {
+            return (_sent.Lock(waitTime) == Core::ERROR_NONE);
+        }
+
+    private:
+        void LinkBody(Core::ProxyType<Web::Response>&) override
+        {
+        }
+        void Received(Core::ProxyType<Web::Response>&) override
+        {
+        }
+        void Send(const Core::ProxyType<Web::Request>&) override
+        {
+            _sent.SetEvent();
+        }
+        void StateChange() override
+        {
+        }
+
+    private:
+        Core::Event _sent;
+    };
+
+    static std::vector<uint8_t> Content(const uint32_t size)
+    {
+        std::vector<uint8_t> result(size);
+
+        for (uint32_t index = 0; index < size; index++) {
+            result[index] = static_cast<uint8_t>((index * 31) ^ (index >> 8));
+        }
+
+        Core::File file{ string(FileBodyContent) };
+        file.Create();
+        file.Write(result.data(), size);
+        file.Close();
+
+        return (result);
+    }
+
+    TEST(Web_FileBody, SentFromFile)
+    {
+        // Quite a bit larger than the send buffer, so it would take many rounds if copied through it.
+        const std::vector<uint8_t> content(Content(256 * 1024 + 13));
+
+        ::unlink(FileBodyConnector);
+        int listener = ::socket(AF_UNIX, SOCK_STREAM, 0);
+        struct sockaddr_un address;
+        ::memset(&address, 0, sizeof(address));
+        address.sun_family = AF_UNIX;
+        ::strncpy(address.sun_path, FileBodyConnector, sizeof(address.sun_path) - 1);
+        ASSERT_EQ(::bind(listener, reinterpret_cast<struct sockaddr*>(&address), sizeof(address)), 0);
+        ASSERT_EQ(::listen(listener, 1), 0);
+
+        Core::ProxyPoolType<Web::Response> pool(1);
+        Uploader uploader(pool, Core::NodeId(FileBodyConnector));
+        ASSERT_EQ(uploader.Open(1000), Core::ERROR_NONE);
+
+        int connection = ::accept(listener, nullptr, nullptr);
+        ASSERT_NE(connection, -1);
+
+        Core::ProxyType<Web::Request> request(Core::ProxyType<Web::Request>::Create());
+        Core::ProxyType<Web::FileBody> body(Core::ProxyType<Web::FileBody>::Create());
+        *body = string(FileBodyContent);
+        request->Verb = Web::Request::HTTP_PUT;
+        request->Path = _T("/upload");
+        request->Body(body);
+        uploader.Submit(Core::ProxyType<Web::Request>(request));
+
+        std::string received;
+        char buffer[4096];
+        size_t headerEnd = std::string::npos;
+
+        while ((headerEnd == std::string::npos) || (received.length() < (headerEnd + 4 + content.size()))) {
+            ssize_t size = ::recv(connection, buffer, sizeof(buffer), 0);
+            ASSERT_GT(size, 0);
+            received.append(buffer, size);
+            headerEnd = received.find("\r\n\r\n");
+        }
+
+        EXPECT_NE(received.find("Content-Length: " + Core::NumberType<uint32_t>(static_cast<uint32_t>(content.size())).Text()), std::string::npos);
+        ASSERT_EQ(received.length(), headerEnd + 4 + content.size());
+        EXPECT_EQ(::memcmp(&received[headerEnd + 4], content.data(), content.size()), 0);
+        EXPECT_TRUE(uploader.IsSent(1000));
+
+        uploader.Close(Core::infinite);
+        ::close(connection);
+        ::close(listener);
+        ::unlink(FileBodyConnector);
+        ::unlink(FileBodyContent);
+    }
+
+    TEST(Web_FileBody, SignedHash)
+    {
+        const std::vector<uint8_t> content(Content(100 * 1000 + 7));
+        Web::SignedFileBodyType<Crypto::SHA256> body;
+        Crypto::SHA256 reference;
+
+        body = string(FileBodyContent);
+        reference.Input(content.data(), 0xFFFF);
+        reference.Input(&content[0xFFFF], static_cast<uint16_t>(content.size() - 0xFFFF));
+
+        EXPECT_EQ(::memcmp(body.SerializedHashValue(), reference.Result(), Crypto::SHA256::Length), 0);
+        EXPECT_FALSE(body.IsOpen());
+
+        ::unlink(FileBodyContent);
+    }
+
+} // Tests
+} // WPEFramework
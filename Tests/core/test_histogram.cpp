@@ -0,0 +1,118 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2020 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include <thread>
+
+#include "Histogram.h"
+
+namespace WPEFramework {
+namespace Tests {
+
+    TEST(Histogram, Buckets)
+    {
+        // Exact below 8us, after that 8 buckets per power of two.
+        for (uint64_t value = 0; value < 8; value++) {
+            EXPECT_EQ(Core::LatencyHistogram::UpperBound(Core::LatencyHistogram::Bucket(value)), value);
+        }
+        EXPECT_EQ(Core::LatencyHistogram::Bucket(8), 8u);
+        EXPECT_EQ(Core::LatencyHistogram::Bucket(15), 15u);
+        EXPECT_EQ(Core::LatencyHistogram::Bucket(16), 16u);
+        EXPECT_EQ(Core::LatencyHistogram::Bucket(17), 16u);
+        EXPECT_EQ(Core::LatencyHistogram::UpperBound(16), 17u);
+
+        // Every value falls in a bucket whose upper bound is within 12.5% above it.
+        for (uint64_t value = 8; value < (1 << 20); value = (value * 9) / 8 + 1) {
+            const uint64_t bound = Core::LatencyHistogram::UpperBound(Core::LatencyHistogram::Bucket(value));
+            EXPECT_GE(bound, value);
+            EXPECT_LE(bound - value, value / 8);
+        }
+
+        EXPECT_EQ(Core::LatencyHistogram::Bucket(~0ull), Core::LatencyHistogram::Buckets - 1);
+    }
+
+    TEST(Histogram, Percentiles)
+    {
+        Core::LatencyHistogram histogram;
+
+        EXPECT_EQ(histogram.Percentile(50), 0u);
+
+        for (uint64_t value = 1; value <= 100; value++) {
+            histogram.Record(value);
+        }
+
+        EXPECT_EQ(histogram.Count(), 100u);
+        EXPECT_EQ(histogram.Sum(), 5050u);
+        EXPECT_EQ(histogram.Max(), 100u);
+        EXPECT_EQ(histogram.Average(), 50u);
+        EXPECT_GE(histogram.Percentile(50), 50u);
+        EXPECT_LE(histogram.Percentile(50), 55u);
+        EXPECT_GE(histogram.Percentile(99), 99u);
+        EXPECT_EQ(histogram.Percentile(100), 100u);
+
+        // The wall clock was set back, count it as no time at all.
+        histogram.Record(200, 100);
+        EXPECT_EQ(histogram.Count(), 101u);
+        EXPECT_EQ(histogram.Occurrences(0), 1u);
+
+        histogram.Reset();
+        EXPECT_EQ(histogram.Count(), 0u);
+        EXPECT_EQ(histogram.Max(), 0u);
+    }
+
+    TEST(Histogram, Statistics)
+    {
+        Core::LatencyStatistics statistics;
+
+        Core::LatencyStatistics::Metric* first = statistics.Find(_T("JSON-RPC"), _T("Controller.1.status"));
+        Core::LatencyStatistics::Metric* second = statistics.Find(_T("COM-RPC"), 0x42, 3);
+
+        ASSERT_NE(first, nullptr);
+        ASSERT_NE(second, nullptr);
+        EXPECT_NE(first, second);
+        EXPECT_EQ(statistics.Find(_T("JSON-RPC"), _T("Controller.1.status")), first);
+        EXPECT_EQ(statistics.Find(_T("COM-RPC"), 0x42, 3), second);
+        EXPECT_EQ(second->Name, _T("0x00000042.3"));
+
+        std::vector<std::thread> threads;
+        for (uint8_t index = 0; index < 4; index++) {
+            threads.emplace_back([&statistics]() {
+                for (uint32_t call = 0; call < 1000; call++) {
+                    statistics.Find(_T("COM-RPC"), 0x100, call % 16)->Execution.Record(call);
+                }
+            });
+        }
+        for (std::thread& thread : threads) {
+            thread.join();
+        }
+
+        uint32_t metrics = 0;
+        uint32_t calls = 0;
+        statistics.Visit([&metrics, &calls](const Core::LatencyStatistics::Metric& metric) {
+            metrics++;
+            calls += metric.Execution.Count();
+        });
+
+        EXPECT_EQ(metrics, 18u);
+        EXPECT_EQ(calls, 4000u);
+    }
+
+} // Tests
+} // WPEFramework
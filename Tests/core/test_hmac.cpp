@@ -0,0 +1,123 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2020 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+#include <core/core.h>
+#include <cryptalgo/cryptalgo.h>
+
+namespace WPEFramework {
+namespace Tests {
+
+    // RFC 4231, HMAC-SHA-256 test cases 1 to 4, 6 and 7 (5 is about truncated output).
+    struct HMACVector {
+        string Key;
+        string Data;
+        const TCHAR* Digest;
+    };
+
+    static const HMACVector& Vector(const uint8_t index)
+    {
+        static const HMACVector vectors[] = {
+            { string(20, '\x0b'), _T("Hi There"),
+                _T("b0344c61d8db38535ca8afceaf0bf12b881dc200c9833da726e9376c2e32cff7") },
+            { _T("Jefe"), _T("what do ya want for nothing?"),
+                _T("5bdcc146bf60754e6a042426089575c75a003f089d2739839dec58b964ec3843") },
+            { string(20, '\xaa'), string(50, '\xdd'),
+                _T("773ea91e36800e46854db8ebd09181a72959098b3ef8c122d9635514ced565fe") },
+            { _T("\x01\x02\x03\x04\x05\x06\x07\x08\x09\x0a\x0b\x0c\x0d\x0e\x0f\x10\x11\x12\x13\x14\x15\x16\x17\x18\x19"), string(50, '\xcd'),
+                _T("82558a389a443c0ea4cc819899f2083a85f0faa3e578f8077a2e3ff46729665b") },
+            { string(131, '\xaa'), _T("Test Using Larger Than Block-Size Key - Hash Key First"),
+                _T("60e431591ee0b67f0d8a26aacbf5b77f8e0bc6213728c5140546040f0ee37f54") },
+            { string(131, '\xaa'), _T("This is a test using a larger than block-size key and a larger than block-size data. The key needs to be hashed before being used by the HMAC algorithm."),
+                _T("9b09ffa71b942fcb27635fbcd5b0e944bfdc63644f0713938a7f51535c3a35e2") }
+        };
+
+        return (vectors[index]);
+    }
+
+    static constexpr uint8_t Vectors = 6;
+
+    static string Calculate(Crypto::SHA256HMAC& hmac, const string& data)
+    {
+        string result;
+
+        hmac.Input(reinterpret_cast<const uint8_t*>(data.c_str()), static_cast<uint16_t>(data.length()));
+        Core::ToHexString(hmac.Result(), Crypto::SHA256HMAC::Length, result);
+
+        return (result);
+    }
+
+    TEST(Crypto_HMAC, RFC4231)
+    {
+        for (uint8_t index = 0; index < Vectors; index++) {
+            const HMACVector& vector(Vector(index));
+            Crypto::SHA256HMAC hmac(vector.Key);
+
+            EXPECT_EQ(Calculate(hmac, vector.Data), vector.Digest) << "vector " << static_cast<int>(index);
+
+            // Asking again does not change the outcome.
+            string again;
+            Core::ToHexString(hmac.Result(), Crypto::SHA256HMAC::Length, again);
+            EXPECT_EQ(again, vector.Digest);
+        }
+    }
+
+    TEST(Crypto_HMAC, RepeatedCalculations)
+    {
+        // Every calculation restarts from the pre-keyed states, nothing of the previous one may linger.
+        Crypto::SHA256HMAC shortKey(Vector(1).Key);
+        Crypto::SHA256HMAC longKey(Vector(4).Key);
+
+        for (uint8_t round = 0; round < 3; round++) {
+            EXPECT_EQ(Calculate(shortKey, Vector(1).Data), Vector(1).Digest);
+            shortKey.Reset();
+
+            EXPECT_EQ(Calculate(longKey, Vector(4).Data), Vector(4).Digest);
+            longKey.Reset();
+            EXPECT_EQ(Calculate(longKey, Vector(5).Data), Vector(5).Digest);
+            longKey.Reset();
+        }
+
+        // Data fed in pieces gives the same result as all at once.
+        const string& data(Vector(5).Data);
+        longKey.Input(reinterpret_cast<const uint8_t*>(data.c_str()), 100);
+        EXPECT_EQ(Calculate(longKey, data.substr(100)), Vector(5).Digest);
+    }
+
+    TEST(Crypto_HMAC, CopiesAreIndependent)
+    {
+        const Crypto::SHA256HMAC keyed(Vector(2).Key);
+
+        // The way the JSON Web Token uses it: one keyed instance, a copy per calculation.
+        Crypto::SHA256HMAC first(keyed);
+        Crypto::SHA256HMAC second(keyed);
+
+        second.Input(reinterpret_cast<const uint8_t*>("garbage"), 7);
+        EXPECT_EQ(Calculate(first, Vector(2).Data), Vector(2).Digest);
+
+        second.Reset();
+        EXPECT_EQ(Calculate(second, Vector(2).Data), Vector(2).Digest);
+
+        // An assigned one starts where the original is, not where it was itself.
+        first = keyed;
+        EXPECT_EQ(Calculate(first, Vector(2).Data), Vector(2).Digest);
+    }
+
+} // Tests
+} // WPEFramework
@@ -0,0 +1,313 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2020 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+#include <core/core.h>
+
+#include <thread>
+
+namespace WPEFramework {
+namespace Tests {
+
+    static const string RingName = _T("/tmp/test_ipcring");
+
+    TEST(Core_IPCRing, WriteReadWrapsAround)
+    {
+        Core::IPCRing producer(RingName, 4096);
+        ASSERT_TRUE(producer.IsValid());
+        EXPECT_FALSE(producer.IsAttached());
+
+        Core::IPCRing consumer(RingName);
+        ASSERT_TRUE(consumer.IsValid());
+        EXPECT_TRUE(producer.IsAttached());
+        EXPECT_EQ(consumer.Size(), producer.Size());
+
+        std::vector<uint8_t> data(3000);
+        std::vector<uint8_t> result(data.size());
+
+        for (uint8_t round = 0; round < 4; round++) {
+            for (uint32_t index = 0; index < data.size(); index++) {
+                data[index] = static_cast<uint8_t>(index + round);
+            }
+
+            EXPECT_EQ(producer.Write(data.data(), static_cast<uint32_t>(data.size()), 0), Core::ERROR_NONE);
+            EXPECT_EQ(consumer.Used(), data.size());
+
+            uint32_t received = 0;
+            uint32_t length;
+            while ((length = consumer.Read(&result[received], static_cast<uint32_t>(result.size() - received), 0)) > 0) {
+                received += length;
+            }
+
+            EXPECT_EQ(received, data.size());
+            EXPECT_EQ(result, data);
+        }
+    }
+
+    TEST(Core_IPCRing, FullRingTimesOut)
+    {
+        Core::IPCRing producer(RingName, 4096);
+        Core::IPCRing consumer(RingName);
+        std::vector<uint8_t> data(producer.Size() + 1, 0x55);
+
+        EXPECT_EQ(producer.Write(data.data(), static_cast<uint32_t>(data.size()), 50), Core::ERROR_TIMEDOUT);
+        EXPECT_EQ(consumer.Used(), producer.Size());
+    }
+
+    TEST(Core_IPCRing, SleepersAreWokenUp)
+    {
+        Core::IPCRing producer(RingName, 4096);
+        Core::IPCRing consumer(RingName);
+        std::vector<uint8_t> data(producer.Size() * 4);
+
+        for (uint32_t index = 0; index < data.size(); index++) {
+            data[index] = static_cast<uint8_t>(index * 7);
+        }
+
+        // The reader starts on an empty ring and the writer has to wait for room three times.
+        std::vector<uint8_t> result;
+        std::thread reader([&]() {
+            uint8_t buffer[1000];
+            while (result.size() < data.size()) {
+                const uint32_t length = consumer.Read(buffer, sizeof(buffer), 1000);
+                if (length == 0) {
+                    break;
+                }
+                result.insert(result.end(), buffer, buffer + length);
+            }
+        });
+
+        EXPECT_EQ(producer.Write(data.data(), static_cast<uint32_t>(data.size()), 1000), Core::ERROR_NONE);
+
+        reader.join();
+
+        EXPECT_EQ(result, data);
+    }
+
+    TEST(Core_IPCRing, CloseWakesTheReader)
+    {
+        Core::IPCRing producer(RingName, 4096);
+        Core::IPCRing consumer(RingName);
+        uint32_t length = ~0;
+
+        std::thread reader([&]() {
+            uint8_t buffer[16];
+            length = consumer.Read(buffer, sizeof(buffer), Core::infinite);
+        });
+
+        ::SleepMs(50);
+        producer.Close();
+        reader.join();
+
+        EXPECT_EQ(length, 0u);
+        EXPECT_TRUE(consumer.IsClosed());
+
+        const uint8_t data[] = { 1, 2, 3 };
+        EXPECT_EQ(producer.Write(data, sizeof(data), 0), Core::ERROR_CONNECTION_CLOSED);
+    }
+
+    typedef Core::IPCMessageType<10, Core::IPC::ScalarType<uint32_t>, Core::IPC::ScalarType<uint32_t>> Increment;
+
+    class IncrementHandler : public Core::IIPCServer {
+    public:
+        IncrementHandler(const IncrementHandler&) = delete;
+        IncrementHandler& operator=(const IncrementHandler&) = delete;
+
+        IncrementHandler()
+        {
+        }
+        ~IncrementHandler() override
+        {
+        }
+
+    public:
+        void Procedure(Core::IPCChannel& channel, Core::ProxyType<Core::IIPC>& data) override
+        {
+            Core::ProxyType<Increment> message(data);
+
+            message->Response() = message->Parameters().Value() + 1;
+
+            channel.ReportResponse(data);
+        }
+    };
+
+    TEST(Core_IPCRing, ChannelMovesToTheShortcut)
+    {
+        const Core::NodeId node(_T("/tmp/test_ipcring_channel"));
+        Core::ProxyType<Core::IIPCServer> handler(Core::ProxyType<IncrementHandler>::Create());
+
+        Core::IPCChannelServerType<Core::Void, true> server(node, 1024);
+        server.CreateFactory<Increment>(1);
+        server.Register(Increment::Id(), handler);
+        ASSERT_EQ(server.Open(1000), Core::ERROR_NONE);
+
+        Core::ProxyType<Core::IPCChannelClientType<Core::Void, false, true>> client(Core::ProxyType<Core::IPCChannelClientType<Core::Void, false, true>>::Create(node, 1024));
+        client->CreateFactory<Increment>(1);
+        ASSERT_EQ(client->Source().Open(1000), Core::ERROR_NONE);
+
+        Core::ProxyType<Increment> message(Core::ProxyType<Increment>::Create());
+
+        // Plain socket first.
+        message->Parameters() = 1;
+        EXPECT_EQ(client->Invoke(message, 1000), Core::ERROR_NONE);
+        EXPECT_EQ(message->Response().Value(), 2u);
+
+        auto remote(server[0]);
+        ASSERT_TRUE(remote.IsValid());
+
+        const string name(RingName + _T(".channel"));
+        EXPECT_EQ(remote->CreateShortcut(name, 4096), Core::ERROR_NONE);
+        EXPECT_EQ(remote->CreateShortcut(name, 4096), Core::ERROR_ALREADY_CONNECTED);
+
+        // Nobody attached yet, so the server still answers over the socket.
+        EXPECT_FALSE(remote->IsShortcut());
+        message->Parameters() = 2;
+        EXPECT_EQ(client->Invoke(message, 1000), Core::ERROR_NONE);
+        EXPECT_EQ(message->Response().Value(), 3u);
+
+        EXPECT_EQ(client->OpenShortcut(name), Core::ERROR_NONE);
+        EXPECT_TRUE(client->IsShortcut());
+        EXPECT_TRUE(remote->IsShortcut());
+
+        for (uint32_t index = 0; index < 100; index++) {
+            message->Parameters() = index;
+            ASSERT_EQ(client->Invoke(message, 1000), Core::ERROR_NONE);
+            EXPECT_EQ(message->Response().Value(), index + 1);
+        }
+
+        // The rings go down with the socket.
+        EXPECT_EQ(client->Close(1000), Core::ERROR_NONE);
+        EXPECT_FALSE(client->IsShortcut());
+
+        remote.Release();
+        client->DestroyFactory<Increment>();
+        client.Release();
+
+        server.Cleanup();
+        server.Close(1000);
+        server.Unregister(Increment::Id());
+        server.DestroyFactory<Increment>();
+    }
+
+    struct Block {
+        uint8_t Data[1500];
+    };
+
+    typedef Core::IPCMessageType<11, Block, Core::IPC::ScalarType<uint32_t>> Bulk;
+
+    // Holds up the thread reading the ring, till it is released.
+    class StallingHandler : public Core::IIPCServer {
+    public:
+        StallingHandler(const StallingHandler&) = delete;
+        StallingHandler& operator=(const StallingHandler&) = delete;
+
+        StallingHandler()
+            : _release(false, true)
+        {
+        }
+        ~StallingHandler() override
+        {
+        }
+
+    public:
+        void Release()
+        {
+            _release.SetEvent();
+        }
+        void Procedure(Core::IPCChannel& channel, Core::ProxyType<Core::IIPC>& data) override
+        {
+            _release.Lock(Core::infinite);
+
+            Core::ProxyType<Bulk> message(data);
+            message->Response() = message->Parameters().Data[0];
+
+            channel.ReportResponse(data);
+        }
+
+    private:
+        Core::Event _release;
+    };
+
+    TEST(Core_IPCRing, FullShortcutFailsTheInvoke)
+    {
+        const Core::NodeId node(_T("/tmp/test_ipcring_full"));
+        Core::ProxyType<StallingHandler> stalling(Core::ProxyType<StallingHandler>::Create());
+        Core::ProxyType<Core::IIPCServer> handler(stalling);
+
+        Core::IPCChannelServerType<Core::Void, true> server(node, 1024);
+        server.CreateFactory<Bulk>(4);
+        server.Register(Bulk::Id(), handler);
+        ASSERT_EQ(server.Open(1000), Core::ERROR_NONE);
+
+        Core::ProxyType<Core::IPCChannelClientType<Core::Void, false, true>> client(Core::ProxyType<Core::IPCChannelClientType<Core::Void, false, true>>::Create(node, 1024));
+        client->CreateFactory<Bulk>(4);
+        ASSERT_EQ(client->Source().Open(1000), Core::ERROR_NONE);
+
+        // Make sure the server knows the client before it creates the rings.
+        auto remote(server[0]);
+        for (uint8_t retries = 0; (remote.IsValid() == false) && (retries < 100); retries++) {
+            ::SleepMs(10);
+            remote = server[0];
+        }
+        ASSERT_TRUE(remote.IsValid());
+
+        const string name(RingName + _T(".full"));
+        ASSERT_EQ(remote->CreateShortcut(name, 4096), Core::ERROR_NONE);
+        ASSERT_EQ(client->OpenShortcut(name), Core::ERROR_NONE);
+
+        Core::ProxyType<Bulk> message(Core::ProxyType<Bulk>::Create());
+        ::memset(message->Parameters().Data, 1, sizeof(Block::Data));
+
+        // The first request stalls the reader, the ones after it fill the ring, till there is no
+        // room for the next one. That one has to give up within its own wait time.
+        uint32_t result = Core::ERROR_NONE;
+        uint8_t attempts = 0;
+        Core::Time start;
+
+        do {
+            start = Core::Time::Now();
+            result = client->Invoke(message, 100);
+            attempts++;
+        } while ((result == Core::ERROR_TIMEDOUT) && (client->IsShortcut() == true) && (attempts < 10));
+
+        const uint64_t elapsed = (Core::Time::Now().Ticks() - start.Ticks()) / Core::Time::TicksPerMillisecond;
+
+        EXPECT_EQ(result, Core::ERROR_TIMEDOUT);
+        EXPECT_LT(elapsed, 1000u);
+        EXPECT_LT(attempts, 10);
+
+        // The frame might be cut in half, so that ring can not be used anymore.
+        EXPECT_FALSE(client->IsShortcut());
+
+        stalling->Release();
+
+        EXPECT_EQ(client->Close(1000), Core::ERROR_NONE);
+
+        remote.Release();
+        client->DestroyFactory<Bulk>();
+        client.Release();
+
+        server.Cleanup();
+        server.Close(1000);
+        server.Unregister(Bulk::Id());
+        server.DestroyFactory<Bulk>();
+    }
+
+} // Tests
+} // WPEFramework
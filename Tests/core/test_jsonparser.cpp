@@ -768,6 +768,209 @@ namespace Tests {
         ExecutePrimitiveJsonTest<Core::JSON::EnumType<JSONTestEnum>>(data, false, nullptr);
     }
 
+    static string Tokens(Core::JSON::Reader& reader, const string& document, const uint32_t chunk)
+    {
+        std::stringstream result;
+
+        for (uint32_t position = 0; position < document.length(); position += chunk) {
+            reader.Feed(&(document[position]), std::min(chunk, static_cast<uint32_t>(document.length() - position)));
+
+            Core::JSON::Reader::token token;
+            while (((token = reader.Next()) != Core::JSON::Reader::NONE) && (token != Core::JSON::Reader::INVALID)) {
+                result << static_cast<int>(token) << ':' << reader.Depth() << ':' << reader.Text() << ' ';
+            }
+        }
+
+        reader.Close();
+
+        Core::JSON::Reader::token token;
+        while ((token = reader.Next()) != Core::JSON::Reader::NONE) {
+            result << static_cast<int>(token) << ':' << reader.Depth() << ':' << reader.Text() << ' ';
+            if (token == Core::JSON::Reader::INVALID) {
+                break;
+            }
+        }
+
+        return (result.str());
+    }
+
+    TEST(JSONReader, TokensDoNotDependOnChunks)
+    {
+        const string document(_T("{ \"name\": \"a \\\"quoted\\\" \\\\ \\u00e9\", \"list\": [1, -2.5e3, 0x1F, true, false, null, {}, []],\n \"nested\": {\"deeper\": [{\"x\": \"}\"}]} }"));
+
+        Core::JSON::Reader reader;
+        const string expected(Tokens(reader, document, static_cast<uint32_t>(document.length())));
+
+        EXPECT_TRUE(reader.IsComplete());
+        EXPECT_FALSE(reader.Failure().IsSet());
+        EXPECT_EQ(reader.Position(), document.length());
+        EXPECT_NE(expected.find(_T(":1:a \"quoted\" \\ \\u00e9 ")), string::npos);
+        EXPECT_NE(expected.find(_T(":2:-2.5e3 ")), string::npos);
+        EXPECT_NE(expected.find(_T(":2:0x1F ")), string::npos);
+
+        for (uint32_t chunk = 1; chunk < 8; chunk++) {
+            reader.Reset();
+            EXPECT_EQ(Tokens(reader, document, chunk), expected);
+        }
+    }
+
+    TEST(JSONReader, InvalidDocuments)
+    {
+        const TCHAR* documents[] = {
+            _T("{\"a\" 1}"),
+            _T("[1, 2}"),
+            _T("{\"a\": tru}"),
+            _T("[\"\\x\"]"),
+            _T("[1, 2"),
+            _T("{} {}")
+        };
+
+        Core::JSON::Reader reader(8);
+
+        for (const TCHAR* document : documents) {
+            reader.Reset();
+            EXPECT_NE(Tokens(reader, document, 3).find(_T("12:")), string::npos) << document;
+            EXPECT_TRUE(reader.Failure().IsSet());
+        }
+
+        reader.Reset();
+        EXPECT_NE(Tokens(reader, _T("[[[[[[[[[1]]]]]]]]]"), 4).find(_T("12:")), string::npos);
+    }
+
+    class Programme : public Core::JSON::Container {
+    public:
+        Programme(const Programme&) = delete;
+        Programme& operator=(const Programme&) = delete;
+
+        Programme()
+            : Core::JSON::Container()
+            , Id(0)
+            , Title()
+            , Extra()
+        {
+            Add(_T("id"), &Id);
+            Add(_T("title"), &Title);
+            Add(_T("extra"), &Extra);
+        }
+        ~Programme() override
+        {
+        }
+
+    public:
+        Core::JSON::DecUInt32 Id;
+        Core::JSON::String Title;
+        Core::JSON::Variant Extra;
+    };
+
+    TEST(JSONReader, LoadElementsFromAStream)
+    {
+        // Bigger than what fits in the 16 bit lengths of the elements.
+        const string title(70000, 'x');
+        string document(_T("{\"version\": 2, \"programmes\": ["));
+
+        for (uint32_t index = 0; index < 100; index++) {
+            document += (index == 0 ? _T("") : _T(", "));
+            document += _T("{\"id\": ") + Core::NumberType<uint32_t>(index).Text() + _T(", \"title\": \"") + (index == 42 ? title : _T("t")) + _T("\", \"extra\": {\"tags\": [\"a\\\"]\"]}}");
+        }
+        document += _T("], \"count\": 100}");
+
+        Core::JSON::Reader reader;
+        Programme programme;
+        Core::JSON::DecUInt32 count;
+        uint32_t loaded = 0;
+        bool inList = false;
+
+        for (uint32_t position = 0; position < document.length(); position += 1000) {
+            reader.Feed(&(document[position]), std::min(1000u, static_cast<uint32_t>(document.length() - position)));
+
+            Core::JSON::Reader::token token;
+            while ((token = reader.Next()) != Core::JSON::Reader::NONE) {
+                ASSERT_NE(token, Core::JSON::Reader::INVALID) << reader.Failure().Value().Message();
+
+                if ((token == Core::JSON::Reader::NAME) && (reader.Text() == _T("version"))) {
+                    reader.Skip();
+                } else if ((token == Core::JSON::Reader::NAME) && (reader.Text() == _T("count"))) {
+                    reader.Load(count);
+                } else if ((token == Core::JSON::Reader::BEGIN_ARRAY) && (reader.Depth() == 2)) {
+                    inList = true;
+                    reader.Load(programme);
+                } else if ((token == Core::JSON::Reader::ELEMENT) && (inList == true)) {
+                    EXPECT_EQ(programme.Id.Value(), loaded);
+                    EXPECT_EQ(programme.Title.Value().length(), (loaded == 42 ? title.length() : 1));
+                    EXPECT_EQ(programme.Extra.Content(), Core::JSON::Variant::type::OBJECT);
+                    EXPECT_EQ(programme.Extra.Object()[_T("tags")].Array()[0].String(), _T("a\"]"));
+                    loaded++;
+                    reader.Load(programme);
+                } else if (token == Core::JSON::Reader::END_ARRAY) {
+                    inList = false;
+                }
+            }
+        }
+
+        EXPECT_TRUE(reader.IsComplete());
+        EXPECT_EQ(loaded, 100u);
+        EXPECT_EQ(count.Value(), 100u);
+    }
+
+    template <typename STORAGE>
+    static void ArrayRoundTrip()
+    {
+        Core::JSON::ArrayType<Core::JSON::DecUInt32, STORAGE> array;
+        array.Reserve(1000);
+
+        for (uint32_t index = 0; index < 1000; index++) {
+            array.Add() = index * 3;
+        }
+
+        string text;
+        EXPECT_TRUE(array.ToString(text));
+
+        Core::JSON::ArrayType<Core::JSON::DecUInt32, STORAGE> result;
+        EXPECT_TRUE(result.FromString(text));
+        ASSERT_EQ(result.Length(), 1000u);
+        EXPECT_EQ(result[0].Value(), 0u);
+        EXPECT_EQ(result[999].Value(), 2997u);
+
+        uint32_t count = 0;
+        auto iterator = result.Elements();
+        while (iterator.Next() == true) {
+            EXPECT_EQ(iterator.Current().Value(), count * 3);
+            count++;
+        }
+        EXPECT_EQ(count, 1000u);
+    }
+
+    TEST(JSONParser, ArrayStorage)
+    {
+        ArrayRoundTrip<std::list<Core::JSON::DecUInt32>>();
+        ArrayRoundTrip<std::deque<Core::JSON::DecUInt32>>();
+        ArrayRoundTrip<std::vector<Core::JSON::DecUInt32>>();
+
+        // A deque does not move what was added before.
+        Core::JSON::ArrayType<Core::JSON::String, std::deque<Core::JSON::String>> array;
+        Core::JSON::String& first(array.Add());
+        first = _T("first");
+        for (uint32_t index = 0; index < 1000; index++) {
+            array.Add() = _T("next");
+        }
+        EXPECT_EQ(&first, &array[0]);
+        EXPECT_EQ(first.Value(), _T("first"));
+    }
+
+    TEST(JSONParser, VariantKeepsTheTextOfItsScope)
+    {
+        const string title(70000, 'y');
+        const string document(_T("{\"a\":{\"b\":\"x\\\"}\",\"c\":[1,{\"d\":\"") + title + _T("\"}]},\"e\":1}"));
+
+        JsonObject object;
+        ASSERT_TRUE(object.FromString(document));
+
+        EXPECT_EQ(object[_T("a")].Content(), Core::JSON::Variant::type::OBJECT);
+        EXPECT_EQ(object[_T("a")].Object()[_T("b")].String(), _T("x\"}"));
+        EXPECT_EQ(object[_T("a")].Object()[_T("c")].Array()[1].Object()[_T("d")].String(), title);
+        EXPECT_EQ(object[_T("e")].Number(), 1);
+    }
+
 } // Tests
 
 ENUM_CONVERSION_BEGIN(Tests::JSONTestEnum){ WPEFramework::Tests::JSONTestEnum::ONE, _TXT("one") },
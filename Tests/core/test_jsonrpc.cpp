@@ -0,0 +1,294 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2020 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include "JSONRPC.h"
+
+namespace WPEFramework {
+namespace Tests {
+
+    class Point : public Core::JSON::Container {
+    public:
+        Point(const Point&) = delete;
+        Point& operator=(const Point&) = delete;
+
+        Point()
+            : Core::JSON::Container()
+            , X(0)
+            , Y(0)
+        {
+            Add(_T("x"), &X);
+            Add(_T("y"), &Y);
+        }
+        ~Point() override
+        {
+        }
+
+    public:
+        Core::JSON::DecSInt32 X;
+        Core::JSON::DecSInt32 Y;
+    };
+
+    TEST(JSONRPC, Designation)
+    {
+        const string designator(_T("Plugin.2.method@index.1"));
+        const Core::JSONRPC::Message::Designation designation(designator);
+
+        EXPECT_EQ(designation.Callsign().Text(), _T("Plugin"));
+        EXPECT_EQ(designation.FullCallsign().Text(), _T("Plugin.2"));
+        EXPECT_EQ(designation.Method().Text(), _T("method"));
+        EXPECT_EQ(designation.FullMethod().Text(), _T("method@index.1"));
+        EXPECT_EQ(designation.VersionedFullMethod().Text(), _T("2.method@index.1"));
+        EXPECT_EQ(designation.Index().Text(), _T("index.1"));
+        EXPECT_EQ(designation.Version(), 2);
+
+        EXPECT_EQ(Core::JSONRPC::Message::Callsign(_T("Plugin2.method")), _T("Plugin2"));
+        EXPECT_EQ(Core::JSONRPC::Message::Version(_T("Plugin2.method")), static_cast<uint8_t>(~0));
+        EXPECT_EQ(Core::JSONRPC::Message::Version(_T("Plugin.method")), static_cast<uint8_t>(~0));
+        EXPECT_EQ(Core::JSONRPC::Message::Version(_T("1.method")), 1);
+        EXPECT_EQ(Core::JSONRPC::Message::Callsign(_T("1.method")), _T(""));
+        EXPECT_EQ(Core::JSONRPC::Message::Method(_T("method")), _T("method"));
+        EXPECT_EQ(Core::JSONRPC::Message::FullCallsign(_T("method")), _T(""));
+        EXPECT_EQ(Core::JSONRPC::Message::Index(_T("method")), _T(""));
+    }
+
+    TEST(JSONRPC, TypedInvoke)
+    {
+        Core::JSONRPC::Handler handler([](const uint32_t, const string&, const string&) {}, { 1 });
+
+        handler.Register<Point, Point>(_T("swap"), [](const Point& inbound, Point& outbound) -> uint32_t {
+            outbound.X = inbound.Y.Value();
+            outbound.Y = inbound.X.Value();
+            return (Core::ERROR_NONE);
+        });
+
+        const string designator(_T("Plugin.1.swap"));
+        const Core::JSONRPC::Message::Designation designation(designator);
+        string response;
+
+        EXPECT_EQ(handler.Invoke(Core::JSONRPC::Connection(1, 1), designation, _T("{\"x\":1,\"y\":2}"), response), Core::ERROR_NONE);
+        EXPECT_EQ(response, _T("{\"x\":2,\"y\":1}"));
+
+        Core::JSONRPC::Message message;
+        message.Result = std::move(response);
+        EXPECT_EQ(message.Result.Value(), _T("{\"x\":2,\"y\":1}"));
+
+        const string unknown(_T("Plugin.1.unknown"));
+        EXPECT_EQ(handler.Invoke(Core::JSONRPC::Connection(1, 1), Core::JSONRPC::Message::Designation(unknown), _T("{}"), response), Core::ERROR_UNKNOWN_KEY);
+    }
+
+    TEST(JSONRPC, MessagePackTranscode)
+    {
+        const string text(_T("{\"a\":[1,-1,300,-200,70000,-5000000000,true,false,null],\"b\":\"t\\\"x\\n\",\"c\":{},\"d\":1.5}"));
+        std::vector<uint8_t> packed;
+        string result;
+
+        EXPECT_TRUE(Core::JSON::IMessagePack::Transcode(text, packed));
+        EXPECT_LT(packed.size(), text.length());
+        EXPECT_EQ(Core::JSON::IMessagePack::Length(packed.data(), static_cast<uint32_t>(packed.size())), packed.size());
+        EXPECT_EQ(Core::JSON::IMessagePack::Length(packed.data(), static_cast<uint32_t>(packed.size() - 1)), 0u);
+        EXPECT_EQ(Core::JSON::IMessagePack::Transcode(packed.data(), static_cast<uint32_t>(packed.size()), result), packed.size());
+        EXPECT_EQ(result, text);
+
+        // Keys that are not strings become strings, their text escaped, so the result is still JSON.
+        const uint8_t keys[] = { 0x83, 0x01, 0xA1, 'a', 0x81, 0xA1, 'a', 0x01, 0xC3, 0x92, 0xA1, '"', 0x02, 0xC0 };
+        EXPECT_EQ(Core::JSON::IMessagePack::Transcode(keys, sizeof(keys), result), sizeof(keys));
+        EXPECT_EQ(result, _T("{\"1\":\"a\",\"{\\\"a\\\":1}\":true,\"[\\\"\\\\\\\"\\\",2]\":null}"));
+
+        Core::JSON::VariantContainer parsed;
+        Core::OptionalType<Core::JSON::Error> error;
+        EXPECT_TRUE(parsed.FromString(result, error));
+        EXPECT_FALSE(error.IsSet());
+        EXPECT_EQ(parsed[_T("1")].String(), _T("a"));
+        EXPECT_TRUE(parsed[_T("{\"a\":1}")].Boolean());
+
+        EXPECT_FALSE(Core::JSON::IMessagePack::Transcode(_T("{\"a\":}"), packed));
+        EXPECT_FALSE(Core::JSON::IMessagePack::Transcode(_T("[1,2"), packed));
+    }
+
+    TEST(JSONRPC, MessagePackMessage)
+    {
+        Core::JSONRPC::Message request;
+        Core::JSONRPC::Message received;
+        std::vector<uint8_t> packed;
+
+        request.Id = 42;
+        request.Designator = _T("Plugin.1.swap");
+        request.Parameters = _T("{\"x\":1,\"y\":[\"two\",3]}");
+
+        request.ToBuffer(packed);
+
+        // Feed it in small chunks, the opaque parameters must survive being split.
+        uint16_t offset = 0;
+        uint32_t index = 0;
+        received.Clear();
+        do {
+            const uint16_t chunk = static_cast<uint16_t>(std::min(static_cast<size_t>(5), packed.size() - index));
+            index += static_cast<Core::JSON::IMessagePack&>(received).Deserialize(&packed[index], chunk, offset);
+        } while ((index < packed.size()) && (offset != 0));
+
+        EXPECT_EQ(offset, 0u);
+        EXPECT_EQ(received.Id.Value(), 42u);
+        EXPECT_EQ(received.Designator.Value(), _T("Plugin.1.swap"));
+        EXPECT_EQ(received.Parameters.Value(), _T("{\"x\":1,\"y\":[\"two\",3]}"));
+    }
+
+    TEST(JSONRPC, MessagePackIntegerBoundaries)
+    {
+        const string text(_T("[-9223372036854775808,-9223372036854775809,18446744073709551615,18446744073709551616]"));
+        std::vector<uint8_t> packed;
+        string result;
+
+        // What does not fit an int64/uint64 must become a float64, not wrap around.
+        EXPECT_TRUE(Core::JSON::IMessagePack::Transcode(text, packed));
+        ASSERT_EQ(packed.size(), 1u + (4 * 9));
+        EXPECT_EQ(packed[1], 0xD3);
+        EXPECT_EQ(packed[10], 0xCB);
+        EXPECT_EQ(packed[19], 0xCF);
+        EXPECT_EQ(packed[28], 0xCB);
+
+        EXPECT_EQ(Core::JSON::IMessagePack::Transcode(packed.data(), static_cast<uint32_t>(packed.size()), result), packed.size());
+        EXPECT_EQ(result.find(_T("[-9223372036854775808,")), 0u);
+        EXPECT_NE(result.find(_T(",18446744073709551615,")), string::npos);
+    }
+
+    TEST(JSONRPC, MessagePackLargeValues)
+    {
+        Core::JSONRPC::Message request;
+        Core::JSONRPC::Message received;
+        std::vector<uint8_t> packed;
+
+        const string designator(_T("Plugin.1.") + string(70000, 'm'));
+        const string parameters(_T("[\"") + string(100000, 'x') + _T("\",1]"));
+
+        request.Id = 7;
+        request.Designator = designator;
+        request.Parameters = parameters;
+
+        EXPECT_TRUE(request.ToBuffer(packed));
+        EXPECT_GT(packed.size(), 170000u);
+
+        uint16_t offset = 0;
+        uint32_t index = 0;
+        received.Clear();
+        do {
+            const uint16_t chunk = static_cast<uint16_t>(std::min(static_cast<size_t>(1000), packed.size() - index));
+            index += static_cast<Core::JSON::IMessagePack&>(received).Deserialize(&packed[index], chunk, offset);
+        } while ((index < packed.size()) && (offset != 0));
+
+        EXPECT_EQ(offset, 0u);
+        EXPECT_EQ(index, packed.size());
+        EXPECT_EQ(received.Id.Value(), 7u);
+        EXPECT_EQ(received.Designator.Value(), designator);
+        EXPECT_EQ(received.Parameters.Value(), parameters);
+    }
+
+    TEST(JSONRPC, MessagePackOpaqueChunks)
+    {
+        Core::JSONRPC::Message request;
+        Core::JSONRPC::Message received;
+        std::vector<uint8_t> packed;
+
+        // Lots of small values, byte by byte, the walk over them carries on with every byte.
+        string parameters(_T("["));
+        for (uint32_t index = 0; index < 5000; index++) {
+            parameters += (index == 0 ? _T("") : _T(",")) + string(_T("{\"v\":")) + Core::NumberType<uint32_t>(index).Text() + _T("}");
+        }
+        parameters += _T("]");
+
+        request.Id = 3;
+        request.Parameters = parameters;
+        EXPECT_TRUE(request.ToBuffer(packed));
+
+        uint16_t offset = 0;
+        uint32_t index = 0;
+        received.Clear();
+        do {
+            index += static_cast<Core::JSON::IMessagePack&>(received).Deserialize(&packed[index], 1, offset);
+        } while ((index < packed.size()) && (offset != 0));
+
+        EXPECT_EQ(offset, 0u);
+        EXPECT_EQ(index, packed.size());
+        EXPECT_EQ(received.Parameters.Value(), parameters);
+
+        // Beyond the limit nothing is kept.
+        request.Parameters = _T("[\"") + string(5 * 1024 * 1024, 'x') + _T("\"]");
+        EXPECT_TRUE(request.ToBuffer(packed));
+
+        offset = 0;
+        index = 0;
+        received.Clear();
+        do {
+            const uint16_t chunk = static_cast<uint16_t>(std::min(static_cast<size_t>(60000), packed.size() - index));
+            index += static_cast<Core::JSON::IMessagePack&>(received).Deserialize(&packed[index], chunk, offset);
+        } while ((index < packed.size()) && (offset != 0));
+
+        EXPECT_FALSE(received.Parameters.IsSet());
+        EXPECT_TRUE(received.Parameters.Value().empty());
+    }
+
+    TEST(JSONRPC, MessagePackArrays)
+    {
+        typedef Core::JSON::ArrayType<Core::JSON::DecUInt32, std::vector<Core::JSON::DecUInt32>> Numbers;
+
+        Numbers sent;
+        for (uint32_t index = 0; index < 300; index++) {
+            sent.Add() = (index * 1000);
+        }
+
+        std::vector<uint8_t> packed(4096);
+        uint16_t offset = 0;
+        const uint16_t length = static_cast<const Core::JSON::IMessagePack&>(sent).Serialize(packed.data(), static_cast<uint16_t>(packed.size()), offset);
+        ASSERT_EQ(offset, 0u);
+        EXPECT_EQ(packed[0], 0xDC);
+
+        // Byte by byte, so the header and the elements are split over the calls.
+        Numbers received;
+        uint16_t index = 0;
+        do {
+            index += static_cast<Core::JSON::IMessagePack&>(received).Deserialize(&packed[index], 1, offset);
+        } while ((index < length) && (offset != 0));
+
+        EXPECT_EQ(offset, 0u);
+        EXPECT_EQ(index, length);
+        ASSERT_EQ(received.Length(), 300u);
+        EXPECT_EQ(received[0].Value(), 0u);
+        EXPECT_EQ(received[299].Value(), 299000u);
+
+        // A count far beyond the data that follows must not be taken for granted.
+        const uint8_t bogus[] = { 0xDC, 0xFF, 0xFF, 0x01, 0x02 };
+        Numbers truncated;
+        offset = 0;
+        EXPECT_EQ(static_cast<Core::JSON::IMessagePack&>(truncated).Deserialize(bogus, sizeof(bogus), offset), sizeof(bogus));
+        EXPECT_NE(offset, 0u);
+        ASSERT_EQ(truncated.Length(), 2u);
+        EXPECT_EQ(truncated[1].Value(), 2u);
+
+        const uint8_t small[] = { 0x93, 0x01, 0x02, 0x03, 0x90 };
+        Numbers fixed;
+        offset = 0;
+        EXPECT_EQ(static_cast<Core::JSON::IMessagePack&>(fixed).Deserialize(small, sizeof(small), offset), 4u);
+        EXPECT_EQ(offset, 0u);
+        ASSERT_EQ(fixed.Length(), 3u);
+        EXPECT_EQ(fixed[2].Value(), 3u);
+    }
+
+} // Tests
+} // WPEFramework
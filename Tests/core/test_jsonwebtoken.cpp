@@ -0,0 +1,122 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2020 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+#include <core/core.h>
+#include <websocket/websocket.h>
+
+namespace WPEFramework {
+namespace Tests {
+
+    static const uint8_t TokenKey[] = { 's', 'e', 'c', 'r', 'e', 't', 'k', 'e', 'y' };
+
+    static string Token(const Web::JSONWebToken& jwt, const string& payload)
+    {
+        string token;
+        jwt.Encode(token, static_cast<uint16_t>(payload.length()), reinterpret_cast<const uint8_t*>(payload.c_str()));
+        return (token);
+    }
+
+    static string Payload(const Web::JSONWebToken& jwt, const string& token)
+    {
+        uint8_t buffer[256];
+        const uint16_t length = jwt.Decode(token, sizeof(buffer), buffer);
+
+        // The decoded length includes the terminating zero of the payload text.
+        return (length == static_cast<uint16_t>(~0) ? string(_T("<invalid>")) : string(reinterpret_cast<const char*>(buffer), ::strnlen(reinterpret_cast<const char*>(buffer), length)));
+    }
+
+    TEST(Web_JSONWebToken, CachedPayload)
+    {
+        Web::JSONWebToken jwt(Web::JSONWebToken::SHA256, sizeof(TokenKey), TokenKey, 4);
+        const string token(Token(jwt, _T("{\"url\":\"http://localhost\"}")));
+
+        EXPECT_FALSE(jwt.IsCached(token));
+        EXPECT_EQ(Payload(jwt, token), _T("{\"url\":\"http://localhost\"}"));
+        EXPECT_TRUE(jwt.IsCached(token));
+
+        // Served from the cache, it is the same payload.
+        EXPECT_EQ(Payload(jwt, token), _T("{\"url\":\"http://localhost\"}"));
+        EXPECT_EQ(Payload(jwt, token), _T("{\"url\":\"http://localhost\"}"));
+
+        // A token that is not valid is never remembered.
+        string forged(token);
+        forged[forged.length() - 2] ^= 0x01;
+        EXPECT_EQ(Payload(jwt, forged), _T("<invalid>"));
+        EXPECT_FALSE(jwt.IsCached(forged));
+    }
+
+    TEST(Web_JSONWebToken, SameSignatureOtherPayload)
+    {
+        Web::JSONWebToken jwt(Web::JSONWebToken::SHA256, sizeof(TokenKey), TokenKey, 4);
+        const string token(Token(jwt, _T("{\"user\":\"guest\"}")));
+        const string other(Token(jwt, _T("{\"user\":\"admin\"}")));
+
+        EXPECT_EQ(Payload(jwt, token), _T("{\"user\":\"guest\"}"));
+
+        // The valid signature of the first one, glued to the payload of the second one.
+        const size_t first = token.find_last_of('.');
+        const string tampered(other.substr(0, other.find_last_of('.')) + token.substr(first));
+
+        EXPECT_FALSE(jwt.IsCached(tampered));
+        EXPECT_EQ(Payload(jwt, tampered), _T("<invalid>"));
+        EXPECT_EQ(Payload(jwt, token), _T("{\"user\":\"guest\"}"));
+    }
+
+    TEST(Web_JSONWebToken, LeastRecentlyUsedIsEvicted)
+    {
+        Web::JSONWebToken jwt(Web::JSONWebToken::SHA256, sizeof(TokenKey), TokenKey, 3);
+        string tokens[4];
+
+        for (uint8_t index = 0; index < 4; index++) {
+            tokens[index] = Token(jwt, _T("{\"id\":") + Core::NumberType<uint8_t>(index).Text() + _T("}"));
+        }
+
+        EXPECT_EQ(Payload(jwt, tokens[0]), _T("{\"id\":0}"));
+        EXPECT_EQ(Payload(jwt, tokens[1]), _T("{\"id\":1}"));
+        EXPECT_EQ(Payload(jwt, tokens[2]), _T("{\"id\":2}"));
+
+        // Touch the oldest, so the second one is the least recently used when the fourth comes in.
+        EXPECT_EQ(Payload(jwt, tokens[0]), _T("{\"id\":0}"));
+        EXPECT_EQ(Payload(jwt, tokens[3]), _T("{\"id\":3}"));
+
+        EXPECT_TRUE(jwt.IsCached(tokens[0]));
+        EXPECT_FALSE(jwt.IsCached(tokens[1]));
+        EXPECT_TRUE(jwt.IsCached(tokens[2]));
+        EXPECT_TRUE(jwt.IsCached(tokens[3]));
+
+        // Evicted is not invalid, it is validated (and remembered) again.
+        EXPECT_EQ(Payload(jwt, tokens[1]), _T("{\"id\":1}"));
+        EXPECT_TRUE(jwt.IsCached(tokens[1]));
+        EXPECT_FALSE(jwt.IsCached(tokens[2]));
+    }
+
+    TEST(Web_JSONWebToken, NoCache)
+    {
+        Web::JSONWebToken jwt(Web::JSONWebToken::SHA256, sizeof(TokenKey), TokenKey, 0);
+        const string token(Token(jwt, _T("{\"url\":\"http://localhost\"}")));
+
+        for (uint8_t round = 0; round < 3; round++) {
+            EXPECT_EQ(Payload(jwt, token), _T("{\"url\":\"http://localhost\"}"));
+            EXPECT_FALSE(jwt.IsCached(token));
+        }
+    }
+
+} // Tests
+} // WPEFramework
@@ -0,0 +1,200 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2020 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+#include <core/core.h>
+#include <websocket/websocket.h>
+
+namespace WPEFramework {
+namespace Tests {
+
+    enum KeywordTestEnum {
+        ACCEPT,
+        CONTENT_TYPE,
+        CONTENT_LENGTH,
+        HOST,
+        UPGRADE,
+        CONNECTION,
+        ORIGIN,
+        ALIAS
+    };
+
+} // Tests
+
+ENUM_CONVERSION_BEGIN(Tests::KeywordTestEnum)
+    { WPEFramework::Tests::KeywordTestEnum::ACCEPT, _TXT("ACCEPT") },
+    { WPEFramework::Tests::KeywordTestEnum::CONTENT_TYPE, _TXT("CONTENT-TYPE") },
+    { WPEFramework::Tests::KeywordTestEnum::CONTENT_LENGTH, _TXT("CONTENT-LENGTH") },
+    { WPEFramework::Tests::KeywordTestEnum::HOST, _TXT("HOST") },
+    { WPEFramework::Tests::KeywordTestEnum::UPGRADE, _TXT("UPGRADE") },
+    { WPEFramework::Tests::KeywordTestEnum::CONNECTION, _TXT("CONNECTION") },
+    { WPEFramework::Tests::KeywordTestEnum::ORIGIN, _TXT("ORIGIN") },
+    { WPEFramework::Tests::KeywordTestEnum::ALIAS, _TXT("HOST") },
+ENUM_CONVERSION_END(Tests::KeywordTestEnum)
+
+namespace Tests {
+
+    // Seven keywords in eight slots, the first seeds are bound to put two of them in the same slot.
+    typedef Web::KeywordLookupType<KeywordTestEnum, 8> KeywordTestLookup;
+
+    static bool Lookup(const KeywordTestLookup& lookup, const string& text, KeywordTestEnum& value)
+    {
+        return (lookup.Find(text.c_str(), static_cast<uint32_t>(text.length()), value));
+    }
+
+    static bool Unique(const uint32_t seed)
+    {
+        uint16_t owner[8];
+        bool result = true;
+        uint16_t index = 0;
+        const Core::EnumerateConversion<KeywordTestEnum>* entry;
+
+        ::memset(owner, 0xFF, sizeof(owner));
+
+        while ((result == true) && ((entry = Core::EnumerateType<KeywordTestEnum>::Entry(index)) != nullptr)) {
+            uint16_t& slot(owner[KeywordTestLookup::Hash(entry->name, entry->length, seed) % 8]);
+
+            if (slot == 0xFFFF) {
+                slot = index;
+            } else {
+                result = (::strcmp(Core::EnumerateType<KeywordTestEnum>::Entry(slot)->name, entry->name) == 0);
+            }
+            index++;
+        }
+
+        return (result);
+    }
+
+    TEST(Web_KeywordLookup, SeedSelection)
+    {
+        KeywordTestLookup lookup;
+
+        // The first seed that gives every (distinct) keyword a slot of its own is taken.
+        EXPECT_GT(lookup.Seed(), 1u);
+        EXPECT_TRUE(Unique(lookup.Seed()));
+        for (uint32_t seed = 1; seed < lookup.Seed(); seed++) {
+            EXPECT_FALSE(Unique(seed)) << "seed " << seed;
+        }
+
+        // It is the same every time, the lookup does not depend on when it was built.
+        KeywordTestLookup again;
+        EXPECT_EQ(again.Seed(), lookup.Seed());
+    }
+
+    TEST(Web_KeywordLookup, Hits)
+    {
+        const KeywordTestLookup& lookup(KeywordTestLookup::Instance());
+        KeywordTestEnum value;
+
+        EXPECT_TRUE(Lookup(lookup, _T("ACCEPT"), value));
+        EXPECT_EQ(value, KeywordTestEnum::ACCEPT);
+        EXPECT_TRUE(Lookup(lookup, _T("content-type"), value));
+        EXPECT_EQ(value, KeywordTestEnum::CONTENT_TYPE);
+        EXPECT_TRUE(Lookup(lookup, _T("Content-Length"), value));
+        EXPECT_EQ(value, KeywordTestEnum::CONTENT_LENGTH);
+        EXPECT_TRUE(Lookup(lookup, _T("uPgRaDe"), value));
+        EXPECT_EQ(value, KeywordTestEnum::UPGRADE);
+
+        // A keyword listed twice resolves to the first entry, like the walk through the table does.
+        EXPECT_TRUE(Lookup(lookup, _T("Host"), value));
+        EXPECT_EQ(value, KeywordTestEnum::HOST);
+
+        // Only the text given is compared, not whatever follows it in the parser buffer.
+        const TCHAR buffer[] = _T("ORIGIN: http://localhost");
+        EXPECT_TRUE(lookup.Find(buffer, 6, value));
+        EXPECT_EQ(value, KeywordTestEnum::ORIGIN);
+    }
+
+    TEST(Web_KeywordLookup, Misses)
+    {
+        const KeywordTestLookup& lookup(KeywordTestLookup::Instance());
+        KeywordTestEnum value = KeywordTestEnum::ALIAS;
+
+        EXPECT_FALSE(Lookup(lookup, _T(""), value));
+        EXPECT_FALSE(Lookup(lookup, _T("ACCEPTS"), value));
+        EXPECT_FALSE(Lookup(lookup, _T("CONTENT"), value));
+        EXPECT_FALSE(Lookup(lookup, _T("CONTENT-TYPE "), value));
+        EXPECT_FALSE(Lookup(lookup, _T("X-Custom-Header"), value));
+        // Case folding is for letters only, '-' and '\r' are different characters.
+        EXPECT_FALSE(Lookup(lookup, _T("CONTENT\rTYPE"), value));
+
+        // A text of the same length that lands in the slot of a keyword is still no match.
+        const uint8_t slot = KeywordTestLookup::Hash(_T("HOST"), 4, lookup.Seed()) % 8;
+        string other(_T("AAAA"));
+        bool found = false;
+
+        for (uint32_t index = 0; (index < (26 * 26 * 26 * 26)) && (found == false); index++) {
+            uint32_t code = index;
+            for (uint8_t position = 0; position < 4; position++, code /= 26) {
+                other[position] = static_cast<TCHAR>('A' + (code % 26));
+            }
+            found = ((other != _T("HOST")) && ((KeywordTestLookup::Hash(other.c_str(), 4, lookup.Seed()) % 8) == slot));
+        }
+
+        ASSERT_TRUE(found);
+        EXPECT_FALSE(Lookup(lookup, other, value));
+
+        // Bytes of 0x80 and up are no letters, they never match (nor upset toupper).
+        EXPECT_FALSE(Lookup(lookup, _T("H\xD3ST"), value));
+        EXPECT_FALSE(Lookup(lookup, _T("\xFF\xFF\xFF\xFF"), value));
+
+        // Nothing was found, so nothing was touched.
+        EXPECT_EQ(value, KeywordTestEnum::ALIAS);
+    }
+
+#ifndef __DEBUG__
+    TEST(Web_KeywordLookup, Crowded)
+    {
+        // Seven keywords do not fit in four slots, no seed is searched, the table is walked instead.
+        typedef Web::KeywordLookupType<KeywordTestEnum, 4> CrowdedLookup;
+
+        CrowdedLookup lookup;
+        KeywordTestEnum value;
+
+        EXPECT_EQ(lookup.Seed(), 0u);
+        EXPECT_TRUE(lookup.Find(_T("origin"), 6, value));
+        EXPECT_EQ(value, KeywordTestEnum::ORIGIN);
+        EXPECT_TRUE(lookup.Find(_T("Host"), 4, value));
+        EXPECT_EQ(value, KeywordTestEnum::HOST);
+        EXPECT_FALSE(lookup.Find(_T("Hosts"), 5, value));
+    }
+#endif
+
+    TEST(Web_KeywordLookup, RequestHeaders)
+    {
+        typedef Web::KeywordLookupType<Web::Request::keywords> RequestLookup;
+
+        const RequestLookup& lookup(RequestLookup::Instance());
+        const Core::EnumerateConversion<Web::Request::keywords>* entry;
+        uint16_t index = 0;
+
+        // Every header name of the table is found, also when it is send in lower case.
+        while ((entry = Core::EnumerateType<Web::Request::keywords>::Entry(index++)) != nullptr) {
+            string lower(entry->name, entry->length);
+            Web::Request::keywords value;
+
+            std::transform(lower.begin(), lower.end(), lower.begin(), ::tolower);
+
+            ASSERT_TRUE(lookup.Find(lower.c_str(), static_cast<uint32_t>(lower.length()), value)) << entry->name;
+            EXPECT_STREQ(Core::EnumerateType<Web::Request::keywords>(value).Data(), entry->name);
+        }
+    }
+
+} // Tests
+} // WPEFramework
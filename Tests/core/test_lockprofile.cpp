@@ -0,0 +1,104 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2020 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+#include <core/core.h>
+
+#include <thread>
+
+namespace WPEFramework {
+namespace Tests {
+
+    class ProfiledObject {
+    public:
+        ProfiledObject(const ProfiledObject&) = delete;
+        ProfiledObject& operator=(const ProfiledObject&) = delete;
+
+        // Not inlined, so the lock is constructed in one place for all instances, whatever the optimization level.
+        __attribute__((noinline)) ProfiledObject()
+            : _adminLock()
+            , _counter(0)
+        {
+        }
+        ~ProfiledObject()
+        {
+        }
+
+    public:
+        void Increment(const uint32_t holdTime)
+        {
+            _adminLock.Lock();
+            _counter++;
+            if (holdTime > 0) {
+                SleepMs(holdTime);
+            }
+            _adminLock.Unlock();
+        }
+        uint32_t Counter() const
+        {
+            return (_counter);
+        }
+
+    private:
+        Core::CriticalSection _adminLock;
+        uint32_t _counter;
+    };
+
+    TEST(Core_LockProfile, SitesAreCounted)
+    {
+        ProfiledObject first;
+        ProfiledObject second;
+
+        Core::LockProfile::Reset();
+
+        first.Increment(0);
+        second.Increment(0);
+
+        std::thread holder([&]() { first.Increment(50); });
+        SleepMs(10);
+        first.Increment(0);
+        holder.join();
+
+        EXPECT_EQ(first.Counter() + second.Counter(), 4u);
+
+        std::vector<Core::LockProfile::Site> sites;
+        Core::LockProfile::Snapshot(sites);
+
+        if (Core::LockProfile::IsEnabled() == false) {
+            EXPECT_TRUE(sites.empty());
+        } else {
+            // Both locks were constructed in the same place, so they share a site.
+            const Core::LockProfile::Site* found = nullptr;
+            for (const Core::LockProfile::Site& site : sites) {
+                if ((site.Acquired == 4) && (site.Contended > 0)) {
+                    EXPECT_EQ(found, nullptr);
+                    found = &site;
+                }
+            }
+            ASSERT_NE(found, nullptr);
+            EXPECT_GE(found->WaitTime, 10000000u);
+            EXPECT_GE(found->MaxHoldTime, 50000000u);
+            EXPECT_FALSE(Core::LockProfile::Name(found->Address).empty());
+
+            Core::LockProfile::Dump(stdout, 4);
+        }
+    }
+
+} // Tests
+} // WPEFramework
@@ -0,0 +1,135 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2020 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include "JSON.h"
+#include "Number.h"
+
+namespace WPEFramework {
+namespace Tests {
+
+    TEST(Numbers, DecimalText)
+    {
+        EXPECT_EQ(Core::NumberType<uint8_t>(0).Text(), "0");
+        EXPECT_EQ(Core::NumberType<uint8_t>(255).Text(), "255");
+        EXPECT_EQ(Core::NumberType<int16_t>(-10).Text(), "-10");
+        EXPECT_EQ(Core::NumberType<uint32_t>(4294967295u).Text(), "4294967295");
+        EXPECT_EQ(Core::NumberType<int32_t>(NUMBER_MIN_SIGNED(int32_t)).Text(), "-2147483648");
+        EXPECT_EQ(Core::NumberType<uint64_t>(18446744073709551615ull).Text(), "18446744073709551615");
+        EXPECT_EQ(Core::NumberType<int64_t>(NUMBER_MIN_SIGNED(int64_t)).Text(), "-9223372036854775808");
+    }
+
+    TEST(Numbers, HexAndOctalText)
+    {
+        EXPECT_EQ((Core::NumberType<uint32_t, false, BASE_HEXADECIMAL>(0).Text()), "0x0");
+        EXPECT_EQ((Core::NumberType<uint32_t, false, BASE_HEXADECIMAL>(0xDEADBEEF).Text()), "0xDEADBEEF");
+        EXPECT_EQ((Core::NumberType<int16_t, true, BASE_HEXADECIMAL>(-0x7F).Text()), "-0x7F");
+        EXPECT_EQ((Core::NumberType<uint16_t, false, BASE_OCTAL>(8).Text()), "010");
+        EXPECT_EQ((Core::NumberType<uint64_t, false, BASE_OCTAL>(18446744073709551615ull).Text()), "01777777777777777777777");
+    }
+
+    TEST(Numbers, DecimalParse)
+    {
+        uint64_t unsignedValue;
+        int64_t signedValue;
+        uint32_t smallValue;
+
+        EXPECT_EQ(Core::NumberType<uint64_t>::Convert("18446744073709551615", 20, unsignedValue, BASE_DECIMAL), 20u);
+        EXPECT_EQ(unsignedValue, 18446744073709551615ull);
+
+        EXPECT_EQ(Core::NumberType<int64_t>::Convert("-9223372036854775808", 20, signedValue, BASE_DECIMAL), 20u);
+        EXPECT_EQ(signedValue, NUMBER_MIN_SIGNED(int64_t));
+
+        EXPECT_EQ(Core::NumberType<int64_t>::Convert("1234567890123", 13, signedValue, BASE_DECIMAL), 13u);
+        EXPECT_EQ(signedValue, 1234567890123ll);
+
+        // Overflow must still stop at the digit that does not fit anymore.
+        EXPECT_EQ(Core::NumberType<uint32_t>::Convert("42949672950", 11, smallValue, BASE_DECIMAL), 10u);
+        EXPECT_EQ(smallValue, 4294967295u);
+
+        EXPECT_EQ(Core::NumberType<uint32_t>::Convert("1234abcd", 8, smallValue, BASE_DECIMAL), 4u);
+        EXPECT_EQ(smallValue, 1234u);
+    }
+
+    TEST(Numbers, JSONRoundTrip)
+    {
+        Core::JSON::DecUInt64 decimal;
+        Core::JSON::DecSInt64 negative;
+        Core::JSON::HexUInt32 hexadecimal;
+        string text;
+
+        decimal = 12345678901234567890ull;
+        decimal.ToString(text);
+        EXPECT_EQ(text, "12345678901234567890");
+        decimal.Clear();
+        EXPECT_TRUE(decimal.FromString(text));
+        EXPECT_EQ(decimal.Value(), 12345678901234567890ull);
+
+        negative = -987654321012345ll;
+        negative.ToString(text);
+        EXPECT_EQ(text, "-987654321012345");
+        negative.Clear();
+        EXPECT_TRUE(negative.FromString(text));
+        EXPECT_EQ(negative.Value(), -987654321012345ll);
+
+        hexadecimal = 0xCAFE01;
+        hexadecimal.ToString(text);
+        EXPECT_EQ(text, "\"0xCAFE01\"");
+        hexadecimal.Clear();
+        EXPECT_TRUE(hexadecimal.FromString(text));
+        EXPECT_EQ(hexadecimal.Value(), 0xCAFE01u);
+    }
+
+    TEST(Numbers, MessagePackRoundTrip)
+    {
+        const int64_t values[] = { 0, 1, 127, 128, -1, -32, -33, -128, -129, 65535, -32601, 4294967296ll, NUMBER_MIN_SIGNED(int64_t) };
+
+        for (const int64_t value : values) {
+            Core::JSON::DecSInt64 source;
+            Core::JSON::DecSInt64 target;
+            std::vector<uint8_t> packed;
+
+            source = value;
+            Core::JSON::IMessagePack::ToBuffer(packed, source);
+            EXPECT_TRUE(Core::JSON::IMessagePack::FromBuffer(packed, target));
+            EXPECT_TRUE(target.IsSet());
+            EXPECT_EQ(target.Value(), value);
+        }
+
+        Core::JSON::DecUInt32 unsignedSource;
+        Core::JSON::DecUInt32 unsignedTarget;
+        std::vector<uint8_t> packed;
+
+        unsignedSource = 0;
+        Core::JSON::IMessagePack::ToBuffer(packed, unsignedSource);
+        EXPECT_EQ(packed.size(), 1u);
+        EXPECT_TRUE(Core::JSON::IMessagePack::FromBuffer(packed, unsignedTarget));
+        EXPECT_TRUE(unsignedTarget.IsSet());
+        EXPECT_EQ(unsignedTarget.Value(), 0u);
+
+        unsignedSource = 4294967295u;
+        Core::JSON::IMessagePack::ToBuffer(packed, unsignedSource);
+        EXPECT_EQ(packed.size(), 5u);
+        EXPECT_TRUE(Core::JSON::IMessagePack::FromBuffer(packed, unsignedTarget));
+        EXPECT_EQ(unsignedTarget.Value(), 4294967295u);
+    }
+
+} // Tests
+} // WPEFramework
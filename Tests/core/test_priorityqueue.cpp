@@ -0,0 +1,200 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2020 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include <core/core.h>
+
+namespace WPEFramework {
+namespace Tests {
+
+    typedef Core::PriorityQueueType<uint32_t, 3> TestQueue;
+
+    // Writes its tag in the log when it runs, optionally it waits to be released first and tells when it is done.
+    class TestJob : public Core::IDispatch {
+    public:
+        TestJob() = delete;
+        TestJob(const TestJob&) = delete;
+        TestJob& operator=(const TestJob&) = delete;
+
+        TestJob(std::vector<uint32_t>& log, const uint32_t tag, Core::Event* started = nullptr, Core::Event* release = nullptr, Core::Event* finished = nullptr)
+            : _log(log)
+            , _tag(tag)
+            , _started(started)
+            , _release(release)
+            , _finished(finished)
+        {
+        }
+        ~TestJob() override
+        {
+        }
+
+    public:
+        void Dispatch() override
+        {
+            if (_started != nullptr) {
+                _started->SetEvent();
+                _release->Lock(Core::infinite);
+            }
+            _log.push_back(_tag);
+            if (_finished != nullptr) {
+                _finished->SetEvent();
+            }
+        }
+
+    private:
+        std::vector<uint32_t>& _log;
+        const uint32_t _tag;
+        Core::Event* _started;
+        Core::Event* _release;
+        Core::Event* _finished;
+    };
+
+    TEST(PriorityQueue, Lanes)
+    {
+        TestQueue queue(16, { 1000, 1000, 1000 });
+        uint32_t result;
+
+        queue.Enable();
+
+        EXPECT_TRUE(queue.Insert(1, 0, 2));
+        EXPECT_TRUE(queue.Insert(2, 0, 1));
+        EXPECT_TRUE(queue.Insert(3, 0, 0));
+        EXPECT_TRUE(queue.Insert(4, 0, 1));
+
+        EXPECT_EQ(queue.Length(), 4u);
+        EXPECT_EQ(queue.Length(1), 2u);
+
+        const uint32_t expected[] = { 3, 2, 4, 1 };
+        for (uint32_t value : expected) {
+            EXPECT_TRUE(queue.Extract(result, 0));
+            EXPECT_EQ(result, value);
+        }
+
+        EXPECT_TRUE(queue.IsEmpty());
+        EXPECT_EQ(queue.Peak(1), 2u);
+        EXPECT_EQ(queue.Promoted(), 0u);
+    }
+
+    TEST(PriorityQueue, Deadlines)
+    {
+        TestQueue queue(16, { 1000, 1000, 1000 });
+        const uint64_t now = TestQueue::Now();
+        uint32_t result;
+
+        queue.Enable();
+
+        // Without a deadline it is now + 1s, so the explicit earlier ones go first.
+        EXPECT_TRUE(queue.Insert(1, 0, 1));
+        EXPECT_TRUE(queue.Insert(2, 0, 1, now + 500000));
+        EXPECT_TRUE(queue.Insert(3, 0, 1, now + 100000));
+        EXPECT_TRUE(queue.Insert(4, 0, 1, now + 5000000));
+
+        const uint32_t expected[] = { 3, 2, 1, 4 };
+        for (uint32_t value : expected) {
+            EXPECT_TRUE(queue.Extract(result, 0));
+            EXPECT_EQ(result, value);
+        }
+    }
+
+    TEST(PriorityQueue, TimerJobsAreDue)
+    {
+        Core::WorkerPool pool(1, Core::Thread::DefaultStackSize(), 16);
+        Core::Event started(false, true);
+        Core::Event release(false, true);
+        Core::Event done(false, true);
+        std::vector<uint32_t> log;
+
+        // Keep the only worker busy, so everything after it has to queue.
+        pool.Submit(Core::ProxyType<Core::IDispatch>(Core::ProxyType<TestJob>::Create(log, 0, &started, &release)));
+        ASSERT_EQ(started.Lock(1000), Core::ERROR_NONE);
+
+        for (uint32_t index = 1; index <= 3; index++) {
+            pool.Submit(Core::ProxyType<Core::IDispatch>(Core::ProxyType<TestJob>::Create(log, index)), Core::ThreadPool::NORMAL);
+        }
+
+        pool.Schedule(Core::Time::Now(), Core::ProxyType<Core::IDispatch>(Core::ProxyType<TestJob>::Create(log, 100)));
+
+        uint32_t waited = 0;
+        while ((pool.Snapshot().Lane[Core::ThreadPool::NORMAL] < 4) && (waited++ < 1000)) {
+            SleepMs(1);
+        }
+        ASSERT_EQ(pool.Snapshot().Lane[Core::ThreadPool::NORMAL], 4u);
+
+        pool.Submit(Core::ProxyType<Core::IDispatch>(Core::ProxyType<TestJob>::Create(log, 200, nullptr, nullptr, &done)), Core::ThreadPool::LOW);
+        release.SetEvent();
+        ASSERT_EQ(done.Lock(1000), Core::ERROR_NONE);
+
+        // The timer fired last, but it is due, so it runs ahead of the normal jobs that still have time.
+        EXPECT_EQ(log, std::vector<uint32_t>({ 0, 100, 1, 2, 3, 200 }));
+    }
+
+    TEST(PriorityQueue, Ageing)
+    {
+        TestQueue queue(64, { 0, 0, 0 });
+        uint32_t result;
+        uint32_t taken = 0;
+
+        queue.Enable();
+
+        // The low entry is overdue right away, it may be passed over, but not forever.
+        EXPECT_TRUE(queue.Insert(100, 0, 2, 1));
+        for (uint32_t index = 0; index < 32; index++) {
+            EXPECT_TRUE(queue.Insert(index, 0, 0));
+        }
+
+        do {
+            EXPECT_TRUE(queue.Extract(result, 0));
+            taken++;
+        } while (result != 100);
+
+        EXPECT_LE(taken, 10u);
+        EXPECT_EQ(queue.Promoted(), 1u);
+    }
+
+    TEST(PriorityQueue, HighWaterMark)
+    {
+        TestQueue queue(2, { 1000, 1000, 1000 });
+        uint32_t result;
+
+        queue.Enable();
+
+        EXPECT_TRUE(queue.Insert(1, 0, 1));
+        EXPECT_TRUE(queue.Insert(2, 0, 2));
+        EXPECT_TRUE(queue.IsFull());
+
+        // No room for normal work, urgent work always gets in.
+        EXPECT_FALSE(queue.Insert(3, 10, 1));
+        EXPECT_TRUE(queue.Insert(4, 0, 0));
+
+        EXPECT_TRUE(queue.Remove(2));
+        EXPECT_FALSE(queue.Remove(2));
+
+        EXPECT_TRUE(queue.Extract(result, 0));
+        EXPECT_EQ(result, 4u);
+        EXPECT_TRUE(queue.Extract(result, 0));
+        EXPECT_EQ(result, 1u);
+        EXPECT_FALSE(queue.Extract(result, 10));
+
+        queue.Disable();
+        EXPECT_FALSE(queue.Insert(5, 0, 0));
+    }
+
+} // Tests
+} // WPEFramework
@@ -0,0 +1,83 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2020 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include <core/core.h>
+
+namespace WPEFramework {
+namespace Tests {
+
+    static string Capture(const Core::Process::Options& options)
+    {
+        Core::Process process(true);
+        uint32_t pid = 0;
+        string result;
+
+        EXPECT_EQ(process.Launch(options, &pid), Core::ERROR_NONE);
+        EXPECT_NE(pid, 0u);
+
+        if (pid != 0) {
+            int status;
+            uint8_t buffer[256];
+            uint16_t length;
+
+            ::waitpid(static_cast<pid_t>(pid), &status, 0);
+
+            // The child is gone, so a failing read simply means there is nothing left.
+            while (((length = process.Output(buffer, sizeof(buffer))) > 0) && (length <= sizeof(buffer))) {
+                result.append(reinterpret_cast<const char*>(buffer), length);
+            }
+        }
+
+        return (result);
+    }
+
+    TEST(Core_Process, Environment)
+    {
+        Core::Process::Options options(_T("/bin/sh"));
+        options.Add(_T("-c")).Add(_T("echo \"$WPE_TEST_VALUE:$HOME\""));
+        options.Environment(_T("WPE_TEST_VALUE"), _T("first")).Environment(_T("WPE_TEST_VALUE"), _T("second"));
+
+        const char* home = ::getenv(_T("HOME"));
+
+        EXPECT_EQ(Capture(options), string(_T("second:")) + (home != nullptr ? home : _T("")) + '\n');
+    }
+
+    TEST(Core_Process, WorkingDirectory)
+    {
+        Core::Process::Options options(_T("/bin/sh"));
+        options.Add(_T("-c")).Add(_T("pwd"));
+        options.WorkingDirectory(_T("/"));
+
+        EXPECT_EQ(Capture(options), string(_T("/\n")));
+    }
+
+    TEST(Core_Process, Unavailable)
+    {
+        Core::Process process(false);
+        const Core::Process::Options options(_T("/nonexisting/executable"));
+        uint32_t pid = 1;
+
+        EXPECT_EQ(process.Launch(options, &pid), Core::ERROR_UNAVAILABLE);
+        EXPECT_EQ(pid, 0u);
+    }
+
+} // Tests
+} // WPEFramework
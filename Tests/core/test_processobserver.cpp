@@ -0,0 +1,211 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2020 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+#include <core/core.h>
+
+namespace WPEFramework {
+namespace Tests {
+
+    // Far beyond any pid_max, so these never have children (or even exist) on the test machine.
+    static constexpr uint32_t Root = 0x40000000;
+
+    class TestObserver : public Core::ProcessObserver, public Core::ProcessObserver::INotification {
+    public:
+        TestObserver(const TestObserver&) = delete;
+        TestObserver& operator=(const TestObserver&) = delete;
+
+        TestObserver()
+            : Core::ProcessObserver(this)
+            , _log()
+            , _frame()
+            , _size(0)
+        {
+        }
+        ~TestObserver() override
+        {
+        }
+
+    public:
+        const std::vector<string>& Log() const
+        {
+            return (_log);
+        }
+        // Events are collected in one datagram, Deliver hands it to the channel as the kernel would.
+        TestObserver& Fork(const uint32_t parent, const uint32_t childPid, const uint32_t childTgid)
+        {
+            struct proc_event event;
+            ::memset(&event, 0, sizeof(event));
+
+            event.what = proc_event::PROC_EVENT_FORK;
+            event.event_data.fork.parent_pid = parent;
+            event.event_data.fork.parent_tgid = parent;
+            event.event_data.fork.child_pid = childPid;
+            event.event_data.fork.child_tgid = childTgid;
+
+            return (Add(event));
+        }
+        TestObserver& Exec(const uint32_t pid)
+        {
+            struct proc_event event;
+            ::memset(&event, 0, sizeof(event));
+
+            event.what = proc_event::PROC_EVENT_EXEC;
+            event.event_data.exec.process_pid = pid;
+            event.event_data.exec.process_tgid = pid;
+
+            return (Add(event));
+        }
+        TestObserver& Exit(const uint32_t pid, const uint32_t tgid, const uint32_t exitCode)
+        {
+            struct proc_event event;
+            ::memset(&event, 0, sizeof(event));
+
+            event.what = proc_event::PROC_EVENT_EXIT;
+            event.event_data.exit.process_pid = pid;
+            event.event_data.exit.process_tgid = tgid;
+            event.event_data.exit.exit_code = exitCode;
+
+            return (Add(event));
+        }
+        void Deliver()
+        {
+            EXPECT_EQ(Link().Deserialize(_frame, _size), _size);
+            _size = 0;
+        }
+
+    private:
+        TestObserver& Add(const struct proc_event& event)
+        {
+            const uint32_t length = NLMSG_LENGTH(sizeof(struct cn_msg) + sizeof(event));
+
+            EXPECT_LE(_size + NLMSG_ALIGN(length), sizeof(_frame));
+
+            struct nlmsghdr* header = reinterpret_cast<struct nlmsghdr*>(&_frame[_size]);
+            ::memset(header, 0, NLMSG_ALIGN(length));
+            header->nlmsg_len = length;
+            header->nlmsg_type = NLMSG_DONE;
+
+            struct cn_msg* message = reinterpret_cast<struct cn_msg*>(NLMSG_DATA(header));
+            message->id.idx = CN_IDX_PROC;
+            message->id.val = CN_VAL_PROC;
+            message->len = sizeof(event);
+            ::memcpy(message->data, &event, sizeof(event));
+
+            _size += NLMSG_ALIGN(length);
+
+            return (*this);
+        }
+
+        void Forked(const uint32_t parent, const uint32_t child) override
+        {
+            _log.push_back(_T("fork ") + Core::NumberType<uint32_t>(parent - Root).Text() + _T(" ") + Core::NumberType<uint32_t>(child - Root).Text());
+        }
+        void Executed(const uint32_t pid) override
+        {
+            _log.push_back(_T("exec ") + Core::NumberType<uint32_t>(pid - Root).Text());
+        }
+        void Exited(const uint32_t pid, const uint32_t exitCode) override
+        {
+            _log.push_back(_T("exit ") + Core::NumberType<uint32_t>(pid - Root).Text() + _T(" ") + Core::NumberType<uint32_t>(exitCode).Text());
+        }
+
+    private:
+        std::vector<string> _log;
+        alignas(NLMSG_ALIGNTO) uint8_t _frame[1024];
+        uint16_t _size;
+    };
+
+    TEST(Core_ProcessObserver, ForkedChildrenAreWatched)
+    {
+        TestObserver observer;
+
+        observer.Watch(Root);
+        EXPECT_TRUE(observer.IsWatched(Root));
+
+        // A child, a grandchild and a process that has nothing to do with the tree.
+        observer.Fork(Root, Root + 1, Root + 1).Fork(Root + 1, Root + 2, Root + 2).Fork(Root + 10, Root + 11, Root + 11).Deliver();
+        observer.Exec(Root + 2).Exec(Root + 11).Deliver();
+
+        EXPECT_TRUE(observer.IsWatched(Root + 1));
+        EXPECT_TRUE(observer.IsWatched(Root + 2));
+        EXPECT_FALSE(observer.IsWatched(Root + 11));
+        EXPECT_EQ(observer.Log(), std::vector<string>({ _T("fork 0 1"), _T("fork 1 2"), _T("exec 2") }));
+    }
+
+    TEST(Core_ProcessObserver, ThreadsAreFilteredOut)
+    {
+        TestObserver observer;
+
+        observer.Watch(Root);
+
+        // A thread of the root is created and ends, the process itself stays.
+        observer.Fork(Root, Root + 5, Root).Deliver();
+        observer.Exit(Root + 5, Root, 0).Deliver();
+
+        EXPECT_FALSE(observer.IsWatched(Root + 5));
+        EXPECT_TRUE(observer.IsWatched(Root));
+        EXPECT_TRUE(observer.Log().empty());
+    }
+
+    TEST(Core_ProcessObserver, ExitedOnce)
+    {
+        TestObserver observer;
+
+        observer.Watch(Root);
+        observer.Fork(Root, Root + 1, Root + 1).Deliver();
+
+        observer.Exit(Root + 1, Root + 1, 256).Deliver();
+        EXPECT_FALSE(observer.IsWatched(Root + 1));
+        EXPECT_TRUE(observer.IsWatched(Root));
+
+        // The same exit again (and one for a process that was never watched) goes unnoticed.
+        observer.Exit(Root + 1, Root + 1, 256).Exit(Root + 20, Root + 20, 0).Deliver();
+        observer.Exit(Root, Root, 9).Deliver();
+        observer.Exit(Root, Root, 9).Deliver();
+
+        EXPECT_FALSE(observer.IsWatched(Root));
+        EXPECT_EQ(observer.Log(), std::vector<string>({ _T("fork 0 1"), _T("exit 1 256"), _T("exit 0 9") }));
+    }
+
+    TEST(Core_ProcessObserver, UnwatchDropsTheTree)
+    {
+        TestObserver observer;
+
+        observer.Watch(Root);
+        observer.Watch(Root + 100);
+        observer.Fork(Root, Root + 1, Root + 1).Fork(Root + 1, Root + 2, Root + 2).Fork(Root + 100, Root + 101, Root + 101).Deliver();
+
+        observer.Unwatch(Root);
+
+        EXPECT_FALSE(observer.IsWatched(Root));
+        EXPECT_FALSE(observer.IsWatched(Root + 1));
+        EXPECT_FALSE(observer.IsWatched(Root + 2));
+        EXPECT_TRUE(observer.IsWatched(Root + 100));
+        EXPECT_TRUE(observer.IsWatched(Root + 101));
+
+        // Nothing of the dropped tree is reported anymore, the other tree still is.
+        observer.Fork(Root + 2, Root + 3, Root + 3).Exit(Root + 1, Root + 1, 0).Exit(Root + 101, Root + 101, 0).Deliver();
+
+        EXPECT_FALSE(observer.IsWatched(Root + 3));
+        EXPECT_EQ(observer.Log(), std::vector<string>({ _T("fork 0 1"), _T("fork 1 2"), _T("fork 100 101"), _T("exit 101 0") }));
+    }
+
+} // Tests
+} // WPEFramework
@@ -0,0 +1,175 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2020 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+#include <core/core.h>
+
+#include <thread>
+
+namespace WPEFramework {
+namespace Tests {
+
+    TEST(Core_ReadWriteLock, ReadersShareWritersExclude)
+    {
+        Core::ReadWriteLock lock;
+
+        EXPECT_TRUE(lock.ReadLock(0));
+        EXPECT_TRUE(lock.ReadLock(0));
+        EXPECT_FALSE(lock.WriteLock(0));
+
+        lock.ReadUnlock();
+        lock.ReadUnlock();
+
+        EXPECT_TRUE(lock.WriteLock(0));
+        EXPECT_FALSE(lock.ReadLock(10));
+        EXPECT_FALSE(lock.WriteLock(10));
+        lock.WriteUnlock();
+
+        const Core::ReadWriteLock::Contention statistics(lock.Statistics());
+        EXPECT_EQ(statistics.ReadAcquired, 2u);
+        EXPECT_EQ(statistics.WriteAcquired, 1u);
+        EXPECT_EQ(statistics.ReadContended, 1u);
+        EXPECT_EQ(statistics.WriteContended, 2u);
+        EXPECT_GE(statistics.WaitTime, 20u * Core::Time::TicksPerMillisecond);
+    }
+
+    TEST(Core_ReadWriteLock, WriterWakesUpWhenReadersLeave)
+    {
+        Core::ReadWriteLock lock;
+        std::atomic<bool> written(false);
+
+        ASSERT_TRUE(lock.ReadLock());
+
+        std::thread writer([&]() {
+            if (lock.WriteLock(5000) == true) {
+                written = true;
+                lock.WriteUnlock();
+            }
+        });
+
+        ::SleepMs(50);
+        EXPECT_FALSE(written.load());
+
+        lock.ReadUnlock();
+        writer.join();
+
+        EXPECT_TRUE(written.load());
+    }
+
+    TEST(Core_ReadWriteLock, WriterPreferenceHoldsOffNewReaders)
+    {
+        Core::ReadWriteLock lock(Core::ReadWriteLock::WRITER, false);
+
+        ASSERT_TRUE(lock.ReadLock());
+
+        std::thread writer([&]() {
+            if (lock.WriteLock(5000) == true) {
+                ::SleepMs(20);
+                lock.WriteUnlock();
+            }
+        });
+
+        ::SleepMs(50);
+
+        // A writer is waiting, so no new readers, not even while the lock is only read locked.
+        EXPECT_FALSE(lock.ReadLock(10));
+
+        lock.Preference(Core::ReadWriteLock::READER);
+        EXPECT_TRUE(lock.ReadLock(0));
+        lock.ReadUnlock();
+
+        lock.ReadUnlock();
+        writer.join();
+
+        EXPECT_TRUE(lock.ReadLock(0));
+        lock.ReadUnlock();
+    }
+
+    TEST(Core_ReadWriteLock, BiasedLockKeepsDataConsistent)
+    {
+        // Writer preference, with readers hammering the lock a reader preferring lock starves the writer.
+        Core::ReadWriteLock lock(Core::ReadWriteLock::WRITER, true);
+        ASSERT_TRUE(lock.IsBiased());
+
+        // The writer keeps both values equal, readers should never see them differ.
+        volatile uint32_t first = 0;
+        volatile uint32_t second = 0;
+        std::atomic<uint32_t> mismatches(0);
+        std::atomic<bool> stop(false);
+        std::vector<std::thread> readers;
+
+        for (uint8_t index = 0; index < 4; index++) {
+            readers.emplace_back([&]() {
+                while (stop == false) {
+                    lock.ReadLock();
+                    if (first != second) {
+                        mismatches++;
+                    }
+                    lock.ReadUnlock();
+                }
+            });
+        }
+
+        for (uint32_t round = 0; round < 200; round++) {
+            lock.WriteLock();
+            first = round;
+            std::this_thread::yield();
+            second = round;
+            lock.WriteUnlock();
+        }
+
+        stop = true;
+        for (std::thread& reader : readers) {
+            reader.join();
+        }
+
+        EXPECT_EQ(mismatches.load(), 0u);
+        EXPECT_EQ(lock.Statistics().WriteAcquired, 200u);
+        EXPECT_GE(lock.Statistics().Revocations, 1u);
+
+        // Nothing may be left behind in the slots or on the lock word.
+        EXPECT_TRUE(lock.WriteLock(0));
+        lock.WriteUnlock();
+    }
+
+    TEST(Core_ReadWriteLock, BiasedWriterTimesOutOnSlotReaders)
+    {
+        Core::ReadWriteLock lock(Core::ReadWriteLock::READER, true);
+
+        ASSERT_TRUE(lock.ReadLock());
+        EXPECT_FALSE(lock.WriteLock(20));
+
+        // The bias is handed back to the readers, so they still get in.
+        std::thread reader([&]() {
+            EXPECT_TRUE(lock.ReadLock(0));
+            lock.ReadUnlock();
+        });
+        reader.join();
+
+        lock.ReadUnlock();
+
+        EXPECT_TRUE(lock.WriteLock(0));
+        lock.WriteUnlock();
+
+        lock.ResetStatistics();
+        EXPECT_EQ(lock.Statistics().ReadAcquired, 0u);
+    }
+
+} // Tests
+} // WPEFramework
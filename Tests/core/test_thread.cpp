@@ -0,0 +1,84 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2020 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include <core/core.h>
+
+namespace WPEFramework {
+namespace Tests {
+
+    class Sleeper : public Core::Thread {
+    public:
+        Sleeper(const Sleeper&) = delete;
+        Sleeper& operator=(const Sleeper&) = delete;
+
+        Sleeper()
+            : Core::Thread(Core::Thread::DefaultStackSize(), _T("Sleeper"))
+        {
+        }
+        ~Sleeper() override
+        {
+            Stop();
+            Wait(Core::Thread::STOPPED, Core::infinite);
+        }
+
+    private:
+        uint32_t Worker() override
+        {
+            return (10);
+        }
+    };
+
+    TEST(Thread, CoreList)
+    {
+        EXPECT_EQ(Core::Thread::Cores(string(_T(""))), 0u);
+        EXPECT_EQ(Core::Thread::Cores(string(_T("0"))), 0x1u);
+        EXPECT_EQ(Core::Thread::Cores(string(_T("0-3"))), 0xFu);
+        EXPECT_EQ(Core::Thread::Cores(string(_T("0-1,4,6-7\n"))), 0xD3u);
+        EXPECT_EQ(Core::Thread::Cores(string(_T("63"))), (1ULL << 63));
+        EXPECT_EQ(Core::Thread::Cores(string(_T("64-70"))), 0u);
+    }
+
+    TEST(Thread, Placement)
+    {
+        const uint64_t online = Core::Thread::Cores(Core::Thread::ALL);
+        Sleeper thread;
+
+        thread.Run();
+
+#ifdef __LINUX__
+        ASSERT_NE(online, 0u);
+
+        // A cluster is always a subset of what is online.
+        EXPECT_EQ(Core::Thread::Cores(Core::Thread::PERFORMANCE) & ~online, 0u);
+        EXPECT_EQ(Core::Thread::Cores(Core::Thread::EFFICIENCY) & ~online, 0u);
+
+        const uint64_t first = online & (~online + 1);
+        EXPECT_TRUE(thread.Affinity(first));
+        EXPECT_TRUE(thread.Affinity(online));
+
+        // Being nicer is always allowed.
+        EXPECT_TRUE(thread.Policy(Core::Thread::OTHER, 5));
+        EXPECT_TRUE(thread.Policy(Core::Thread::BATCH, 10));
+#endif
+    }
+
+} // Tests
+} // WPEFramework
@@ -0,0 +1,105 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2020 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+#include <time.h>
+
+#include "Time.h"
+
+namespace WPEFramework {
+namespace Tests {
+
+    TEST(Time, BreakDownMatchesLibc)
+    {
+        // Walk a few decades in steps that hit all kinds of days, including leap days.
+        for (time_t seconds = 0; seconds < 2000000000; seconds += 86399 * 7 + 3601) {
+            struct tm expected;
+            gmtime_r(&seconds, &expected);
+
+            Core::Time time(static_cast<uint64_t>(seconds) * 1000000, false);
+
+            ASSERT_EQ(time.Year(), static_cast<uint32_t>(expected.tm_year + 1900));
+            ASSERT_EQ(time.Month(), expected.tm_mon + 1);
+            ASSERT_EQ(time.Day(), expected.tm_mday);
+            ASSERT_EQ(time.Hours(), expected.tm_hour);
+            ASSERT_EQ(time.Minutes(), expected.tm_min);
+            ASSERT_EQ(time.Seconds(), expected.tm_sec);
+            ASSERT_EQ(time.DayOfWeek(), expected.tm_wday);
+            ASSERT_EQ(time.DayOfYear(), expected.tm_yday);
+            ASSERT_FALSE(time.IsLocalTime());
+        }
+    }
+
+    TEST(Time, Formatting)
+    {
+        Core::Time time(1994, 11, 6, 8, 49, 37, 0, false);
+
+        EXPECT_EQ(time.ToRFC1123(false), "Sun, 06 Nov 1994 08:49:37 GMT");
+        EXPECT_EQ(time.ToISO8601(false), "1994-11-06T08:49:37Z");
+    }
+
+    TEST(Time, Parsing)
+    {
+        Core::Time time;
+
+        EXPECT_TRUE(time.FromString("Sun, 06 Nov 1994 08:49:37 GMT", false));
+        EXPECT_EQ(time.ToISO8601(false), "1994-11-06T08:49:37Z");
+
+        EXPECT_TRUE(time.FromString("1994-11-06T08:49:37.125Z", false));
+        EXPECT_EQ(time.ToRFC1123(false), "Sun, 06 Nov 1994 08:49:37 GMT");
+        EXPECT_EQ(time.MilliSeconds(), 125u);
+
+        EXPECT_TRUE(time.FromISO8601("1994-11-06T08:49:37+01:30"));
+        EXPECT_FALSE(time.FromISO8601("1994-11-06T08:49:37+1"));
+        EXPECT_FALSE(time.FromISO8601("1994-11-06T08:49:37X"));
+        EXPECT_FALSE(time.FromISO8601("1994-13-06T08:49:37Z"));
+        EXPECT_FALSE(time.FromISO8601("1994-11-06 08:49:37Z"));
+    }
+
+    TEST(Time, LocalFollowsTheZone)
+    {
+        const char* original = ::getenv("TZ");
+        const string previous(original != nullptr ? original : "");
+        const struct timespec moment = { 1000000800, 0 }; // 2001-09-09 02:00:00 UTC
+
+        ::setenv("TZ", "UTC0", 1);
+        ::tzset();
+        SleepMs(1100);
+
+        Core::Time utc(moment, true);
+        EXPECT_EQ(utc.Hours(), 2);
+
+        // Nobody tells, the new zone is picked up within a second.
+        ::setenv("TZ", "EST5", 1);
+        SleepMs(1100);
+
+        Core::Time est(moment, true);
+        EXPECT_EQ(est.Hours(), 21);
+        EXPECT_EQ(est.Day(), 8);
+
+        if (original != nullptr) {
+            ::setenv("TZ", previous.c_str(), 1);
+        } else {
+            ::unsetenv("TZ");
+        }
+        ::tzset();
+    }
+
+} // Tests
+} // WPEFramework
@@ -0,0 +1,174 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2020 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+#include <core/core.h>
+#include <processcontainers/CGroupStatistics.h>
+
+#include <fstream>
+#include <set>
+
+namespace WPEFramework {
+namespace Tests {
+
+    // A cgroup filesystem of our own, the statistic files hold fixed text.
+    class CGroupTree {
+    public:
+        CGroupTree(const CGroupTree&) = delete;
+        CGroupTree& operator=(const CGroupTree&) = delete;
+
+        CGroupTree(const string& root)
+            : _root(root)
+        {
+            Core::Directory((_root + _T("/")).c_str()).CreatePath();
+        }
+        ~CGroupTree()
+        {
+            for (const string& file : _files) {
+                Core::File(file).Destroy();
+            }
+            // A sub directory sorts after its parent, so walking backwards empties the children first.
+            for (std::set<string>::const_reverse_iterator index = _directories.crbegin(); index != _directories.crend(); ++index) {
+                ::rmdir(index->c_str());
+            }
+            ::rmdir(_root.c_str());
+        }
+
+    public:
+        const string& Root() const
+        {
+            return (_root);
+        }
+        void Write(const string& file, const string& content) const
+        {
+            const string path(_root + '/' + file);
+            string::size_type slash = file.find('/');
+
+            while (slash != string::npos) {
+                _directories.insert(_root + '/' + file.substr(0, slash));
+                slash = file.find('/', slash + 1);
+            }
+            _files.insert(path);
+
+            Core::Directory((path.substr(0, path.rfind('/') + 1)).c_str()).CreatePath();
+
+            std::ofstream stream(path, std::ios::out | std::ios::trunc);
+            stream << content;
+        }
+
+    private:
+        const string _root;
+        mutable std::set<string> _files;
+        mutable std::set<string> _directories;
+    };
+
+    TEST(ProcessContainers_CGroupStatistics, Legacy)
+    {
+        CGroupTree tree(_T("/tmp/test_cgroup_v1"));
+
+        tree.Write(_T("memory/lxc/box/memory.usage_in_bytes"), _T("1048576\n"));
+        tree.Write(_T("memory/lxc/box/memory.stat"), _T("cache 100\ntotal_rss 9999\nrss 2048\nrss_huge 0\nmapped_file 512\nswap 0\n"));
+        tree.Write(_T("cpuacct/lxc/box/cpuacct.usage"), _T("123456789\n"));
+        tree.Write(_T("cpuacct/lxc/box/cpuacct.usage_percpu"), _T("100 200 300 400 \n"));
+
+        ProcessContainers::CGroupStatistics statistics(tree.Root());
+        EXPECT_FALSE(statistics.IsUnified());
+        EXPECT_FALSE(statistics.IsAttached());
+
+        statistics.Attach(_T("lxc/box"));
+        EXPECT_TRUE(statistics.IsAttached());
+
+        const ProcessContainers::IContainer::MemoryInfo memory(statistics.Memory());
+        EXPECT_EQ(memory.allocated, 1048576u);
+        EXPECT_EQ(memory.resident, 2048u);
+        EXPECT_EQ(memory.shared, 512u);
+
+        const ProcessContainers::IContainer::CPUInfo cpu(statistics.Cpu());
+        EXPECT_EQ(cpu.total, 123456789u);
+        ASSERT_EQ(cpu.cores.size(), 4u);
+        EXPECT_EQ(cpu.cores[0], 100u);
+        EXPECT_EQ(cpu.cores[3], 400u);
+    }
+
+    TEST(ProcessContainers_CGroupStatistics, Unified)
+    {
+        CGroupTree tree(_T("/tmp/test_cgroup_v2"));
+
+        tree.Write(_T("cgroup.controllers"), _T("cpu memory\n"));
+        tree.Write(_T("lxc/box/memory.current"), _T("4096\n"));
+        tree.Write(_T("lxc/box/memory.stat"), _T("anon_thp 7\nanon 1024\nfile 2048\nkernel_stack 0\nfile_mapped 256\n"));
+        tree.Write(_T("lxc/box/cpu.stat"), _T("usage_usec 1500\nuser_usec 1000\nsystem_usec 500\n"));
+
+        ProcessContainers::CGroupStatistics statistics(tree.Root());
+        EXPECT_TRUE(statistics.IsUnified());
+
+        statistics.Attach(_T("lxc/box"));
+
+        ProcessContainers::IContainer::UsageInfo usage;
+        statistics.Sample(usage);
+
+        EXPECT_EQ(usage.memory.allocated, 4096u);
+        EXPECT_EQ(usage.memory.resident, 1024u);
+        EXPECT_EQ(usage.memory.shared, 256u);
+
+        // Reported in usec, handed out in nsec, and there is no per core accounting.
+        EXPECT_EQ(usage.cpu.total, 1500000u);
+        EXPECT_TRUE(usage.cpu.cores.empty());
+    }
+
+    TEST(ProcessContainers_CGroupStatistics, SamplesFollowTheFiles)
+    {
+        CGroupTree tree(_T("/tmp/test_cgroup_sample"));
+
+        tree.Write(_T("cgroup.controllers"), _T("cpu memory\n"));
+
+        ProcessContainers::CGroupStatistics statistics(tree.Root());
+        statistics.Attach(_T("box"));
+
+        // The group does not exist yet, nothing is known.
+        ProcessContainers::IContainer::MemoryInfo memory(statistics.Memory());
+        EXPECT_EQ(memory.allocated, UINT64_MAX);
+        EXPECT_EQ(memory.resident, UINT64_MAX);
+        EXPECT_EQ(statistics.Cpu().total, UINT64_MAX);
+
+        tree.Write(_T("box/memory.current"), _T("100\n"));
+        tree.Write(_T("box/memory.stat"), _T("anon 10\nfile_mapped 20\n"));
+        tree.Write(_T("box/cpu.stat"), _T("user_usec 3\n"));
+
+        memory = statistics.Memory();
+        EXPECT_EQ(memory.allocated, 100u);
+        EXPECT_EQ(memory.resident, 10u);
+        EXPECT_EQ(memory.shared, 20u);
+        // A key that is missing stays unknown.
+        EXPECT_EQ(statistics.Cpu().total, UINT64_MAX);
+
+        // The descriptors stay open, a new sample reads the new content.
+        tree.Write(_T("box/memory.current"), _T("200\n"));
+        tree.Write(_T("box/cpu.stat"), _T("usage_usec 7\n"));
+
+        EXPECT_EQ(statistics.Memory().allocated, 200u);
+        EXPECT_EQ(statistics.Cpu().total, 7000u);
+
+        statistics.Detach();
+        EXPECT_FALSE(statistics.IsAttached());
+        EXPECT_EQ(statistics.Memory().allocated, UINT64_MAX);
+    }
+
+} // Tests
+} // WPEFramework